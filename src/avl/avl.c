@@ -98,6 +98,12 @@ static bool yadsl_avltree_subtree_node_search_internal(
 	yadsl_AVLTreeObject* object,
 	yadsl_AVLSubtree* node);
 
+static yadsl_AVLSubtree* yadsl_avltree_subtree_bound_internal(
+	yadsl_AVLTree* tree,
+	yadsl_AVLTreeObject* object,
+	yadsl_AVLSubtree* node,
+	bool is_strict);
+
 static yadsl_AVLTreeVisitObjRet* yadsl_avltree_subtree_traverse_post_internal(
 	yadsl_AVLSubtree* node,
 	yadsl_AVLTreeVisitObjFunc visit_func,
@@ -174,6 +180,34 @@ yadsl_AVLTreeRet yadsl_avltree_object_search(
 	return YADSL_AVLTREE_RET_OK;
 }
 
+yadsl_AVLTreeRet yadsl_avltree_object_lower_bound(
+	yadsl_AVLTreeHandle* tree_handle,
+	yadsl_AVLTreeObject* object,
+	bool* exists_ptr,
+	yadsl_AVLTreeObject** bound_ptr)
+{
+	yadsl_AVLTree* tree = (yadsl_AVLTree*) tree_handle;
+	yadsl_AVLSubtree* bound = yadsl_avltree_subtree_bound_internal(tree, object, tree->root, false);
+	*exists_ptr = bound != NULL;
+	if (bound)
+		*bound_ptr = bound->object;
+	return YADSL_AVLTREE_RET_OK;
+}
+
+yadsl_AVLTreeRet yadsl_avltree_object_upper_bound(
+	yadsl_AVLTreeHandle* tree_handle,
+	yadsl_AVLTreeObject* object,
+	bool* exists_ptr,
+	yadsl_AVLTreeObject** bound_ptr)
+{
+	yadsl_AVLTree* tree = (yadsl_AVLTree*) tree_handle;
+	yadsl_AVLSubtree* bound = yadsl_avltree_subtree_bound_internal(tree, object, tree->root, true);
+	*exists_ptr = bound != NULL;
+	if (bound)
+		*bound_ptr = bound->object;
+	return YADSL_AVLTREE_RET_OK;
+}
+
 yadsl_AVLTreeRet yadsl_avltree_tree_traverse(
 	yadsl_AVLTreeHandle* tree_handle,
 	yadsl_AVLTreeVisitingOrder visit_order,
@@ -442,6 +476,36 @@ bool yadsl_avltree_subtree_node_search_internal(
 		return true;
 }
 
+/**
+ * @brief Search for lowest node in subtree not less than object
+ * (or greater than object, if strict)
+ * @param tree tree from whose nodes the object will be searched
+ * @param object object to be compared with
+ * @param node subtree root
+ * @param is_strict whether node object must be greater than object
+ * @return lowest such node or NULL, if there is none
+*/
+yadsl_AVLSubtree* yadsl_avltree_subtree_bound_internal(
+	yadsl_AVLTree* tree,
+	yadsl_AVLTreeObject* object,
+	yadsl_AVLSubtree* node,
+	bool is_strict)
+{
+	int cmp;
+	yadsl_AVLSubtree* bound = NULL;
+	while (node != NULL) {
+		YADSL_AVLTREE_CHECK_INVARIANTS(node);
+		cmp = YADSL_AVLTREE_COMPARE_OBJECTS(object, node->object, tree);
+		if (cmp < 0 || (cmp == 0 && !is_strict)) {
+			bound = node;
+			node = node->left;
+		} else {
+			node = node->right;
+		}
+	}
+	return bound;
+}
+
 /**
  * @brief Remove node containing object from subtree
  * @param tree tree from where node will be removed
@@ -115,6 +115,40 @@ yadsl_avltree_object_search(
 	yadsl_AVLTreeObject* object,
 	bool* exists_ptr);
 
+/**
+ * @brief Get lowest object in tree not less than a given object
+ * @param tree tree where object will be searched
+ * @param object object to be compared with
+ * @param exists_ptr whether such object exists or not
+ * @param bound_ptr lowest object not less than object
+ * @return
+ * * ::YADSL_AVLTREE_RET_OK, and *exists_ptr is updated.
+ *   If it exists, *bound_ptr is updated.
+*/
+yadsl_AVLTreeRet
+yadsl_avltree_object_lower_bound(
+	yadsl_AVLTreeHandle* tree,
+	yadsl_AVLTreeObject* object,
+	bool* exists_ptr,
+	yadsl_AVLTreeObject** bound_ptr);
+
+/**
+ * @brief Get lowest object in tree greater than a given object
+ * @param tree tree where object will be searched
+ * @param object object to be compared with
+ * @param exists_ptr whether such object exists or not
+ * @param bound_ptr lowest object greater than object
+ * @return
+ * * ::YADSL_AVLTREE_RET_OK, and *exists_ptr is updated.
+ *   If it exists, *bound_ptr is updated.
+*/
+yadsl_AVLTreeRet
+yadsl_avltree_object_upper_bound(
+	yadsl_AVLTreeHandle* tree,
+	yadsl_AVLTreeObject* object,
+	bool* exists_ptr,
+	yadsl_AVLTreeObject** bound_ptr);
+
 /**
  * @brief Remove object from tree
  * @param tree tree where object will be removed from
@@ -18,6 +18,10 @@ const char *yadsl_tester_help_strings[] = {
 	"/traverse* <first> <last>            traverse from first to last ...",
 	"/delete <number> [YES/NO]            delete number from tree",
 	"/delete* <first> <last> [YES/NO]     delete from first to last ...",
+	"/lowerbound <number> <expected>      get lowest number not less than",
+	"                                     number (or NONE)",
+	"/upperbound <number> <expected>      get lowest number greater than",
+	"                                     number (or NONE)",
 	NULL,
 };
 
@@ -222,6 +226,26 @@ yadsl_TesterRet yadsl_tester_parse(const char *command)
 			else if (first > last)
 				--first;
 		} while (first != last);
+	} else if (yadsl_testerutils_match(command, "lowerbound") ||
+		yadsl_testerutils_match(command, "upperbound")) {
+		int number;
+		void *pBound;
+		bool exists;
+		if (yadsl_tester_parse_arguments("is", &number, buffer) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (yadsl_testerutils_match(command, "lowerbound"))
+			returnId = yadsl_avltree_object_lower_bound(pTree, &number, &exists, &pBound);
+		else
+			returnId = yadsl_avltree_object_upper_bound(pTree, &number, &exists, &pBound);
+		if (!returnId) {
+			if (!exists) {
+				if (!yadsl_testerutils_match(buffer, "NONE"))
+					return YADSL_TESTER_RET_RETURN;
+			} else if (yadsl_testerutils_match(buffer, "NONE") ||
+				*(int *) pBound != atoi(buffer)) {
+				return YADSL_TESTER_RET_RETURN;
+			}
+		}
 	} else {
 		return YADSL_TESTER_RET_COMMAND;
 	}
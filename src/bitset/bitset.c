@@ -0,0 +1,389 @@
+#include <bitset/bitset.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef YADSL_DEBUG
+#include <memdb/memdb.h>
+#else
+#include <stdlib.h>
+#endif
+
+#define YADSL_BITSET_WORD_BITS 64
+
+typedef struct
+{
+	uint64_t* words; /* Bit i is bit (i % 64) of words[i / 64] */
+	size_t word_count; /* Number of words used */
+	size_t size; /* Number of bits (bits beyond are always cleared) */
+}
+yadsl_Bitset;
+
+// Private functions prototypes
+
+static size_t
+yadsl_bitset_word_count_internal(
+	size_t size);
+
+static uint64_t*
+yadsl_bitset_words_alloc_internal(
+	size_t word_count);
+
+static void
+yadsl_bitset_tail_clear_internal(
+	yadsl_Bitset* bitset);
+
+static size_t
+yadsl_bitset_popcount_internal(
+	uint64_t word);
+
+static size_t
+yadsl_bitset_ctz_internal(
+	uint64_t word);
+
+// Public functions
+
+yadsl_BitsetHandle*
+yadsl_bitset_create(
+	size_t size)
+{
+	yadsl_Bitset* bitset = malloc(sizeof(*bitset));
+	if (bitset) {
+		bitset->size = size;
+		bitset->word_count = yadsl_bitset_word_count_internal(size);
+		bitset->words = yadsl_bitset_words_alloc_internal(bitset->word_count);
+		if (bitset->words == NULL) {
+			free(bitset);
+			return NULL;
+		}
+		memset(bitset->words, 0, bitset->word_count * sizeof(*bitset->words));
+	}
+	return bitset;
+}
+
+yadsl_BitsetHandle*
+yadsl_bitset_copy(
+	yadsl_BitsetHandle* bitset)
+{
+	yadsl_Bitset* bitset_ = (yadsl_Bitset*) bitset;
+	yadsl_Bitset* copy = malloc(sizeof(*copy));
+	if (copy) {
+		copy->size = bitset_->size;
+		copy->word_count = bitset_->word_count;
+		copy->words = yadsl_bitset_words_alloc_internal(copy->word_count);
+		if (copy->words == NULL) {
+			free(copy);
+			return NULL;
+		}
+		memcpy(copy->words, bitset_->words, copy->word_count * sizeof(*copy->words));
+	}
+	return copy;
+}
+
+yadsl_BitsetRet
+yadsl_bitset_size_get(
+	yadsl_BitsetHandle* bitset,
+	size_t* size_ptr)
+{
+	*size_ptr = ((yadsl_Bitset*) bitset)->size;
+	return YADSL_BITSET_RET_OK;
+}
+
+yadsl_BitsetRet
+yadsl_bitset_resize(
+	yadsl_BitsetHandle* bitset,
+	size_t size)
+{
+	yadsl_Bitset* bitset_ = (yadsl_Bitset*) bitset;
+	size_t word_count = yadsl_bitset_word_count_internal(size);
+
+	if (word_count != bitset_->word_count) {
+		uint64_t* words = realloc(bitset_->words,
+			(word_count ? word_count : 1) * sizeof(*words));
+		if (words == NULL)
+			return YADSL_BITSET_RET_MEMORY;
+		if (word_count > bitset_->word_count)
+			memset(words + bitset_->word_count, 0,
+				(word_count - bitset_->word_count) * sizeof(*words));
+		bitset_->words = words;
+		bitset_->word_count = word_count;
+	}
+
+	bitset_->size = size;
+	yadsl_bitset_tail_clear_internal(bitset_);
+
+	return YADSL_BITSET_RET_OK;
+}
+
+yadsl_BitsetRet
+yadsl_bitset_bit_set(
+	yadsl_BitsetHandle* bitset,
+	size_t index)
+{
+	yadsl_Bitset* bitset_ = (yadsl_Bitset*) bitset;
+
+	if (index >= bitset_->size)
+		return YADSL_BITSET_RET_OUT_OF_BOUNDS;
+
+	bitset_->words[index / YADSL_BITSET_WORD_BITS] |=
+		(uint64_t) 1 << (index % YADSL_BITSET_WORD_BITS);
+
+	return YADSL_BITSET_RET_OK;
+}
+
+yadsl_BitsetRet
+yadsl_bitset_bit_clear(
+	yadsl_BitsetHandle* bitset,
+	size_t index)
+{
+	yadsl_Bitset* bitset_ = (yadsl_Bitset*) bitset;
+
+	if (index >= bitset_->size)
+		return YADSL_BITSET_RET_OUT_OF_BOUNDS;
+
+	bitset_->words[index / YADSL_BITSET_WORD_BITS] &=
+		~((uint64_t) 1 << (index % YADSL_BITSET_WORD_BITS));
+
+	return YADSL_BITSET_RET_OK;
+}
+
+yadsl_BitsetRet
+yadsl_bitset_bit_check(
+	yadsl_BitsetHandle* bitset,
+	size_t index,
+	bool* is_set_ptr)
+{
+	yadsl_Bitset* bitset_ = (yadsl_Bitset*) bitset;
+
+	if (index >= bitset_->size)
+		return YADSL_BITSET_RET_OUT_OF_BOUNDS;
+
+	*is_set_ptr = (bitset_->words[index / YADSL_BITSET_WORD_BITS] >>
+		(index % YADSL_BITSET_WORD_BITS)) & 1;
+
+	return YADSL_BITSET_RET_OK;
+}
+
+yadsl_BitsetRet
+yadsl_bitset_clear(
+	yadsl_BitsetHandle* bitset)
+{
+	yadsl_Bitset* bitset_ = (yadsl_Bitset*) bitset;
+	memset(bitset_->words, 0, bitset_->word_count * sizeof(*bitset_->words));
+	return YADSL_BITSET_RET_OK;
+}
+
+yadsl_BitsetRet
+yadsl_bitset_count_get(
+	yadsl_BitsetHandle* bitset,
+	size_t* count_ptr)
+{
+	yadsl_Bitset* bitset_ = (yadsl_Bitset*) bitset;
+	size_t i, count = 0;
+
+	for (i = 0; i < bitset_->word_count; ++i)
+		count += yadsl_bitset_popcount_internal(bitset_->words[i]);
+
+	*count_ptr = count;
+	return YADSL_BITSET_RET_OK;
+}
+
+yadsl_BitsetRet
+yadsl_bitset_rank_get(
+	yadsl_BitsetHandle* bitset,
+	size_t index,
+	size_t* rank_ptr)
+{
+	yadsl_Bitset* bitset_ = (yadsl_Bitset*) bitset;
+	size_t i, rank = 0, word_count, offset;
+
+	if (index > bitset_->size)
+		return YADSL_BITSET_RET_OUT_OF_BOUNDS;
+
+	word_count = index / YADSL_BITSET_WORD_BITS;
+	offset = index % YADSL_BITSET_WORD_BITS;
+
+	for (i = 0; i < word_count; ++i)
+		rank += yadsl_bitset_popcount_internal(bitset_->words[i]);
+	if (offset)
+		rank += yadsl_bitset_popcount_internal(bitset_->words[word_count] &
+			(((uint64_t) 1 << offset) - 1));
+
+	*rank_ptr = rank;
+	return YADSL_BITSET_RET_OK;
+}
+
+yadsl_BitsetRet
+yadsl_bitset_select(
+	yadsl_BitsetHandle* bitset,
+	size_t rank,
+	size_t* index_ptr)
+{
+	yadsl_Bitset* bitset_ = (yadsl_Bitset*) bitset;
+	size_t i;
+
+	for (i = 0; i < bitset_->word_count; ++i) {
+		uint64_t word = bitset_->words[i];
+		size_t count = yadsl_bitset_popcount_internal(word);
+		if (rank < count) {
+			// drop the lowest set bits of the word
+			while (rank--)
+				word &= word - 1;
+			*index_ptr = i * YADSL_BITSET_WORD_BITS +
+				yadsl_bitset_ctz_internal(word);
+			return YADSL_BITSET_RET_OK;
+		}
+		rank -= count;
+	}
+
+	return YADSL_BITSET_RET_NOT_FOUND;
+}
+
+yadsl_BitsetRet
+yadsl_bitset_bit_next_get(
+	yadsl_BitsetHandle* bitset,
+	size_t index,
+	size_t* index_ptr)
+{
+	yadsl_Bitset* bitset_ = (yadsl_Bitset*) bitset;
+	size_t i;
+	uint64_t word;
+
+	if (index >= bitset_->size)
+		return YADSL_BITSET_RET_NOT_FOUND;
+
+	i = index / YADSL_BITSET_WORD_BITS;
+	word = bitset_->words[i] & (~(uint64_t) 0 << (index % YADSL_BITSET_WORD_BITS));
+	while (word == 0) {
+		if (++i == bitset_->word_count)
+			return YADSL_BITSET_RET_NOT_FOUND;
+		word = bitset_->words[i];
+	}
+
+	*index_ptr = i * YADSL_BITSET_WORD_BITS + yadsl_bitset_ctz_internal(word);
+	return YADSL_BITSET_RET_OK;
+}
+
+yadsl_BitsetRet
+yadsl_bitset_union_update(
+	yadsl_BitsetHandle* bitset,
+	yadsl_BitsetHandle* other)
+{
+	yadsl_Bitset* bitset_ = (yadsl_Bitset*) bitset;
+	yadsl_Bitset* other_ = (yadsl_Bitset*) other;
+	size_t i;
+
+	if (bitset_->size != other_->size)
+		return YADSL_BITSET_RET_SIZE_MISMATCH;
+
+	for (i = 0; i < bitset_->word_count; ++i)
+		bitset_->words[i] |= other_->words[i];
+
+	return YADSL_BITSET_RET_OK;
+}
+
+yadsl_BitsetRet
+yadsl_bitset_intersection_update(
+	yadsl_BitsetHandle* bitset,
+	yadsl_BitsetHandle* other)
+{
+	yadsl_Bitset* bitset_ = (yadsl_Bitset*) bitset;
+	yadsl_Bitset* other_ = (yadsl_Bitset*) other;
+	size_t i;
+
+	if (bitset_->size != other_->size)
+		return YADSL_BITSET_RET_SIZE_MISMATCH;
+
+	for (i = 0; i < bitset_->word_count; ++i)
+		bitset_->words[i] &= other_->words[i];
+
+	return YADSL_BITSET_RET_OK;
+}
+
+yadsl_BitsetRet
+yadsl_bitset_xor_update(
+	yadsl_BitsetHandle* bitset,
+	yadsl_BitsetHandle* other)
+{
+	yadsl_Bitset* bitset_ = (yadsl_Bitset*) bitset;
+	yadsl_Bitset* other_ = (yadsl_Bitset*) other;
+	size_t i;
+
+	if (bitset_->size != other_->size)
+		return YADSL_BITSET_RET_SIZE_MISMATCH;
+
+	for (i = 0; i < bitset_->word_count; ++i)
+		bitset_->words[i] ^= other_->words[i];
+
+	return YADSL_BITSET_RET_OK;
+}
+
+void
+yadsl_bitset_destroy(
+	yadsl_BitsetHandle* bitset)
+{
+	yadsl_Bitset* bitset_ = (yadsl_Bitset*) bitset;
+
+	if (bitset_ == NULL)
+		return;
+
+	free(bitset_->words);
+	free(bitset_);
+}
+
+// Private functions
+
+// Number of words needed to store size bits
+size_t
+yadsl_bitset_word_count_internal(
+	size_t size)
+{
+	return size / YADSL_BITSET_WORD_BITS + (size % YADSL_BITSET_WORD_BITS != 0);
+}
+
+// Allocates words (at least one, so that malloc(0) is never called)
+uint64_t*
+yadsl_bitset_words_alloc_internal(
+	size_t word_count)
+{
+	return malloc((word_count ? word_count : 1) * sizeof(uint64_t));
+}
+
+// Clears the bits of the last word beyond the bitset size
+void
+yadsl_bitset_tail_clear_internal(
+	yadsl_Bitset* bitset)
+{
+	size_t offset = bitset->size % YADSL_BITSET_WORD_BITS;
+	if (offset)
+		bitset->words[bitset->word_count - 1] &= ((uint64_t) 1 << offset) - 1;
+}
+
+// Counts set bits in word, with the POPCNT instruction
+// when the compiler targets it
+size_t
+yadsl_bitset_popcount_internal(
+	uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return (size_t) __builtin_popcountll(word);
+#else
+	word = word - ((word >> 1) & 0x5555555555555555ULL);
+	word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+	word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (size_t) ((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Counts trailing zeros in word
+// [!] Assumes word is not zero
+size_t
+yadsl_bitset_ctz_internal(
+	uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return (size_t) __builtin_ctzll(word);
+#else
+	return yadsl_bitset_popcount_internal((word & (~word + 1)) - 1);
+#endif
+}
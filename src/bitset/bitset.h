@@ -0,0 +1,260 @@
+#ifndef __YADSL_BITSET_H__
+#define __YADSL_BITSET_H__
+
+/**
+ * \defgroup bitset Bitset
+ * @brief Dense set of small integers
+ *
+ * A Bitset stores a set of integers in the range [0, size),
+ * using one bit per integer, packed in 64-bit words. It is
+ * best suited for dense id ranges, where a node-based set
+ * would spend dozens of bytes per element.
+ *
+ * Set operations (union, intersection and xor) are computed
+ * a whole word at a time, and counting uses the population
+ * count instructions of the target when the compiler exposes
+ * them, with a portable fallback otherwise.
+ *
+ * Rank and select walk the words up to the position of
+ * interest, and so take time proportional to size / 64.
+ *
+ * Set bits can be iterated in increasing order with
+ * ::yadsl_bitset_bit_next_get.
+ *
+ * @{
+*/
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief Value returned by Bitset functions
+*/
+typedef enum
+{
+	YADSL_BITSET_RET_OK = 0, /**< All went ok */
+	YADSL_BITSET_RET_MEMORY, /**< Could not allocate memory */
+	YADSL_BITSET_RET_OUT_OF_BOUNDS, /**< Index out of bounds */
+	YADSL_BITSET_RET_SIZE_MISMATCH, /**< Bitsets have different sizes */
+	YADSL_BITSET_RET_NOT_FOUND, /**< No set bit was found */
+}
+yadsl_BitsetRet;
+
+typedef void yadsl_BitsetHandle; /**< Bitset handle */
+
+/**
+ * @brief Create a bitset with all bits cleared
+ * @param size number of bits
+ * @return newly created bitset or NULL if could not allocate memory
+*/
+yadsl_BitsetHandle*
+yadsl_bitset_create(
+	size_t size);
+
+/**
+ * @brief Create a copy of a bitset
+ * @param bitset bitset
+ * @return newly created bitset or NULL if could not allocate memory
+*/
+yadsl_BitsetHandle*
+yadsl_bitset_copy(
+	yadsl_BitsetHandle* bitset);
+
+/**
+ * @brief Get number of bits in a bitset
+ * @param bitset bitset
+ * @param size_ptr number of bits
+ * @return
+ * * ::YADSL_BITSET_RET_OK, and *size_ptr is updated
+*/
+yadsl_BitsetRet
+yadsl_bitset_size_get(
+	yadsl_BitsetHandle* bitset,
+	size_t* size_ptr);
+
+/**
+ * @brief Change number of bits in a bitset
+ *
+ * New bits start cleared. Bits beyond the new size are dropped.
+ *
+ * @param bitset bitset
+ * @param size new number of bits
+ * @return
+ * * ::YADSL_BITSET_RET_OK, and bitset is resized
+ * * ::YADSL_BITSET_RET_MEMORY
+*/
+yadsl_BitsetRet
+yadsl_bitset_resize(
+	yadsl_BitsetHandle* bitset,
+	size_t size);
+
+/**
+ * @brief Set bit
+ * @param bitset bitset
+ * @param index bit index
+ * @return
+ * * ::YADSL_BITSET_RET_OK, and bit is set
+ * * ::YADSL_BITSET_RET_OUT_OF_BOUNDS
+*/
+yadsl_BitsetRet
+yadsl_bitset_bit_set(
+	yadsl_BitsetHandle* bitset,
+	size_t index);
+
+/**
+ * @brief Clear bit
+ * @param bitset bitset
+ * @param index bit index
+ * @return
+ * * ::YADSL_BITSET_RET_OK, and bit is cleared
+ * * ::YADSL_BITSET_RET_OUT_OF_BOUNDS
+*/
+yadsl_BitsetRet
+yadsl_bitset_bit_clear(
+	yadsl_BitsetHandle* bitset,
+	size_t index);
+
+/**
+ * @brief Check whether bit is set
+ * @param bitset bitset
+ * @param index bit index
+ * @param is_set_ptr whether bit is set
+ * @return
+ * * ::YADSL_BITSET_RET_OK, and *is_set_ptr is updated
+ * * ::YADSL_BITSET_RET_OUT_OF_BOUNDS
+*/
+yadsl_BitsetRet
+yadsl_bitset_bit_check(
+	yadsl_BitsetHandle* bitset,
+	size_t index,
+	bool* is_set_ptr);
+
+/**
+ * @brief Clear all bits
+ * @param bitset bitset
+ * @return
+ * * ::YADSL_BITSET_RET_OK, and all bits are cleared
+*/
+yadsl_BitsetRet
+yadsl_bitset_clear(
+	yadsl_BitsetHandle* bitset);
+
+/**
+ * @brief Get number of set bits
+ * @param bitset bitset
+ * @param count_ptr number of set bits
+ * @return
+ * * ::YADSL_BITSET_RET_OK, and *count_ptr is updated
+*/
+yadsl_BitsetRet
+yadsl_bitset_count_get(
+	yadsl_BitsetHandle* bitset,
+	size_t* count_ptr);
+
+/**
+ * @brief Get number of set bits before index
+ * @param bitset bitset
+ * @param index bit index (up to the bitset size)
+ * @param rank_ptr number of set bits in [0, index)
+ * @return
+ * * ::YADSL_BITSET_RET_OK, and *rank_ptr is updated
+ * * ::YADSL_BITSET_RET_OUT_OF_BOUNDS
+*/
+yadsl_BitsetRet
+yadsl_bitset_rank_get(
+	yadsl_BitsetHandle* bitset,
+	size_t index,
+	size_t* rank_ptr);
+
+/**
+ * @brief Get index of the set bit with a given rank
+ *
+ * Inverse of ::yadsl_bitset_rank_get: the set bit of rank 0
+ * is the lowest one, and so on.
+ *
+ * @param bitset bitset
+ * @param rank number of set bits before the one searched
+ * @param index_ptr index of set bit
+ * @return
+ * * ::YADSL_BITSET_RET_OK, and *index_ptr is updated
+ * * ::YADSL_BITSET_RET_NOT_FOUND, if rank is not less than the count
+*/
+yadsl_BitsetRet
+yadsl_bitset_select(
+	yadsl_BitsetHandle* bitset,
+	size_t rank,
+	size_t* index_ptr);
+
+/**
+ * @brief Get lowest set bit not below index
+ *
+ * Iterating over the set bits can be done as follows:
+ * @code
+ * size_t i;
+ * for (i = 0; !yadsl_bitset_bit_next_get(bitset, i, &i); ++i)
+ *     visit(i);
+ * @endcode
+ *
+ * @param bitset bitset
+ * @param index bit index where search starts
+ * @param index_ptr index of set bit
+ * @return
+ * * ::YADSL_BITSET_RET_OK, and *index_ptr is updated
+ * * ::YADSL_BITSET_RET_NOT_FOUND
+*/
+yadsl_BitsetRet
+yadsl_bitset_bit_next_get(
+	yadsl_BitsetHandle* bitset,
+	size_t index,
+	size_t* index_ptr);
+
+/**
+ * @brief Set bits that are set in other bitset
+ * @param bitset bitset
+ * @param other other bitset, of same size
+ * @return
+ * * ::YADSL_BITSET_RET_OK, and bitset becomes the union of both
+ * * ::YADSL_BITSET_RET_SIZE_MISMATCH
+*/
+yadsl_BitsetRet
+yadsl_bitset_union_update(
+	yadsl_BitsetHandle* bitset,
+	yadsl_BitsetHandle* other);
+
+/**
+ * @brief Clear bits that are not set in other bitset
+ * @param bitset bitset
+ * @param other other bitset, of same size
+ * @return
+ * * ::YADSL_BITSET_RET_OK, and bitset becomes the intersection of both
+ * * ::YADSL_BITSET_RET_SIZE_MISMATCH
+*/
+yadsl_BitsetRet
+yadsl_bitset_intersection_update(
+	yadsl_BitsetHandle* bitset,
+	yadsl_BitsetHandle* other);
+
+/**
+ * @brief Flip bits that are set in other bitset
+ * @param bitset bitset
+ * @param other other bitset, of same size
+ * @return
+ * * ::YADSL_BITSET_RET_OK, and bitset becomes the xor of both
+ * * ::YADSL_BITSET_RET_SIZE_MISMATCH
+*/
+yadsl_BitsetRet
+yadsl_bitset_xor_update(
+	yadsl_BitsetHandle* bitset,
+	yadsl_BitsetHandle* other);
+
+/**
+ * @brief Destroy bitset
+ * @param bitset bitset
+*/
+void
+yadsl_bitset_destroy(
+	yadsl_BitsetHandle* bitset);
+
+/** @} */
+
+#endif
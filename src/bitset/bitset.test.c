@@ -0,0 +1,185 @@
+#include <bitset/bitset.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <tester/tester.h>
+#include <testerutils/testerutils.h>
+
+/* Help */
+
+const char *yadsl_tester_help_strings[] = {
+	"This is an interactive module of the bitset library",
+	"You interact with a bitset and an auxiliary bitset",
+	"",
+	"The registered actions are the following:",
+	"/create <size>             replace bitset by an empty one",
+	"/copy                      replace auxiliary bitset by a copy of bitset",
+	"/swap                      swap bitset with the auxiliary bitset",
+	"/resize <size>             resize bitset",
+	"/size <expected>           get bitset size",
+	"/set <index>               set bit",
+	"/clear <index>             clear bit",
+	"/check <index> [YES/NO]    check whether bit is set",
+	"/clearall                  clear all bits",
+	"/count <expected>          count set bits",
+	"/rank <index> <expected>   count set bits before index",
+	"/select <rank> <expected>  get index of set bit with rank",
+	"/next <index> <expected>   get lowest set bit not below index",
+	"/bits <expected>           iterate over set bits, separated by spaces",
+	"/union                     set bits set in the auxiliary bitset",
+	"/intersection              clear bits not set in the auxiliary bitset",
+	"/xor                       flip bits set in the auxiliary bitset",
+	NULL, /* Sentinel */
+};
+
+yadsl_TesterRet convertReturn(yadsl_BitsetRet bitsetId)
+{
+	switch (bitsetId) {
+	case YADSL_BITSET_RET_OK:
+		return YADSL_TESTER_RET_OK;
+	case YADSL_BITSET_RET_MEMORY:
+		return YADSL_TESTER_RET_MALLOC;
+	case YADSL_BITSET_RET_OUT_OF_BOUNDS:
+		return yadsl_tester_return_external_value("bounds");
+	case YADSL_BITSET_RET_SIZE_MISMATCH:
+		return yadsl_tester_return_external_value("mismatch");
+	case YADSL_BITSET_RET_NOT_FOUND:
+		return yadsl_tester_return_external_value("notfound");
+	default:
+		return yadsl_tester_return_external_value("unknown");
+	}
+}
+
+/* Bitset objects */
+static yadsl_BitsetHandle *pBitset = NULL;
+static yadsl_BitsetHandle *pOther = NULL;
+
+static char buffer[BUFSIZ], arg[BUFSIZ];
+
+yadsl_TesterRet yadsl_tester_init()
+{
+	if ((pBitset = yadsl_bitset_create(0)) &&
+		(pOther = yadsl_bitset_create(0)))
+		return YADSL_TESTER_RET_OK;
+	else
+		return YADSL_TESTER_RET_MALLOC;
+}
+
+yadsl_TesterRet yadsl_tester_parse(const char *command)
+{
+	yadsl_BitsetRet bitsetId = YADSL_BITSET_RET_OK;
+	if (yadsl_testerutils_match(command, "create")) {
+		size_t size;
+		yadsl_BitsetHandle *temp;
+		if (yadsl_tester_parse_arguments("z", &size) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if ((temp = yadsl_bitset_create(size)) == NULL)
+			return YADSL_TESTER_RET_MALLOC;
+		yadsl_bitset_destroy(pBitset);
+		pBitset = temp;
+	} else if (yadsl_testerutils_match(command, "copy")) {
+		yadsl_BitsetHandle *temp;
+		if ((temp = yadsl_bitset_copy(pBitset)) == NULL)
+			return YADSL_TESTER_RET_MALLOC;
+		yadsl_bitset_destroy(pOther);
+		pOther = temp;
+	} else if (yadsl_testerutils_match(command, "swap")) {
+		yadsl_BitsetHandle *temp = pBitset;
+		pBitset = pOther;
+		pOther = temp;
+	} else if (yadsl_testerutils_match(command, "resize")) {
+		size_t size;
+		if (yadsl_tester_parse_arguments("z", &size) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		bitsetId = yadsl_bitset_resize(pBitset, size);
+	} else if (yadsl_testerutils_match(command, "size")) {
+		size_t expected, actual;
+		if (yadsl_tester_parse_arguments("z", &expected) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		bitsetId = yadsl_bitset_size_get(pBitset, &actual);
+		if (bitsetId == YADSL_BITSET_RET_OK && actual != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "set")) {
+		size_t index;
+		if (yadsl_tester_parse_arguments("z", &index) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		bitsetId = yadsl_bitset_bit_set(pBitset, index);
+	} else if (yadsl_testerutils_match(command, "clear")) {
+		size_t index;
+		if (yadsl_tester_parse_arguments("z", &index) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		bitsetId = yadsl_bitset_bit_clear(pBitset, index);
+	} else if (yadsl_testerutils_match(command, "check")) {
+		size_t index;
+		bool expected, actual;
+		if (yadsl_tester_parse_arguments("zs", &index, arg) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		expected = yadsl_testerutils_str_to_bool(arg);
+		bitsetId = yadsl_bitset_bit_check(pBitset, index, &actual);
+		if (bitsetId == YADSL_BITSET_RET_OK && actual != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "clearall")) {
+		bitsetId = yadsl_bitset_clear(pBitset);
+	} else if (yadsl_testerutils_match(command, "count")) {
+		size_t expected, actual;
+		if (yadsl_tester_parse_arguments("z", &expected) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		bitsetId = yadsl_bitset_count_get(pBitset, &actual);
+		if (bitsetId == YADSL_BITSET_RET_OK && actual != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "rank")) {
+		size_t index, expected, actual;
+		if (yadsl_tester_parse_arguments("zz", &index, &expected) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		bitsetId = yadsl_bitset_rank_get(pBitset, index, &actual);
+		if (bitsetId == YADSL_BITSET_RET_OK && actual != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "select")) {
+		size_t rank, expected, actual;
+		if (yadsl_tester_parse_arguments("zz", &rank, &expected) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		bitsetId = yadsl_bitset_select(pBitset, rank, &actual);
+		if (bitsetId == YADSL_BITSET_RET_OK && actual != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "next")) {
+		size_t index, expected, actual;
+		if (yadsl_tester_parse_arguments("zz", &index, &expected) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		bitsetId = yadsl_bitset_bit_next_get(pBitset, index, &actual);
+		if (bitsetId == YADSL_BITSET_RET_OK && actual != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "bits")) {
+		size_t index, length = 0;
+		if (yadsl_tester_parse_arguments("s", arg) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		buffer[0] = '\0';
+		for (index = 0;
+			!yadsl_bitset_bit_next_get(pBitset, index, &index);
+			++index) {
+			length += sprintf(buffer + length, length ? " %zu" : "%zu", index);
+			if (length >= sizeof(buffer) - 32)
+				break;
+		}
+		if (strcmp(buffer, arg) != 0) {
+			yadsl_tester_log("Set bits are \"%s\"", buffer);
+			return YADSL_TESTER_RET_RETURN;
+		}
+	} else if (yadsl_testerutils_match(command, "union")) {
+		bitsetId = yadsl_bitset_union_update(pBitset, pOther);
+	} else if (yadsl_testerutils_match(command, "intersection")) {
+		bitsetId = yadsl_bitset_intersection_update(pBitset, pOther);
+	} else if (yadsl_testerutils_match(command, "xor")) {
+		bitsetId = yadsl_bitset_xor_update(pBitset, pOther);
+	} else {
+		return YADSL_TESTER_RET_COMMAND;
+	}
+	return convertReturn(bitsetId);
+}
+
+yadsl_TesterRet yadsl_tester_release()
+{
+	yadsl_bitset_destroy(pBitset);
+	yadsl_bitset_destroy(pOther);
+	return YADSL_TESTER_RET_OK;
+}
@@ -0,0 +1,567 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <yadsl/pydefines.h>
+#include <bitset/bitset.h>
+
+//
+// Objects
+//
+
+typedef struct
+{
+	PyObject_HEAD
+	yadsl_BitsetHandle *ob_bitset;
+} BitsetObject;
+
+static PyTypeObject BitsetType;
+
+//
+// Exceptions
+//
+
+static PyObject *PyExc_OutOfBounds = NULL;
+static PyObject *PyExc_SizeMismatch = NULL;
+static PyObject *PyExc_NotFound = NULL;
+
+YADSL_PYDEFINES_EXCEPTION_METADATA()
+
+static struct _exception_metadata exceptions[] = {
+	//
+	// Exception definitions
+	//
+	{
+		&PyExc_OutOfBounds,
+		"pybitset.OutOfBounds",
+		"OutOfBounds",
+		"Index is out of the bitset bounds."
+	},
+	{
+		&PyExc_SizeMismatch,
+		"pybitset.SizeMismatch",
+		"SizeMismatch",
+		"Bitsets have different sizes."
+	},
+	{
+		&PyExc_NotFound,
+		"pybitset.NotFound",
+		"NotFound",
+		"No set bit was found."
+	},
+	//
+	// Sentinel
+	//
+	{
+		NULL,
+		NULL,
+		NULL,
+	},
+};
+
+YADSL_PYDEFINES_EXCEPTION_FUNCTIONS(Bitset, exceptions)
+
+//
+// Auxiliary functions
+//
+
+static int
+Bitset_parse_size(PyObject *obj, size_t *size_ptr)
+{
+	if (!PyLong_Check(obj)) {
+		PyErr_SetString(PyExc_TypeError,
+			"parameter should be an integer");
+		return 0;
+	}
+	*size_ptr = PyLong_AsSize_t(obj);
+	if (*size_ptr == ((size_t) -1) && PyErr_Occurred())
+		return 0;
+	return 1;
+}
+
+static int
+Bitset_parse_other(PyObject *obj, yadsl_BitsetHandle **bitset_ptr)
+{
+	if (!PyObject_TypeCheck(obj, &BitsetType)) {
+		PyErr_SetString(PyExc_TypeError,
+			"parameter should be a bitset");
+		return 0;
+	}
+	*bitset_ptr = ((BitsetObject *) obj)->ob_bitset;
+	return 1;
+}
+
+static PyObject *
+Bitset_throw(yadsl_BitsetRet returnId)
+{
+	switch (returnId) {
+	case YADSL_BITSET_RET_MEMORY:
+		PyErr_SetString(PyExc_MemoryError,
+			"Could not allocate memory for bitset");
+		break;
+	case YADSL_BITSET_RET_OUT_OF_BOUNDS:
+		_Bitset_throw_error(PyExc_OutOfBounds);
+		break;
+	case YADSL_BITSET_RET_SIZE_MISMATCH:
+		_Bitset_throw_error(PyExc_SizeMismatch);
+		break;
+	case YADSL_BITSET_RET_NOT_FOUND:
+		_Bitset_throw_error(PyExc_NotFound);
+		break;
+	default:
+		Py_UNREACHABLE();
+	}
+	return NULL;
+}
+
+//
+// Method definitions
+//
+
+static PyObject *
+Bitset_new(PyTypeObject *type, PyObject *args, PyObject *kw)
+{
+	BitsetObject *self;
+	self = (BitsetObject *) type->tp_alloc(type, 0);
+	if (self != NULL)
+		self->ob_bitset = NULL;
+	return (PyObject *) self;
+}
+
+PyDoc_STRVAR(_Bitset_init__doc__,
+"Bitset(size : int)\n"
+"--\n"
+"\n"
+"Python dense set of integers in the range [0, size).");
+
+static int
+Bitset_init(BitsetObject *self, PyObject *args, PyObject *kw)
+{
+	PyObject *sizeObj = NULL;
+	size_t size;
+	static char *keywords[] = { "size", NULL };
+	if (!PyArg_ParseTupleAndKeywords(args, kw,
+		"O!:pybitset.Bitset.__init__", keywords,
+		&PyLong_Type, &sizeObj))
+		return -1;
+	if (!Bitset_parse_size(sizeObj, &size))
+		return -1;
+	if (self->ob_bitset)
+		yadsl_bitset_destroy(self->ob_bitset);
+	if (!(self->ob_bitset = yadsl_bitset_create(size))) {
+		PyErr_SetString(PyExc_MemoryError, "Could not create bitset");
+		return -1;
+	}
+	return 0;
+}
+
+static void
+Bitset_dealloc(BitsetObject *self)
+{
+	if (self->ob_bitset)
+		yadsl_bitset_destroy(self->ob_bitset);
+	Py_TYPE(self)->tp_free((PyObject *) self);
+}
+
+PyDoc_STRVAR(_Bitset_size__doc__,
+"size() -> int\n"
+"--\n"
+"\n"
+"Get number of bits.");
+
+static PyObject *
+Bitset_size(BitsetObject *self, PyObject *Py_UNUSED(ignored))
+{
+	size_t size;
+	yadsl_bitset_size_get(self->ob_bitset, &size);
+	return PyLong_FromSize_t(size);
+}
+
+PyDoc_STRVAR(_Bitset_resize__doc__,
+"resize(size : int) -> None\n"
+"--\n"
+"\n"
+"Change number of bits. New bits start cleared.");
+
+static PyObject *
+Bitset_resize(BitsetObject *self, PyObject *obj)
+{
+	size_t size;
+	yadsl_BitsetRet returnId;
+	if (!Bitset_parse_size(obj, &size))
+		return NULL;
+	if (returnId = yadsl_bitset_resize(self->ob_bitset, size))
+		return Bitset_throw(returnId);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(_Bitset_set__doc__,
+"set(index : int) -> None\n"
+"--\n"
+"\n"
+"Set bit.");
+
+static PyObject *
+Bitset_set(BitsetObject *self, PyObject *obj)
+{
+	size_t index;
+	yadsl_BitsetRet returnId;
+	if (!Bitset_parse_size(obj, &index))
+		return NULL;
+	if (returnId = yadsl_bitset_bit_set(self->ob_bitset, index))
+		return Bitset_throw(returnId);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(_Bitset_clear__doc__,
+"clear(index : int) -> None\n"
+"--\n"
+"\n"
+"Clear bit.");
+
+static PyObject *
+Bitset_clear(BitsetObject *self, PyObject *obj)
+{
+	size_t index;
+	yadsl_BitsetRet returnId;
+	if (!Bitset_parse_size(obj, &index))
+		return NULL;
+	if (returnId = yadsl_bitset_bit_clear(self->ob_bitset, index))
+		return Bitset_throw(returnId);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(_Bitset_check__doc__,
+"check(index : int) -> bool\n"
+"--\n"
+"\n"
+"Check whether bit is set.");
+
+static PyObject *
+Bitset_check(BitsetObject *self, PyObject *obj)
+{
+	size_t index;
+	bool is_set;
+	yadsl_BitsetRet returnId;
+	if (!Bitset_parse_size(obj, &index))
+		return NULL;
+	if (returnId = yadsl_bitset_bit_check(self->ob_bitset, index, &is_set))
+		return Bitset_throw(returnId);
+	return PyBool_FromLong(is_set);
+}
+
+PyDoc_STRVAR(_Bitset_clear_all__doc__,
+"clear_all() -> None\n"
+"--\n"
+"\n"
+"Clear all bits.");
+
+static PyObject *
+Bitset_clear_all(BitsetObject *self, PyObject *Py_UNUSED(ignored))
+{
+	yadsl_bitset_clear(self->ob_bitset);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(_Bitset_count__doc__,
+"count() -> int\n"
+"--\n"
+"\n"
+"Count set bits.");
+
+static PyObject *
+Bitset_count(BitsetObject *self, PyObject *Py_UNUSED(ignored))
+{
+	size_t count;
+	yadsl_bitset_count_get(self->ob_bitset, &count);
+	return PyLong_FromSize_t(count);
+}
+
+PyDoc_STRVAR(_Bitset_rank__doc__,
+"rank(index : int) -> int\n"
+"--\n"
+"\n"
+"Count set bits before index.");
+
+static PyObject *
+Bitset_rank(BitsetObject *self, PyObject *obj)
+{
+	size_t index, rank;
+	yadsl_BitsetRet returnId;
+	if (!Bitset_parse_size(obj, &index))
+		return NULL;
+	if (returnId = yadsl_bitset_rank_get(self->ob_bitset, index, &rank))
+		return Bitset_throw(returnId);
+	return PyLong_FromSize_t(rank);
+}
+
+PyDoc_STRVAR(_Bitset_select__doc__,
+"select(rank : int) -> int\n"
+"--\n"
+"\n"
+"Get index of the set bit with rank set bits before it.");
+
+static PyObject *
+Bitset_select(BitsetObject *self, PyObject *obj)
+{
+	size_t rank, index;
+	yadsl_BitsetRet returnId;
+	if (!Bitset_parse_size(obj, &rank))
+		return NULL;
+	if (returnId = yadsl_bitset_select(self->ob_bitset, rank, &index))
+		return Bitset_throw(returnId);
+	return PyLong_FromSize_t(index);
+}
+
+PyDoc_STRVAR(_Bitset_copy__doc__,
+"copy() -> Bitset\n"
+"--\n"
+"\n"
+"Copy bitset.");
+
+static PyObject *
+Bitset_copy(BitsetObject *self, PyObject *Py_UNUSED(ignored))
+{
+	BitsetObject *copy;
+	copy = (BitsetObject *) Bitset_new(Py_TYPE(self), NULL, NULL);
+	if (copy == NULL)
+		return NULL;
+	if (!(copy->ob_bitset = yadsl_bitset_copy(self->ob_bitset))) {
+		Py_DECREF(copy);
+		PyErr_SetString(PyExc_MemoryError, "Could not copy bitset");
+		return NULL;
+	}
+	return (PyObject *) copy;
+}
+
+PyDoc_STRVAR(_Bitset_union_update__doc__,
+"union_update(other : Bitset) -> None\n"
+"--\n"
+"\n"
+"Set bits that are set in other bitset.");
+
+static PyObject *
+Bitset_union_update(BitsetObject *self, PyObject *obj)
+{
+	yadsl_BitsetHandle *other;
+	yadsl_BitsetRet returnId;
+	if (!Bitset_parse_other(obj, &other))
+		return NULL;
+	if (returnId = yadsl_bitset_union_update(self->ob_bitset, other))
+		return Bitset_throw(returnId);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(_Bitset_intersection_update__doc__,
+"intersection_update(other : Bitset) -> None\n"
+"--\n"
+"\n"
+"Clear bits that are not set in other bitset.");
+
+static PyObject *
+Bitset_intersection_update(BitsetObject *self, PyObject *obj)
+{
+	yadsl_BitsetHandle *other;
+	yadsl_BitsetRet returnId;
+	if (!Bitset_parse_other(obj, &other))
+		return NULL;
+	if (returnId = yadsl_bitset_intersection_update(self->ob_bitset, other))
+		return Bitset_throw(returnId);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(_Bitset_xor_update__doc__,
+"xor_update(other : Bitset) -> None\n"
+"--\n"
+"\n"
+"Flip bits that are set in other bitset.");
+
+static PyObject *
+Bitset_xor_update(BitsetObject *self, PyObject *obj)
+{
+	yadsl_BitsetHandle *other;
+	yadsl_BitsetRet returnId;
+	if (!Bitset_parse_other(obj, &other))
+		return NULL;
+	if (returnId = yadsl_bitset_xor_update(self->ob_bitset, other))
+		return Bitset_throw(returnId);
+	Py_RETURN_NONE;
+}
+
+static PyObject *
+Bitset_iter(BitsetObject *self)
+{
+	PyObject *list, *indexObj, *iter;
+	size_t index;
+	list = PyList_New(0);
+	if (list == NULL)
+		return NULL;
+	for (index = 0;
+		!yadsl_bitset_bit_next_get(self->ob_bitset, index, &index);
+		++index) {
+		indexObj = PyLong_FromSize_t(index);
+		if (indexObj == NULL || PyList_Append(list, indexObj) < 0) {
+			Py_XDECREF(indexObj);
+			Py_DECREF(list);
+			return NULL;
+		}
+		Py_DECREF(indexObj);
+	}
+	iter = PyObject_GetIter(list);
+	Py_DECREF(list);
+	return iter;
+}
+
+//
+// Method table
+//
+
+PyMethodDef Bitset_methods[] = {
+	//
+	// Size management
+	//
+	{
+		"size",
+		(PyCFunction) Bitset_size,
+		METH_NOARGS,
+		_Bitset_size__doc__
+	},
+	{
+		"resize",
+		(PyCFunction) Bitset_resize,
+		METH_O,
+		_Bitset_resize__doc__
+	},
+	//
+	// Bits
+	//
+	{
+		"set",
+		(PyCFunction) Bitset_set,
+		METH_O,
+		_Bitset_set__doc__
+	},
+	{
+		"clear",
+		(PyCFunction) Bitset_clear,
+		METH_O,
+		_Bitset_clear__doc__
+	},
+	{
+		"check",
+		(PyCFunction) Bitset_check,
+		METH_O,
+		_Bitset_check__doc__
+	},
+	{
+		"clear_all",
+		(PyCFunction) Bitset_clear_all,
+		METH_NOARGS,
+		_Bitset_clear_all__doc__
+	},
+	//
+	// Counting
+	//
+	{
+		"count",
+		(PyCFunction) Bitset_count,
+		METH_NOARGS,
+		_Bitset_count__doc__
+	},
+	{
+		"rank",
+		(PyCFunction) Bitset_rank,
+		METH_O,
+		_Bitset_rank__doc__
+	},
+	{
+		"select",
+		(PyCFunction) Bitset_select,
+		METH_O,
+		_Bitset_select__doc__
+	},
+	//
+	// Set operations
+	//
+	{
+		"copy",
+		(PyCFunction) Bitset_copy,
+		METH_NOARGS,
+		_Bitset_copy__doc__
+	},
+	{
+		"union_update",
+		(PyCFunction) Bitset_union_update,
+		METH_O,
+		_Bitset_union_update__doc__
+	},
+	{
+		"intersection_update",
+		(PyCFunction) Bitset_intersection_update,
+		METH_O,
+		_Bitset_intersection_update__doc__
+	},
+	{
+		"xor_update",
+		(PyCFunction) Bitset_xor_update,
+		METH_O,
+		_Bitset_xor_update__doc__
+	},
+	//
+	//
+	// Sentinel
+	//
+	{
+		NULL,
+		NULL,
+		0,
+		NULL
+	}
+};
+
+//
+// Types
+//
+
+static PyTypeObject BitsetType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	.tp_name = "pybitset.Bitset",
+	.tp_basicsize = sizeof(BitsetObject),
+	.tp_itemsize = 0,
+	.tp_dealloc = (destructor) Bitset_dealloc,
+	.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+	.tp_doc = _Bitset_init__doc__,
+	.tp_iter = (getiterfunc) Bitset_iter,
+	.tp_methods = Bitset_methods,
+	.tp_init = (initproc) Bitset_init,
+	.tp_new = (newfunc) Bitset_new,
+};
+
+//
+// Module
+//
+
+PyModuleDef pybitset_module = {
+	PyModuleDef_HEAD_INIT,
+	"pybitset",
+};
+
+PyMODINIT_FUNC
+PyInit_pybitset(void)
+{
+	PyObject *m;
+	struct _exception_metadata *_exc;
+	Py_Initialize();
+	if (PyType_Ready(&BitsetType) < 0)
+		return NULL;
+	m = PyModule_Create(&pybitset_module);
+	if (m == NULL)
+		return NULL;
+	YADSL_PYDEFINES_INIT_EXCEPTION_OBJECTS(m, _exc)
+	Py_INCREF(&BitsetType);
+	if (PyModule_AddObject(m, "Bitset", (PyObject *) &BitsetType) < 0) {
+		Py_DECREF(&BitsetType);
+		Py_DECREF(m);
+		return NULL;
+	}
+	return m;
+}
@@ -0,0 +1,97 @@
+from pybitset import *
+
+def test_create():
+	b = Bitset(100)
+	assert b.size() == 100
+	assert b.count() == 0
+	assert list(b) == []
+	b = Bitset(0)
+	assert b.size() == 0
+	assert list(b) == []
+
+def test_out_of_bounds():
+	b = Bitset(10)
+	for method in (b.set, b.clear, b.check):
+		try:
+			method(10)
+		except OutOfBounds:
+			continue
+		assert False
+
+def test_set_and_clear():
+	b = Bitset(200)
+	ids = [0, 1, 63, 64, 65, 127, 128, 199]
+	for i in ids:
+		b.set(i)
+	assert b.count() == len(ids)
+	assert list(b) == ids
+	for i in range(200):
+		assert b.check(i) == (i in ids)
+	b.clear(64)
+	ids.remove(64)
+	assert list(b) == ids
+	b.clear_all()
+	assert b.count() == 0
+
+def test_rank_and_select():
+	b = Bitset(300)
+	ids = list(range(3, 300, 7))
+	for i in ids:
+		b.set(i)
+	for rank, i in enumerate(ids):
+		assert b.select(rank) == i
+		assert b.rank(i) == rank
+		assert b.rank(i + 1) == rank + 1
+	assert b.rank(300) == len(ids)
+	try:
+		b.select(len(ids))
+	except NotFound:
+		return
+	assert False
+
+def test_resize():
+	b = Bitset(10)
+	b.set(9)
+	b.resize(100)
+	assert b.size() == 100
+	assert list(b) == [9]
+	b.set(99)
+	b.resize(9)
+	assert list(b) == []
+	b.resize(100)
+	assert b.count() == 0
+
+def test_set_operations():
+	a = Bitset(130)
+	b = Bitset(130)
+	for i in (1, 64, 129):
+		a.set(i)
+	for i in (2, 64, 128):
+		b.set(i)
+	c = a.copy()
+	c.union_update(b)
+	assert list(c) == [1, 2, 64, 128, 129]
+	c = a.copy()
+	c.intersection_update(b)
+	assert list(c) == [64]
+	c = a.copy()
+	c.xor_update(b)
+	assert list(c) == [1, 2, 128, 129]
+	assert list(a) == [1, 64, 129]
+
+def test_size_mismatch():
+	a = Bitset(10)
+	b = Bitset(11)
+	try:
+		a.union_update(b)
+	except SizeMismatch:
+		return
+	assert False
+
+def test_type_error():
+	a = Bitset(10)
+	try:
+		a.union_update(set())
+	except TypeError:
+		return
+	assert False
@@ -39,12 +39,37 @@
 * VI) yadsl_GraphVertex::out_edges_to_iterate must never be lower than
 * yadsl_GraphVertex::in_edges_to_iterate.
 *
+* VII) Vertex and edge ids are dense, that is, for every vertex v (and edge e):
+* - yadsl_Graph::vertices_by_id[v->id] points to v
+* - yadsl_Graph::edges_by_id[e->id] points to e
+* - row v->id (or e->id) of yadsl_Graph::vertex_attrs (or edge_attrs)
+*   holds the attributes of v (or e)
+* When an element is removed, the one with the largest id takes its id.
+*
+* VIII) Every vertex v (and edge e) holds handles to the set nodes that
+* contain it, so that it can be unlinked in constant time:
+* - v->handle is the node of yadsl_Graph::vertex_set containing v
+* - e->out_handle is the node of e->source->out_edges containing e
+* - e->in_handle is the node of e->destination->in_edges containing e
+*
 *******************************************************************************/
 
+typedef struct yadsl_GraphVertex_s yadsl_GraphVertex;
+typedef struct yadsl_GraphEdge_s yadsl_GraphEdge;
+
 typedef struct
 {
 	bool is_directed; /**< whether graph is directed or not */
+	yadsl_GraphEdgeWeightType weight_type; /**< type of yadsl_GraphEdge::weight */
 	yadsl_SetHandle* vertex_set; /**< set of yadsl_GraphVertex */
+	yadsl_GraphVertex** vertices_by_id; /**< vertices indexed by id */
+	size_t vertices_by_id_capacity; /**< capacity of vertices_by_id */
+	size_t vertex_count; /**< number of vertices */
+	yadsl_GraphEdge** edges_by_id; /**< edges indexed by id */
+	size_t edges_by_id_capacity; /**< capacity of edges_by_id */
+	size_t edge_count; /**< number of edges */
+	yadsl_GraphAttrTableHandle* vertex_attrs; /**< vertex attributes (one row per vertex id) */
+	yadsl_GraphAttrTableHandle* edge_attrs; /**< edge attributes (one row per edge id) */
 	yadsl_GraphCmpVertexObjsFunc cmp_vertices_func; /**< compares yadsl_GraphVertex::item */
 	yadsl_GraphCmpEdgeObjsFunc cmp_edges_func; /**< compares yadsl_GraphEdge::item */
 	yadsl_GraphFreeVertexObjFunc free_vertex_func; /**< frees yadsl_GraphVertex::item */
@@ -52,24 +77,28 @@ typedef struct
 }
 yadsl_Graph;
 
-typedef struct
+struct yadsl_GraphVertex_s
 {
 	yadsl_GraphVertexObject* item; /**< generic portion of vertex */
+	size_t id; /**< index in yadsl_Graph::vertices_by_id */
 	yadsl_GraphVertexFlag flag; /**< flag (for dfs, bfs, coloring...) */
 	yadsl_SetHandle* out_edges; /**< edges from which the vertex is SOURCE */
 	yadsl_SetHandle* in_edges; /**< edges from which the vertex is DESTINATION */
+	yadsl_SetItemHandle* handle; /**< node in yadsl_Graph::vertex_set */
 	size_t out_edges_to_iterate; /**< counter for graphGet*Neighbour */
 	size_t in_edges_to_iterate; /**< counter for graphGet*Neighbour */
-}
-yadsl_GraphVertex;
+};
 
-typedef struct
+struct yadsl_GraphEdge_s
 {
 	yadsl_GraphEdgeObject* item; /**< generic portion of edge */
+	size_t id; /**< index in yadsl_Graph::edges_by_id */
+	yadsl_GraphEdgeWeight weight; /**< inline weight (if graph is weighted) */
 	yadsl_GraphVertex* source; /**< vertex from which the edge comes from */
 	yadsl_GraphVertex* destination; /**< vertex to with the edge goes to */
-}
-yadsl_GraphEdge;
+	yadsl_SetItemHandle* out_handle; /**< node in source->out_edges */
+	yadsl_SetItemHandle* in_handle; /**< node in destination->in_edges */
+};
 
 /**********************************/
 /*  Private functions prototypes  */
@@ -89,6 +118,20 @@ typedef struct
 }
 yadsl_GraphVertexItemCmpParam;
 
+///////////////////////////////////////////////
+// Sorting key for yadsl_graph_build
+// key          - source index (high 32 bits)
+//                and destination index (low 32 bits)
+// index        - index in the edge array
+///////////////////////////////////////////////
+
+typedef struct
+{
+	uint64_t key;
+	size_t index;
+}
+yadsl_GraphBuildKey;
+
 ///////////////////////////////////////////////
 // Callbacks
 ///////////////////////////////////////////////
@@ -125,13 +168,15 @@ static yadsl_GraphRet yadsl_graph_vertex_nb_total_next_get_internal(
 	yadsl_GraphHandle* graph,
 	yadsl_GraphVertexObject* curr,
 	yadsl_GraphVertexObject** next_nb_ptr,
-	yadsl_GraphEdgeObject** edge_ptr);
+	yadsl_GraphEdgeObject** edge_ptr,
+	yadsl_GraphEdgeWeight* weight_ptr);
 
 static yadsl_GraphRet yadsl_graph_vertex_nb_total_prev_get_internal(
 	yadsl_GraphHandle* graph,
 	yadsl_GraphVertexObject* curr,
 	yadsl_GraphVertexObject** previous_nb_ptr,
-	yadsl_GraphEdgeObject** edge_ptr);
+	yadsl_GraphEdgeObject** edge_ptr,
+	yadsl_GraphEdgeWeight* weight_ptr);
 
 static void yadsl_graph_adj_list_counters_reset_internal(
 	yadsl_GraphVertex* vertex,
@@ -148,7 +193,8 @@ static yadsl_GraphRet yadsl_graph_vertex_nb_get_internal(
 	yadsl_GraphEdgeDirection edge_direction,
 	yadsl_GraphIterationDirection iter_direction,
 	yadsl_GraphVertexObject** v_ptr,
-	yadsl_GraphEdgeObject** uv_ptr);
+	yadsl_GraphEdgeObject** uv_ptr,
+	yadsl_GraphEdgeWeight* weight_ptr);
 
 static yadsl_GraphRet yadsl_graph_edge_find_internal(
 	yadsl_GraphHandle* graph,
@@ -158,6 +204,41 @@ static yadsl_GraphRet yadsl_graph_edge_find_internal(
 	yadsl_GraphVertex** destination_ptr,
 	yadsl_GraphEdge** uv_edge_ptr);
 
+static bool yadsl_graph_array_reserve_internal(
+	void** array_ptr,
+	size_t* capacity_ptr,
+	size_t count);
+
+static void yadsl_graph_vertex_id_release_internal(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertex* vertex);
+
+static void yadsl_graph_edge_id_release_internal(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphEdge* edge);
+
+static yadsl_GraphVertex* yadsl_graph_vertex_create_internal(
+	yadsl_GraphVertexObject* item,
+	size_t id);
+
+static void yadsl_graph_vertex_release_internal(
+	yadsl_GraphVertex* vertex);
+
+static yadsl_GraphBuildKey* yadsl_graph_build_keys_sort_internal(
+	yadsl_GraphBuildKey* keys,
+	yadsl_GraphBuildKey* buffer,
+	size_t count);
+
+static int yadsl_graph_address_compare_internal(
+	const void* a,
+	const void* b);
+
+static bool yadsl_graph_edges_insert_internal(
+	yadsl_SetHandle* set,
+	yadsl_GraphEdge** edges,
+	size_t count,
+	bool is_out);
+
 #define YADSL_GRAPH_VERTICES_FIND(...) \
 yadsl_graph_vertices_find_internal(__VA_ARGS__, NULL, NULL)
 
@@ -179,13 +260,59 @@ yadsl_GraphHandle* yadsl_graph_create(
 	yadsl_GraphCmpEdgeObjsFunc cmp_edges_func,
 	yadsl_GraphFreeEdgeObjFunc free_edge_func)
 {
-	yadsl_Graph* graph = malloc(sizeof(*graph));
+	return yadsl_graph_create_weighted(
+		is_directed,
+		YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE,
+		cmp_vertices_func,
+		free_vertex_func,
+		cmp_edges_func,
+		free_edge_func);
+}
+
+yadsl_GraphHandle* yadsl_graph_create_weighted(
+	bool is_directed,
+	yadsl_GraphEdgeWeightType weight_type,
+	yadsl_GraphCmpVertexObjsFunc cmp_vertices_func,
+	yadsl_GraphFreeVertexObjFunc free_vertex_func,
+	yadsl_GraphCmpEdgeObjsFunc cmp_edges_func,
+	yadsl_GraphFreeEdgeObjFunc free_edge_func)
+{
+	yadsl_Graph* graph;
+	switch (weight_type) {
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE:
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32:
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT64:
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_FLOAT:
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE:
+		break;
+	default:
+		return NULL;
+	}
+	graph = malloc(sizeof(*graph));
 	if (graph) {
 		if (!(graph->vertex_set = yadsl_set_create())) {
 			free(graph);
 			return NULL;
 		}
+		if (!(graph->vertex_attrs = yadsl_graphattr_table_create(0))) {
+			yadsl_set_destroy(graph->vertex_set, NULL, NULL);
+			free(graph);
+			return NULL;
+		}
+		if (!(graph->edge_attrs = yadsl_graphattr_table_create(0))) {
+			yadsl_graphattr_table_destroy(graph->vertex_attrs);
+			yadsl_set_destroy(graph->vertex_set, NULL, NULL);
+			free(graph);
+			return NULL;
+		}
+		graph->vertices_by_id = NULL;
+		graph->vertices_by_id_capacity = 0;
+		graph->vertex_count = 0;
+		graph->edges_by_id = NULL;
+		graph->edges_by_id_capacity = 0;
+		graph->edge_count = 0;
 		graph->is_directed = is_directed;
+		graph->weight_type = weight_type;
 		graph->free_vertex_func = free_vertex_func;
 		graph->free_edge_func = free_edge_func;
 		graph->cmp_vertices_func = cmp_vertices_func;
@@ -194,6 +321,195 @@ yadsl_GraphHandle* yadsl_graph_create(
 	return graph;
 }
 
+yadsl_GraphRet yadsl_graph_build(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject** vertices,
+	size_t vertex_count,
+	yadsl_GraphBuildEdge* edges,
+	size_t edge_count)
+{
+	yadsl_GraphVertex* vertex, * source, * destination, ** vertex_order = NULL;
+	yadsl_GraphEdge* edge, ** edge_order = NULL;
+	yadsl_GraphBuildKey* keys = NULL, * sorted;
+	size_t* offsets = NULL;
+	size_t i, j, u, v;
+	size_t vertex_records = 0, edge_records = 0, vertices_added = 0;
+	size_t vertex_rows = 0, edge_rows = 0;
+	cast_(graph);
+	if (graph_->vertex_count > 0)
+		return YADSL_GRAPH_RET_PARAMETER;
+	if ((uint64_t) vertex_count > ((uint64_t) 1 << 32))
+		return YADSL_GRAPH_RET_PARAMETER;
+	for (i = 0; i < edge_count; ++i)
+		if (edges[i].u >= vertex_count || edges[i].v >= vertex_count)
+			return YADSL_GRAPH_RET_PARAMETER;
+	if (!yadsl_graph_array_reserve_internal(
+		(void**) &graph_->vertices_by_id,
+		&graph_->vertices_by_id_capacity,
+		vertex_count))
+		return YADSL_GRAPH_RET_MEMORY;
+	if (!yadsl_graph_array_reserve_internal(
+		(void**) &graph_->edges_by_id,
+		&graph_->edges_by_id_capacity,
+		edge_count))
+		return YADSL_GRAPH_RET_MEMORY;
+
+	/* Vertex records, with id equal to their index */
+	for (; vertex_records < vertex_count; ++vertex_records) {
+		vertex = yadsl_graph_vertex_create_internal(
+			vertices[vertex_records], vertex_records);
+		if (vertex == NULL)
+			goto fail;
+		graph_->vertices_by_id[vertex_records] = vertex;
+	}
+
+	/* Sort edges by source and destination (see invariant II) */
+	if (edge_count > 0) {
+		keys = malloc(2 * edge_count * sizeof(*keys));
+		if (keys == NULL)
+			goto fail;
+	}
+	for (i = 0; i < edge_count; ++i) {
+		u = edges[i].u;
+		v = edges[i].v;
+		if (!graph_->is_directed &&
+			graph_->vertices_by_id[u] > graph_->vertices_by_id[v]) {
+			u = edges[i].v;
+			v = edges[i].u;
+		}
+		keys[i].key = ((uint64_t) u << 32) | (uint64_t) v;
+		keys[i].index = i;
+	}
+	sorted = yadsl_graph_build_keys_sort_internal(keys, keys + edge_count, edge_count);
+
+	/* Edge records, keeping only the first of each (source, destination) */
+	for (i = 0; i < edge_count; ++i) {
+		if (i > 0 && sorted[i].key == sorted[i - 1].key)
+			continue;
+		edge = malloc(sizeof(yadsl_GraphEdge));
+		if (edge == NULL)
+			goto fail;
+		edge->item = edges[sorted[i].index].item;
+		edge->id = edge_records;
+		if (graph_->weight_type == YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE)
+			edge->weight = yadsl_graph_edge_weight_from_double(graph_->weight_type, 0);
+		else
+			edge->weight = edges[sorted[i].index].weight;
+		edge->source = graph_->vertices_by_id[(size_t) (sorted[i].key >> 32)];
+		edge->destination = graph_->vertices_by_id[(size_t) (sorted[i].key & 0xffffffff)];
+		graph_->edges_by_id[edge_records++] = edge;
+	}
+
+	for (; vertex_rows < vertex_count; ++vertex_rows)
+		if (yadsl_graphattr_row_add(graph_->vertex_attrs))
+			goto fail;
+	for (; edge_rows < edge_records; ++edge_rows)
+		if (yadsl_graphattr_row_add(graph_->edge_attrs))
+			goto fail;
+
+	/* Sets are ordered by address, so inserting in increasing order of
+	address makes every insertion take constant time */
+	if (vertex_count > 0) {
+		vertex_order = malloc(vertex_count * sizeof(*vertex_order));
+		if (vertex_order == NULL)
+			goto fail;
+		offsets = malloc((vertex_count + 1) * sizeof(*offsets));
+		if (offsets == NULL)
+			goto fail;
+	}
+	if (edge_records > 0) {
+		edge_order = malloc(edge_records * sizeof(*edge_order));
+		if (edge_order == NULL)
+			goto fail;
+	}
+	for (i = 0; i < vertex_count; ++i)
+		vertex_order[i] = graph_->vertices_by_id[i];
+	if (vertex_count > 0)
+		qsort(vertex_order, vertex_count, sizeof(*vertex_order),
+			yadsl_graph_address_compare_internal);
+	if (yadsl_set_reserve(graph_->vertex_set, vertex_count))
+		goto fail;
+	for (; vertices_added < vertex_count; ++vertices_added)
+		if (yadsl_set_item_handle_add(graph_->vertex_set,
+			vertex_order[vertices_added], &vertex_order[vertices_added]->handle))
+			goto fail;
+
+	/* Edges are already grouped by source */
+	for (i = 0; i < edge_records; i = j) {
+		source = graph_->edges_by_id[i]->source;
+		for (j = i; j < edge_records && graph_->edges_by_id[j]->source == source; ++j)
+			edge_order[j] = graph_->edges_by_id[j];
+		if (!yadsl_graph_edges_insert_internal(source->out_edges, edge_order + i, j - i, true))
+			goto fail;
+	}
+
+	/* Group edges by destination (counting sort) */
+	if (vertex_count > 0) {
+		for (i = 0; i <= vertex_count; ++i)
+			offsets[i] = 0;
+		for (i = 0; i < edge_records; ++i)
+			++offsets[graph_->edges_by_id[i]->destination->id + 1];
+		for (i = 0; i < vertex_count; ++i)
+			offsets[i + 1] += offsets[i];
+		for (i = 0; i < edge_records; ++i) {
+			edge = graph_->edges_by_id[i];
+			edge_order[offsets[edge->destination->id]++] = edge;
+		}
+		for (i = 0, j = 0; i < vertex_count; ++i) {
+			destination = graph_->vertices_by_id[i];
+			if (!yadsl_graph_edges_insert_internal(destination->in_edges, edge_order + j, offsets[i] - j, false))
+				goto fail;
+			j = offsets[i];
+		}
+	}
+
+	for (i = 0; i < vertex_count; ++i)
+		yadsl_graph_adj_list_counters_reset_internal(graph_->vertices_by_id[i], 1);
+	graph_->vertex_count = vertex_count;
+	graph_->edge_count = edge_records;
+
+	/* Free the objects of repeated edges */
+	if (graph_->free_edge_func)
+		for (i = 1; i < edge_count; ++i)
+			if (sorted[i].key == sorted[i - 1].key)
+				graph_->free_edge_func(edges[sorted[i].index].item);
+
+	if (keys)
+		free(keys);
+	if (offsets)
+		free(offsets);
+	if (vertex_order)
+		free(vertex_order);
+	if (edge_order)
+		free(edge_order);
+	return YADSL_GRAPH_RET_OK;
+
+fail:
+	/* Remove in reverse order, so that every removal takes constant time */
+	while (vertices_added > 0)
+		if (yadsl_set_item_handle_remove(graph_->vertex_set, vertex_order[--vertices_added]->handle))
+			assert(0);
+	for (i = 0; i < vertex_records; ++i)
+		yadsl_graph_vertex_release_internal(graph_->vertices_by_id[i]);
+	for (i = 0; i < edge_records; ++i)
+		free(graph_->edges_by_id[i]);
+	while (vertex_rows > 0)
+		if (yadsl_graphattr_row_remove(graph_->vertex_attrs, --vertex_rows))
+			assert(0);
+	while (edge_rows > 0)
+		if (yadsl_graphattr_row_remove(graph_->edge_attrs, --edge_rows))
+			assert(0);
+	if (keys)
+		free(keys);
+	if (offsets)
+		free(offsets);
+	if (vertex_order)
+		free(vertex_order);
+	if (edge_order)
+		free(edge_order);
+	return YADSL_GRAPH_RET_MEMORY;
+}
+
 yadsl_GraphRet yadsl_graph_vertex_count_get(
 	yadsl_GraphHandle* graph,
 	size_t* size_ptr)
@@ -239,6 +555,15 @@ yadsl_GraphRet yadsl_graph_is_directed_check(
 	return YADSL_GRAPH_RET_OK;
 }
 
+yadsl_GraphRet yadsl_graph_edge_weight_type_get(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphEdgeWeightType* weight_type_ptr)
+{
+	cast_(graph);
+	*weight_type_ptr = graph_->weight_type;
+	return YADSL_GRAPH_RET_OK;
+}
+
 yadsl_GraphRet yadsl_graph_vertex_exists_check(
 	yadsl_GraphHandle* graph,
 	yadsl_GraphVertexObject* curr,
@@ -273,35 +598,32 @@ yadsl_GraphRet yadsl_graph_vertex_add(
 	yadsl_GraphVertex* vertex;
 	yadsl_GraphRet graph_ret;
 	yadsl_SetRet set_ret;
+	size_t vertex_count;
 	bool contains_vertex;
 	cast_(graph);
 	if (graph_ret = yadsl_graph_vertex_exists_check(graph, curr, &contains_vertex))
 		return graph_ret;
 	if (contains_vertex)
 		return YADSL_GRAPH_RET_CONTAINS_VERTEX;
-	vertex = malloc(sizeof(yadsl_GraphVertex));
-	if (vertex == NULL)
+	vertex_count = graph_->vertex_count;
+	if (!yadsl_graph_array_reserve_internal(
+		(void**) &graph_->vertices_by_id,
+		&graph_->vertices_by_id_capacity,
+		vertex_count + 1))
 		return YADSL_GRAPH_RET_MEMORY;
-	vertex->item = curr;
-	vertex->flag = 0;
-	vertex->in_edges_to_iterate = 0;
-	vertex->out_edges_to_iterate = 0;
-	if (!(vertex->in_edges = yadsl_set_create())) {
-		free(vertex);
+	if (!(vertex = yadsl_graph_vertex_create_internal(curr, vertex_count)))
 		return YADSL_GRAPH_RET_MEMORY;
-	}
-	if (!(vertex->out_edges = yadsl_set_create())) {
-		yadsl_set_destroy(vertex->in_edges, NULL, NULL);
-		free(vertex);
+	if (yadsl_graphattr_row_add(graph_->vertex_attrs)) {
+		yadsl_graph_vertex_release_internal(vertex);
 		return YADSL_GRAPH_RET_MEMORY;
 	}
-	if (set_ret = yadsl_set_item_add(graph_->vertex_set, vertex)) {
-		yadsl_set_destroy(vertex->in_edges, NULL, NULL);
-		yadsl_set_destroy(vertex->out_edges, NULL, NULL);
-		free(vertex);
+	if (set_ret = yadsl_set_item_handle_add(graph_->vertex_set, vertex, &vertex->handle)) {
+		if (yadsl_graphattr_row_remove(graph_->vertex_attrs, vertex_count)) assert(0);
+		yadsl_graph_vertex_release_internal(vertex);
 		assert(set_ret == YADSL_SET_RET_MEMORY);
 		return YADSL_GRAPH_RET_MEMORY;
 	}
+	graph_->vertices_by_id[graph_->vertex_count++] = vertex;
 	return YADSL_GRAPH_RET_OK;
 }
 
@@ -314,7 +636,7 @@ yadsl_GraphRet yadsl_graph_vertex_remove(
 	cast_(graph);
 	if (graph_ret = YADSL_GRAPH_VERTICES_FIND(graph, curr, &vertex))
 		return graph_ret;
-	if (yadsl_set_item_remove(graph_->vertex_set, vertex)) assert(0);
+	if (yadsl_set_item_handle_remove(graph_->vertex_set, vertex->handle)) assert(0);
 	yadsl_graph_vertex_free_internal(vertex, graph);
 	return YADSL_GRAPH_RET_OK;
 }
@@ -324,6 +646,18 @@ yadsl_GraphRet yadsl_graph_edge_add(
 	yadsl_GraphVertexObject* u,
 	yadsl_GraphVertexObject* v,
 	yadsl_GraphEdgeObject* uv)
+{
+	cast_(graph);
+	return yadsl_graph_edge_weighted_add(graph, u, v, uv,
+		yadsl_graph_edge_weight_from_double(graph_->weight_type, 0));
+}
+
+yadsl_GraphRet yadsl_graph_edge_weighted_add(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* u,
+	yadsl_GraphVertexObject* v,
+	yadsl_GraphEdgeObject* uv,
+	yadsl_GraphEdgeWeight weight)
 {
 	yadsl_GraphVertex* u_vertex = NULL, * v_vertex = NULL;
 	yadsl_GraphEdge* uv_edge = NULL;
@@ -337,10 +671,21 @@ yadsl_GraphRet yadsl_graph_edge_add(
 		assert(0);
 	if (contains_edge)
 		return YADSL_GRAPH_RET_CONTAINS_EDGE;
+	if (!yadsl_graph_array_reserve_internal(
+		(void**) &graph_->edges_by_id,
+		&graph_->edges_by_id_capacity,
+		graph_->edge_count + 1))
+		return YADSL_GRAPH_RET_MEMORY;
 	uv_edge = malloc(sizeof(yadsl_GraphEdge));
 	if (uv_edge == NULL)
 		return YADSL_GRAPH_RET_MEMORY;
+	if (yadsl_graphattr_row_add(graph_->edge_attrs)) {
+		free(uv_edge);
+		return YADSL_GRAPH_RET_MEMORY;
+	}
 	uv_edge->item = uv;
+	uv_edge->id = graph_->edge_count;
+	uv_edge->weight = weight;
 	if (graph_->is_directed) {
 		uv_edge->source = u_vertex;
 		uv_edge->destination = v_vertex;
@@ -349,20 +694,24 @@ yadsl_GraphRet yadsl_graph_edge_add(
 		uv_edge->destination = u_vertex < v_vertex ? v_vertex : u_vertex;
 	}
 	assert(uv_edge->source != NULL);
-	if (set_ret = yadsl_set_item_add(uv_edge->source->out_edges, uv_edge)) {
+	if (set_ret = yadsl_set_item_handle_add(uv_edge->source->out_edges, uv_edge, &uv_edge->out_handle)) {
+		if (yadsl_graphattr_row_remove(graph_->edge_attrs, uv_edge->id)) assert(0);
 		free(uv_edge);
 		assert(set_ret == YADSL_SET_RET_MEMORY);
 		return YADSL_GRAPH_RET_MEMORY;
 	}
 	yadsl_graph_adj_list_counters_reset_internal(uv_edge->source, 1);
 	assert(uv_edge->destination != NULL);
-	if (set_ret = yadsl_set_item_add(uv_edge->destination->in_edges, uv_edge)) {
-		if (yadsl_set_item_remove(uv_edge->source->out_edges, uv_edge)) assert(0);
+	if (set_ret = yadsl_set_item_handle_add(uv_edge->destination->in_edges, uv_edge, &uv_edge->in_handle)) {
+		if (yadsl_set_item_handle_remove(uv_edge->source->out_edges, uv_edge->out_handle)) assert(0);
+		yadsl_graph_adj_list_counters_reset_internal(uv_edge->source, 1);
+		if (yadsl_graphattr_row_remove(graph_->edge_attrs, uv_edge->id)) assert(0);
 		free(uv_edge);
 		assert(set_ret == YADSL_SET_RET_MEMORY);
 		return YADSL_GRAPH_RET_MEMORY;
 	}
 	yadsl_graph_adj_list_counters_reset_internal(uv_edge->destination, 1);
+	graph_->edges_by_id[graph_->edge_count++] = uv_edge;
 	return YADSL_GRAPH_RET_OK;
 }
 
@@ -404,10 +753,11 @@ yadsl_GraphRet yadsl_graph_edge_remove(
 	if (graph_ret = yadsl_graph_edge_find_internal(graph, u_vertex, v_vertex, &source,
 		&destination, &uv_edge))
 		return graph_ret;
-	if (yadsl_set_item_remove(source->out_edges, uv_edge)) assert(0);
+	if (yadsl_set_item_handle_remove(source->out_edges, uv_edge->out_handle)) assert(0);
 	yadsl_graph_adj_list_counters_reset_internal(source, 1);
-	if (yadsl_set_item_remove(destination->in_edges, uv_edge)) assert(0);
+	if (yadsl_set_item_handle_remove(destination->in_edges, uv_edge->in_handle)) assert(0);
 	yadsl_graph_adj_list_counters_reset_internal(destination, 1);
+	yadsl_graph_edge_id_release_internal(graph, uv_edge);
 	if (graph_->free_edge_func)
 		graph_->free_edge_func(uv_edge->item);
 	free(uv_edge);
@@ -431,6 +781,89 @@ yadsl_GraphRet yadsl_graph_edge_get(
 	return YADSL_GRAPH_RET_OK;
 }
 
+yadsl_GraphRet yadsl_graph_edge_weight_get(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* u,
+	yadsl_GraphVertexObject* v,
+	yadsl_GraphEdgeWeight* weight_ptr)
+{
+	yadsl_GraphVertex* u_vertex, * v_vertex;
+	yadsl_GraphEdge* temp;
+	yadsl_GraphRet graph_ret;
+	cast_(graph);
+	if (graph_->weight_type == YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE)
+		return YADSL_GRAPH_RET_PARAMETER;
+	if (graph_ret = YADSL_GRAPH_VERTICES_FIND(graph, u, &u_vertex, v, &v_vertex))
+		return graph_ret;
+	if (graph_ret = yadsl_graph_edge_find_internal(graph, u_vertex, v_vertex, NULL, NULL, &temp))
+		return graph_ret;
+	*weight_ptr = temp->weight;
+	return YADSL_GRAPH_RET_OK;
+}
+
+yadsl_GraphRet yadsl_graph_edge_weight_set(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* u,
+	yadsl_GraphVertexObject* v,
+	yadsl_GraphEdgeWeight weight)
+{
+	yadsl_GraphVertex* u_vertex, * v_vertex;
+	yadsl_GraphEdge* temp;
+	yadsl_GraphRet graph_ret;
+	cast_(graph);
+	if (graph_->weight_type == YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE)
+		return YADSL_GRAPH_RET_PARAMETER;
+	if (graph_ret = YADSL_GRAPH_VERTICES_FIND(graph, u, &u_vertex, v, &v_vertex))
+		return graph_ret;
+	if (graph_ret = yadsl_graph_edge_find_internal(graph, u_vertex, v_vertex, NULL, NULL, &temp))
+		return graph_ret;
+	temp->weight = weight;
+	return YADSL_GRAPH_RET_OK;
+}
+
+double yadsl_graph_edge_weight_to_double(
+	yadsl_GraphEdgeWeightType weight_type,
+	yadsl_GraphEdgeWeight weight)
+{
+	switch (weight_type) {
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32:
+		return (double) weight.i32;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT64:
+		return (double) weight.i64;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_FLOAT:
+		return (double) weight.f32;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE:
+		return weight.f64;
+	default:
+		return 0;
+	}
+}
+
+yadsl_GraphEdgeWeight yadsl_graph_edge_weight_from_double(
+	yadsl_GraphEdgeWeightType weight_type,
+	double value)
+{
+	yadsl_GraphEdgeWeight weight;
+	weight.i64 = 0;
+	switch (weight_type) {
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32:
+		weight.i32 = (int32_t) value;
+		break;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT64:
+		weight.i64 = (int64_t) value;
+		break;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_FLOAT:
+		weight.f32 = (float) value;
+		break;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE:
+		weight.f64 = value;
+		break;
+	default:
+		break;
+	}
+	return weight;
+}
+
 yadsl_GraphRet yadsl_graph_vertex_degree_get(
 	yadsl_GraphHandle* graph,
 	yadsl_GraphVertexObject* curr,
@@ -465,21 +898,35 @@ yadsl_GraphRet yadsl_graph_vertex_nb_iter(
 	yadsl_GraphIterationDirection iter_direction,
 	yadsl_GraphVertexObject** nb_ptr,
 	yadsl_GraphEdgeObject** edge_ptr)
+{
+	yadsl_GraphEdgeWeight weight;
+	return yadsl_graph_vertex_nb_weighted_iter(graph, vertex, edge_direction,
+		iter_direction, nb_ptr, edge_ptr, &weight);
+}
+
+yadsl_GraphRet yadsl_graph_vertex_nb_weighted_iter(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* vertex,
+	yadsl_GraphEdgeDirection edge_direction,
+	yadsl_GraphIterationDirection iter_direction,
+	yadsl_GraphVertexObject** nb_ptr,
+	yadsl_GraphEdgeObject** edge_ptr,
+	yadsl_GraphEdgeWeight* weight_ptr)
 {
 	if (edge_direction == YADSL_GRAPH_EDGE_DIR_BOTH) {
 		switch (iter_direction) {
 		case YADSL_GRAPH_ITER_DIR_NEXT:
 			return yadsl_graph_vertex_nb_total_next_get_internal(
-				graph, vertex, nb_ptr, edge_ptr);
+				graph, vertex, nb_ptr, edge_ptr, weight_ptr);
 		case YADSL_GRAPH_ITER_DIR_PREVIOUS:
 			return yadsl_graph_vertex_nb_total_prev_get_internal(
-				graph, vertex, nb_ptr, edge_ptr);
+				graph, vertex, nb_ptr, edge_ptr, weight_ptr);
 		default:
 			return YADSL_GRAPH_RET_PARAMETER;
 		}
 	} else {
 		return yadsl_graph_vertex_nb_get_internal(
-			graph, vertex, edge_direction, iter_direction, nb_ptr, edge_ptr);
+			graph, vertex, edge_direction, iter_direction, nb_ptr, edge_ptr, weight_ptr);
 	}
 }
 
@@ -509,6 +956,30 @@ yadsl_GraphRet yadsl_graph_vertex_flag_set(
 	return YADSL_GRAPH_RET_OK;
 }
 
+yadsl_GraphRet yadsl_graph_vertex_flag_by_id_get(
+	yadsl_GraphHandle* graph,
+	size_t id,
+	yadsl_GraphVertexFlag* flag_ptr)
+{
+	cast_(graph);
+	if (id >= graph_->vertex_count)
+		return YADSL_GRAPH_RET_PARAMETER;
+	*flag_ptr = graph_->vertices_by_id[id]->flag;
+	return YADSL_GRAPH_RET_OK;
+}
+
+yadsl_GraphRet yadsl_graph_vertex_flag_by_id_set(
+	yadsl_GraphHandle* graph,
+	size_t id,
+	yadsl_GraphVertexFlag flag)
+{
+	cast_(graph);
+	if (id >= graph_->vertex_count)
+		return YADSL_GRAPH_RET_PARAMETER;
+	graph_->vertices_by_id[id]->flag = flag;
+	return YADSL_GRAPH_RET_OK;
+}
+
 yadsl_GraphRet yadsl_graph_vertex_flag_set_all(
 	yadsl_GraphHandle* graph,
 	yadsl_GraphVertexFlag flag)
@@ -524,6 +995,111 @@ yadsl_GraphRet yadsl_graph_vertex_flag_set_all(
 	return YADSL_GRAPH_RET_OK;
 }
 
+yadsl_GraphRet yadsl_graph_edge_count_get(
+	yadsl_GraphHandle* graph,
+	size_t* edge_count_ptr)
+{
+	cast_(graph);
+	*edge_count_ptr = graph_->edge_count;
+	return YADSL_GRAPH_RET_OK;
+}
+
+yadsl_GraphRet yadsl_graph_vertex_id_get(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* curr,
+	size_t* id_ptr)
+{
+	yadsl_GraphVertex* vertex;
+	yadsl_GraphRet graph_ret;
+	if (graph_ret = YADSL_GRAPH_VERTICES_FIND(graph, curr, &vertex))
+		return graph_ret;
+	*id_ptr = vertex->id;
+	return YADSL_GRAPH_RET_OK;
+}
+
+yadsl_GraphRet yadsl_graph_vertex_by_id_get(
+	yadsl_GraphHandle* graph,
+	size_t id,
+	yadsl_GraphVertexObject** vertex_ptr)
+{
+	cast_(graph);
+	if (id >= graph_->vertex_count)
+		return YADSL_GRAPH_RET_PARAMETER;
+	*vertex_ptr = graph_->vertices_by_id[id]->item;
+	return YADSL_GRAPH_RET_OK;
+}
+
+yadsl_GraphRet yadsl_graph_edge_id_get(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* u,
+	yadsl_GraphVertexObject* v,
+	size_t* id_ptr)
+{
+	yadsl_GraphVertex* u_vertex, * v_vertex;
+	yadsl_GraphEdge* temp;
+	yadsl_GraphRet graph_ret;
+	if (graph_ret = YADSL_GRAPH_VERTICES_FIND(graph, u, &u_vertex, v, &v_vertex))
+		return graph_ret;
+	if (graph_ret = yadsl_graph_edge_find_internal(graph, u_vertex, v_vertex, NULL, NULL, &temp))
+		return graph_ret;
+	*id_ptr = temp->id;
+	return YADSL_GRAPH_RET_OK;
+}
+
+yadsl_GraphRet yadsl_graph_edge_by_id_get(
+	yadsl_GraphHandle* graph,
+	size_t id,
+	yadsl_GraphVertexObject** u_ptr,
+	yadsl_GraphVertexObject** v_ptr,
+	yadsl_GraphEdgeObject** uv_ptr)
+{
+	yadsl_GraphEdge* edge;
+	cast_(graph);
+	if (id >= graph_->edge_count)
+		return YADSL_GRAPH_RET_PARAMETER;
+	edge = graph_->edges_by_id[id];
+	*u_ptr = edge->source->item;
+	*v_ptr = edge->destination->item;
+	*uv_ptr = edge->item;
+	return YADSL_GRAPH_RET_OK;
+}
+
+yadsl_GraphRet yadsl_graph_edge_endpoint_ids_get(
+	yadsl_GraphHandle* graph,
+	size_t id,
+	size_t* u_id_ptr,
+	size_t* v_id_ptr,
+	yadsl_GraphEdgeWeight* weight_ptr)
+{
+	yadsl_GraphEdge* edge;
+	cast_(graph);
+	if (id >= graph_->edge_count)
+		return YADSL_GRAPH_RET_PARAMETER;
+	edge = graph_->edges_by_id[id];
+	*u_id_ptr = edge->source->id;
+	*v_id_ptr = edge->destination->id;
+	*weight_ptr = edge->weight;
+	return YADSL_GRAPH_RET_OK;
+}
+
+yadsl_GraphRet yadsl_graph_vertex_attrs_get(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphAttrTableHandle** table_ptr)
+{
+	cast_(graph);
+	*table_ptr = graph_->vertex_attrs;
+	return YADSL_GRAPH_RET_OK;
+}
+
+yadsl_GraphRet yadsl_graph_edge_attrs_get(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphAttrTableHandle** table_ptr)
+{
+	cast_(graph);
+	*table_ptr = graph_->edge_attrs;
+	return YADSL_GRAPH_RET_OK;
+}
+
 void yadsl_graph_destroy(yadsl_GraphHandle* graph)
 {
 	if (graph == NULL)
@@ -533,6 +1109,12 @@ void yadsl_graph_destroy(yadsl_GraphHandle* graph)
 		graph_->vertex_set,
 		yadsl_graph_vertex_free_internal,
 		graph);
+	yadsl_graphattr_table_destroy(graph_->vertex_attrs);
+	yadsl_graphattr_table_destroy(graph_->edge_attrs);
+	if (graph_->vertices_by_id)
+		free(graph_->vertices_by_id);
+	if (graph_->edges_by_id)
+		free(graph_->edges_by_id);
 	free(graph);
 }
 
@@ -544,7 +1126,8 @@ yadsl_GraphRet yadsl_graph_vertex_nb_total_next_get_internal(
 	yadsl_GraphHandle* graph,
 	yadsl_GraphVertexObject* curr,
 	yadsl_GraphVertexObject** next_nb_ptr,
-	yadsl_GraphEdgeObject** edge_ptr)
+	yadsl_GraphEdgeObject** edge_ptr,
+	yadsl_GraphEdgeWeight* weight_ptr)
 {
 	yadsl_GraphVertex* vertex;
 	yadsl_GraphRet graph_ret;
@@ -594,6 +1177,7 @@ yadsl_GraphRet yadsl_graph_vertex_nb_total_next_get_internal(
 	*next_nb_ptr = temp->destination == vertex ?
 		temp->source->item : temp->destination->item;
 	*edge_ptr = temp->item;
+	*weight_ptr = temp->weight;
 	return YADSL_GRAPH_RET_OK;
 }
 
@@ -601,7 +1185,8 @@ yadsl_GraphRet yadsl_graph_vertex_nb_total_prev_get_internal(
 	yadsl_GraphHandle* graph,
 	yadsl_GraphVertexObject* curr,
 	yadsl_GraphVertexObject** previous_nb_ptr,
-	yadsl_GraphEdgeObject** edge_ptr)
+	yadsl_GraphEdgeObject** edge_ptr,
+	yadsl_GraphEdgeWeight* weight_ptr)
 {
 	yadsl_GraphVertex* vertex;
 	yadsl_GraphRet graph_ret;
@@ -654,6 +1239,7 @@ yadsl_GraphRet yadsl_graph_vertex_nb_total_prev_get_internal(
 	*previous_nb_ptr = temp->destination == vertex ?
 		temp->source->item : temp->destination->item;
 	*edge_ptr = temp->item;
+	*weight_ptr = temp->weight;
 	return YADSL_GRAPH_RET_OK;
 }
 
@@ -742,11 +1328,12 @@ void yadsl_graph_vertex_free_internal(
 	yadsl_set_destroy(
 		vertex->in_edges,
 		yadsl_graph_vertex_in_free_internal,
-		graph->free_edge_func);
+		graph);
 	yadsl_set_destroy(
 		vertex->out_edges,
 		yadsl_graph_vertex_out_free_internal,
-		graph->free_edge_func);
+		graph);
+	yadsl_graph_vertex_id_release_internal(graph, vertex);
 	free(vertex);
 }
 
@@ -756,10 +1343,13 @@ void yadsl_graph_vertex_in_free_internal(
 	yadsl_SetItemFreeArg *arg)
 {
 	yadsl_GraphEdge* edge_ptr = (yadsl_GraphEdge*) item;
-	yadsl_GraphFreeEdgeObjFunc free_edge_func = (yadsl_GraphFreeEdgeObjFunc) arg;
-	yadsl_set_item_remove(edge_ptr->source->out_edges, edge_ptr);
-	if (free_edge_func)
-		free_edge_func(edge_ptr->item);
+	yadsl_Graph* graph = (yadsl_Graph*) arg;
+	if (yadsl_set_item_handle_remove(edge_ptr->source->out_edges, edge_ptr->out_handle)) assert(0);
+	if (edge_ptr->source != edge_ptr->destination) /* otherwise, being destroyed */
+		yadsl_graph_adj_list_counters_reset_internal(edge_ptr->source, 1);
+	yadsl_graph_edge_id_release_internal(graph, edge_ptr);
+	if (graph->free_edge_func)
+		graph->free_edge_func(edge_ptr->item);
 	free(edge_ptr);
 }
 
@@ -769,10 +1359,13 @@ void yadsl_graph_vertex_out_free_internal(
 	yadsl_SetItemFreeArg* arg)
 {
 	yadsl_GraphEdge* edge_ptr = (yadsl_GraphEdge*) item;
-	yadsl_GraphFreeEdgeObjFunc free_edge_func = (yadsl_GraphFreeEdgeObjFunc) arg;
-	yadsl_set_item_remove(edge_ptr->destination->in_edges, edge_ptr);
-	if (free_edge_func)
-		free_edge_func(edge_ptr->item);
+	yadsl_Graph* graph = (yadsl_Graph*) arg;
+	if (yadsl_set_item_handle_remove(edge_ptr->destination->in_edges, edge_ptr->in_handle)) assert(0);
+	if (edge_ptr->source != edge_ptr->destination) /* otherwise, being destroyed */
+		yadsl_graph_adj_list_counters_reset_internal(edge_ptr->destination, 1);
+	yadsl_graph_edge_id_release_internal(graph, edge_ptr);
+	if (graph->free_edge_func)
+		graph->free_edge_func(edge_ptr->item);
 	free(edge_ptr);
 }
 
@@ -878,7 +1471,8 @@ yadsl_GraphRet yadsl_graph_vertex_nb_get_internal(
 	yadsl_GraphEdgeDirection edge_direction,
 	yadsl_GraphIterationDirection iter_direction,
 	yadsl_GraphVertexObject** v_ptr,
-	yadsl_GraphEdgeObject** uv_ptr)
+	yadsl_GraphEdgeObject** uv_ptr,
+	yadsl_GraphEdgeWeight* weight_ptr)
 {
 	yadsl_GraphVertex* vertex;
 	yadsl_SetHandle* set;
@@ -907,5 +1501,156 @@ yadsl_GraphRet yadsl_graph_vertex_nb_get_internal(
 		return graph_ret;
 	*v_ptr = edge_direction == YADSL_GRAPH_EDGE_DIR_IN ? temp->source->item : temp->destination->item;
 	*uv_ptr = temp->item;
+	*weight_ptr = temp->weight;
 	return YADSL_GRAPH_RET_OK;
 }
+
+// Grows array of pointers so that it fits at least count elements
+bool yadsl_graph_array_reserve_internal(
+	void** array_ptr,
+	size_t* capacity_ptr,
+	size_t count)
+{
+	size_t new_capacity;
+	void* new_array;
+	if (count <= *capacity_ptr)
+		return true;
+	new_capacity = *capacity_ptr ? *capacity_ptr * 2 : 16;
+	if (new_capacity < count)
+		new_capacity = count;
+	if (*array_ptr)
+		new_array = realloc(*array_ptr, new_capacity * sizeof(void*));
+	else
+		new_array = malloc(new_capacity * sizeof(void*));
+	if (new_array == NULL)
+		return false;
+	*array_ptr = new_array;
+	*capacity_ptr = new_capacity;
+	return true;
+}
+
+// Gives the id of vertex to the vertex with the largest id
+// (see invariant VII)
+void yadsl_graph_vertex_id_release_internal(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertex* vertex)
+{
+	yadsl_GraphVertex* last;
+	cast_(graph);
+	last = graph_->vertices_by_id[--graph_->vertex_count];
+	graph_->vertices_by_id[vertex->id] = last;
+	last->id = vertex->id;
+	if (yadsl_graphattr_row_remove(graph_->vertex_attrs, vertex->id)) assert(0);
+}
+
+// Gives the id of edge to the edge with the largest id
+// (see invariant VII)
+void yadsl_graph_edge_id_release_internal(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphEdge* edge)
+{
+	yadsl_GraphEdge* last;
+	cast_(graph);
+	last = graph_->edges_by_id[--graph_->edge_count];
+	graph_->edges_by_id[edge->id] = last;
+	last->id = edge->id;
+	if (yadsl_graphattr_row_remove(graph_->edge_attrs, edge->id)) assert(0);
+}
+
+// Allocates a vertex record with empty adjacency sets
+yadsl_GraphVertex* yadsl_graph_vertex_create_internal(
+	yadsl_GraphVertexObject* item,
+	size_t id)
+{
+	yadsl_GraphVertex* vertex = malloc(sizeof(yadsl_GraphVertex));
+	if (vertex == NULL)
+		return NULL;
+	vertex->item = item;
+	vertex->id = id;
+	vertex->flag = 0;
+	vertex->in_edges_to_iterate = 0;
+	vertex->out_edges_to_iterate = 0;
+	if (!(vertex->in_edges = yadsl_set_create())) {
+		free(vertex);
+		return NULL;
+	}
+	if (!(vertex->out_edges = yadsl_set_create())) {
+		yadsl_set_destroy(vertex->in_edges, NULL, NULL);
+		free(vertex);
+		return NULL;
+	}
+	return vertex;
+}
+
+// Frees a vertex record, without freeing its item nor its edges
+void yadsl_graph_vertex_release_internal(
+	yadsl_GraphVertex* vertex)
+{
+	yadsl_set_destroy(vertex->in_edges, NULL, NULL);
+	yadsl_set_destroy(vertex->out_edges, NULL, NULL);
+	free(vertex);
+}
+
+// Sorts keys with a stable LSD radix sort (one byte per pass),
+// skipping passes in which every key has the same digit.
+// Returns either keys or buffer, whichever holds the sorted keys.
+yadsl_GraphBuildKey* yadsl_graph_build_keys_sort_internal(
+	yadsl_GraphBuildKey* keys,
+	yadsl_GraphBuildKey* buffer,
+	size_t count)
+{
+	size_t histogram[256], offset, i;
+	yadsl_GraphBuildKey* temp;
+	unsigned int shift, digit;
+	for (shift = 0; shift < 64; shift += 8) {
+		for (digit = 0; digit < 256; ++digit)
+			histogram[digit] = 0;
+		for (i = 0; i < count; ++i)
+			++histogram[(keys[i].key >> shift) & 0xff];
+		if (count == 0 || histogram[(keys[0].key >> shift) & 0xff] == count)
+			continue;
+		for (digit = 0, offset = 0; digit < 256; ++digit) {
+			i = histogram[digit];
+			histogram[digit] = offset;
+			offset += i;
+		}
+		for (i = 0; i < count; ++i)
+			buffer[histogram[(keys[i].key >> shift) & 0xff]++] = keys[i];
+		temp = keys;
+		keys = buffer;
+		buffer = temp;
+	}
+	return keys;
+}
+
+// Orders pointers by address (for qsort)
+int yadsl_graph_address_compare_internal(
+	const void* a,
+	const void* b)
+{
+	const void* pa = *(const void* const*) a;
+	const void* pb = *(const void* const*) b;
+	return pa < pb ? -1 : pa > pb;
+}
+
+// Adds edges to a set (out_edges if is_out, else in_edges)
+// in increasing order of address
+// [!] Assumes set is empty!
+bool yadsl_graph_edges_insert_internal(
+	yadsl_SetHandle* set,
+	yadsl_GraphEdge** edges,
+	size_t count,
+	bool is_out)
+{
+	size_t i;
+	if (count == 0)
+		return true;
+	qsort(edges, count, sizeof(*edges), yadsl_graph_address_compare_internal);
+	if (yadsl_set_reserve(set, count))
+		return false;
+	for (i = 0; i < count; ++i)
+		if (yadsl_set_item_handle_add(set, edges[i],
+			is_out ? &edges[i]->out_handle : &edges[i]->in_handle))
+			return false;
+	return true;
+}
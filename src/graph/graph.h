@@ -17,11 +17,24 @@
  * in or out neighbours will provide diferent edges, for every
  * vertex on a graph. That's why it can be used for serialization.
  *
+ * Graphs created with ::yadsl_graph_create_weighted also store a numeric
+ * weight inline in every edge, which can be read by algorithms without
+ * going through the (opaque) edge object.
+ *
+ * Vertices and edges are also identified by dense ids, ranging from
+ * zero to the vertex (or edge) count minus one. Removing a vertex (or
+ * edge) gives its id to the vertex (or edge) with the largest id, so
+ * ids may change after removals. These ids index the rows of the
+ * attribute tables owned by the graph (see \ref graphattr).
+ *
  * @{
 */
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+
+#include <graphattr/graphattr.h>
 
 /**
  * @brief Return condition of Graph functions
@@ -61,6 +74,33 @@ typedef enum
 }
 yadsl_GraphEdgeDirection;
 
+/**
+ * @brief Type of the numeric weight stored inline in every edge
+*/
+typedef enum
+{
+	YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE = 0, /**< Edges carry no inline weight */
+	YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32, /**< 32-bit signed integer weights */
+	YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT64, /**< 64-bit signed integer weights */
+	YADSL_GRAPH_EDGE_WEIGHT_TYPE_FLOAT, /**< Single-precision floating-point weights */
+	YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE, /**< Double-precision floating-point weights */
+}
+yadsl_GraphEdgeWeightType;
+
+/**
+ * @brief Inline edge weight
+ *
+ * Only the member matching the graph edge weight type is meaningful.
+*/
+typedef union
+{
+	int32_t i32; /**< ::YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32 */
+	int64_t i64; /**< ::YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT64 */
+	float f32; /**< ::YADSL_GRAPH_EDGE_WEIGHT_TYPE_FLOAT */
+	double f64; /**< ::YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE */
+}
+yadsl_GraphEdgeWeight;
+
 typedef void yadsl_GraphHandle; /**< Graph handle */
 typedef void yadsl_GraphVertexObject; /**< Graph vertex object (user data) */
 typedef void yadsl_GraphEdgeObject; /**< Graph edge object (user data) */
@@ -110,6 +150,18 @@ typedef void
 (*yadsl_GraphFreeEdgeObjFunc)(
 	yadsl_GraphEdgeObject* obj);
 
+/**
+ * @brief Edge to be inserted by ::yadsl_graph_build
+*/
+typedef struct
+{
+	size_t u; /**< index of the source vertex in the vertex array */
+	size_t v; /**< index of the destination vertex in the vertex array */
+	yadsl_GraphEdgeWeight weight; /**< inline weight (ignored if graph is not weighted) */
+	yadsl_GraphEdgeObject* item; /**< edge object */
+}
+yadsl_GraphBuildEdge;
+
 /**
  * @brief Create an empty graph
  * @param is_directed whether the graph is directed or not
@@ -127,6 +179,77 @@ yadsl_graph_create(
 	yadsl_GraphCmpEdgeObjsFunc cmp_edges_func,
 	yadsl_GraphFreeEdgeObjFunc free_edge_func);
 
+/**
+ * @brief Create an empty graph whose edges carry an inline numeric weight
+ *
+ * The weight is stored next to the edge record, so that it can be read
+ * without dereferencing the edge object or calling back into user code.
+ * Edges added with ::yadsl_graph_edge_add have a weight of zero.
+ *
+ * @param is_directed whether the graph is directed or not
+ * @param weight_type edge weight type
+ * @param cmp_vertices_func vertex object comparison function
+ * @param free_vertex_func vertex object freeing function
+ * @param cmp_edges_func edge object comparison function
+ * @param free_edge_func edge object freeing function
+ * @return newly created graph or NULL if could not allocate enough memory
+ * or if the weight type is invalid
+*/
+yadsl_GraphHandle*
+yadsl_graph_create_weighted(
+	bool is_directed,
+	yadsl_GraphEdgeWeightType weight_type,
+	yadsl_GraphCmpVertexObjsFunc cmp_vertices_func,
+	yadsl_GraphFreeVertexObjFunc free_vertex_func,
+	yadsl_GraphCmpEdgeObjsFunc cmp_edges_func,
+	yadsl_GraphFreeEdgeObjFunc free_edge_func);
+
+/**
+ * @brief Populate an empty graph from arrays of vertices and edges
+ *
+ * This is much faster than adding each vertex and edge separately,
+ * because vertices are referred to by index and therefore no lookups
+ * are needed. Edges are sorted by source and destination (using radix
+ * sort) and inserted in a single pass.
+ *
+ * Vertex i is given id i, and edges are given ids in the order of
+ * their (source, destination) pair. If the same pair occurs more
+ * than once (or, in undirected graphs, both uv and vu occur), only the
+ * first occurrence is kept, and the objects of the others are freed
+ * with the graph edge freeing function.
+ *
+ * @param graph graph with no vertices
+ * @param vertices array of distinct vertex objects
+ * @param vertex_count number of vertices (at most 2^32)
+ * @param edges array of edges
+ * @param edge_count number of edges
+ * @return
+ * * ::YADSL_GRAPH_RET_OK, and graph owns every vertex and edge object
+ * * ::YADSL_GRAPH_RET_PARAMETER, if graph is not empty, or if there
+ * are too many vertices, or if an edge refers to an invalid index
+ * * ::YADSL_GRAPH_RET_MEMORY
+ * @note On failure, graph is left empty and the caller keeps
+ * ownership of every vertex and edge object.
+*/
+yadsl_GraphRet
+yadsl_graph_build(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject** vertices,
+	size_t vertex_count,
+	yadsl_GraphBuildEdge* edges,
+	size_t edge_count);
+
+/**
+ * @brief Get the type of the inline edge weights
+ * @param graph graph
+ * @param weight_type_ptr edge weight type
+ * @return ::YADSL_GRAPH_RET_OK, and *weight_type_ptr is updated
+*/
+yadsl_GraphRet
+yadsl_graph_edge_weight_type_get(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphEdgeWeightType* weight_type_ptr);
+
 /**
  * @brief Check whether graph is directed or not
  * @param graph graph
@@ -205,6 +328,32 @@ yadsl_graph_vertex_nb_iter(
 	yadsl_GraphVertexObject** nb_ptr,
 	yadsl_GraphEdgeObject** edge_ptr);
 
+/**
+ * @brief Iterate through neighbour of a given vertex, also
+ * obtaining the inline weight of the edge between them
+ * @param graph graph
+ * @param vertex vertex
+ * @param edge_direction edge direction
+ * @param iter_direction iteration direction
+ * @param nb_ptr neighbour of vertex
+ * @param edge_ptr edge between vertex and its neighbour
+ * @param weight_ptr weight of the edge between vertex and its neighbour
+ * @return
+ * * ::YADSL_GRAPH_RET_OK, and *nb_ptr, *edge_ptr and *weight_ptr are updated
+ * * ::YADSL_GRAPH_RET_DOES_NOT_CONTAIN_VERTEX
+ * * ::YADSL_GRAPH_RET_DOES_NOT_CONTAIN_EDGE
+ * * ::YADSL_GRAPH_RET_PARAMETER
+*/
+yadsl_GraphRet
+yadsl_graph_vertex_nb_weighted_iter(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* vertex,
+	yadsl_GraphEdgeDirection edge_direction,
+	yadsl_GraphIterationDirection iter_direction,
+	yadsl_GraphVertexObject** nb_ptr,
+	yadsl_GraphEdgeObject** edge_ptr,
+	yadsl_GraphEdgeWeight* weight_ptr);
+
 /**
  * @brief Check whether vertex exists in a graph or not
  * @param graph graph
@@ -283,6 +432,29 @@ yadsl_graph_edge_add(
 	yadsl_GraphVertexObject* v,
 	yadsl_GraphEdgeObject* uv);
 
+/**
+ * @brief Add weighted edge to graph
+ * @param graph graph
+ * @param u edge source (if directed)
+ * @param v edge destination (if directed)
+ * @param uv edge connecting u and v
+ * @param weight inline edge weight
+ * @return
+ * * ::YADSL_GRAPH_RET_OK, and edge is added
+ * * ::YADSL_GRAPH_RET_DOES_NOT_CONTAIN_VERTEX
+ * * ::YADSL_GRAPH_RET_CONTAINS_EDGE
+ * * ::YADSL_GRAPH_RET_MEMORY
+ * @attention on success, this function may alter the state of the neighbour
+ * iterator functions such as ::yadsl_graph_vertex_nb_iter
+*/
+yadsl_GraphRet
+yadsl_graph_edge_weighted_add(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* u,
+	yadsl_GraphVertexObject* v,
+	yadsl_GraphEdgeObject* uv,
+	yadsl_GraphEdgeWeight weight);
+
 /**
  * @brief Get edge between two vertices in a graph
  * @param graph graph
@@ -301,6 +473,66 @@ yadsl_graph_edge_get(
 	yadsl_GraphVertexObject* v,
 	yadsl_GraphEdgeObject** uv_ptr);
 
+/**
+ * @brief Get inline weight of edge between two vertices in a graph
+ * @param graph graph
+ * @param u edge source (if directed)
+ * @param v edge destination (if directed)
+ * @param weight_ptr weight of edge between u and v
+ * @return
+ * * ::YADSL_GRAPH_RET_OK, and *weight_ptr is updated
+ * * ::YADSL_GRAPH_RET_DOES_NOT_CONTAIN_VERTEX
+ * * ::YADSL_GRAPH_RET_DOES_NOT_CONTAIN_EDGE
+ * * ::YADSL_GRAPH_RET_PARAMETER, if graph is not weighted
+*/
+yadsl_GraphRet
+yadsl_graph_edge_weight_get(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* u,
+	yadsl_GraphVertexObject* v,
+	yadsl_GraphEdgeWeight* weight_ptr);
+
+/**
+ * @brief Set inline weight of edge between two vertices in a graph
+ * @param graph graph
+ * @param u edge source (if directed)
+ * @param v edge destination (if directed)
+ * @param weight new weight of edge between u and v
+ * @return
+ * * ::YADSL_GRAPH_RET_OK, and weight is updated
+ * * ::YADSL_GRAPH_RET_DOES_NOT_CONTAIN_VERTEX
+ * * ::YADSL_GRAPH_RET_DOES_NOT_CONTAIN_EDGE
+ * * ::YADSL_GRAPH_RET_PARAMETER, if graph is not weighted
+*/
+yadsl_GraphRet
+yadsl_graph_edge_weight_set(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* u,
+	yadsl_GraphVertexObject* v,
+	yadsl_GraphEdgeWeight weight);
+
+/**
+ * @brief Convert inline edge weight to double
+ * @param weight_type edge weight type
+ * @param weight edge weight
+ * @return weight as double (or zero if weight type is ::YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE)
+*/
+double
+yadsl_graph_edge_weight_to_double(
+	yadsl_GraphEdgeWeightType weight_type,
+	yadsl_GraphEdgeWeight weight);
+
+/**
+ * @brief Convert double to inline edge weight
+ * @param weight_type edge weight type
+ * @param value value to be converted
+ * @return edge weight (integer types are truncated towards zero)
+*/
+yadsl_GraphEdgeWeight
+yadsl_graph_edge_weight_from_double(
+	yadsl_GraphEdgeWeightType weight_type,
+	double value);
+
 /**
  * @brief Remove edge between u and v from graph
  * @param graph graph
@@ -349,6 +581,36 @@ yadsl_graph_vertex_flag_set(
 	yadsl_GraphVertexObject* v,
 	yadsl_GraphVertexFlag flag);
 
+/**
+ * @brief Get flag associated with vertex, by vertex id
+ * @param graph graph
+ * @param id vertex id
+ * @param flag_ptr flag associated with vertex
+ * @return
+ * * ::YADSL_GRAPH_RET_OK, and *flag_ptr is updated
+ * * ::YADSL_GRAPH_RET_PARAMETER, if there is no vertex with such id
+*/
+yadsl_GraphRet
+yadsl_graph_vertex_flag_by_id_get(
+	yadsl_GraphHandle* graph,
+	size_t id,
+	yadsl_GraphVertexFlag* flag_ptr);
+
+/**
+ * @brief Set flag associated with vertex, by vertex id
+ * @param graph graph
+ * @param id vertex id
+ * @param flag new flag
+ * @return
+ * * ::YADSL_GRAPH_RET_OK, and flag is associated with vertex
+ * * ::YADSL_GRAPH_RET_PARAMETER, if there is no vertex with such id
+*/
+yadsl_GraphRet
+yadsl_graph_vertex_flag_by_id_set(
+	yadsl_GraphHandle* graph,
+	size_t id,
+	yadsl_GraphVertexFlag flag);
+
 /**
  * @brief Set flag associated with all vertices in graph
  * @param graph graph
@@ -361,6 +623,137 @@ yadsl_graph_vertex_flag_set_all(
 	yadsl_GraphHandle* graph,
 	yadsl_GraphVertexFlag flag);
 
+/**
+ * @brief Get the number of edges in graph
+ * @param graph graph
+ * @param edge_count_ptr edge count
+ * @return ::YADSL_GRAPH_RET_OK, and *edge_count_ptr is updated
+*/
+yadsl_GraphRet
+yadsl_graph_edge_count_get(
+	yadsl_GraphHandle* graph,
+	size_t* edge_count_ptr);
+
+/**
+ * @brief Get the id of a vertex
+ * @param graph graph
+ * @param v vertex
+ * @param id_ptr vertex id, between 0 and the vertex count minus one
+ * @return
+ * * ::YADSL_GRAPH_RET_OK, and *id_ptr is updated
+ * * ::YADSL_GRAPH_RET_DOES_NOT_CONTAIN_VERTEX
+*/
+yadsl_GraphRet
+yadsl_graph_vertex_id_get(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* v,
+	size_t* id_ptr);
+
+/**
+ * @brief Get vertex by its id
+ * @param graph graph
+ * @param id vertex id
+ * @param v_ptr vertex
+ * @return
+ * * ::YADSL_GRAPH_RET_OK, and *v_ptr is updated
+ * * ::YADSL_GRAPH_RET_PARAMETER, if there is no vertex with such id
+*/
+yadsl_GraphRet
+yadsl_graph_vertex_by_id_get(
+	yadsl_GraphHandle* graph,
+	size_t id,
+	yadsl_GraphVertexObject** v_ptr);
+
+/**
+ * @brief Get the id of the edge between two vertices
+ * @param graph graph
+ * @param u vertex
+ * @param v vertex
+ * @param id_ptr edge id, between 0 and the edge count minus one
+ * @return
+ * * ::YADSL_GRAPH_RET_OK, and *id_ptr is updated
+ * * ::YADSL_GRAPH_RET_DOES_NOT_CONTAIN_VERTEX
+ * * ::YADSL_GRAPH_RET_DOES_NOT_CONTAIN_EDGE
+*/
+yadsl_GraphRet
+yadsl_graph_edge_id_get(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* u,
+	yadsl_GraphVertexObject* v,
+	size_t* id_ptr);
+
+/**
+ * @brief Get edge by its id
+ * @param graph graph
+ * @param id edge id
+ * @param u_ptr source vertex
+ * @param v_ptr destination vertex
+ * @param uv_ptr edge
+ * @return
+ * * ::YADSL_GRAPH_RET_OK, and *u_ptr, *v_ptr and *uv_ptr are updated
+ * * ::YADSL_GRAPH_RET_PARAMETER, if there is no edge with such id
+ * @note On undirected graphs, the order of u and v is unspecified
+*/
+yadsl_GraphRet
+yadsl_graph_edge_by_id_get(
+	yadsl_GraphHandle* graph,
+	size_t id,
+	yadsl_GraphVertexObject** u_ptr,
+	yadsl_GraphVertexObject** v_ptr,
+	yadsl_GraphEdgeObject** uv_ptr);
+
+/**
+ * @brief Get the endpoint ids and weight of an edge by its id
+ * @param graph graph
+ * @param id edge id
+ * @param u_id_ptr source vertex id
+ * @param v_id_ptr destination vertex id
+ * @param weight_ptr edge weight (zero if graph is not weighted)
+ * @return
+ * * ::YADSL_GRAPH_RET_OK, and *u_id_ptr, *v_id_ptr and *weight_ptr are updated
+ * * ::YADSL_GRAPH_RET_PARAMETER, if there is no edge with such id
+ * @note On undirected graphs, the order of u and v is unspecified
+*/
+yadsl_GraphRet
+yadsl_graph_edge_endpoint_ids_get(
+	yadsl_GraphHandle* graph,
+	size_t id,
+	size_t* u_id_ptr,
+	size_t* v_id_ptr,
+	yadsl_GraphEdgeWeight* weight_ptr);
+
+/**
+ * @brief Get the vertex attribute table
+ *
+ * The table is owned by the graph and has one row per vertex,
+ * indexed by vertex id. Rows are added and removed together
+ * with vertices, but columns are managed by the caller.
+ *
+ * @param graph graph
+ * @param table_ptr vertex attribute table
+ * @return ::YADSL_GRAPH_RET_OK, and *table_ptr is updated
+*/
+yadsl_GraphRet
+yadsl_graph_vertex_attrs_get(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphAttrTableHandle** table_ptr);
+
+/**
+ * @brief Get the edge attribute table
+ *
+ * The table is owned by the graph and has one row per edge,
+ * indexed by edge id. Rows are added and removed together
+ * with edges, but columns are managed by the caller.
+ *
+ * @param graph graph
+ * @param table_ptr edge attribute table
+ * @return ::YADSL_GRAPH_RET_OK, and *table_ptr is updated
+*/
+yadsl_GraphRet
+yadsl_graph_edge_attrs_get(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphAttrTableHandle** table_ptr);
+
 /**
  * @brief Destroys graph
  * @param graph graph
@@ -1,7 +1,14 @@
 #include <graph/graph.h>
+#include <graphapsp/graphapsp.h>
+#include <graphcolor/graphcolor.h>
+#include <graphcsr/graphcsr.h>
+#include <graphflow/graphflow.h>
+#include <graphgen/graphgen.h>
 #include <graphio/graphio.h>
 #include <graphsearch/graphsearch.h>
+#include <graphwalk/graphwalk.h>
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <string/string.h>
@@ -35,33 +42,197 @@ const char* yadsl_tester_help_strings[] = {
 	"/setvertexflag <u> <flag>                               set vertex flag",
 	"/setallflags <flag>                                     set flag of all vertices",
 	"/getvertexflag <u> <expected>                           get vertex flag",
+	"/createweighted [DIRECTED/UNDIRECTED] <weight-type>     create new weighted graph",
+	"/weighttype <expected>                                  get edge weight type",
+	"/addweightededge <u> <v> <edge> <weight>                add weighted edge to graph",
+	"/getweight <u> <v> <expected>                           get weight of edge uv",
+	"/setweight <u> <v> <weight>                             set weight of edge uv",
+	"/edgecount <expected>                                   get graph edge count",
+	"/vertexid <vertex> <expected>                           get vertex id",
+	"/vertexbyid <id> <expected>                             get vertex by id",
+	"/edgeid <u> <v> <expected>                              get id of edge uv",
+	"/edgebyid <id> <u> <v> <edge>                           get edge by id",
+	"/addvertexattr <name>                                   add integer vertex attribute",
+	"/setvertexattr <vertex> <name> <value>                  set integer vertex attribute",
+	"/getvertexattr <vertex> <name> <expected>               get integer vertex attribute",
+	"/addedgeattr <name>                                     add integer edge attribute",
+	"/setedgeattr <u> <v> <name> <value>                     set integer attribute of edge uv",
+	"/getedgeattr <u> <v> <name> <expected>                  get integer attribute of edge uv",
+	"/buildvertex <vertex>                                   append vertex to build list",
+	"/buildedge <u-index> <v-index> <edge> <weight>          append edge to build list",
+	"/build                                                  build graph from build lists",
+	"",
+	"Graph CSR commands:",
+	"/csrcreate                             create CSR snapshot of graph",
+	"/csredgecount <expected>               get CSR edge count",
+	"/csrdeltasize <expected>               get number of pending changes",
+	"/csraddedge <u-id> <v-id> <weight>     add edge to CSR graph",
+	"/csrremoveedge <u-id> <v-id>           remove edge from CSR graph",
+	"/csrcontainsedge <u-id> <v-id> [YES/NO] check if CSR graph contains edge",
+	"/csrgetweight <u-id> <v-id> <expected> get weight of edge in CSR graph",
+	"/csrdegree <u-id> <expected>           get number of neighbours",
+	"/csrneighbours <u-id> <expected>       iterate through neighbours",
+	"                                       (comma-separated ids, or - if none)",
+	"/csrcompact                            fold pending changes into snapshot",
+	"",
+	"Graph Colour commands:",
+	"/colorgreedy <order> <expected-count>  colour greedily in order",
+	"                                       (comma-separated ids, or - for id order)",
+	"/colordsatur <expected-count>          colour with DSATUR",
+	"/colorjp <seed> <max-count>            colour with Jones-Plassmann",
+	"/colorflags <expected-count>           colour with DSATUR into vertex flags",
+	"/colorof <id> <expected>               get colour of vertex",
+	"/colorvalid [YES/NO]                   check if colouring is valid",
+	"",
+	"Graph Flow commands:",
+	"/maxflow <s-id> <t-id> <capacity> <expected>",
+	"                                       compute maximum flow from s to t, with",
+	"                                       capacity = weight or length (of edge name)",
+	"/edgeflow <id> <expected>              get flow on edge",
+	"/mincut <id> [YES/NO]                  check if vertex is on the source side",
+	"",
+	"Graph APSP commands:",
+	"/apsp <weights> <block-size>           compute distances between all pairs, with",
+	"                                       weights = weight or hops",
+	"/distance <u-id> <v-id> <expected>     get distance from u to v (or inf)",
+	"/apspcheck <weights>                   compare distances with untiled algorithm",
+	"",
+	"Graph Walk commands:",
+	"/walkcreate [YES/NO]                   create walker (weighted or not) from graph",
+	"/walk <id> <index> <length> <p> <q> <seed> <expected>",
+	"                                       generate walk (comma-separated ids, - for none)",
+	"/walkcheck <count> <length> <p> <q> <seed>",
+	"                                       generate walks from every vertex, and check",
+	"                                       that they follow edges and are reproducible",
+	"/walkfreq <id> <nb-id> <samples> <expected>",
+	"                                       check frequency of first step to neighbour",
+	"",
+	"Graph Generator commands:",
+	"/genweights <min> <max>                set range of generated edge weights",
+	"/generdosrenyi <n> <p> <seed>          generate G(n, p) graph",
+	"/genrmat <scale> <m> <a> <b> <c> <seed>",
+	"                                       generate R-MAT graph",
+	"/gengrid <rows> <columns>              generate grid graph",
+	"/genbarabasialbert <n> <m> <seed>      generate preferential attachment graph",
+	"/genregular <n> <d> <seed>             generate random regular graph",
+	"/gendegrees <edge-dir> <min> <max>     check range of every vertex degree",
+	"/genweightrange <min> <max>            check range of every edge weight",
+	"/genhash <expected>                    check hash of edge endpoints, in hexadecimal",
 	"",
 	"Graph IO commands:",
 	"/write <filename>                      write graph to file",
 	"/read <filename>                       read from file to graph",
+	"/writestreamed <filename> <size>       write graph to file, in chunks of about size bytes",
+	"/progress <calls> <written> <total>    check progress reported by the last streamed write",
+	"/writebinary <filename>                write graph to file, in binary format",
+	"/readbinary <filename>                 read from file to graph, in binary format",
+	"/writecompressed <filename>            write graph to file, in compressed format",
+	"/readcompressed <filename>             read from file to graph, in compressed format",
+	"/compressedopen <filename>             open file in compressed format",
+	"/compresseddegree <id> <expected>      decode degree of vertex from compressed file",
+	"/compressednbs <id> <expected>         decode neighbour ids of vertex from compressed file",
+	"                                       (separated by spaces)",
+	"/compressedweights <id> <expected>     decode edge weights of vertex from compressed file",
+	"                                       (separated by spaces)",
+	"/mappedopen <filename>                 open file in binary format as a mapped view",
+	"/mappeddegree <id> <expected>          get degree of vertex from mapped file",
+	"/mappednbs <id> <expected>             get neighbour ids of vertex from mapped file",
+	"                                       (separated by spaces)",
+	"/mappedweights <id> <expected>         get edge weights of vertex from mapped file",
+	"                                       (separated by spaces)",
+	"/mappedflag <id> <expected>            get flag of vertex from mapped file",
+	"/textfile <filename>                   create empty text file",
+	"/textline <filename> <line>            append line to text file",
+	"/import <format> [DIRECTED/UNDIRECTED] <weight-type> <filename>",
+	"                                       import graph from EDGELIST, MTX or DIMACS file",
 	"",
 	"Graph Search commands:",
 	"/dfs <v> <flag>                        run dfs on graph starting from v"
 	"                                       v and marking visited with flag",
 	"/bfs <v> <flag>                        run bfs on graph starting from v"
 	"                                       v and marking visited with flag",
+	"/dfscount <v> <flag> <expected>        count vertices visited by dfs (with context)",
+	"/bfscount <v> <flag> <expected>        count vertices visited by bfs (with context)",
+	"/bfslevels <v> <flag> <expected>       run bfs one level at a time",
+	"                                       (levels separated by |, vertices by ,)",
+	"/bfsmulti <seeds> <max-depth>          run bfs from comma-separated seeds at once",
+	"                                       up to max-depth (or inf)",
+	"/seeddistance <v> <expected>           get distance of v to nearest seed (or inf)",
+	"/nearestseed <v> <expected>            get nearest seed of v (or - if not reached)",
+	"/mappedbfsmulti <seeds> <max-depth>    same as bfsmulti, but on mapped file",
+	"/betweenness                           compute betweenness centrality",
+	"/betweennesssampled <count> <seed>     estimate betweenness centrality",
+	"/mappedbetweenness                     same as betweenness, but on mapped file",
+	"/mappedbetweennesssampled <count> <seed>",
+	"                                       same as betweennesssampled, but on mapped file",
+	"/centrality <v> <expected>             get betweenness of v",
+	"/dfsids <v> <expected>                 run dfs by id starting from v",
+	"                                       (vertices separated by , and",
+	"                                       prefixed by their parent and >)",
+	"/bfsids <v> <expected>                 run bfs by id starting from v",
+	"/bfsidslevels <v> <expected>           run bfs by id one level at a time",
+	"/mappeddfsids <v> <expected>           same as dfsids, but on mapped file",
+	"/mappedbfsids <v> <expected>           same as bfsids, but on mapped file",
+	"/mappedbfsidslevels <v> <expected>     same as bfsidslevels, but on mapped file",
+	"/unvisitids                            mark every vertex as not visited by id",
 	NULL,
 };
 
 static yadsl_GraphHandle* graph = NULL;
+static yadsl_GraphCsrHandle* csr = NULL;
+static yadsl_GraphWalkHandle* walker = NULL;
+static yadsl_GraphIoCompressedHandle* compressed = NULL;
+static yadsl_GraphIoMappedHandle* mapped = NULL;
+static size_t* colors = NULL;
+static size_t color_vertex_count = 0;
+static double* flows = NULL;
+static size_t flow_edge_count = 0;
+static bool* cut = NULL;
+static size_t cut_vertex_count = 0;
+static double* distances = NULL;
+static size_t distance_vertex_count = 0;
+static double* centralities = NULL;
+static size_t centrality_vertex_count = 0;
+static size_t* seed_distances = NULL;
+static size_t* nearest_seeds = NULL;
+static size_t seed_vertex_count = 0;
+static bool* visited_ids = NULL;
+static size_t visited_id_count = 0;
+static double gen_min_weight = 1.0, gen_max_weight = 1.0;
 static char buffer[BUFSIZ], buffer2[BUFSIZ], buffer3[BUFSIZ], buffer4[BUFSIZ], buffer5[BUFSIZ];
 static bool string_duplicate_failed = false;
+static size_t progress_call_count = 0, progress_written_count = 0, progress_total_count = 0;
+static bool is_progress_monotonic = true;
+static FILE* written_file_ptr = NULL;
+static bool is_written_file_kept = true;
+static char** build_vertices = NULL;
+static size_t build_vertex_count = 0, build_vertex_capacity = 0;
+static yadsl_GraphBuildEdge* build_edges = NULL;
+static size_t build_edge_count = 0, build_edge_capacity = 0;
 
 static int compare_strings_func(void* a, void* b);
 static int read_string_func(FILE* fp, void** vertex_ptr);
 static int write_string_func(FILE* fp, void* v);
+static int write_string_to_kept_file_func(FILE* fp, void* v);
+static void record_progress_func(size_t written_count, size_t total_count, void* arg);
 
 static bool parse_edge_direction(const char* buffer, yadsl_GraphEdgeDirection* edge_direction_ptr);
 static bool parse_iteration_direction(const char* buffer, yadsl_GraphIterationDirection* iteration_direction_ptr);
+static bool parse_weight_type(const char* buffer, yadsl_GraphEdgeWeightType* weight_type_ptr);
+static bool parse_weight(const char* buffer, yadsl_GraphEdgeWeight* weight_ptr);
+static bool reserve_build_array(void** array_ptr, size_t* capacity_ptr, size_t count, size_t size);
+static void clear_build_lists();
 
 static yadsl_TesterRet convert_graph_ret(yadsl_GraphRet graphId);
+static yadsl_TesterRet convert_graph_apsp_ret(yadsl_GraphApspRet graphApspId);
+static yadsl_TesterRet convert_graph_attr_ret(yadsl_GraphAttrRet graphAttrId);
+static yadsl_TesterRet convert_graph_color_ret(yadsl_GraphColorRet graphColorId);
+static yadsl_TesterRet convert_graph_csr_ret(yadsl_GraphCsrRet graphCsrId);
+static yadsl_TesterRet convert_graph_flow_ret(yadsl_GraphFlowRet graphFlowId);
+static yadsl_TesterRet convert_graph_gen_ret(yadsl_GraphGenRet graphGenId);
 static yadsl_TesterRet convert_graph_io_ret(yadsl_GraphIoRet graphIoId);
 static yadsl_TesterRet convert_graph_search_ret(yadsl_GraphSearchRet graphSearchId);
+static yadsl_TesterRet convert_graph_walk_ret(yadsl_GraphWalkRet graphWalkId);
 
 yadsl_TesterRet yadsl_tester_init()
 {
@@ -200,154 +371,1635 @@ static yadsl_TesterRet parse_graph_command(const char* command)
 		graph_ret = yadsl_graph_vertex_flag_get(graph, buffer, &actual);
 		if (graph_ret == YADSL_GRAPH_RET_OK && actual != expected)
 			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "createweighted")) {
+		int is_directed;
+		yadsl_GraphEdgeWeightType weight_type;
+		if (yadsl_tester_parse_arguments("ss", buffer, buffer2) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!parse_weight_type(buffer2, &weight_type))
+			return YADSL_TESTER_RET_ARGUMENT;
+		is_directed = yadsl_testerutils_match(buffer, "DIRECTED");
+		yadsl_GraphHandle* temp = yadsl_graph_create_weighted(is_directed, weight_type, compare_strings_func, free, compare_strings_func, free);
+		if (temp) {
+			yadsl_graph_destroy(graph);
+			graph = temp;
+		} else {
+			return YADSL_TESTER_RET_MALLOC;
+		}
+	} else if (yadsl_testerutils_match(command, "weighttype")) {
+		yadsl_GraphEdgeWeightType actual, expected;
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!parse_weight_type(buffer, &expected))
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_ret = yadsl_graph_edge_weight_type_get(graph, &actual);
+		if (graph_ret == YADSL_GRAPH_RET_OK && actual != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "addweightededge")) {
+		char* edge;
+		yadsl_GraphEdgeWeight weight;
+		if (yadsl_tester_parse_arguments("ssss", buffer, buffer2, buffer3, buffer4) != 4)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!parse_weight(buffer4, &weight))
+			return YADSL_TESTER_RET_ARGUMENT;
+		if ((edge = yadsl_string_duplicate(buffer3)) == NULL)
+			return YADSL_TESTER_RET_MALLOC;
+		if (graph_ret = yadsl_graph_edge_weighted_add(graph, buffer, buffer2, edge, weight))
+			free(edge);
+	} else if (yadsl_testerutils_match(command, "getweight")) {
+		yadsl_GraphEdgeWeightType weight_type;
+		yadsl_GraphEdgeWeight actual, expected;
+		if (yadsl_tester_parse_arguments("sss", buffer, buffer2, buffer3) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!parse_weight(buffer3, &expected))
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_ret = yadsl_graph_edge_weight_get(graph, buffer, buffer2, &actual);
+		if (graph_ret == YADSL_GRAPH_RET_OK) {
+			if (yadsl_graph_edge_weight_type_get(graph, &weight_type))
+				return YADSL_TESTER_RET_RETURN;
+			if (yadsl_graph_edge_weight_to_double(weight_type, actual) !=
+				yadsl_graph_edge_weight_to_double(weight_type, expected))
+				return YADSL_TESTER_RET_RETURN;
+		}
+	} else if (yadsl_testerutils_match(command, "setweight")) {
+		yadsl_GraphEdgeWeight weight;
+		if (yadsl_tester_parse_arguments("sss", buffer, buffer2, buffer3) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!parse_weight(buffer3, &weight))
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_ret = yadsl_graph_edge_weight_set(graph, buffer, buffer2, weight);
+	} else if (yadsl_testerutils_match(command, "edgecount")) {
+		size_t actual, expected;
+		if (yadsl_tester_parse_arguments("z", &expected) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_ret = yadsl_graph_edge_count_get(graph, &actual);
+		if (graph_ret == YADSL_GRAPH_RET_OK && expected != actual)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "vertexid")) {
+		size_t actual, expected;
+		if (yadsl_tester_parse_arguments("sz", buffer, &expected) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_ret = yadsl_graph_vertex_id_get(graph, buffer, &actual);
+		if (graph_ret == YADSL_GRAPH_RET_OK && expected != actual)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "vertexbyid")) {
+		size_t id;
+		char* actual;
+		if (yadsl_tester_parse_arguments("zs", &id, buffer) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_ret = yadsl_graph_vertex_by_id_get(graph, id, (yadsl_GraphVertexObject**) &actual);
+		if (graph_ret == YADSL_GRAPH_RET_OK && strcmp(actual, buffer))
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "edgeid")) {
+		size_t actual, expected;
+		if (yadsl_tester_parse_arguments("ssz", buffer, buffer2, &expected) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_ret = yadsl_graph_edge_id_get(graph, buffer, buffer2, &actual);
+		if (graph_ret == YADSL_GRAPH_RET_OK && expected != actual)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "edgebyid")) {
+		size_t id;
+		char* u, * v, * uv;
+		if (yadsl_tester_parse_arguments("zsss", &id, buffer, buffer2, buffer3) != 4)
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_ret = yadsl_graph_edge_by_id_get(graph, id, (yadsl_GraphVertexObject**) &u,
+			(yadsl_GraphVertexObject**) &v, (yadsl_GraphEdgeObject**) &uv);
+		if (graph_ret == YADSL_GRAPH_RET_OK)
+			if (strcmp(u, buffer) || strcmp(v, buffer2) || strcmp(uv, buffer3))
+				return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "addvertexattr") ||
+		yadsl_testerutils_match(command, "addedgeattr")) {
+		yadsl_GraphAttrTableHandle* table;
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (yadsl_testerutils_match(command, "addvertexattr"))
+			graph_ret = yadsl_graph_vertex_attrs_get(graph, &table);
+		else
+			graph_ret = yadsl_graph_edge_attrs_get(graph, &table);
+		if (graph_ret == YADSL_GRAPH_RET_OK)
+			return convert_graph_attr_ret(yadsl_graphattr_column_add(
+				table, buffer, YADSL_GRAPHATTR_TYPE_INT64, NULL));
+	} else if (yadsl_testerutils_match(command, "setvertexattr") ||
+		yadsl_testerutils_match(command, "getvertexattr") ||
+		yadsl_testerutils_match(command, "setedgeattr") ||
+		yadsl_testerutils_match(command, "getedgeattr")) {
+		yadsl_GraphAttrTableHandle* table;
+		yadsl_GraphAttrColumnHandle* column;
+		yadsl_GraphAttrRet graph_attr_ret;
+		size_t id;
+		int64_t actual;
+		int value;
+		bool is_set = yadsl_testerutils_match(command, "setvertexattr") ||
+			yadsl_testerutils_match(command, "setedgeattr");
+		if (yadsl_testerutils_match(command, "setvertexattr") ||
+			yadsl_testerutils_match(command, "getvertexattr")) {
+			if (yadsl_tester_parse_arguments("ssi", buffer, buffer3, &value) != 3)
+				return YADSL_TESTER_RET_ARGUMENT;
+			if (graph_ret = yadsl_graph_vertex_id_get(graph, buffer, &id))
+				return convert_graph_ret(graph_ret);
+			if (yadsl_graph_vertex_attrs_get(graph, &table))
+				return YADSL_TESTER_RET_RETURN;
+		} else {
+			if (yadsl_tester_parse_arguments("sssi", buffer, buffer2, buffer3, &value) != 4)
+				return YADSL_TESTER_RET_ARGUMENT;
+			if (graph_ret = yadsl_graph_edge_id_get(graph, buffer, buffer2, &id))
+				return convert_graph_ret(graph_ret);
+			if (yadsl_graph_edge_attrs_get(graph, &table))
+				return YADSL_TESTER_RET_RETURN;
+		}
+		if (graph_attr_ret = yadsl_graphattr_column_get(table, buffer3, &column))
+			return convert_graph_attr_ret(graph_attr_ret);
+		if (is_set) {
+			graph_attr_ret = yadsl_graphattr_int64_set(column, id, value);
+		} else {
+			graph_attr_ret = yadsl_graphattr_int64_get(column, id, &actual);
+			if (graph_attr_ret == YADSL_GRAPHATTR_RET_OK && actual != value)
+				return YADSL_TESTER_RET_RETURN;
+		}
+		return convert_graph_attr_ret(graph_attr_ret);
+	} else if (yadsl_testerutils_match(command, "buildvertex")) {
+		char* vertex;
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!reserve_build_array((void**) &build_vertices, &build_vertex_capacity,
+			build_vertex_count + 1, sizeof(*build_vertices)))
+			return YADSL_TESTER_RET_MALLOC;
+		if ((vertex = yadsl_string_duplicate(buffer)) == NULL)
+			return YADSL_TESTER_RET_MALLOC;
+		build_vertices[build_vertex_count++] = vertex;
+	} else if (yadsl_testerutils_match(command, "buildedge")) {
+		yadsl_GraphBuildEdge* build_edge;
+		size_t u, v;
+		char* edge;
+		yadsl_GraphEdgeWeight weight;
+		if (yadsl_tester_parse_arguments("zzss", &u, &v, buffer, buffer2) != 4)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!parse_weight(buffer2, &weight))
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!reserve_build_array((void**) &build_edges, &build_edge_capacity,
+			build_edge_count + 1, sizeof(*build_edges)))
+			return YADSL_TESTER_RET_MALLOC;
+		if ((edge = yadsl_string_duplicate(buffer)) == NULL)
+			return YADSL_TESTER_RET_MALLOC;
+		build_edge = &build_edges[build_edge_count++];
+		build_edge->u = u;
+		build_edge->v = v;
+		build_edge->weight = weight;
+		build_edge->item = edge;
+	} else if (yadsl_testerutils_match(command, "build")) {
+		graph_ret = yadsl_graph_build(graph,
+			(yadsl_GraphVertexObject**) build_vertices, build_vertex_count,
+			build_edges, build_edge_count);
+		if (graph_ret == YADSL_GRAPH_RET_OK) {
+			/* graph owns the objects now */
+			build_vertex_count = 0;
+			build_edge_count = 0;
+		}
+		clear_build_lists();
 	} else {
 		return YADSL_TESTER_RET_COUNT;
 	}
 	return convert_graph_ret(graph_ret);
 }
 
-static yadsl_TesterRet parse_graph_io_command(const char* command)
+static yadsl_TesterRet parse_graph_csr_command(const char* command)
 {
-	yadsl_GraphIoRet graph_io_ret = YADSL_GRAPHIO_RET_OK;
-	FILE* file_ptr;
-	if (yadsl_testerutils_match(command, "write")) {
-		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+	yadsl_GraphCsrRet graph_csr_ret = YADSL_GRAPHCSR_RET_OK;
+	if (strncmp(command, "csr", 3)) {
+		return YADSL_TESTER_RET_COUNT;
+	} else if (yadsl_testerutils_match(command, "csrcreate")) {
+		yadsl_GraphCsrHandle* temp;
+		if (graph_csr_ret = yadsl_graphcsr_create(graph, &temp))
+			return convert_graph_csr_ret(graph_csr_ret);
+		yadsl_graphcsr_destroy(csr);
+		csr = temp;
+		return YADSL_TESTER_RET_OK;
+	} else if (csr == NULL) {
+		return yadsl_tester_return_external_value("no csr");
+	} else if (yadsl_testerutils_match(command, "csredgecount")) {
+		size_t actual, expected;
+		if (yadsl_tester_parse_arguments("z", &expected) != 1)
 			return YADSL_TESTER_RET_ARGUMENT;
-		file_ptr = fopen(buffer, "w");
-		if (file_ptr == NULL)
-			return YADSL_TESTER_RET_FILE;
-		graph_io_ret = yadsl_graphio_write(graph, file_ptr, write_string_func, write_string_func);
-		fclose(file_ptr);
-		if (!yadsl_testerutils_add_tempfile_to_list(buffer))
-			return YADSL_TESTER_RET_MALLOC;
-	} else if (yadsl_testerutils_match(command, "read")) {
-		yadsl_GraphHandle* temp;
-		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+		graph_csr_ret = yadsl_graphcsr_edge_count_get(csr, &actual);
+		if (graph_csr_ret == YADSL_GRAPHCSR_RET_OK && expected != actual)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "csrdeltasize")) {
+		size_t actual, expected;
+		if (yadsl_tester_parse_arguments("z", &expected) != 1)
 			return YADSL_TESTER_RET_ARGUMENT;
-		file_ptr = fopen(buffer, "r");
-		if (file_ptr == NULL)
-			return YADSL_TESTER_RET_FILE;
-		graph_io_ret = yadsl_graphio_read(file_ptr, read_string_func, read_string_func, compare_strings_func, free, compare_strings_func, free, &temp);
-		if (graph_io_ret == YADSL_GRAPHIO_RET_OK) {
-			yadsl_graph_destroy(graph);
-			graph = temp;
-		} else if (graph_io_ret == YADSL_GRAPHIO_RET_CREATION_FAILURE && string_duplicate_failed) {
-			graph_io_ret = YADSL_GRAPHIO_RET_MEMORY; /* So that it gets ignored when --fail-memory-allocation is set */
+		graph_csr_ret = yadsl_graphcsr_delta_size_get(csr, &actual);
+		if (graph_csr_ret == YADSL_GRAPHCSR_RET_OK && expected != actual)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "csraddedge")) {
+		size_t u, v;
+		yadsl_GraphEdgeWeight weight;
+		if (yadsl_tester_parse_arguments("zzs", &u, &v, buffer) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!parse_weight(buffer, &weight))
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_csr_ret = yadsl_graphcsr_edge_add(csr, u, v, weight);
+	} else if (yadsl_testerutils_match(command, "csrremoveedge")) {
+		size_t u, v;
+		if (yadsl_tester_parse_arguments("zz", &u, &v) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_csr_ret = yadsl_graphcsr_edge_remove(csr, u, v);
+	} else if (yadsl_testerutils_match(command, "csrcontainsedge")) {
+		size_t u, v;
+		bool actual, expected;
+		if (yadsl_tester_parse_arguments("zzs", &u, &v, buffer) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		expected = yadsl_testerutils_str_to_bool(buffer);
+		graph_csr_ret = yadsl_graphcsr_edge_exists_check(csr, u, v, &actual);
+		if (graph_csr_ret == YADSL_GRAPHCSR_RET_OK && expected != actual)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "csrgetweight")) {
+		size_t u, v;
+		yadsl_GraphEdgeWeightType weight_type;
+		yadsl_GraphEdgeWeight actual, expected;
+		if (yadsl_tester_parse_arguments("zzs", &u, &v, buffer) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!parse_weight(buffer, &expected))
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_csr_ret = yadsl_graphcsr_edge_weight_get(csr, u, v, &actual);
+		if (graph_csr_ret == YADSL_GRAPHCSR_RET_OK) {
+			if (yadsl_graph_edge_weight_type_get(graph, &weight_type))
+				return YADSL_TESTER_RET_RETURN;
+			if (yadsl_graph_edge_weight_to_double(weight_type, actual) !=
+				yadsl_graph_edge_weight_to_double(weight_type, expected))
+				return YADSL_TESTER_RET_RETURN;
 		}
-		fclose(file_ptr);
+	} else if (yadsl_testerutils_match(command, "csrdegree")) {
+		size_t u, actual, expected;
+		if (yadsl_tester_parse_arguments("zz", &u, &expected) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_csr_ret = yadsl_graphcsr_vertex_degree_get(csr, u, &actual);
+		if (graph_csr_ret == YADSL_GRAPHCSR_RET_OK && expected != actual)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "csrneighbours")) {
+		yadsl_GraphCsrNbIter iter;
+		yadsl_GraphEdgeWeight weight;
+		size_t u, v, length = 0;
+		if (yadsl_tester_parse_arguments("zs", &u, buffer) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (graph_csr_ret = yadsl_graphcsr_nb_iter_begin(csr, u, &iter))
+			return convert_graph_csr_ret(graph_csr_ret);
+		strcpy(buffer2, "-");
+		while (yadsl_graphcsr_nb_iter_next(&iter, &v, &weight) == YADSL_GRAPHCSR_RET_OK)
+			length += sprintf(buffer2 + length, length ? ",%zu" : "%zu", v);
+		if (strcmp(buffer, buffer2))
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "csrcompact")) {
+		graph_csr_ret = yadsl_graphcsr_compact(csr);
 	} else {
 		return YADSL_TESTER_RET_COUNT;
 	}
-	return convert_graph_io_ret(graph_io_ret);
+	return convert_graph_csr_ret(graph_csr_ret);
 }
 
-static void visit_vertex_func(void* vertex)
+static bool reserve_colors()
 {
-	printf("%s was visited\n", (char*) vertex);
+	size_t vertex_count;
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count))
+		return false;
+	if (colors)
+		free(colors);
+	colors = NULL;
+	color_vertex_count = vertex_count;
+	if (vertex_count == 0)
+		return true;
+	colors = malloc(vertex_count * sizeof(*colors));
+	return colors != NULL;
 }
 
-static void visit_edge_func(void* source, void* edge, void* dest)
+static bool parse_order(const char* buffer, size_t** order_ptr)
 {
-	printf("%s was visited (%s -> %s)\n", (char*) edge, (char*) source, (char*) dest);
+	size_t* order = NULL;
+	const char* p = buffer;
+	size_t i;
+	int length;
+	*order_ptr = NULL;
+	if (strcmp(buffer, "-") == 0 || color_vertex_count == 0)
+		return true;
+	order = malloc(color_vertex_count * sizeof(*order));
+	if (order == NULL)
+		return false;
+	for (i = 0; i < color_vertex_count; ++i)
+		order[i] = color_vertex_count; /* invalid id */
+	for (i = 0; i < color_vertex_count && *p; ++i) {
+		if (sscanf(p, "%zu%n", &order[i], &length) != 1)
+			break;
+		p += length;
+		if (*p == ',')
+			++p;
+	}
+	*order_ptr = order;
+	return true;
 }
 
-static yadsl_TesterRet parse_graph_search_command(const char* command)
+static yadsl_TesterRet parse_graph_color_command(const char* command)
 {
-	yadsl_GraphSearchRet graph_search_ret = YADSL_GRAPHSEARCH_RET_OK;
-	int flag;
-	if (yadsl_testerutils_match(command, "dfs")) {
-		if (yadsl_tester_parse_arguments("si", buffer, &flag) != 2)
+	yadsl_GraphColorRet graph_color_ret = YADSL_GRAPHCOLOR_RET_OK;
+	if (strncmp(command, "color", 5)) {
+		return YADSL_TESTER_RET_COUNT;
+	} else if (yadsl_testerutils_match(command, "colorgreedy")) {
+		size_t* order, actual, expected;
+		if (yadsl_tester_parse_arguments("sz", buffer, &expected) != 2)
 			return YADSL_TESTER_RET_ARGUMENT;
-		graph_search_ret = yadsl_graphsearch_dfs(graph, buffer, flag, visit_vertex_func, visit_edge_func);
-	} else if (yadsl_testerutils_match(command, "bfs")) {
-		if (yadsl_tester_parse_arguments("si", buffer, &flag) != 2)
+		if (!reserve_colors() || !parse_order(buffer, &order))
+			return YADSL_TESTER_RET_MALLOC;
+		graph_color_ret = yadsl_graphcolor_greedy(graph, order, colors, &actual);
+		if (order)
+			free(order);
+		if (graph_color_ret == YADSL_GRAPHCOLOR_RET_OK && expected != actual)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "colordsatur")) {
+		size_t actual, expected;
+		if (yadsl_tester_parse_arguments("z", &expected) != 1)
 			return YADSL_TESTER_RET_ARGUMENT;
-		graph_search_ret = yadsl_graphsearch_bfs(graph, buffer, flag, visit_vertex_func, visit_edge_func);
+		if (!reserve_colors())
+			return YADSL_TESTER_RET_MALLOC;
+		graph_color_ret = yadsl_graphcolor_dsatur(graph, colors, &actual);
+		if (graph_color_ret == YADSL_GRAPHCOLOR_RET_OK && expected != actual)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "colorjp")) {
+		size_t actual, max_count, round_count;
+		int seed;
+		if (yadsl_tester_parse_arguments("iz", &seed, &max_count) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!reserve_colors())
+			return YADSL_TESTER_RET_MALLOC;
+		graph_color_ret = yadsl_graphcolor_jones_plassmann(graph,
+			(unsigned long) seed, colors, &actual, &round_count);
+		if (graph_color_ret == YADSL_GRAPHCOLOR_RET_OK)
+			if (actual > max_count || round_count > color_vertex_count)
+				return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "colorflags")) {
+		size_t actual, expected;
+		if (yadsl_tester_parse_arguments("z", &expected) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_color_ret = yadsl_graphcolor_dsatur(graph, NULL, &actual);
+		if (graph_color_ret == YADSL_GRAPHCOLOR_RET_OK && expected != actual)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "colorof")) {
+		size_t id, expected;
+		if (yadsl_tester_parse_arguments("zz", &id, &expected) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (id >= color_vertex_count)
+			return yadsl_tester_return_external_value("parameter");
+		if (colors[id] != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "colorvalid")) {
+		size_t vertex_count;
+		bool actual, expected;
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		expected = yadsl_testerutils_str_to_bool(buffer);
+		if (yadsl_graph_vertex_count_get(graph, &vertex_count) || vertex_count != color_vertex_count)
+			return yadsl_tester_return_external_value("parameter");
+		graph_color_ret = yadsl_graphcolor_check(graph, colors, &actual);
+		if (graph_color_ret == YADSL_GRAPHCOLOR_RET_OK && expected != actual)
+			return YADSL_TESTER_RET_RETURN;
 	} else {
 		return YADSL_TESTER_RET_COUNT;
 	}
-	return convert_graph_search_ret(graph_search_ret);
+	return convert_graph_color_ret(graph_color_ret);
 }
 
-/**
- * Here the YADSL_TESTER_RET_COUNT is being used as a flag to indicate that
- * the command is not of a certain type, since it is never used truly for
- * testing purposes. 
-*/
-yadsl_TesterRet yadsl_tester_parse(const char* command)
+static double edge_name_length_func(yadsl_GraphEdgeObject* edge, void* arg)
 {
-	yadsl_TesterRet ret;
-	if ((ret = parse_graph_command(command)) != YADSL_TESTER_RET_COUNT)
-		return ret;
-	if ((ret = parse_graph_io_command(command)) != YADSL_TESTER_RET_COUNT)
-		return ret;
-	if ((ret = parse_graph_search_command(command)) != YADSL_TESTER_RET_COUNT)
-		return ret;
-	return YADSL_TESTER_RET_COMMAND;
+	return (double) strlen((char*) edge);
 }
 
-yadsl_TesterRet yadsl_tester_release()
+static void clear_flow_results()
 {
-	yadsl_testerutils_clear_tempfile_list();
-
-	if (graph)
-		yadsl_graph_destroy(graph);
-
-#ifdef YADSL_DEBUG
-	if (yadsl_graphsearch_get_node_ref_count())
-		return YADSL_TESTER_RET_MEMLEAK;
-#endif
-
-	return YADSL_TESTER_RET_OK;
+	if (flows)
+		free(flows);
+	if (cut)
+		free(cut);
+	flows = NULL;
+	cut = NULL;
+	flow_edge_count = 0;
+	cut_vertex_count = 0;
 }
 
-int compare_strings_func(void* a, void* b)
+static yadsl_TesterRet parse_graph_flow_command(const char* command)
 {
-	return strcmp((char*) a, (char*) b) == 0;
+	yadsl_GraphFlowRet graph_flow_ret = YADSL_GRAPHFLOW_RET_OK;
+	if (yadsl_testerutils_match(command, "maxflow")) {
+		yadsl_GraphFlowCapacityFunc capacity_func;
+		size_t s, t, vertex_count, edge_count;
+		double actual;
+		float expected;
+		if (yadsl_tester_parse_arguments("zzsf", &s, &t, buffer, &expected) != 4)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (yadsl_testerutils_match(buffer, "weight"))
+			capacity_func = NULL;
+		else if (yadsl_testerutils_match(buffer, "length"))
+			capacity_func = edge_name_length_func;
+		else
+			return YADSL_TESTER_RET_ARGUMENT;
+		clear_flow_results();
+		if (yadsl_graph_vertex_count_get(graph, &vertex_count) ||
+			yadsl_graph_edge_count_get(graph, &edge_count))
+			return YADSL_TESTER_RET_RETURN;
+		if (edge_count > 0 && !(flows = malloc(edge_count * sizeof(*flows))))
+			return YADSL_TESTER_RET_MALLOC;
+		if (vertex_count > 0 && !(cut = malloc(vertex_count * sizeof(*cut))))
+			return YADSL_TESTER_RET_MALLOC;
+		graph_flow_ret = yadsl_graphflow_max_flow(graph, s, t,
+			capacity_func, NULL, &actual, flows, cut);
+		if (graph_flow_ret == YADSL_GRAPHFLOW_RET_OK) {
+			flow_edge_count = edge_count;
+			cut_vertex_count = vertex_count;
+			if ((float) actual != expected)
+				return YADSL_TESTER_RET_RETURN;
+		}
+	} else if (yadsl_testerutils_match(command, "edgeflow")) {
+		size_t id;
+		float expected;
+		if (yadsl_tester_parse_arguments("zf", &id, &expected) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (id >= flow_edge_count)
+			return yadsl_tester_return_external_value("parameter");
+		if ((float) flows[id] != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "mincut")) {
+		size_t id;
+		if (yadsl_tester_parse_arguments("zs", &id, buffer) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (id >= cut_vertex_count)
+			return yadsl_tester_return_external_value("parameter");
+		if (cut[id] != yadsl_testerutils_str_to_bool(buffer))
+			return YADSL_TESTER_RET_RETURN;
+	} else {
+		return YADSL_TESTER_RET_COUNT;
+	}
+	return convert_graph_flow_ret(graph_flow_ret);
 }
 
-int read_string_func(FILE* fp, void** vertex_ptr)
+static bool parse_apsp_weights(const char* buffer, bool* is_weighted_ptr)
 {
-	char* str = yadsl_testerutils_str_deserialize(fp);
-	
-	if (str == NULL)
-		string_duplicate_failed = true;
+	if (yadsl_testerutils_match(buffer, "weight"))
+		*is_weighted_ptr = true;
+	else if (yadsl_testerutils_match(buffer, "hops"))
+		*is_weighted_ptr = false;
 	else
-		*vertex_ptr = str;
-
-	return str == NULL;
+		return false;
+	return true;
 }
 
-int write_string_func(FILE* fp, void* v)
+static yadsl_TesterRet parse_graph_apsp_command(const char* command)
 {
-	return yadsl_testerutils_str_serialize(fp, (char*) v);
+	yadsl_GraphApspRet graph_apsp_ret = YADSL_GRAPHAPSP_RET_OK;
+	if (yadsl_testerutils_match(command, "apsp")) {
+		size_t vertex_count, block_size;
+		bool is_weighted;
+		if (yadsl_tester_parse_arguments("sz", buffer, &block_size) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!parse_apsp_weights(buffer, &is_weighted))
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (distances)
+			free(distances);
+		distances = NULL;
+		distance_vertex_count = 0;
+		if (yadsl_graph_vertex_count_get(graph, &vertex_count))
+			return YADSL_TESTER_RET_RETURN;
+		if (vertex_count > 0 && !(distances = malloc(vertex_count * vertex_count * sizeof(*distances))))
+			return YADSL_TESTER_RET_MALLOC;
+		distance_vertex_count = vertex_count;
+		graph_apsp_ret = yadsl_graphapsp_matrix_fill(graph, is_weighted, distances);
+		if (graph_apsp_ret == YADSL_GRAPHAPSP_RET_OK)
+			graph_apsp_ret = yadsl_graphapsp_floyd_warshall(distances, vertex_count, block_size);
+	} else if (yadsl_testerutils_match(command, "distance")) {
+		size_t u, v;
+		if (yadsl_tester_parse_arguments("zzs", &u, &v, buffer) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (u >= distance_vertex_count || v >= distance_vertex_count)
+			return yadsl_tester_return_external_value("parameter");
+		if (distances[u * distance_vertex_count + v] != strtod(buffer, NULL))
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "apspcheck")) {
+		size_t n = distance_vertex_count, k, i, j;
+		double* expected, d;
+		bool is_weighted;
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!parse_apsp_weights(buffer, &is_weighted))
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (n == 0)
+			return YADSL_TESTER_RET_OK;
+		if (!(expected = malloc(n * n * sizeof(*expected))))
+			return YADSL_TESTER_RET_MALLOC;
+		graph_apsp_ret = yadsl_graphapsp_matrix_fill(graph, is_weighted, expected);
+		if (graph_apsp_ret == YADSL_GRAPHAPSP_RET_OK) {
+			for (k = 0; k < n; ++k)
+				for (i = 0; i < n; ++i)
+					for (j = 0; j < n; ++j)
+						if ((d = expected[i * n + k] + expected[k * n + j]) < expected[i * n + j])
+							expected[i * n + j] = d;
+			for (i = 0; i < n * n; ++i) {
+				if (expected[i] != distances[i]) {
+					free(expected);
+					return YADSL_TESTER_RET_RETURN;
+				}
+			}
+		}
+		free(expected);
+	} else {
+		return YADSL_TESTER_RET_COUNT;
+	}
+	return convert_graph_apsp_ret(graph_apsp_ret);
 }
 
-yadsl_TesterRet convert_graph_ret(yadsl_GraphRet graphId)
+static void* gen_vertex_func(size_t index, void* arg)
 {
-	switch (graphId) {
-	case YADSL_GRAPH_RET_OK:
-		return YADSL_TESTER_RET_OK;
-	case YADSL_GRAPH_RET_EMPTY:
-		return yadsl_tester_return_external_value("empty");
-	case YADSL_GRAPH_RET_CONTAINS_VERTEX:
-		return yadsl_tester_return_external_value("contains vertex");
-	case YADSL_GRAPH_RET_DOES_NOT_CONTAIN_VERTEX:
-		return yadsl_tester_return_external_value("does not contain vertex");
-	case YADSL_GRAPH_RET_CONTAINS_EDGE:
-		return yadsl_tester_return_external_value("contains edge");
-	case YADSL_GRAPH_RET_DOES_NOT_CONTAIN_EDGE:
-		return yadsl_tester_return_external_value("does not contain edge");
-	case YADSL_GRAPH_RET_MEMORY:
-		return YADSL_TESTER_RET_MALLOC;
-	case YADSL_GRAPH_RET_PARAMETER:
-		return yadsl_tester_return_external_value("parameter");
-	default:
-		return yadsl_tester_return_external_value("unknown");
-	}
+	char* vertex = malloc(24);
+	if (vertex)
+		sprintf(vertex, "%zu", index);
+	return vertex;
 }
 
-yadsl_TesterRet convert_graph_io_ret(yadsl_GraphIoRet graphIoId)
+static void* gen_edge_func(size_t u, size_t v, void* arg)
+{
+	char* edge = malloc(48);
+	if (edge)
+		sprintf(edge, "%zu-%zu", u, v);
+	return edge;
+}
+
+static yadsl_TesterRet parse_graph_gen_command(const char* command)
+{
+	yadsl_GraphGenRet graph_gen_ret = YADSL_GRAPHGEN_RET_OK;
+	yadsl_GraphGenParams params;
+	int seed;
+	if (strncmp(command, "gen", 3))
+		return YADSL_TESTER_RET_COUNT;
+	params.vertex_func = gen_vertex_func;
+	params.free_vertex_func = free;
+	params.edge_func = gen_edge_func;
+	params.free_edge_func = free;
+	params.arg = NULL;
+	params.min_weight = gen_min_weight;
+	params.max_weight = gen_max_weight;
+	if (yadsl_testerutils_match(command, "genweights")) {
+		float min_weight, max_weight;
+		if (yadsl_tester_parse_arguments("ff", &min_weight, &max_weight) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		gen_min_weight = min_weight;
+		gen_max_weight = max_weight;
+	} else if (yadsl_testerutils_match(command, "generdosrenyi")) {
+		size_t vertex_count;
+		float probability;
+		if (yadsl_tester_parse_arguments("zfi", &vertex_count, &probability, &seed) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		params.seed = (unsigned long) seed;
+		graph_gen_ret = yadsl_graphgen_erdos_renyi(graph, &params, vertex_count, probability);
+	} else if (yadsl_testerutils_match(command, "genrmat")) {
+		size_t scale, edge_count;
+		float a, b, c;
+		if (yadsl_tester_parse_arguments("zzfffi", &scale, &edge_count, &a, &b, &c, &seed) != 6)
+			return YADSL_TESTER_RET_ARGUMENT;
+		params.seed = (unsigned long) seed;
+		graph_gen_ret = yadsl_graphgen_rmat(graph, &params, scale, edge_count, a, b, c);
+	} else if (yadsl_testerutils_match(command, "gengrid")) {
+		size_t row_count, column_count;
+		if (yadsl_tester_parse_arguments("zz", &row_count, &column_count) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		params.seed = 0;
+		graph_gen_ret = yadsl_graphgen_grid(graph, &params, row_count, column_count);
+	} else if (yadsl_testerutils_match(command, "genbarabasialbert")) {
+		size_t vertex_count, edges_per_vertex;
+		if (yadsl_tester_parse_arguments("zzi", &vertex_count, &edges_per_vertex, &seed) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		params.seed = (unsigned long) seed;
+		graph_gen_ret = yadsl_graphgen_barabasi_albert(graph, &params, vertex_count, edges_per_vertex);
+	} else if (yadsl_testerutils_match(command, "genregular")) {
+		size_t vertex_count, degree;
+		if (yadsl_tester_parse_arguments("zzi", &vertex_count, &degree, &seed) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		params.seed = (unsigned long) seed;
+		graph_gen_ret = yadsl_graphgen_random_regular(graph, &params, vertex_count, degree);
+	} else if (yadsl_testerutils_match(command, "gendegrees")) {
+		yadsl_GraphEdgeDirection edge_direction;
+		yadsl_GraphVertexObject* vertex;
+		size_t min_degree, max_degree, vertex_count, degree, id;
+		if (yadsl_tester_parse_arguments("szz", buffer, &min_degree, &max_degree) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!parse_edge_direction(buffer, &edge_direction))
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (yadsl_graph_vertex_count_get(graph, &vertex_count))
+			return YADSL_TESTER_RET_RETURN;
+		for (id = 0; id < vertex_count; ++id) {
+			if (yadsl_graph_vertex_by_id_get(graph, id, &vertex) ||
+				yadsl_graph_vertex_degree_get(graph, vertex, edge_direction, &degree))
+				return YADSL_TESTER_RET_RETURN;
+			if (degree < min_degree || degree > max_degree)
+				return YADSL_TESTER_RET_RETURN;
+		}
+	} else if (yadsl_testerutils_match(command, "genweightrange")) {
+		yadsl_GraphEdgeWeightType weight_type;
+		yadsl_GraphEdgeWeight weight;
+		size_t edge_count, id, u, v;
+		float min_weight, max_weight;
+		double w;
+		if (yadsl_tester_parse_arguments("ff", &min_weight, &max_weight) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (yadsl_graph_edge_count_get(graph, &edge_count) ||
+			yadsl_graph_edge_weight_type_get(graph, &weight_type))
+			return YADSL_TESTER_RET_RETURN;
+		for (id = 0; id < edge_count; ++id) {
+			if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight))
+				return YADSL_TESTER_RET_RETURN;
+			w = yadsl_graph_edge_weight_to_double(weight_type, weight);
+			if (w < min_weight || w > max_weight)
+				return YADSL_TESTER_RET_RETURN;
+		}
+	} else if (yadsl_testerutils_match(command, "genhash")) {
+		yadsl_GraphEdgeWeight weight;
+		size_t edge_count, id, u, v;
+		unsigned long long hash = 0, key;
+		bool is_directed;
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (yadsl_graph_edge_count_get(graph, &edge_count) ||
+			yadsl_graph_is_directed_check(graph, &is_directed))
+			return YADSL_TESTER_RET_RETURN;
+		/* Sum of mixed endpoints, which depends neither on the order of
+		edges nor on the order of endpoints of undirected edges */
+		for (id = 0; id < edge_count; ++id) {
+			if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight))
+				return YADSL_TESTER_RET_RETURN;
+			if (!is_directed && u > v)
+				key = ((unsigned long long) v << 32) | u;
+			else
+				key = ((unsigned long long) u << 32) | v;
+			key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+			hash += key ^ (key >> 31);
+		}
+		sprintf(buffer2, "%016llx", hash);
+		if (strcmp(buffer, buffer2))
+			return YADSL_TESTER_RET_RETURN;
+	} else {
+		return YADSL_TESTER_RET_COUNT;
+	}
+	return convert_graph_gen_ret(graph_gen_ret);
+}
+
+static bool check_walk_step(size_t u, size_t v)
+{
+	yadsl_GraphVertexObject* u_obj, * v_obj;
+	bool contains;
+	if (yadsl_graph_vertex_by_id_get(graph, u, &u_obj) ||
+		yadsl_graph_vertex_by_id_get(graph, v, &v_obj) ||
+		yadsl_graph_edge_exists_check(graph, u_obj, v_obj, &contains))
+		return false;
+	return contains;
+}
+
+static yadsl_TesterRet parse_graph_walk_command(const char* command)
+{
+	yadsl_GraphWalkRet graph_walk_ret = YADSL_GRAPHWALK_RET_OK;
+	yadsl_GraphWalkParams params;
+	float p, q;
+	int seed;
+	if (strncmp(command, "walk", 4)) {
+		return YADSL_TESTER_RET_COUNT;
+	} else if (yadsl_testerutils_match(command, "walkcreate")) {
+		yadsl_GraphWalkHandle* temp;
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (graph_walk_ret = yadsl_graphwalk_create(graph, yadsl_testerutils_str_to_bool(buffer), &temp))
+			return convert_graph_walk_ret(graph_walk_ret);
+		yadsl_graphwalk_destroy(walker);
+		walker = temp;
+		return YADSL_TESTER_RET_OK;
+	} else if (walker == NULL) {
+		return yadsl_tester_return_external_value("no walker");
+	} else if (yadsl_testerutils_match(command, "walk")) {
+		size_t start, index, i, length = 0, * walk;
+		if (yadsl_tester_parse_arguments("zzzffis", &start, &index,
+			&params.walk_length, &p, &q, &seed, buffer) != 7)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (params.walk_length == 0 || params.walk_length > 64)
+			return YADSL_TESTER_RET_ARGUMENT;
+		params.walks_per_vertex = 1;
+		params.p = p;
+		params.q = q;
+		params.seed = (unsigned long) seed;
+		if (!(walk = malloc(params.walk_length * sizeof(*walk))))
+			return YADSL_TESTER_RET_MALLOC;
+		graph_walk_ret = yadsl_graphwalk_walk(walker, &params, start, index, walk);
+		if (graph_walk_ret == YADSL_GRAPHWALK_RET_OK) {
+			for (i = 0; i < params.walk_length; ++i) {
+				if (walk[i] == YADSL_GRAPHWALK_NONE)
+					length += sprintf(buffer2 + length, i ? ",-" : "-");
+				else
+					length += sprintf(buffer2 + length, i ? ",%zu" : "%zu", walk[i]);
+			}
+		}
+		free(walk);
+		if (graph_walk_ret == YADSL_GRAPHWALK_RET_OK && strcmp(buffer, buffer2))
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "walkcheck")) {
+		size_t vertex_count, total, i, v, j, * walks = NULL, * walk = NULL, * generated;
+		if (yadsl_tester_parse_arguments("zzffi", &params.walks_per_vertex,
+			&params.walk_length, &p, &q, &seed) != 5)
+			return YADSL_TESTER_RET_ARGUMENT;
+		params.p = p;
+		params.q = q;
+		params.seed = (unsigned long) seed;
+		if (yadsl_graph_vertex_count_get(graph, &vertex_count))
+			return YADSL_TESTER_RET_RETURN;
+		total = params.walks_per_vertex * vertex_count * params.walk_length;
+		if (total == 0)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!(walks = malloc(total * sizeof(*walks))))
+			return YADSL_TESTER_RET_MALLOC;
+		if (!(walk = malloc(params.walk_length * sizeof(*walk)))) {
+			free(walks);
+			return YADSL_TESTER_RET_MALLOC;
+		}
+		graph_walk_ret = yadsl_graphwalk_walks_generate(walker, &params, walks);
+		for (i = 0; graph_walk_ret == YADSL_GRAPHWALK_RET_OK && i < params.walks_per_vertex; ++i) {
+			for (v = 0; v < vertex_count; ++v) {
+				generated = walks + (i * vertex_count + v) * params.walk_length;
+				if (generated[0] != v ||
+					yadsl_graphwalk_walk(walker, &params, v, i, walk) ||
+					memcmp(walk, generated, params.walk_length * sizeof(*walk)))
+					break;
+				/* Steps follow edges until the walk is padded */
+				for (j = 1; j < params.walk_length && generated[j] != YADSL_GRAPHWALK_NONE; ++j)
+					if (!check_walk_step(generated[j - 1], generated[j]))
+						break;
+				for (; j < params.walk_length && generated[j] == YADSL_GRAPHWALK_NONE; ++j);
+				if (j < params.walk_length)
+					break;
+			}
+			if (v < vertex_count)
+				break;
+		}
+		free(walk);
+		free(walks);
+		if (graph_walk_ret == YADSL_GRAPHWALK_RET_OK && i < params.walks_per_vertex)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "walkfreq")) {
+		size_t start, target, sample_count, hit_count = 0, i, walk[2];
+		float expected;
+		double frequency;
+		if (yadsl_tester_parse_arguments("zzzf", &start, &target, &sample_count, &expected) != 4)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (sample_count == 0)
+			return YADSL_TESTER_RET_ARGUMENT;
+		params.walk_length = 2;
+		params.walks_per_vertex = 1;
+		params.p = 1.0;
+		params.q = 1.0;
+		params.seed = 0;
+		for (i = 0; i < sample_count; ++i) {
+			if (graph_walk_ret = yadsl_graphwalk_walk(walker, &params, start, i, walk))
+				break;
+			if (walk[1] == target)
+				++hit_count;
+		}
+		if (graph_walk_ret == YADSL_GRAPHWALK_RET_OK) {
+			frequency = (double) hit_count / (double) sample_count;
+			if (frequency - expected > 0.02 || expected - frequency > 0.02)
+				return YADSL_TESTER_RET_RETURN;
+		}
+	} else {
+		return YADSL_TESTER_RET_COUNT;
+	}
+	return convert_graph_walk_ret(graph_walk_ret);
+}
+
+static yadsl_TesterRet parse_graph_io_command(const char* command)
+{
+	yadsl_GraphIoRet graph_io_ret = YADSL_GRAPHIO_RET_OK;
+	FILE* file_ptr;
+	if (yadsl_testerutils_match(command, "write")) {
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		file_ptr = fopen(buffer, "w");
+		if (file_ptr == NULL)
+			return YADSL_TESTER_RET_FILE;
+		written_file_ptr = file_ptr;
+		is_written_file_kept = true;
+		graph_io_ret = yadsl_graphio_write(graph, file_ptr,
+			write_string_to_kept_file_func, write_string_to_kept_file_func);
+		fclose(file_ptr);
+		if (!yadsl_testerutils_add_tempfile_to_list(buffer))
+			return YADSL_TESTER_RET_MALLOC;
+		/* Serialization functions are given the file itself */
+		if (!is_written_file_kept)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "writestreamed")) {
+		yadsl_GraphIoWriteParams params;
+		if (yadsl_tester_parse_arguments("sz", buffer, &params.buffer_size) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		params.progress_func = record_progress_func;
+		params.arg = NULL;
+		progress_call_count = progress_written_count = progress_total_count = 0;
+		is_progress_monotonic = true;
+		file_ptr = fopen(buffer, "w");
+		if (file_ptr == NULL)
+			return YADSL_TESTER_RET_FILE;
+		graph_io_ret = yadsl_graphio_write_streamed(graph, file_ptr, write_string_func, write_string_func, &params);
+		fclose(file_ptr);
+		if (!yadsl_testerutils_add_tempfile_to_list(buffer))
+			return YADSL_TESTER_RET_MALLOC;
+	} else if (yadsl_testerutils_match(command, "progress")) {
+		size_t call_count, written_count, total_count;
+		if (yadsl_tester_parse_arguments("zzz", &call_count, &written_count, &total_count) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!is_progress_monotonic || progress_call_count != call_count ||
+			progress_written_count != written_count || progress_total_count != total_count)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "read")) {
+		yadsl_GraphHandle* temp;
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		file_ptr = fopen(buffer, "r");
+		if (file_ptr == NULL)
+			return YADSL_TESTER_RET_FILE;
+		graph_io_ret = yadsl_graphio_read(file_ptr, read_string_func, read_string_func, compare_strings_func, free, compare_strings_func, free, &temp);
+		if (graph_io_ret == YADSL_GRAPHIO_RET_OK) {
+			yadsl_graph_destroy(graph);
+			graph = temp;
+		} else if (graph_io_ret == YADSL_GRAPHIO_RET_CREATION_FAILURE && string_duplicate_failed) {
+			graph_io_ret = YADSL_GRAPHIO_RET_MEMORY; /* So that it gets ignored when --fail-memory-allocation is set */
+		}
+		fclose(file_ptr);
+	} else if (yadsl_testerutils_match(command, "writebinary")) {
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		file_ptr = fopen(buffer, "wb");
+		if (file_ptr == NULL)
+			return YADSL_TESTER_RET_FILE;
+		graph_io_ret = yadsl_graphio_binary_write(graph, file_ptr, write_string_func, write_string_func);
+		fclose(file_ptr);
+		if (!yadsl_testerutils_add_tempfile_to_list(buffer))
+			return YADSL_TESTER_RET_MALLOC;
+	} else if (yadsl_testerutils_match(command, "readbinary")) {
+		yadsl_GraphHandle* temp;
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		file_ptr = fopen(buffer, "rb");
+		if (file_ptr == NULL)
+			return YADSL_TESTER_RET_FILE;
+		graph_io_ret = yadsl_graphio_binary_read(file_ptr, read_string_func, read_string_func, compare_strings_func, free, compare_strings_func, free, &temp);
+		if (graph_io_ret == YADSL_GRAPHIO_RET_OK) {
+			yadsl_graph_destroy(graph);
+			graph = temp;
+		} else if (graph_io_ret == YADSL_GRAPHIO_RET_CREATION_FAILURE && string_duplicate_failed) {
+			graph_io_ret = YADSL_GRAPHIO_RET_MEMORY; /* So that it gets ignored when --fail-memory-allocation is set */
+		}
+		fclose(file_ptr);
+	} else if (yadsl_testerutils_match(command, "writecompressed")) {
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		file_ptr = fopen(buffer, "wb");
+		if (file_ptr == NULL)
+			return YADSL_TESTER_RET_FILE;
+		graph_io_ret = yadsl_graphio_compressed_write(graph, file_ptr, write_string_func, write_string_func);
+		fclose(file_ptr);
+		if (!yadsl_testerutils_add_tempfile_to_list(buffer))
+			return YADSL_TESTER_RET_MALLOC;
+	} else if (yadsl_testerutils_match(command, "readcompressed")) {
+		yadsl_GraphHandle* temp;
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		file_ptr = fopen(buffer, "rb");
+		if (file_ptr == NULL)
+			return YADSL_TESTER_RET_FILE;
+		graph_io_ret = yadsl_graphio_compressed_read(file_ptr, read_string_func, read_string_func, compare_strings_func, free, compare_strings_func, free, &temp);
+		if (graph_io_ret == YADSL_GRAPHIO_RET_OK) {
+			yadsl_graph_destroy(graph);
+			graph = temp;
+		} else if (graph_io_ret == YADSL_GRAPHIO_RET_CREATION_FAILURE && string_duplicate_failed) {
+			graph_io_ret = YADSL_GRAPHIO_RET_MEMORY; /* So that it gets ignored when --fail-memory-allocation is set */
+		}
+		fclose(file_ptr);
+	} else if (yadsl_testerutils_match(command, "compressedopen")) {
+		yadsl_GraphIoCompressedHandle* temp;
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		file_ptr = fopen(buffer, "rb");
+		if (file_ptr == NULL)
+			return YADSL_TESTER_RET_FILE;
+		graph_io_ret = yadsl_graphio_compressed_open(file_ptr, &temp);
+		fclose(file_ptr);
+		if (graph_io_ret == YADSL_GRAPHIO_RET_OK) {
+			yadsl_graphio_compressed_close(compressed);
+			compressed = temp;
+		}
+	} else if (yadsl_testerutils_match(command, "compresseddegree")) {
+		size_t id, expected, actual;
+		if (yadsl_tester_parse_arguments("zz", &id, &expected) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (compressed == NULL)
+			return yadsl_tester_return_external_value("no compressed file");
+		graph_io_ret = yadsl_graphio_compressed_degree_get(compressed, id, &actual);
+		if (graph_io_ret == YADSL_GRAPHIO_RET_OK && actual != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "compressednbs") ||
+		yadsl_testerutils_match(command, "compressedweights")) {
+		bool is_weights = yadsl_testerutils_match(command, "compressedweights");
+		size_t id, degree, i;
+		size_t* nbs = NULL;
+		yadsl_GraphEdgeWeight* weights = NULL;
+		yadsl_GraphEdgeWeightType weight_type = YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE;
+		int length = 0;
+		if (yadsl_tester_parse_arguments("zs", &id, buffer) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (compressed == NULL)
+			return yadsl_tester_return_external_value("no compressed file");
+		if (graph_io_ret = yadsl_graphio_compressed_degree_get(compressed, id, &degree))
+			return convert_graph_io_ret(graph_io_ret);
+		if (is_weights && yadsl_graph_edge_weight_type_get(graph, &weight_type))
+			return YADSL_TESTER_RET_RETURN;
+		if (degree > 0) {
+			if (!(nbs = malloc(degree * sizeof(*nbs))))
+				return YADSL_TESTER_RET_MALLOC;
+			if (!(weights = malloc(degree * sizeof(*weights)))) {
+				free(nbs);
+				return YADSL_TESTER_RET_MALLOC;
+			}
+			graph_io_ret = yadsl_graphio_compressed_nbs_get(compressed, id, nbs, weights);
+		}
+		buffer2[0] = '\0';
+		for (i = 0; graph_io_ret == YADSL_GRAPHIO_RET_OK && i < degree && length < BUFSIZ - 32; ++i) {
+			if (is_weights)
+				length += sprintf(buffer2 + length, i ? " %g" : "%g",
+					yadsl_graph_edge_weight_to_double(weight_type, weights[i]));
+			else
+				length += sprintf(buffer2 + length, i ? " %zu" : "%zu", nbs[i]);
+		}
+		if (nbs)
+			free(nbs);
+		if (weights)
+			free(weights);
+		if (graph_io_ret == YADSL_GRAPHIO_RET_OK && strcmp(buffer, buffer2))
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "mappedopen")) {
+		yadsl_GraphIoMappedHandle* temp;
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		file_ptr = fopen(buffer, "rb");
+		if (file_ptr == NULL)
+			return YADSL_TESTER_RET_FILE;
+		graph_io_ret = yadsl_graphio_mapped_open(file_ptr, &temp);
+		fclose(file_ptr);
+		if (graph_io_ret == YADSL_GRAPHIO_RET_OK) {
+			yadsl_graphio_mapped_close(mapped);
+			mapped = temp;
+		}
+	} else if (yadsl_testerutils_match(command, "mappeddegree")) {
+		size_t id, expected, actual;
+		if (yadsl_tester_parse_arguments("zz", &id, &expected) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (mapped == NULL)
+			return yadsl_tester_return_external_value("no mapped file");
+		graph_io_ret = yadsl_graphio_mapped_vertex_degree_get(mapped, id, &actual);
+		if (graph_io_ret == YADSL_GRAPHIO_RET_OK && actual != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "mappednbs") ||
+		yadsl_testerutils_match(command, "mappedweights")) {
+		bool is_weights = yadsl_testerutils_match(command, "mappedweights");
+		size_t id, degree, nb, i;
+		yadsl_GraphEdgeWeight weight;
+		yadsl_GraphEdgeWeightType weight_type;
+		int length = 0;
+		if (yadsl_tester_parse_arguments("zs", &id, buffer) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (mapped == NULL)
+			return yadsl_tester_return_external_value("no mapped file");
+		if (graph_io_ret = yadsl_graphio_mapped_vertex_degree_get(mapped, id, &degree))
+			return convert_graph_io_ret(graph_io_ret);
+		yadsl_graphio_mapped_edge_weight_type_get(mapped, &weight_type);
+		buffer2[0] = '\0';
+		for (i = 0; i < degree && length < BUFSIZ - 32; ++i) {
+			if (graph_io_ret = yadsl_graphio_mapped_vertex_nb_get(mapped, id, i, &nb, &weight))
+				return convert_graph_io_ret(graph_io_ret);
+			if (is_weights)
+				length += sprintf(buffer2 + length, i ? " %g" : "%g",
+					yadsl_graph_edge_weight_to_double(weight_type, weight));
+			else
+				length += sprintf(buffer2 + length, i ? " %zu" : "%zu", nb);
+		}
+		if (strcmp(buffer, buffer2))
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "mappedflag")) {
+		size_t id;
+		int expected, actual;
+		if (yadsl_tester_parse_arguments("zi", &id, &expected) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (mapped == NULL)
+			return yadsl_tester_return_external_value("no mapped file");
+		graph_io_ret = yadsl_graphio_mapped_vertex_flag_get(mapped, id, &actual);
+		if (graph_io_ret == YADSL_GRAPHIO_RET_OK && actual != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "textfile")) {
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		file_ptr = fopen(buffer, "w");
+		if (file_ptr == NULL)
+			return YADSL_TESTER_RET_FILE;
+		fclose(file_ptr);
+		if (!yadsl_testerutils_add_tempfile_to_list(buffer))
+			return YADSL_TESTER_RET_MALLOC;
+	} else if (yadsl_testerutils_match(command, "textline")) {
+		if (yadsl_tester_parse_arguments("ss", buffer, buffer2) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		file_ptr = fopen(buffer, "a");
+		if (file_ptr == NULL)
+			return YADSL_TESTER_RET_FILE;
+		if (fprintf(file_ptr, "%s\n", buffer2) < 0) {
+			fclose(file_ptr);
+			return YADSL_TESTER_RET_FILE;
+		}
+		fclose(file_ptr);
+	} else if (yadsl_testerutils_match(command, "import")) {
+		yadsl_GraphIoImportParams params;
+		yadsl_GraphHandle* temp;
+		if (yadsl_tester_parse_arguments("ssss", buffer, buffer2, buffer3, buffer4) != 4)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (yadsl_testerutils_match(buffer, "EDGELIST"))
+			params.format = YADSL_GRAPHIO_IMPORT_FORMAT_EDGE_LIST;
+		else if (yadsl_testerutils_match(buffer, "MTX"))
+			params.format = YADSL_GRAPHIO_IMPORT_FORMAT_MATRIX_MARKET;
+		else if (yadsl_testerutils_match(buffer, "DIMACS"))
+			params.format = YADSL_GRAPHIO_IMPORT_FORMAT_DIMACS;
+		else
+			return YADSL_TESTER_RET_ARGUMENT;
+		params.is_directed = yadsl_testerutils_match(buffer2, "DIRECTED");
+		if (!parse_weight_type(buffer3, &params.weight_type))
+			return YADSL_TESTER_RET_ARGUMENT;
+		params.create_vertex_func = gen_vertex_func;
+		params.create_edge_func = gen_edge_func;
+		params.arg = NULL;
+		file_ptr = fopen(buffer4, "r");
+		if (file_ptr == NULL)
+			return YADSL_TESTER_RET_FILE;
+		graph_io_ret = yadsl_graphio_import(file_ptr, &params, compare_strings_func, free, compare_strings_func, free, &temp);
+		if (graph_io_ret == YADSL_GRAPHIO_RET_OK) {
+			yadsl_graph_destroy(graph);
+			graph = temp;
+		} else if (graph_io_ret == YADSL_GRAPHIO_RET_CREATION_FAILURE) {
+			graph_io_ret = YADSL_GRAPHIO_RET_MEMORY; /* Objects are only created with malloc */
+		}
+		fclose(file_ptr);
+	} else {
+		return YADSL_TESTER_RET_COUNT;
+	}
+	return convert_graph_io_ret(graph_io_ret);
+}
+
+static void visit_vertex_func(void* vertex)
+{
+	printf("%s was visited\n", (char*) vertex);
+}
+
+static void visit_edge_func(void* source, void* edge, void* dest)
+{
+	printf("%s was visited (%s -> %s)\n", (char*) edge, (char*) source, (char*) dest);
+}
+
+typedef struct
+{
+	size_t vertex_count;
+	size_t edge_count;
+}
+SearchCounter;
+
+static void count_vertex_func(void* ctx, void* vertex)
+{
+	++((SearchCounter*) ctx)->vertex_count;
+}
+
+static void count_edge_func(void* ctx, void* source, void* edge, void* dest)
+{
+	++((SearchCounter*) ctx)->edge_count;
+}
+
+static int compare_string_ptrs_func(const void* a, const void* b)
+{
+	return strcmp(*(char* const*) a, *(char* const*) b);
+}
+
+/* Vertices of each level are appended in alphabetical order,
+ * since neighbour order is unspecified */
+static void append_level_func(void* ctx, size_t depth, const yadsl_GraphSearchBfsTriple* triples, size_t count)
+{
+	char* names[64];
+	size_t* length_ptr = (size_t*) ctx, i;
+	if (count > sizeof(names) / sizeof(*names))
+		count = sizeof(names) / sizeof(*names);
+	for (i = 0; i < count; ++i)
+		names[i] = (char*) triples[i].child;
+	qsort(names, count, sizeof(*names), compare_string_ptrs_func);
+	for (i = 0; i < count; ++i)
+		*length_ptr += sprintf(buffer2 + *length_ptr, "%s%s",
+			i ? "," : (depth ? "|" : ""), names[i]);
+}
+
+static char* vertex_name_by_id(size_t id)
+{
+	yadsl_GraphVertexObject* vertex;
+	if (yadsl_graph_vertex_by_id_get(graph, id, &vertex))
+		return "?";
+	return (char*) vertex;
+}
+
+static void append_vertex_id_func(void* ctx, size_t vertex)
+{
+	size_t* length_ptr = (size_t*) ctx;
+	*length_ptr += sprintf(buffer2 + *length_ptr, "%s%s",
+		*length_ptr && buffer2[*length_ptr - 1] != '>' ? "," : "", vertex_name_by_id(vertex));
+}
+
+static void append_edge_id_func(void* ctx, size_t source, size_t dest)
+{
+	size_t* length_ptr = (size_t*) ctx;
+	*length_ptr += sprintf(buffer2 + *length_ptr, ",%s>", vertex_name_by_id(source));
+}
+
+/* Same format as append_level_func, with the initial vertex marked
+ * by ! if it has a parent */
+static void append_level_id_func(void* ctx, size_t depth, const size_t* parents, const size_t* vertices, size_t count)
+{
+	char* names[64];
+	size_t* length_ptr = (size_t*) ctx, i;
+	if (depth == 0 && parents[0] != YADSL_GRAPHSEARCH_NONE)
+		*length_ptr += sprintf(buffer2 + *length_ptr, "!");
+	if (count > sizeof(names) / sizeof(*names))
+		count = sizeof(names) / sizeof(*names);
+	for (i = 0; i < count; ++i)
+		names[i] = vertex_name_by_id(vertices[i]);
+	qsort(names, count, sizeof(*names), compare_string_ptrs_func);
+	for (i = 0; i < count; ++i)
+		*length_ptr += sprintf(buffer2 + *length_ptr, "%s%s",
+			i ? "," : (depth ? "|" : ""), names[i]);
+}
+
+/* Keeps the visited array between searches, unless the number
+ * of vertices changes */
+static bool reserve_visited_ids(size_t vertex_count)
+{
+	if (vertex_count == visited_id_count && visited_ids)
+		return true;
+	if (visited_ids)
+		free(visited_ids);
+	visited_ids = NULL;
+	visited_id_count = 0;
+	if (!(visited_ids = calloc(vertex_count ? vertex_count : 1, sizeof(*visited_ids))))
+		return false;
+	visited_id_count = vertex_count;
+	return true;
+}
+
+static void clear_seed_results()
+{
+	if (seed_distances)
+		free(seed_distances);
+	if (nearest_seeds)
+		free(nearest_seeds);
+	seed_distances = NULL;
+	nearest_seeds = NULL;
+	seed_vertex_count = 0;
+}
+
+static bool reserve_centralities(size_t vertex_count)
+{
+	if (centralities)
+		free(centralities);
+	centralities = NULL;
+	centrality_vertex_count = vertex_count;
+	if (vertex_count == 0)
+		return true;
+	centralities = malloc(vertex_count * sizeof(*centralities));
+	return centralities != NULL;
+}
+
+static yadsl_TesterRet parse_graph_search_command(const char* command)
+{
+	yadsl_GraphSearchRet graph_search_ret = YADSL_GRAPHSEARCH_RET_OK;
+	int flag;
+	if (yadsl_testerutils_match(command, "dfs")) {
+		if (yadsl_tester_parse_arguments("si", buffer, &flag) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_search_ret = yadsl_graphsearch_dfs(graph, buffer, flag, visit_vertex_func, visit_edge_func);
+	} else if (yadsl_testerutils_match(command, "bfs")) {
+		if (yadsl_tester_parse_arguments("si", buffer, &flag) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		graph_search_ret = yadsl_graphsearch_bfs(graph, buffer, flag, visit_vertex_func, visit_edge_func);
+	} else if (yadsl_testerutils_match(command, "dfscount") || yadsl_testerutils_match(command, "bfscount")) {
+		SearchCounter counter = { 0, 0 };
+		size_t expected;
+		if (yadsl_tester_parse_arguments("siz", buffer, &flag, &expected) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (yadsl_testerutils_match(command, "dfscount"))
+			graph_search_ret = yadsl_graphsearch_dfs_ctx(graph, buffer, flag, count_vertex_func, count_edge_func, &counter);
+		else
+			graph_search_ret = yadsl_graphsearch_bfs_ctx(graph, buffer, flag, count_vertex_func, count_edge_func, &counter);
+		if (graph_search_ret == YADSL_GRAPHSEARCH_RET_OK)
+			if (counter.vertex_count != expected || counter.edge_count + 1 != expected)
+				return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "bfslevels")) {
+		size_t length = 0;
+		if (yadsl_tester_parse_arguments("sis", buffer, &flag, buffer3) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		buffer2[0] = '\0';
+		graph_search_ret = yadsl_graphsearch_bfs_batch(graph, buffer, flag, append_level_func, &length);
+		if (graph_search_ret == YADSL_GRAPHSEARCH_RET_OK && strcmp(buffer2, buffer3))
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "bfsmulti") ||
+		yadsl_testerutils_match(command, "mappedbfsmulti")) {
+		bool is_mapped = yadsl_testerutils_match(command, "mappedbfsmulti");
+		size_t vertex_count, seed_count = 0, max_depth, id;
+		size_t* seeds = NULL;
+		char* name;
+		if (yadsl_tester_parse_arguments("ss", buffer, buffer2) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (yadsl_testerutils_match(buffer2, "inf"))
+			max_depth = YADSL_GRAPHSEARCH_DISTANCE_INFINITE;
+		else if (sscanf(buffer2, "%zu", &max_depth) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (is_mapped && mapped == NULL)
+			return yadsl_tester_return_external_value("no mapped file");
+		clear_seed_results();
+		/* Seeds are named after the vertices of the graph */
+		if (is_mapped)
+			yadsl_graphio_mapped_vertex_count_get(mapped, &vertex_count);
+		else if (yadsl_graph_vertex_count_get(graph, &vertex_count))
+			return YADSL_TESTER_RET_RETURN;
+		if (vertex_count > 0) {
+			if (!(seed_distances = malloc(vertex_count * sizeof(*seed_distances))) ||
+				!(nearest_seeds = malloc(vertex_count * sizeof(*nearest_seeds))) ||
+				!(seeds = malloc(vertex_count * sizeof(*seeds)))) {
+				clear_seed_results();
+				return YADSL_TESTER_RET_MALLOC;
+			}
+		}
+		for (name = strtok(buffer, ","); name; name = strtok(NULL, ",")) {
+			/* Unknown vertices are passed as invalid ids */
+			if (yadsl_graph_vertex_id_get(graph, name, &id))
+				id = vertex_count;
+			if (seed_count < vertex_count)
+				seeds[seed_count++] = id;
+		}
+		if (is_mapped)
+			graph_search_ret = yadsl_graphsearch_bfs_multi_mapped(mapped, seeds, seed_count,
+				max_depth, seed_distances, nearest_seeds);
+		else
+			graph_search_ret = yadsl_graphsearch_bfs_multi(graph, seeds, seed_count,
+				max_depth, seed_distances, nearest_seeds);
+		if (seeds)
+			free(seeds);
+		if (graph_search_ret == YADSL_GRAPHSEARCH_RET_OK)
+			seed_vertex_count = vertex_count;
+	} else if (yadsl_testerutils_match(command, "seeddistance")) {
+		size_t id, expected;
+		if (yadsl_tester_parse_arguments("ss", buffer, buffer2) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (yadsl_testerutils_match(buffer2, "inf"))
+			expected = YADSL_GRAPHSEARCH_DISTANCE_INFINITE;
+		else if (sscanf(buffer2, "%zu", &expected) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (yadsl_graph_vertex_id_get(graph, buffer, &id) || id >= seed_vertex_count)
+			return yadsl_tester_return_external_value("does not contain vertex");
+		if (seed_distances[id] != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "nearestseed")) {
+		size_t id;
+		char* seed;
+		if (yadsl_tester_parse_arguments("ss", buffer, buffer2) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (yadsl_graph_vertex_id_get(graph, buffer, &id) || id >= seed_vertex_count)
+			return yadsl_tester_return_external_value("does not contain vertex");
+		if (nearest_seeds[id] == YADSL_GRAPHSEARCH_NONE) {
+			if (strcmp(buffer2, "-"))
+				return YADSL_TESTER_RET_RETURN;
+		} else {
+			if (yadsl_graph_vertex_by_id_get(graph, nearest_seeds[id], (yadsl_GraphVertexObject**) &seed))
+				return YADSL_TESTER_RET_RETURN;
+			if (strcmp(buffer2, seed))
+				return YADSL_TESTER_RET_RETURN;
+		}
+	} else if (yadsl_testerutils_match(command, "betweenness") ||
+		yadsl_testerutils_match(command, "mappedbetweenness")) {
+		bool is_mapped = yadsl_testerutils_match(command, "mappedbetweenness");
+		size_t vertex_count;
+		if (is_mapped && mapped == NULL)
+			return yadsl_tester_return_external_value("no mapped file");
+		if (is_mapped)
+			yadsl_graphio_mapped_vertex_count_get(mapped, &vertex_count);
+		else if (yadsl_graph_vertex_count_get(graph, &vertex_count))
+			return YADSL_TESTER_RET_RETURN;
+		if (!reserve_centralities(vertex_count))
+			return YADSL_TESTER_RET_MALLOC;
+		if (is_mapped)
+			graph_search_ret = yadsl_graphsearch_betweenness_mapped(mapped, centralities);
+		else
+			graph_search_ret = yadsl_graphsearch_betweenness(graph, centralities);
+	} else if (yadsl_testerutils_match(command, "betweennesssampled") ||
+		yadsl_testerutils_match(command, "mappedbetweennesssampled")) {
+		bool is_mapped = yadsl_testerutils_match(command, "mappedbetweennesssampled");
+		size_t vertex_count, sample_count;
+		if (yadsl_tester_parse_arguments("zi", &sample_count, &flag) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (is_mapped && mapped == NULL)
+			return yadsl_tester_return_external_value("no mapped file");
+		if (is_mapped)
+			yadsl_graphio_mapped_vertex_count_get(mapped, &vertex_count);
+		else if (yadsl_graph_vertex_count_get(graph, &vertex_count))
+			return YADSL_TESTER_RET_RETURN;
+		if (!reserve_centralities(vertex_count))
+			return YADSL_TESTER_RET_MALLOC;
+		if (is_mapped)
+			graph_search_ret = yadsl_graphsearch_betweenness_sampled_mapped(mapped,
+				sample_count, (unsigned long) flag, centralities);
+		else
+			graph_search_ret = yadsl_graphsearch_betweenness_sampled(graph,
+				sample_count, (unsigned long) flag, centralities);
+	} else if (yadsl_testerutils_match(command, "dfsids") ||
+		yadsl_testerutils_match(command, "bfsids") ||
+		yadsl_testerutils_match(command, "bfsidslevels") ||
+		yadsl_testerutils_match(command, "mappeddfsids") ||
+		yadsl_testerutils_match(command, "mappedbfsids") ||
+		yadsl_testerutils_match(command, "mappedbfsidslevels")) {
+		bool is_mapped = yadsl_testerutils_match(command, "mappeddfsids") ||
+			yadsl_testerutils_match(command, "mappedbfsids") ||
+			yadsl_testerutils_match(command, "mappedbfsidslevels");
+		bool is_dfs = yadsl_testerutils_match(command, "dfsids") ||
+			yadsl_testerutils_match(command, "mappeddfsids");
+		bool is_levels = yadsl_testerutils_match(command, "bfsidslevels") ||
+			yadsl_testerutils_match(command, "mappedbfsidslevels");
+		yadsl_GraphSearchAdjacencyHandle* adj;
+		size_t vertex_count, id, length = 0;
+		if (yadsl_tester_parse_arguments("ss", buffer, buffer3) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (is_mapped && mapped == NULL)
+			return yadsl_tester_return_external_value("no mapped file");
+		if (is_mapped)
+			adj = yadsl_graphsearch_adjacency_create_mapped(mapped);
+		else
+			adj = yadsl_graphsearch_adjacency_create(graph);
+		if (adj == NULL)
+			return YADSL_TESTER_RET_MALLOC;
+		yadsl_graphsearch_adjacency_vertex_count_get(adj, &vertex_count);
+		if (!reserve_visited_ids(vertex_count)) {
+			yadsl_graphsearch_adjacency_destroy(adj);
+			return YADSL_TESTER_RET_MALLOC;
+		}
+		/* Unknown vertices are passed as invalid ids */
+		if (yadsl_graph_vertex_id_get(graph, buffer, &id))
+			id = vertex_count;
+		buffer2[0] = '\0';
+		if (is_dfs)
+			graph_search_ret = yadsl_graphsearch_dfs_ids(adj, id, visited_ids,
+				append_vertex_id_func, append_edge_id_func, &length);
+		else if (!is_levels)
+			graph_search_ret = yadsl_graphsearch_bfs_ids(adj, id, visited_ids,
+				append_vertex_id_func, append_edge_id_func, &length);
+		else
+			graph_search_ret = yadsl_graphsearch_bfs_ids_batch(adj, id, visited_ids,
+				append_level_id_func, &length);
+		yadsl_graphsearch_adjacency_destroy(adj);
+		if (graph_search_ret == YADSL_GRAPHSEARCH_RET_OK && strcmp(buffer2, buffer3))
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "unvisitids")) {
+		size_t id;
+		for (id = 0; id < visited_id_count; ++id)
+			visited_ids[id] = false;
+	} else if (yadsl_testerutils_match(command, "centrality")) {
+		size_t id;
+		float expected;
+		double difference;
+		if (yadsl_tester_parse_arguments("sf", buffer, &expected) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (yadsl_graph_vertex_id_get(graph, buffer, &id) || id >= centrality_vertex_count)
+			return yadsl_tester_return_external_value("does not contain vertex");
+		difference = centralities[id] - expected;
+		if (difference > 1e-4 || difference < -1e-4)
+			return YADSL_TESTER_RET_RETURN;
+	} else {
+		return YADSL_TESTER_RET_COUNT;
+	}
+	return convert_graph_search_ret(graph_search_ret);
+}
+
+/**
+ * Here the YADSL_TESTER_RET_COUNT is being used as a flag to indicate that
+ * the command is not of a certain type, since it is never used truly for
+ * testing purposes. 
+*/
+yadsl_TesterRet yadsl_tester_parse(const char* command)
+{
+	yadsl_TesterRet ret;
+	if ((ret = parse_graph_command(command)) != YADSL_TESTER_RET_COUNT)
+		return ret;
+	if ((ret = parse_graph_csr_command(command)) != YADSL_TESTER_RET_COUNT)
+		return ret;
+	if ((ret = parse_graph_color_command(command)) != YADSL_TESTER_RET_COUNT)
+		return ret;
+	if ((ret = parse_graph_flow_command(command)) != YADSL_TESTER_RET_COUNT)
+		return ret;
+	if ((ret = parse_graph_apsp_command(command)) != YADSL_TESTER_RET_COUNT)
+		return ret;
+	if ((ret = parse_graph_walk_command(command)) != YADSL_TESTER_RET_COUNT)
+		return ret;
+	if ((ret = parse_graph_gen_command(command)) != YADSL_TESTER_RET_COUNT)
+		return ret;
+	if ((ret = parse_graph_io_command(command)) != YADSL_TESTER_RET_COUNT)
+		return ret;
+	if ((ret = parse_graph_search_command(command)) != YADSL_TESTER_RET_COUNT)
+		return ret;
+	return YADSL_TESTER_RET_COMMAND;
+}
+
+yadsl_TesterRet yadsl_tester_release()
+{
+	yadsl_testerutils_clear_tempfile_list();
+
+	if (graph)
+		yadsl_graph_destroy(graph);
+
+	yadsl_graphcsr_destroy(csr);
+
+	yadsl_graphwalk_destroy(walker);
+
+	yadsl_graphio_compressed_close(compressed);
+
+	yadsl_graphio_mapped_close(mapped);
+
+	if (colors)
+		free(colors);
+
+	clear_flow_results();
+
+	if (distances)
+		free(distances);
+
+	if (centralities)
+		free(centralities);
+
+	clear_seed_results();
+
+	if (visited_ids)
+		free(visited_ids);
+
+	clear_build_lists();
+
+#ifdef YADSL_DEBUG
+	if (yadsl_graphsearch_get_node_ref_count())
+		return YADSL_TESTER_RET_MEMLEAK;
+#endif
+
+	return YADSL_TESTER_RET_OK;
+}
+
+int compare_strings_func(void* a, void* b)
+{
+	return strcmp((char*) a, (char*) b) == 0;
+}
+
+int read_string_func(FILE* fp, void** vertex_ptr)
+{
+	char* str = yadsl_testerutils_str_deserialize(fp);
+	
+	if (str == NULL)
+		string_duplicate_failed = true;
+	else
+		*vertex_ptr = str;
+
+	return str == NULL;
+}
+
+int write_string_func(FILE* fp, void* v)
+{
+	return yadsl_testerutils_str_serialize(fp, (char*) v);
+}
+
+int write_string_to_kept_file_func(FILE* fp, void* v)
+{
+	if (fp != written_file_ptr)
+		is_written_file_kept = false;
+	return yadsl_testerutils_str_serialize(fp, (char*) v);
+}
+
+void record_progress_func(size_t written_count, size_t total_count, void* arg)
+{
+	if (written_count < progress_written_count || (progress_call_count > 0 && total_count != progress_total_count))
+		is_progress_monotonic = false;
+	++progress_call_count;
+	progress_written_count = written_count;
+	progress_total_count = total_count;
+}
+
+yadsl_TesterRet convert_graph_ret(yadsl_GraphRet graphId)
+{
+	switch (graphId) {
+	case YADSL_GRAPH_RET_OK:
+		return YADSL_TESTER_RET_OK;
+	case YADSL_GRAPH_RET_EMPTY:
+		return yadsl_tester_return_external_value("empty");
+	case YADSL_GRAPH_RET_CONTAINS_VERTEX:
+		return yadsl_tester_return_external_value("contains vertex");
+	case YADSL_GRAPH_RET_DOES_NOT_CONTAIN_VERTEX:
+		return yadsl_tester_return_external_value("does not contain vertex");
+	case YADSL_GRAPH_RET_CONTAINS_EDGE:
+		return yadsl_tester_return_external_value("contains edge");
+	case YADSL_GRAPH_RET_DOES_NOT_CONTAIN_EDGE:
+		return yadsl_tester_return_external_value("does not contain edge");
+	case YADSL_GRAPH_RET_MEMORY:
+		return YADSL_TESTER_RET_MALLOC;
+	case YADSL_GRAPH_RET_PARAMETER:
+		return yadsl_tester_return_external_value("parameter");
+	default:
+		return yadsl_tester_return_external_value("unknown");
+	}
+}
+
+yadsl_TesterRet convert_graph_apsp_ret(yadsl_GraphApspRet graphApspId)
+{
+	switch (graphApspId) {
+	case YADSL_GRAPHAPSP_RET_OK:
+		return YADSL_TESTER_RET_OK;
+	case YADSL_GRAPHAPSP_RET_PARAMETER:
+		return yadsl_tester_return_external_value("parameter");
+	case YADSL_GRAPHAPSP_RET_NEGATIVE_CYCLE:
+		return yadsl_tester_return_external_value("negative cycle");
+	default:
+		return yadsl_tester_return_external_value("unknown");
+	}
+}
+
+yadsl_TesterRet convert_graph_attr_ret(yadsl_GraphAttrRet graphAttrId)
+{
+	switch (graphAttrId) {
+	case YADSL_GRAPHATTR_RET_OK:
+		return YADSL_TESTER_RET_OK;
+	case YADSL_GRAPHATTR_RET_MEMORY:
+		return YADSL_TESTER_RET_MALLOC;
+	case YADSL_GRAPHATTR_RET_EXISTS:
+		return yadsl_tester_return_external_value("exists");
+	case YADSL_GRAPHATTR_RET_DOES_NOT_EXIST:
+		return yadsl_tester_return_external_value("does not exist");
+	default:
+		return yadsl_tester_return_external_value("unknown");
+	}
+}
+
+yadsl_TesterRet convert_graph_color_ret(yadsl_GraphColorRet graphColorId)
+{
+	switch (graphColorId) {
+	case YADSL_GRAPHCOLOR_RET_OK:
+		return YADSL_TESTER_RET_OK;
+	case YADSL_GRAPHCOLOR_RET_MEMORY:
+		return YADSL_TESTER_RET_MALLOC;
+	case YADSL_GRAPHCOLOR_RET_PARAMETER:
+		return yadsl_tester_return_external_value("parameter");
+	default:
+		return yadsl_tester_return_external_value("unknown");
+	}
+}
+
+yadsl_TesterRet convert_graph_csr_ret(yadsl_GraphCsrRet graphCsrId)
+{
+	switch (graphCsrId) {
+	case YADSL_GRAPHCSR_RET_OK:
+		return YADSL_TESTER_RET_OK;
+	case YADSL_GRAPHCSR_RET_MEMORY:
+		return YADSL_TESTER_RET_MALLOC;
+	case YADSL_GRAPHCSR_RET_PARAMETER:
+		return yadsl_tester_return_external_value("parameter");
+	case YADSL_GRAPHCSR_RET_CONTAINS_EDGE:
+		return yadsl_tester_return_external_value("contains edge");
+	case YADSL_GRAPHCSR_RET_DOES_NOT_CONTAIN_EDGE:
+		return yadsl_tester_return_external_value("does not contain edge");
+	case YADSL_GRAPHCSR_RET_OUT_OF_BOUNDS:
+		return yadsl_tester_return_external_value("out of bounds");
+	default:
+		return yadsl_tester_return_external_value("unknown");
+	}
+}
+
+yadsl_TesterRet convert_graph_flow_ret(yadsl_GraphFlowRet graphFlowId)
+{
+	switch (graphFlowId) {
+	case YADSL_GRAPHFLOW_RET_OK:
+		return YADSL_TESTER_RET_OK;
+	case YADSL_GRAPHFLOW_RET_MEMORY:
+		return YADSL_TESTER_RET_MALLOC;
+	case YADSL_GRAPHFLOW_RET_PARAMETER:
+		return yadsl_tester_return_external_value("parameter");
+	default:
+		return yadsl_tester_return_external_value("unknown");
+	}
+}
+
+yadsl_TesterRet convert_graph_io_ret(yadsl_GraphIoRet graphIoId)
 {
 	switch (graphIoId) {
 	case YADSL_GRAPHIO_RET_OK:
@@ -364,6 +2016,10 @@ yadsl_TesterRet convert_graph_io_ret(yadsl_GraphIoRet graphIoId)
 		return yadsl_tester_return_external_value("file error");
 	case YADSL_GRAPHIO_RET_DEPRECATED_FILE_FORMAT:
 		return yadsl_tester_return_external_value("deprecated file format");
+	case YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT:
+		return yadsl_tester_return_external_value("corrupted file format");
+	case YADSL_GRAPHIO_RET_PARAMETER:
+		return yadsl_tester_return_external_value("parameter");
 	default:
 		return yadsl_tester_return_external_value("unknown");
 	}
@@ -380,6 +2036,38 @@ yadsl_TesterRet convert_graph_search_ret(yadsl_GraphSearchRet graphSearchId)
 		return yadsl_tester_return_external_value("vertex already visited");
 	case YADSL_GRAPHSEARCH_RET_MEMORY:
 		return YADSL_TESTER_RET_MALLOC;
+	case YADSL_GRAPHSEARCH_RET_PARAMETER:
+		return yadsl_tester_return_external_value("parameter");
+	case YADSL_GRAPHSEARCH_RET_CORRUPTED_FILE_FORMAT:
+		return yadsl_tester_return_external_value("corrupted file format");
+	default:
+		return yadsl_tester_return_external_value("unknown");
+	}
+}
+
+yadsl_TesterRet convert_graph_gen_ret(yadsl_GraphGenRet graphGenId)
+{
+	switch (graphGenId) {
+	case YADSL_GRAPHGEN_RET_OK:
+		return YADSL_TESTER_RET_OK;
+	case YADSL_GRAPHGEN_RET_MEMORY:
+		return YADSL_TESTER_RET_MALLOC;
+	case YADSL_GRAPHGEN_RET_PARAMETER:
+		return yadsl_tester_return_external_value("parameter");
+	default:
+		return yadsl_tester_return_external_value("unknown");
+	}
+}
+
+yadsl_TesterRet convert_graph_walk_ret(yadsl_GraphWalkRet graphWalkId)
+{
+	switch (graphWalkId) {
+	case YADSL_GRAPHWALK_RET_OK:
+		return YADSL_TESTER_RET_OK;
+	case YADSL_GRAPHWALK_RET_MEMORY:
+		return YADSL_TESTER_RET_MALLOC;
+	case YADSL_GRAPHWALK_RET_PARAMETER:
+		return yadsl_tester_return_external_value("parameter");
 	default:
 		return yadsl_tester_return_external_value("unknown");
 	}
@@ -411,4 +2099,73 @@ bool parse_iteration_direction(const char* buffer, yadsl_GraphIterationDirection
 		return false;
 	}
 	return true;
-}
\ No newline at end of file
+}
+
+bool parse_weight_type(const char* buffer, yadsl_GraphEdgeWeightType* weight_type_ptr)
+{
+	if (yadsl_testerutils_match(buffer, "none")) {
+		*weight_type_ptr = YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE;
+	} else if (yadsl_testerutils_match(buffer, "int32")) {
+		*weight_type_ptr = YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32;
+	} else if (yadsl_testerutils_match(buffer, "int64")) {
+		*weight_type_ptr = YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT64;
+	} else if (yadsl_testerutils_match(buffer, "float")) {
+		*weight_type_ptr = YADSL_GRAPH_EDGE_WEIGHT_TYPE_FLOAT;
+	} else if (yadsl_testerutils_match(buffer, "double")) {
+		*weight_type_ptr = YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE;
+	} else {
+		yadsl_tester_log("Unknown weight type \"%s\"", buffer);
+		return false;
+	}
+	return true;
+}
+
+bool parse_weight(const char* buffer, yadsl_GraphEdgeWeight* weight_ptr)
+{
+	yadsl_GraphEdgeWeightType weight_type;
+	char* end;
+	double value = strtod(buffer, &end);
+	if (*end != '\0') {
+		yadsl_tester_log("Invalid weight \"%s\"", buffer);
+		return false;
+	}
+	if (yadsl_graph_edge_weight_type_get(graph, &weight_type))
+		return false;
+	*weight_ptr = yadsl_graph_edge_weight_from_double(weight_type, value);
+	return true;
+}
+
+bool reserve_build_array(void** array_ptr, size_t* capacity_ptr, size_t count, size_t size)
+{
+	size_t new_capacity;
+	void* new_array;
+	if (count <= *capacity_ptr)
+		return true;
+	new_capacity = *capacity_ptr ? *capacity_ptr * 2 : 8;
+	if (*array_ptr)
+		new_array = realloc(*array_ptr, new_capacity * size);
+	else
+		new_array = malloc(new_capacity * size);
+	if (new_array == NULL)
+		return false;
+	*array_ptr = new_array;
+	*capacity_ptr = new_capacity;
+	return true;
+}
+
+void clear_build_lists()
+{
+	size_t i;
+	for (i = 0; i < build_vertex_count; ++i)
+		free(build_vertices[i]);
+	for (i = 0; i < build_edge_count; ++i)
+		free(build_edges[i].item);
+	if (build_vertices)
+		free(build_vertices);
+	if (build_edges)
+		free(build_edges);
+	build_vertices = NULL;
+	build_edges = NULL;
+	build_vertex_count = build_vertex_capacity = 0;
+	build_edge_count = build_edge_capacity = 0;
+}
@@ -3,6 +3,7 @@
 
 #include <yadsl/pydefines.h>
 #include <graph/graph.h>
+#include <graphcolor/graphcolor.h>
 
 typedef struct {
     PyObject_HEAD
@@ -530,6 +531,80 @@ Graph_set_all_flags(GraphObject *self, PyObject *obj)
 	}
 }
 
+PyDoc_STRVAR(_Graph_color__doc__,
+"color(self, /, method='dsatur', seed=0) -> dict\n"
+"--\n"
+"\n"
+"Colour vertices so that no two neighbours share the same colour\n"
+"Returns a dictionary from vertex to colour (0, 1, 2...)\n"
+"Edge direction and self-loops are ignored\n"
+"  - 'greedy' colours vertices in insertion order\n"
+"  - 'dsatur' colours the most constrained vertex first\n"
+"  - 'jp' colours vertices in rounds of random priority (uses seed)\n");
+
+static PyObject *
+Graph_color(GraphObject *self, PyObject *args, PyObject *kw)
+{
+	const char *method = "dsatur";
+	unsigned long seed = 0;
+	size_t vertex_count, color_count, id;
+	size_t *colors = NULL;
+	yadsl_GraphColorRet returnId;
+	PyObject *dict = NULL, *vertex, *color;
+	static char *keywords[] = { "method", "seed", NULL };
+	if (!PyArg_ParseTupleAndKeywords(args, kw,
+		"|sk:pygraph.Graph.color", keywords, &method, &seed))
+		return NULL;
+	if (yadsl_graph_vertex_count_get(self->ob_graph, &vertex_count))
+		goto badinternalcall_exit;
+	if (vertex_count > 0 &&
+		(colors = PyMem_Malloc(vertex_count * sizeof(*colors))) == NULL) {
+		PyErr_NoMemory();
+		goto exit;
+	}
+	if (strcmp(method, "greedy") == 0)
+		returnId = yadsl_graphcolor_greedy(self->ob_graph, NULL, colors, &color_count);
+	else if (strcmp(method, "dsatur") == 0)
+		returnId = yadsl_graphcolor_dsatur(self->ob_graph, colors, &color_count);
+	else if (strcmp(method, "jp") == 0)
+		returnId = yadsl_graphcolor_jones_plassmann(self->ob_graph, seed, colors, &color_count, NULL);
+	else {
+		PyErr_Format(PyExc_ValueError, "Unknown colouring method '%s'", method);
+		goto exit;
+	}
+	switch (returnId) {
+	case YADSL_GRAPHCOLOR_RET_OK:
+		break;
+	case YADSL_GRAPHCOLOR_RET_MEMORY:
+		PyErr_NoMemory();
+		goto exit;
+	default:
+		goto badinternalcall_exit;
+	}
+	if ((dict = PyDict_New()) == NULL)
+		goto exit;
+	for (id = 0; id < vertex_count; ++id) {
+		if (yadsl_graph_vertex_by_id_get(self->ob_graph, id,
+				(yadsl_GraphVertexObject**) &vertex))
+			goto badinternalcall_exit;
+		if ((color = PyLong_FromSize_t(colors[id])) == NULL)
+			goto exit;
+		if (PyDict_SetItem(dict, vertex, color)) {
+			Py_DECREF(color);
+			goto exit;
+		}
+		Py_DECREF(color);
+	}
+	PyMem_Free(colors);
+	return dict;
+badinternalcall_exit:
+	PyErr_BadInternalCall();
+exit:
+	Py_XDECREF(dict);
+	PyMem_Free(colors);
+	return NULL;
+}
+
 PyMethodDef Graph_methods[] = {
 	//
 	// Metadata about graph
@@ -637,6 +712,15 @@ PyMethodDef Graph_methods[] = {
 		_Graph_set_all_flags__doc__
 	},
 	//
+	// Algorithms
+	//
+	{
+		"color",
+		(PyCFunction) Graph_color,
+		METH_VARARGS | METH_KEYWORDS,
+		_Graph_color__doc__
+	},
+	//
 	// Sentinel
 	//
 	{
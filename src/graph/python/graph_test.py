@@ -1,3 +1,5 @@
+import pytest
+
 from pygraph import Graph
 
 dtypes = [42, True, 'str', None]
@@ -92,4 +94,21 @@ def test_flags():
     assert g.get_flag(1) == 2
     g.set_flag(0,3)
     assert g.get_flag(0) == 3
-    assert g.get_flag(1) == 2
\ No newline at end of file
+    assert g.get_flag(1) == 2
+
+def test_color():
+    g = Graph(directed = False)
+    for i in range(5):
+        g.add_vertex(i)
+    for i in range(5):
+        g.add_edge(i, (i + 1) % 5, i)
+    for method in ('greedy', 'dsatur', 'jp'):
+        colors = g.color(method = method, seed = 3)
+        assert set(colors) == set(range(5))
+        assert len(set(colors.values())) == 3
+        for i in range(5):
+            assert colors[i] != colors[(i + 1) % 5]
+    assert g.color() == g.color(method = 'dsatur')
+    assert Graph().color() == {}
+    with pytest.raises(ValueError):
+        g.color(method = 'unknown')
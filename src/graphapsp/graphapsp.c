@@ -0,0 +1,138 @@
+#include <graphapsp/graphapsp.h>
+
+#include <assert.h>
+#include <math.h>
+
+#define YADSL_GRAPHAPSP_DEFAULT_BLOCK_SIZE 64
+
+/**********************************/
+/*  Private functions prototypes  */
+/**********************************/
+
+static void yadsl_graphapsp_block_update_internal(
+	double* distances,
+	size_t vertex_count,
+	size_t k_begin, size_t k_end,
+	size_t i_begin, size_t i_end,
+	size_t j_begin, size_t j_end);
+
+/**********************/
+/*  Public functions  */
+/**********************/
+
+yadsl_GraphApspRet yadsl_graphapsp_matrix_fill(
+	yadsl_GraphHandle* graph,
+	bool is_weighted,
+	double* distances)
+{
+	yadsl_GraphEdgeWeightType weight_type;
+	yadsl_GraphEdgeWeight weight;
+	size_t vertex_count, edge_count, id, u, v, i;
+	bool is_directed;
+	double w;
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (yadsl_graph_edge_count_get(graph, &edge_count)) assert(0);
+	if (yadsl_graph_is_directed_check(graph, &is_directed)) assert(0);
+	if (yadsl_graph_edge_weight_type_get(graph, &weight_type)) assert(0);
+	if (is_weighted && weight_type == YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE)
+		return YADSL_GRAPHAPSP_RET_PARAMETER;
+	for (i = 0; i < vertex_count * vertex_count; ++i)
+		distances[i] = INFINITY;
+	for (u = 0; u < vertex_count; ++u)
+		distances[u * vertex_count + u] = 0.0;
+	for (id = 0; id < edge_count; ++id) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+		w = is_weighted ? yadsl_graph_edge_weight_to_double(weight_type, weight) : 1.0;
+		if (w < distances[u * vertex_count + v])
+			distances[u * vertex_count + v] = w;
+		if (!is_directed && w < distances[v * vertex_count + u])
+			distances[v * vertex_count + u] = w;
+	}
+	return YADSL_GRAPHAPSP_RET_OK;
+}
+
+yadsl_GraphApspRet yadsl_graphapsp_floyd_warshall(
+	double* distances,
+	size_t vertex_count,
+	size_t block_size)
+{
+	size_t n = vertex_count, kb, ib, jb, k_end, i_end, j_end, u;
+	if (block_size == 0)
+		block_size = YADSL_GRAPHAPSP_DEFAULT_BLOCK_SIZE;
+	for (kb = 0; kb < n; kb += block_size) {
+		k_end = kb + block_size < n ? kb + block_size : n;
+		/* Diagonal tile depends only on itself */
+		yadsl_graphapsp_block_update_internal(distances, n,
+			kb, k_end, kb, k_end, kb, k_end);
+		/* Tiles in the same row or column depend on the diagonal tile */
+		for (jb = 0; jb < n; jb += block_size) {
+			if (jb == kb)
+				continue;
+			j_end = jb + block_size < n ? jb + block_size : n;
+			yadsl_graphapsp_block_update_internal(distances, n,
+				kb, k_end, kb, k_end, jb, j_end);
+			yadsl_graphapsp_block_update_internal(distances, n,
+				kb, k_end, jb, j_end, kb, k_end);
+		}
+		/* Remaining tiles depend on the tiles of their row and column */
+		for (ib = 0; ib < n; ib += block_size) {
+			if (ib == kb)
+				continue;
+			i_end = ib + block_size < n ? ib + block_size : n;
+			for (jb = 0; jb < n; jb += block_size) {
+				if (jb == kb)
+					continue;
+				j_end = jb + block_size < n ? jb + block_size : n;
+				yadsl_graphapsp_block_update_internal(distances, n,
+					kb, k_end, ib, i_end, jb, j_end);
+			}
+		}
+	}
+	for (u = 0; u < n; ++u)
+		if (distances[u * n + u] < 0.0)
+			return YADSL_GRAPHAPSP_RET_NEGATIVE_CYCLE;
+	return YADSL_GRAPHAPSP_RET_OK;
+}
+
+yadsl_GraphApspRet yadsl_graphapsp_compute(
+	yadsl_GraphHandle* graph,
+	bool is_weighted,
+	double* distances)
+{
+	yadsl_GraphApspRet ret;
+	size_t vertex_count;
+	if (ret = yadsl_graphapsp_matrix_fill(graph, is_weighted, distances))
+		return ret;
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	return yadsl_graphapsp_floyd_warshall(distances, vertex_count, 0);
+}
+
+/**************************************/
+/*  Private functions implementation  */
+/**************************************/
+
+// Relaxes the tile of rows [i_begin, i_end) and columns [j_begin, j_end)
+// through the intermediate vertices [k_begin, k_end) (min-plus product)
+void yadsl_graphapsp_block_update_internal(
+	double* distances,
+	size_t vertex_count,
+	size_t k_begin, size_t k_end,
+	size_t i_begin, size_t i_end,
+	size_t j_begin, size_t j_end)
+{
+	double* row_i, * row_k, d_ik, d;
+	size_t k, i, j;
+	for (k = k_begin; k < k_end; ++k) {
+		row_k = distances + k * vertex_count;
+		for (i = i_begin; i < i_end; ++i) {
+			row_i = distances + i * vertex_count;
+			d_ik = row_i[k];
+			if (d_ik == INFINITY)
+				continue;
+			for (j = j_begin; j < j_end; ++j) {
+				d = d_ik + row_k[j];
+				row_i[j] = d < row_i[j] ? d : row_i[j];
+			}
+		}
+	}
+}
@@ -0,0 +1,96 @@
+#ifndef __YADSL_GRAPHAPSP_H__
+#define __YADSL_GRAPHAPSP_H__
+
+/**
+ * \defgroup graphapsp Graph All-Pairs Shortest Paths
+ * @brief Auxiliary module for computing distances between every pair of vertices.
+ *
+ * Distances are stored in a dense n-by-n matrix of doubles, in row-major
+ * order, where the entry at row u and column v (index u * n + v) holds the
+ * distance from vertex u to vertex v, identified by their ids (see \ref graph).
+ * Unreachable pairs have an infinite distance (INFINITY, from math.h).
+ *
+ * The Floyd-Warshall algorithm runs in O(n^3) time, over square tiles of
+ * the matrix, so that the working set of every step fits in cache. The
+ * innermost loops run over contiguous rows with no branches, so that
+ * compilers can vectorize them. Matrices of up to a few tens of thousands
+ * of vertices are practical.
+ *
+ * @{
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <graph/graph.h>
+
+/**
+ * @brief Return condition of Graph APSP functions
+*/
+typedef enum
+{
+	YADSL_GRAPHAPSP_RET_OK = 0, /**< All went ok */
+	YADSL_GRAPHAPSP_RET_PARAMETER, /**< Invalid parameter */
+	YADSL_GRAPHAPSP_RET_NEGATIVE_CYCLE, /**< Graph has a cycle of negative weight */
+}
+yadsl_GraphApspRet;
+
+/**
+ * @brief Fill a distance matrix with the edges of a graph
+ *
+ * Every entry is set to the weight of the edge between the pair, to zero
+ * in the diagonal, and to infinity otherwise. On undirected graphs, the
+ * matrix is symmetric.
+ *
+ * @param graph graph
+ * @param is_weighted whether to use the inline edge weights or, otherwise,
+ * a weight of one for every edge (so distances count hops)
+ * @param distances distance matrix, with n * n entries
+ * @return
+ * * ::YADSL_GRAPHAPSP_RET_OK, and distances is updated
+ * * ::YADSL_GRAPHAPSP_RET_PARAMETER, if is_weighted is true and graph is not weighted
+*/
+yadsl_GraphApspRet
+yadsl_graphapsp_matrix_fill(
+	yadsl_GraphHandle* graph,
+	bool is_weighted,
+	double* distances);
+
+/**
+ * @brief Turn a distance matrix into shortest distances, in place
+ * @param distances distance matrix, with vertex_count * vertex_count entries
+ * @param vertex_count number of rows (and columns) of the matrix
+ * @param block_size side of the tiles, or zero for the default
+ * @return
+ * * ::YADSL_GRAPHAPSP_RET_OK, and distances is updated
+ * * ::YADSL_GRAPHAPSP_RET_NEGATIVE_CYCLE, and distances is left unspecified
+*/
+yadsl_GraphApspRet
+yadsl_graphapsp_floyd_warshall(
+	double* distances,
+	size_t vertex_count,
+	size_t block_size);
+
+/**
+ * @brief Compute the shortest distances between every pair of vertices
+ *
+ * Same as ::yadsl_graphapsp_matrix_fill followed by
+ * ::yadsl_graphapsp_floyd_warshall with the default tile size.
+ *
+ * @param graph graph
+ * @param is_weighted whether to use the inline edge weights or to count hops
+ * @param distances distance matrix, with n * n entries
+ * @return
+ * * ::YADSL_GRAPHAPSP_RET_OK, and distances is updated
+ * * ::YADSL_GRAPHAPSP_RET_PARAMETER, if is_weighted is true and graph is not weighted
+ * * ::YADSL_GRAPHAPSP_RET_NEGATIVE_CYCLE, and distances is left unspecified
+*/
+yadsl_GraphApspRet
+yadsl_graphapsp_compute(
+	yadsl_GraphHandle* graph,
+	bool is_weighted,
+	double* distances);
+
+/** @} */
+
+#endif
@@ -0,0 +1,822 @@
+#include <graphattr/graphattr.h>
+
+#include <assert.h>
+#include <string.h>
+
+#ifdef YADSL_DEBUG
+#include <memdb/memdb.h>
+#else
+#include <stdlib.h>
+#endif
+
+#include <string/string.h>
+
+/* Row capacity is always a multiple of the bitset word size */
+#define YADSL_GRAPHATTR_WORD_BITS 64
+#define YADSL_GRAPHATTR_MIN_CAPACITY YADSL_GRAPHATTR_WORD_BITS
+#define YADSL_GRAPHATTR_POOL_MIN_SIZE 16
+
+/**
+ * @brief Set of unique strings owned by a string column
+*/
+typedef struct
+{
+	char** slots; /**< open addressing table (NULL means free slot) */
+	size_t size; /**< number of slots (power of two) */
+	size_t count; /**< number of strings */
+}
+yadsl_GraphAttrStringPool;
+
+typedef struct yadsl_GraphAttrTable_s yadsl_GraphAttrTable;
+
+typedef struct yadsl_GraphAttrColumn_s
+{
+	struct yadsl_GraphAttrColumn_s* next; /**< next column in table */
+	yadsl_GraphAttrTable* table; /**< table that owns the column */
+	char* name; /**< column name */
+	yadsl_GraphAttrType type; /**< column type */
+	union
+	{
+		int64_t* i64;
+		double* f64;
+		uint64_t* words;
+		const char** str;
+		void* ptr;
+	} data; /**< row values (row capacity long) */
+	yadsl_GraphAttrStringPool pool; /**< interned strings (string columns only) */
+}
+yadsl_GraphAttrColumn;
+
+struct yadsl_GraphAttrTable_s
+{
+	yadsl_GraphAttrColumn* columns; /**< linked list of columns */
+	size_t row_count; /**< number of rows */
+	size_t row_capacity; /**< number of rows allocated in every column */
+};
+
+#define cast_table_(x) yadsl_GraphAttrTable* x ## _ = (yadsl_GraphAttrTable*) x
+#define cast_column_(x) yadsl_GraphAttrColumn* x ## _ = (yadsl_GraphAttrColumn*) x
+
+/* Private functions prototypes */
+
+static size_t yadsl_graphattr_data_size_internal(
+	yadsl_GraphAttrType type,
+	size_t row_capacity);
+
+static void yadsl_graphattr_row_clear_internal(
+	yadsl_GraphAttrColumn* column,
+	size_t row);
+
+static void yadsl_graphattr_row_copy_internal(
+	yadsl_GraphAttrColumn* column,
+	size_t to,
+	size_t from);
+
+static yadsl_GraphAttrRet yadsl_graphattr_column_check_internal(
+	yadsl_GraphAttrColumn* column,
+	yadsl_GraphAttrType type,
+	size_t row);
+
+static void yadsl_graphattr_column_destroy_internal(
+	yadsl_GraphAttrColumn* column);
+
+static const char* yadsl_graphattr_pool_find_internal(
+	yadsl_GraphAttrStringPool* pool,
+	const char* str);
+
+static yadsl_GraphAttrRet yadsl_graphattr_pool_intern_internal(
+	yadsl_GraphAttrStringPool* pool,
+	const char* str,
+	const char** interned_ptr);
+
+static void yadsl_graphattr_pool_destroy_internal(
+	yadsl_GraphAttrStringPool* pool);
+
+/* Public functions */
+
+yadsl_GraphAttrTableHandle* yadsl_graphattr_table_create(
+	size_t row_count)
+{
+	yadsl_GraphAttrTable* table = malloc(sizeof(*table));
+	if (table) {
+		table->columns = NULL;
+		table->row_count = row_count;
+		table->row_capacity = 0;
+	}
+	return table;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_row_count_get(
+	yadsl_GraphAttrTableHandle* table,
+	size_t* row_count_ptr)
+{
+	cast_table_(table);
+	*row_count_ptr = table_->row_count;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_row_add(
+	yadsl_GraphAttrTableHandle* table)
+{
+	yadsl_GraphAttrColumn* column;
+	size_t new_capacity;
+	void* new_data;
+	cast_table_(table);
+	if (table_->row_count == table_->row_capacity && table_->columns) {
+		new_capacity = table_->row_capacity ?
+			table_->row_capacity * 2 : YADSL_GRAPHATTR_MIN_CAPACITY;
+		/* Columns that were already grown keep their larger buffers
+		 * if a later one fails, which does no harm */
+		for (column = table_->columns; column; column = column->next) {
+			size_t size = yadsl_graphattr_data_size_internal(column->type, new_capacity);
+			new_data = column->data.ptr ? realloc(column->data.ptr, size) : malloc(size);
+			if (new_data == NULL)
+				return YADSL_GRAPHATTR_RET_MEMORY;
+			column->data.ptr = new_data;
+		}
+		table_->row_capacity = new_capacity;
+	}
+	for (column = table_->columns; column; column = column->next)
+		yadsl_graphattr_row_clear_internal(column, table_->row_count);
+	++table_->row_count;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_row_remove(
+	yadsl_GraphAttrTableHandle* table,
+	size_t row)
+{
+	yadsl_GraphAttrColumn* column;
+	size_t last;
+	cast_table_(table);
+	if (row >= table_->row_count)
+		return YADSL_GRAPHATTR_RET_PARAMETER;
+	last = --table_->row_count;
+	if (row != last)
+		for (column = table_->columns; column; column = column->next)
+			yadsl_graphattr_row_copy_internal(column, row, last);
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_column_add(
+	yadsl_GraphAttrTableHandle* table,
+	const char* name,
+	yadsl_GraphAttrType type,
+	yadsl_GraphAttrColumnHandle** column_ptr)
+{
+	yadsl_GraphAttrColumn* column;
+	size_t capacity;
+	cast_table_(table);
+	switch (type) {
+	case YADSL_GRAPHATTR_TYPE_INT64:
+	case YADSL_GRAPHATTR_TYPE_DOUBLE:
+	case YADSL_GRAPHATTR_TYPE_BOOL:
+	case YADSL_GRAPHATTR_TYPE_STRING:
+		break;
+	default:
+		return YADSL_GRAPHATTR_RET_PARAMETER;
+	}
+	if (yadsl_graphattr_column_get(table, name, NULL) == YADSL_GRAPHATTR_RET_OK)
+		return YADSL_GRAPHATTR_RET_EXISTS;
+	capacity = table_->row_capacity;
+	if (capacity < table_->row_count) {
+		/* First column of a table created with rows */
+		capacity = YADSL_GRAPHATTR_MIN_CAPACITY;
+		while (capacity < table_->row_count)
+			capacity *= 2;
+	}
+	column = malloc(sizeof(*column));
+	if (column == NULL)
+		return YADSL_GRAPHATTR_RET_MEMORY;
+	if ((column->name = yadsl_string_duplicate(name)) == NULL) {
+		free(column);
+		return YADSL_GRAPHATTR_RET_MEMORY;
+	}
+	column->data.ptr = NULL;
+	if (capacity > 0) {
+		column->data.ptr = calloc(1, yadsl_graphattr_data_size_internal(type, capacity));
+		if (column->data.ptr == NULL) {
+			free(column->name);
+			free(column);
+			return YADSL_GRAPHATTR_RET_MEMORY;
+		}
+	}
+	column->type = type;
+	if (type == YADSL_GRAPHATTR_TYPE_STRING) {
+		/* All-zero bits are not guaranteed to be a NULL pointer */
+		size_t i;
+		for (i = 0; i < table_->row_count; ++i)
+			column->data.str[i] = NULL;
+	}
+	column->table = table_;
+	column->pool.slots = NULL;
+	column->pool.size = 0;
+	column->pool.count = 0;
+	column->next = table_->columns;
+	table_->columns = column;
+	table_->row_capacity = capacity;
+	if (column_ptr)
+		*column_ptr = column;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_column_get(
+	yadsl_GraphAttrTableHandle* table,
+	const char* name,
+	yadsl_GraphAttrColumnHandle** column_ptr)
+{
+	yadsl_GraphAttrColumn* column;
+	cast_table_(table);
+	for (column = table_->columns; column; column = column->next) {
+		if (!strcmp(column->name, name)) {
+			if (column_ptr)
+				*column_ptr = column;
+			return YADSL_GRAPHATTR_RET_OK;
+		}
+	}
+	return YADSL_GRAPHATTR_RET_DOES_NOT_EXIST;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_column_remove(
+	yadsl_GraphAttrTableHandle* table,
+	const char* name)
+{
+	yadsl_GraphAttrColumn** column_ptr, * column;
+	cast_table_(table);
+	for (column_ptr = &table_->columns; *column_ptr; column_ptr = &(*column_ptr)->next) {
+		column = *column_ptr;
+		if (!strcmp(column->name, name)) {
+			*column_ptr = column->next;
+			yadsl_graphattr_column_destroy_internal(column);
+			return YADSL_GRAPHATTR_RET_OK;
+		}
+	}
+	return YADSL_GRAPHATTR_RET_DOES_NOT_EXIST;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_column_type_get(
+	yadsl_GraphAttrColumnHandle* column,
+	yadsl_GraphAttrType* type_ptr)
+{
+	cast_column_(column);
+	*type_ptr = column_->type;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_int64_get(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	int64_t* value_ptr)
+{
+	yadsl_GraphAttrRet ret;
+	cast_column_(column);
+	if (ret = yadsl_graphattr_column_check_internal(column_, YADSL_GRAPHATTR_TYPE_INT64, row))
+		return ret;
+	*value_ptr = column_->data.i64[row];
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_int64_set(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	int64_t value)
+{
+	yadsl_GraphAttrRet ret;
+	cast_column_(column);
+	if (ret = yadsl_graphattr_column_check_internal(column_, YADSL_GRAPHATTR_TYPE_INT64, row))
+		return ret;
+	column_->data.i64[row] = value;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_double_get(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	double* value_ptr)
+{
+	yadsl_GraphAttrRet ret;
+	cast_column_(column);
+	if (ret = yadsl_graphattr_column_check_internal(column_, YADSL_GRAPHATTR_TYPE_DOUBLE, row))
+		return ret;
+	*value_ptr = column_->data.f64[row];
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_double_set(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	double value)
+{
+	yadsl_GraphAttrRet ret;
+	cast_column_(column);
+	if (ret = yadsl_graphattr_column_check_internal(column_, YADSL_GRAPHATTR_TYPE_DOUBLE, row))
+		return ret;
+	column_->data.f64[row] = value;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_bool_get(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	bool* value_ptr)
+{
+	yadsl_GraphAttrRet ret;
+	cast_column_(column);
+	if (ret = yadsl_graphattr_column_check_internal(column_, YADSL_GRAPHATTR_TYPE_BOOL, row))
+		return ret;
+	*value_ptr = (column_->data.words[row / YADSL_GRAPHATTR_WORD_BITS] >>
+		(row % YADSL_GRAPHATTR_WORD_BITS)) & 1;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_bool_set(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	bool value)
+{
+	yadsl_GraphAttrRet ret;
+	uint64_t mask;
+	cast_column_(column);
+	if (ret = yadsl_graphattr_column_check_internal(column_, YADSL_GRAPHATTR_TYPE_BOOL, row))
+		return ret;
+	mask = (uint64_t) 1 << (row % YADSL_GRAPHATTR_WORD_BITS);
+	if (value)
+		column_->data.words[row / YADSL_GRAPHATTR_WORD_BITS] |= mask;
+	else
+		column_->data.words[row / YADSL_GRAPHATTR_WORD_BITS] &= ~mask;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_string_get(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	const char** value_ptr)
+{
+	yadsl_GraphAttrRet ret;
+	cast_column_(column);
+	if (ret = yadsl_graphattr_column_check_internal(column_, YADSL_GRAPHATTR_TYPE_STRING, row))
+		return ret;
+	*value_ptr = column_->data.str[row];
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_string_set(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	const char* value)
+{
+	yadsl_GraphAttrRet ret;
+	const char* interned = NULL;
+	cast_column_(column);
+	if (ret = yadsl_graphattr_column_check_internal(column_, YADSL_GRAPHATTR_TYPE_STRING, row))
+		return ret;
+	if (value != NULL)
+		if (ret = yadsl_graphattr_pool_intern_internal(&column_->pool, value, &interned))
+			return ret;
+	column_->data.str[row] = interned;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_int64_data_get(
+	yadsl_GraphAttrColumnHandle* column,
+	int64_t** data_ptr)
+{
+	cast_column_(column);
+	if (column_->type != YADSL_GRAPHATTR_TYPE_INT64)
+		return YADSL_GRAPHATTR_RET_TYPE;
+	*data_ptr = column_->data.i64;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_double_data_get(
+	yadsl_GraphAttrColumnHandle* column,
+	double** data_ptr)
+{
+	cast_column_(column);
+	if (column_->type != YADSL_GRAPHATTR_TYPE_DOUBLE)
+		return YADSL_GRAPHATTR_RET_TYPE;
+	*data_ptr = column_->data.f64;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_bool_data_get(
+	yadsl_GraphAttrColumnHandle* column,
+	const uint64_t** words_ptr)
+{
+	cast_column_(column);
+	if (column_->type != YADSL_GRAPHATTR_TYPE_BOOL)
+		return YADSL_GRAPHATTR_RET_TYPE;
+	*words_ptr = column_->data.words;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_string_data_get(
+	yadsl_GraphAttrColumnHandle* column,
+	const char* const** data_ptr)
+{
+	cast_column_(column);
+	if (column_->type != YADSL_GRAPHATTR_TYPE_STRING)
+		return YADSL_GRAPHATTR_RET_TYPE;
+	*data_ptr = column_->data.str;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+/* The comparison is hoisted out of the loop so that each
+ * loop body is a plain branch-free scan over the column */
+#define YADSL_GRAPHATTR_SELECT(data, n, op, operand, rows, count) do { \
+	size_t i_; \
+	for (i_ = 0; i_ < (n); ++i_) { \
+		(rows)[count] = i_; \
+		count += (data)[i_] op (operand); \
+	} \
+} while (0)
+
+#define YADSL_GRAPHATTR_SELECT_CMP(data, n, cmp, operand, rows, count) do { \
+	switch (cmp) { \
+	case YADSL_GRAPHATTR_CMP_EQ: YADSL_GRAPHATTR_SELECT(data, n, ==, operand, rows, count); break; \
+	case YADSL_GRAPHATTR_CMP_NE: YADSL_GRAPHATTR_SELECT(data, n, !=, operand, rows, count); break; \
+	case YADSL_GRAPHATTR_CMP_LT: YADSL_GRAPHATTR_SELECT(data, n, <, operand, rows, count); break; \
+	case YADSL_GRAPHATTR_CMP_LE: YADSL_GRAPHATTR_SELECT(data, n, <=, operand, rows, count); break; \
+	case YADSL_GRAPHATTR_CMP_GT: YADSL_GRAPHATTR_SELECT(data, n, >, operand, rows, count); break; \
+	case YADSL_GRAPHATTR_CMP_GE: YADSL_GRAPHATTR_SELECT(data, n, >=, operand, rows, count); break; \
+	default: return YADSL_GRAPHATTR_RET_PARAMETER; \
+	} \
+} while (0)
+
+yadsl_GraphAttrRet yadsl_graphattr_int64_select(
+	yadsl_GraphAttrColumnHandle* column,
+	yadsl_GraphAttrCmp cmp,
+	int64_t operand,
+	size_t* rows,
+	size_t* count_ptr)
+{
+	size_t count = 0;
+	cast_column_(column);
+	if (column_->type != YADSL_GRAPHATTR_TYPE_INT64)
+		return YADSL_GRAPHATTR_RET_TYPE;
+	YADSL_GRAPHATTR_SELECT_CMP(column_->data.i64, column_->table->row_count,
+		cmp, operand, rows, count);
+	*count_ptr = count;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_double_select(
+	yadsl_GraphAttrColumnHandle* column,
+	yadsl_GraphAttrCmp cmp,
+	double operand,
+	size_t* rows,
+	size_t* count_ptr)
+{
+	size_t count = 0;
+	cast_column_(column);
+	if (column_->type != YADSL_GRAPHATTR_TYPE_DOUBLE)
+		return YADSL_GRAPHATTR_RET_TYPE;
+	YADSL_GRAPHATTR_SELECT_CMP(column_->data.f64, column_->table->row_count,
+		cmp, operand, rows, count);
+	*count_ptr = count;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_bool_select(
+	yadsl_GraphAttrColumnHandle* column,
+	bool operand,
+	size_t* rows,
+	size_t* count_ptr)
+{
+	size_t count = 0, row_count, word_count, i, base, bit;
+	uint64_t word;
+	cast_column_(column);
+	if (column_->type != YADSL_GRAPHATTR_TYPE_BOOL)
+		return YADSL_GRAPHATTR_RET_TYPE;
+	row_count = column_->table->row_count;
+	word_count = (row_count + YADSL_GRAPHATTR_WORD_BITS - 1) / YADSL_GRAPHATTR_WORD_BITS;
+	for (i = 0; i < word_count; ++i) {
+		word = operand ? column_->data.words[i] : ~column_->data.words[i];
+		base = i * YADSL_GRAPHATTR_WORD_BITS;
+		/* Stop as soon as no set bits are left in the word */
+		for (bit = 0; word && base + bit < row_count; ++bit, word >>= 1)
+			if (word & 1)
+				rows[count++] = base + bit;
+	}
+	*count_ptr = count;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_string_select(
+	yadsl_GraphAttrColumnHandle* column,
+	const char* operand,
+	size_t* rows,
+	size_t* count_ptr)
+{
+	size_t count = 0, row_count;
+	const char* interned = NULL;
+	cast_column_(column);
+	if (column_->type != YADSL_GRAPHATTR_TYPE_STRING)
+		return YADSL_GRAPHATTR_RET_TYPE;
+	row_count = column_->table->row_count;
+	if (operand != NULL) {
+		/* Rows are compared by address instead of by content */
+		if ((interned = yadsl_graphattr_pool_find_internal(&column_->pool, operand)) == NULL) {
+			*count_ptr = 0;
+			return YADSL_GRAPHATTR_RET_OK;
+		}
+	}
+	YADSL_GRAPHATTR_SELECT(column_->data.str, row_count, ==, interned, rows, count);
+	*count_ptr = count;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_int64_sum(
+	yadsl_GraphAttrColumnHandle* column,
+	int64_t* sum_ptr)
+{
+	size_t i, row_count;
+	int64_t sum = 0;
+	cast_column_(column);
+	if (column_->type != YADSL_GRAPHATTR_TYPE_INT64)
+		return YADSL_GRAPHATTR_RET_TYPE;
+	row_count = column_->table->row_count;
+	for (i = 0; i < row_count; ++i)
+		sum += column_->data.i64[i];
+	*sum_ptr = sum;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_int64_range(
+	yadsl_GraphAttrColumnHandle* column,
+	int64_t* min_ptr,
+	int64_t* max_ptr)
+{
+	size_t i, row_count;
+	int64_t min, max, value;
+	cast_column_(column);
+	if (column_->type != YADSL_GRAPHATTR_TYPE_INT64)
+		return YADSL_GRAPHATTR_RET_TYPE;
+	row_count = column_->table->row_count;
+	if (row_count == 0)
+		return YADSL_GRAPHATTR_RET_EMPTY;
+	min = max = column_->data.i64[0];
+	for (i = 1; i < row_count; ++i) {
+		value = column_->data.i64[i];
+		min = value < min ? value : min;
+		max = value > max ? value : max;
+	}
+	if (min_ptr) *min_ptr = min;
+	if (max_ptr) *max_ptr = max;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_double_sum(
+	yadsl_GraphAttrColumnHandle* column,
+	double* sum_ptr)
+{
+	size_t i, row_count;
+	double sum = 0.0;
+	cast_column_(column);
+	if (column_->type != YADSL_GRAPHATTR_TYPE_DOUBLE)
+		return YADSL_GRAPHATTR_RET_TYPE;
+	row_count = column_->table->row_count;
+	for (i = 0; i < row_count; ++i)
+		sum += column_->data.f64[i];
+	*sum_ptr = sum;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_double_range(
+	yadsl_GraphAttrColumnHandle* column,
+	double* min_ptr,
+	double* max_ptr)
+{
+	size_t i, row_count;
+	double min, max, value;
+	cast_column_(column);
+	if (column_->type != YADSL_GRAPHATTR_TYPE_DOUBLE)
+		return YADSL_GRAPHATTR_RET_TYPE;
+	row_count = column_->table->row_count;
+	if (row_count == 0)
+		return YADSL_GRAPHATTR_RET_EMPTY;
+	min = max = column_->data.f64[0];
+	for (i = 1; i < row_count; ++i) {
+		value = column_->data.f64[i];
+		min = value < min ? value : min;
+		max = value > max ? value : max;
+	}
+	if (min_ptr) *min_ptr = min;
+	if (max_ptr) *max_ptr = max;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_bool_count(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t* count_ptr)
+{
+	size_t count = 0, row_count, word_count, i;
+	uint64_t word;
+	cast_column_(column);
+	if (column_->type != YADSL_GRAPHATTR_TYPE_BOOL)
+		return YADSL_GRAPHATTR_RET_TYPE;
+	row_count = column_->table->row_count;
+	word_count = row_count / YADSL_GRAPHATTR_WORD_BITS;
+	for (i = 0; i < word_count; ++i) {
+		/* Population count (SWAR) */
+		word = column_->data.words[i];
+		word = word - ((word >> 1) & 0x5555555555555555ULL);
+		word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+		word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		count += (size_t) ((word * 0x0101010101010101ULL) >> 56);
+	}
+	for (i = word_count * YADSL_GRAPHATTR_WORD_BITS; i < row_count; ++i)
+		count += (column_->data.words[i / YADSL_GRAPHATTR_WORD_BITS] >>
+			(i % YADSL_GRAPHATTR_WORD_BITS)) & 1;
+	*count_ptr = count;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+void yadsl_graphattr_table_destroy(
+	yadsl_GraphAttrTableHandle* table)
+{
+	yadsl_GraphAttrColumn* column, * next;
+	if (table == NULL)
+		return;
+	cast_table_(table);
+	for (column = table_->columns; column; column = next) {
+		next = column->next;
+		yadsl_graphattr_column_destroy_internal(column);
+	}
+	free(table_);
+}
+
+/* Private functions */
+
+size_t yadsl_graphattr_data_size_internal(
+	yadsl_GraphAttrType type,
+	size_t row_capacity)
+{
+	switch (type) {
+	case YADSL_GRAPHATTR_TYPE_INT64:
+		return row_capacity * sizeof(int64_t);
+	case YADSL_GRAPHATTR_TYPE_DOUBLE:
+		return row_capacity * sizeof(double);
+	case YADSL_GRAPHATTR_TYPE_BOOL:
+		return row_capacity / YADSL_GRAPHATTR_WORD_BITS * sizeof(uint64_t);
+	case YADSL_GRAPHATTR_TYPE_STRING:
+		return row_capacity * sizeof(const char*);
+	default:
+		assert(0);
+		return 0;
+	}
+}
+
+void yadsl_graphattr_row_clear_internal(
+	yadsl_GraphAttrColumn* column,
+	size_t row)
+{
+	switch (column->type) {
+	case YADSL_GRAPHATTR_TYPE_INT64:
+		column->data.i64[row] = 0;
+		break;
+	case YADSL_GRAPHATTR_TYPE_DOUBLE:
+		column->data.f64[row] = 0.0;
+		break;
+	case YADSL_GRAPHATTR_TYPE_BOOL:
+		column->data.words[row / YADSL_GRAPHATTR_WORD_BITS] &=
+			~((uint64_t) 1 << (row % YADSL_GRAPHATTR_WORD_BITS));
+		break;
+	case YADSL_GRAPHATTR_TYPE_STRING:
+		column->data.str[row] = NULL;
+		break;
+	default:
+		assert(0);
+	}
+}
+
+void yadsl_graphattr_row_copy_internal(
+	yadsl_GraphAttrColumn* column,
+	size_t to,
+	size_t from)
+{
+	uint64_t bit;
+	switch (column->type) {
+	case YADSL_GRAPHATTR_TYPE_INT64:
+		column->data.i64[to] = column->data.i64[from];
+		break;
+	case YADSL_GRAPHATTR_TYPE_DOUBLE:
+		column->data.f64[to] = column->data.f64[from];
+		break;
+	case YADSL_GRAPHATTR_TYPE_BOOL:
+		bit = (column->data.words[from / YADSL_GRAPHATTR_WORD_BITS] >>
+			(from % YADSL_GRAPHATTR_WORD_BITS)) & 1;
+		column->data.words[to / YADSL_GRAPHATTR_WORD_BITS] =
+			(column->data.words[to / YADSL_GRAPHATTR_WORD_BITS] &
+			~((uint64_t) 1 << (to % YADSL_GRAPHATTR_WORD_BITS))) |
+			(bit << (to % YADSL_GRAPHATTR_WORD_BITS));
+		break;
+	case YADSL_GRAPHATTR_TYPE_STRING:
+		column->data.str[to] = column->data.str[from];
+		break;
+	default:
+		assert(0);
+	}
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_column_check_internal(
+	yadsl_GraphAttrColumn* column,
+	yadsl_GraphAttrType type,
+	size_t row)
+{
+	if (column->type != type)
+		return YADSL_GRAPHATTR_RET_TYPE;
+	if (row >= column->table->row_count)
+		return YADSL_GRAPHATTR_RET_PARAMETER;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+void yadsl_graphattr_column_destroy_internal(
+	yadsl_GraphAttrColumn* column)
+{
+	yadsl_graphattr_pool_destroy_internal(&column->pool);
+	if (column->data.ptr)
+		free(column->data.ptr);
+	free(column->name);
+	free(column);
+}
+
+// FNV-1a hash function
+static size_t yadsl_graphattr_hash_internal(const char* str)
+{
+	size_t hash = (size_t) 2166136261U;
+	for (; *str; ++str) {
+		hash ^= (unsigned char) *str;
+		hash *= (size_t) 16777619U;
+	}
+	return hash;
+}
+
+const char* yadsl_graphattr_pool_find_internal(
+	yadsl_GraphAttrStringPool* pool,
+	const char* str)
+{
+	size_t i, mask;
+	if (pool->size == 0)
+		return NULL;
+	mask = pool->size - 1;
+	for (i = yadsl_graphattr_hash_internal(str) & mask; pool->slots[i]; i = (i + 1) & mask)
+		if (!strcmp(pool->slots[i], str))
+			return pool->slots[i];
+	return NULL;
+}
+
+yadsl_GraphAttrRet yadsl_graphattr_pool_intern_internal(
+	yadsl_GraphAttrStringPool* pool,
+	const char* str,
+	const char** interned_ptr)
+{
+	size_t i, mask;
+	char* copy;
+	const char* interned;
+	if (interned = yadsl_graphattr_pool_find_internal(pool, str)) {
+		*interned_ptr = interned;
+		return YADSL_GRAPHATTR_RET_OK;
+	}
+	/* Keep load factor under 1/2 */
+	if ((pool->count + 1) * 2 > pool->size) {
+		size_t new_size = pool->size ? pool->size * 2 : YADSL_GRAPHATTR_POOL_MIN_SIZE;
+		size_t j;
+		char** new_slots = calloc(new_size, sizeof(char*));
+		if (new_slots == NULL)
+			return YADSL_GRAPHATTR_RET_MEMORY;
+		for (j = 0; j < new_size; ++j)
+			new_slots[j] = NULL;
+		mask = new_size - 1;
+		for (j = 0; j < pool->size; ++j) {
+			if (pool->slots[j]) {
+				for (i = yadsl_graphattr_hash_internal(pool->slots[j]) & mask; new_slots[i]; i = (i + 1) & mask);
+				new_slots[i] = pool->slots[j];
+			}
+		}
+		if (pool->slots)
+			free(pool->slots);
+		pool->slots = new_slots;
+		pool->size = new_size;
+	}
+	if ((copy = yadsl_string_duplicate(str)) == NULL)
+		return YADSL_GRAPHATTR_RET_MEMORY;
+	mask = pool->size - 1;
+	for (i = yadsl_graphattr_hash_internal(str) & mask; pool->slots[i]; i = (i + 1) & mask);
+	pool->slots[i] = copy;
+	++pool->count;
+	*interned_ptr = copy;
+	return YADSL_GRAPHATTR_RET_OK;
+}
+
+void yadsl_graphattr_pool_destroy_internal(
+	yadsl_GraphAttrStringPool* pool)
+{
+	size_t i;
+	if (pool->slots == NULL)
+		return;
+	for (i = 0; i < pool->size; ++i)
+		if (pool->slots[i])
+			free(pool->slots[i]);
+	free(pool->slots);
+}
@@ -0,0 +1,528 @@
+#ifndef __YADSL_GRAPHATTR_H__
+#define __YADSL_GRAPHATTR_H__
+
+/**
+ * \defgroup graphattr Graph Attributes
+ * @brief Columnar attribute table for graph vertices and edges
+ *
+ * An attribute table is a set of named, typed columns that share
+ * the same number of rows. Each column is stored as a contiguous
+ * array, so that scans which only need one attribute do not have to
+ * touch any other data.
+ *
+ * Every graph owns one table for its vertices and another for its
+ * edges, whose rows are indexed by vertex and edge id, respectively.
+ * Rows are removed by moving the last row into the vacated one, which
+ * mirrors how the graph keeps its ids dense.
+ *
+ * The supported column types are:
+ * * 64-bit signed integers
+ * * double-precision floating-point numbers
+ * * booleans, packed as a bitset
+ * * interned strings, in which equal strings share the same pointer
+ *
+ * @{
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Return condition of Graph Attributes functions
+*/
+typedef enum
+{
+	YADSL_GRAPHATTR_RET_OK = 0, /**< All went ok */
+	YADSL_GRAPHATTR_RET_MEMORY, /**< Could not allocate memory */
+	YADSL_GRAPHATTR_RET_PARAMETER, /**< Invalid parameter (e.g. row out of range) */
+	YADSL_GRAPHATTR_RET_EMPTY, /**< Table has no rows */
+	YADSL_GRAPHATTR_RET_EXISTS, /**< Column (already) exists */
+	YADSL_GRAPHATTR_RET_DOES_NOT_EXIST, /**< Column does not exist */
+	YADSL_GRAPHATTR_RET_TYPE, /**< Column has a different type */
+}
+yadsl_GraphAttrRet;
+
+/**
+ * @brief Type of the values stored in a column
+*/
+typedef enum
+{
+	YADSL_GRAPHATTR_TYPE_INT64, /**< 64-bit signed integer (defaults to 0) */
+	YADSL_GRAPHATTR_TYPE_DOUBLE, /**< Double-precision floating-point (defaults to 0.0) */
+	YADSL_GRAPHATTR_TYPE_BOOL, /**< Boolean (defaults to false) */
+	YADSL_GRAPHATTR_TYPE_STRING, /**< Interned string (defaults to NULL) */
+}
+yadsl_GraphAttrType;
+
+/**
+ * @brief Comparison operator used by selections
+*/
+typedef enum
+{
+	YADSL_GRAPHATTR_CMP_EQ, /**< value == operand */
+	YADSL_GRAPHATTR_CMP_NE, /**< value != operand */
+	YADSL_GRAPHATTR_CMP_LT, /**< value < operand */
+	YADSL_GRAPHATTR_CMP_LE, /**< value <= operand */
+	YADSL_GRAPHATTR_CMP_GT, /**< value > operand */
+	YADSL_GRAPHATTR_CMP_GE, /**< value >= operand */
+}
+yadsl_GraphAttrCmp;
+
+typedef void yadsl_GraphAttrTableHandle; /**< Attribute table handle */
+typedef void yadsl_GraphAttrColumnHandle; /**< Attribute column handle */
+
+/**
+ * @brief Create an attribute table with no columns
+ * @param row_count initial number of rows
+ * @return newly created table or NULL if could not allocate memory
+*/
+yadsl_GraphAttrTableHandle*
+yadsl_graphattr_table_create(
+	size_t row_count);
+
+/**
+ * @brief Get number of rows in table
+ * @param table attribute table
+ * @param row_count_ptr number of rows
+ * @return ::YADSL_GRAPHATTR_RET_OK, and *row_count_ptr is updated
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_row_count_get(
+	yadsl_GraphAttrTableHandle* table,
+	size_t* row_count_ptr);
+
+/**
+ * @brief Append a row to table, with default values in every column
+ * @param table attribute table
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and row is appended
+ * * ::YADSL_GRAPHATTR_RET_MEMORY
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_row_add(
+	yadsl_GraphAttrTableHandle* table);
+
+/**
+ * @brief Remove a row from table, moving the last row into its place
+ * @param table attribute table
+ * @param row row index
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and row is removed
+ * * ::YADSL_GRAPHATTR_RET_PARAMETER, if row is out of range
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_row_remove(
+	yadsl_GraphAttrTableHandle* table,
+	size_t row);
+
+/**
+ * @brief Add a column to table, with default values in every row
+ * @param table attribute table
+ * @param name column name (copied)
+ * @param type column type
+ * @param column_ptr (optional) newly created column
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *column_ptr is updated
+ * * ::YADSL_GRAPHATTR_RET_EXISTS
+ * * ::YADSL_GRAPHATTR_RET_PARAMETER, if type is invalid
+ * * ::YADSL_GRAPHATTR_RET_MEMORY
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_column_add(
+	yadsl_GraphAttrTableHandle* table,
+	const char* name,
+	yadsl_GraphAttrType type,
+	yadsl_GraphAttrColumnHandle** column_ptr);
+
+/**
+ * @brief Get column from table by name
+ * @param table attribute table
+ * @param name column name
+ * @param column_ptr column
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *column_ptr is updated
+ * * ::YADSL_GRAPHATTR_RET_DOES_NOT_EXIST
+ * @note Column handles stay valid until the column is removed
+ * or the table is destroyed.
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_column_get(
+	yadsl_GraphAttrTableHandle* table,
+	const char* name,
+	yadsl_GraphAttrColumnHandle** column_ptr);
+
+/**
+ * @brief Remove column from table
+ * @param table attribute table
+ * @param name column name
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and column is removed
+ * * ::YADSL_GRAPHATTR_RET_DOES_NOT_EXIST
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_column_remove(
+	yadsl_GraphAttrTableHandle* table,
+	const char* name);
+
+/**
+ * @brief Get type of column
+ * @param column column
+ * @param type_ptr column type
+ * @return ::YADSL_GRAPHATTR_RET_OK, and *type_ptr is updated
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_column_type_get(
+	yadsl_GraphAttrColumnHandle* column,
+	yadsl_GraphAttrType* type_ptr);
+
+/**
+ * @brief Get integer value from column
+ * @param column integer column
+ * @param row row index
+ * @param value_ptr value
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *value_ptr is updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * * ::YADSL_GRAPHATTR_RET_PARAMETER, if row is out of range
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_int64_get(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	int64_t* value_ptr);
+
+/**
+ * @brief Set integer value in column
+ * @param column integer column
+ * @param row row index
+ * @param value value
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and value is set
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * * ::YADSL_GRAPHATTR_RET_PARAMETER, if row is out of range
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_int64_set(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	int64_t value);
+
+/**
+ * @brief Get floating-point value from column
+ * @param column floating-point column
+ * @param row row index
+ * @param value_ptr value
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *value_ptr is updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * * ::YADSL_GRAPHATTR_RET_PARAMETER, if row is out of range
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_double_get(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	double* value_ptr);
+
+/**
+ * @brief Set floating-point value in column
+ * @param column floating-point column
+ * @param row row index
+ * @param value value
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and value is set
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * * ::YADSL_GRAPHATTR_RET_PARAMETER, if row is out of range
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_double_set(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	double value);
+
+/**
+ * @brief Get boolean value from column
+ * @param column boolean column
+ * @param row row index
+ * @param value_ptr value
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *value_ptr is updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * * ::YADSL_GRAPHATTR_RET_PARAMETER, if row is out of range
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_bool_get(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	bool* value_ptr);
+
+/**
+ * @brief Set boolean value in column
+ * @param column boolean column
+ * @param row row index
+ * @param value value
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and value is set
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * * ::YADSL_GRAPHATTR_RET_PARAMETER, if row is out of range
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_bool_set(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	bool value);
+
+/**
+ * @brief Get string value from column
+ * @param column string column
+ * @param row row index
+ * @param value_ptr interned string (or NULL, if unset)
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *value_ptr is updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * * ::YADSL_GRAPHATTR_RET_PARAMETER, if row is out of range
+ * @note The string is owned by the column and lives as long as it.
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_string_get(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	const char** value_ptr);
+
+/**
+ * @brief Set string value in column
+ *
+ * The string is interned in the column, so that equal
+ * strings are stored only once and share the same pointer.
+ *
+ * @param column string column
+ * @param row row index
+ * @param value string (copied) or NULL
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and value is set
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * * ::YADSL_GRAPHATTR_RET_PARAMETER, if row is out of range
+ * * ::YADSL_GRAPHATTR_RET_MEMORY
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_string_set(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t row,
+	const char* value);
+
+/**
+ * @brief Get the contiguous array of an integer column
+ * @param column integer column
+ * @param data_ptr array with one value per row
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *data_ptr is updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * @note The array is invalidated when rows are added.
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_int64_data_get(
+	yadsl_GraphAttrColumnHandle* column,
+	int64_t** data_ptr);
+
+/**
+ * @brief Get the contiguous array of a floating-point column
+ * @param column floating-point column
+ * @param data_ptr array with one value per row
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *data_ptr is updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * @note The array is invalidated when rows are added.
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_double_data_get(
+	yadsl_GraphAttrColumnHandle* column,
+	double** data_ptr);
+
+/**
+ * @brief Get the bitset of a boolean column
+ * @param column boolean column
+ * @param words_ptr bitset, in which row i is bit (i % 64) of word (i / 64)
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *words_ptr is updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * @note The bitset is invalidated when rows are added.
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_bool_data_get(
+	yadsl_GraphAttrColumnHandle* column,
+	const uint64_t** words_ptr);
+
+/**
+ * @brief Get the contiguous array of a string column
+ * @param column string column
+ * @param data_ptr array with one interned string (or NULL) per row
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *data_ptr is updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * @note The array is invalidated when rows are added.
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_string_data_get(
+	yadsl_GraphAttrColumnHandle* column,
+	const char* const** data_ptr);
+
+/**
+ * @brief Select rows whose integer value satisfies a comparison
+ * @param column integer column
+ * @param cmp comparison operator
+ * @param operand right-hand side of the comparison
+ * @param rows array of at least row count elements, which
+ * is filled with the matching row indices, in increasing order
+ * @param count_ptr number of matching rows
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and rows and *count_ptr are updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * * ::YADSL_GRAPHATTR_RET_PARAMETER, if cmp is invalid
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_int64_select(
+	yadsl_GraphAttrColumnHandle* column,
+	yadsl_GraphAttrCmp cmp,
+	int64_t operand,
+	size_t* rows,
+	size_t* count_ptr);
+
+/**
+ * @brief Select rows whose floating-point value satisfies a comparison
+ * @param column floating-point column
+ * @param cmp comparison operator
+ * @param operand right-hand side of the comparison
+ * @param rows array of at least row count elements, which
+ * is filled with the matching row indices, in increasing order
+ * @param count_ptr number of matching rows
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and rows and *count_ptr are updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * * ::YADSL_GRAPHATTR_RET_PARAMETER, if cmp is invalid
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_double_select(
+	yadsl_GraphAttrColumnHandle* column,
+	yadsl_GraphAttrCmp cmp,
+	double operand,
+	size_t* rows,
+	size_t* count_ptr);
+
+/**
+ * @brief Select rows whose boolean value is equal to the operand
+ * @param column boolean column
+ * @param operand value to be matched
+ * @param rows array of at least row count elements, which
+ * is filled with the matching row indices, in increasing order
+ * @param count_ptr number of matching rows
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and rows and *count_ptr are updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_bool_select(
+	yadsl_GraphAttrColumnHandle* column,
+	bool operand,
+	size_t* rows,
+	size_t* count_ptr);
+
+/**
+ * @brief Select rows whose string value is equal to the operand
+ * @param column string column
+ * @param operand string to be matched (or NULL, to match unset rows)
+ * @param rows array of at least row count elements, which
+ * is filled with the matching row indices, in increasing order
+ * @param count_ptr number of matching rows
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and rows and *count_ptr are updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_string_select(
+	yadsl_GraphAttrColumnHandle* column,
+	const char* operand,
+	size_t* rows,
+	size_t* count_ptr);
+
+/**
+ * @brief Sum all values of an integer column
+ * @param column integer column
+ * @param sum_ptr sum (0, if table has no rows)
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *sum_ptr is updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_int64_sum(
+	yadsl_GraphAttrColumnHandle* column,
+	int64_t* sum_ptr);
+
+/**
+ * @brief Get the minimum and maximum values of an integer column
+ * @param column integer column
+ * @param min_ptr (optional) minimum value
+ * @param max_ptr (optional) maximum value
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *min_ptr and *max_ptr are updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * * ::YADSL_GRAPHATTR_RET_EMPTY
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_int64_range(
+	yadsl_GraphAttrColumnHandle* column,
+	int64_t* min_ptr,
+	int64_t* max_ptr);
+
+/**
+ * @brief Sum all values of a floating-point column
+ * @param column floating-point column
+ * @param sum_ptr sum (0.0, if table has no rows)
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *sum_ptr is updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_double_sum(
+	yadsl_GraphAttrColumnHandle* column,
+	double* sum_ptr);
+
+/**
+ * @brief Get the minimum and maximum values of a floating-point column
+ * @param column floating-point column
+ * @param min_ptr (optional) minimum value
+ * @param max_ptr (optional) maximum value
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *min_ptr and *max_ptr are updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+ * * ::YADSL_GRAPHATTR_RET_EMPTY
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_double_range(
+	yadsl_GraphAttrColumnHandle* column,
+	double* min_ptr,
+	double* max_ptr);
+
+/**
+ * @brief Count rows of a boolean column that are true
+ * @param column boolean column
+ * @param count_ptr number of true rows
+ * @return
+ * * ::YADSL_GRAPHATTR_RET_OK, and *count_ptr is updated
+ * * ::YADSL_GRAPHATTR_RET_TYPE
+*/
+yadsl_GraphAttrRet
+yadsl_graphattr_bool_count(
+	yadsl_GraphAttrColumnHandle* column,
+	size_t* count_ptr);
+
+/**
+ * @brief Destroy attribute table and all of its columns
+ * @param table attribute table
+*/
+void
+yadsl_graphattr_table_destroy(
+	yadsl_GraphAttrTableHandle* table);
+
+/** @} */
+
+#endif
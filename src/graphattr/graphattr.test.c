@@ -0,0 +1,353 @@
+#include <graphattr/graphattr.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <tester/tester.h>
+#include <testerutils/testerutils.h>
+
+#if defined(_MSC_VER)
+# pragma warning(disable : 4996)
+#endif
+
+const char* yadsl_tester_help_strings[] = {
+	"This is an interactive module of the graph attributes library",
+	"You will interact with the same attribute table at all times",
+	"An empty table (with no rows) is already created from the start",
+	"",
+	"The registered actions are the following:",
+	"/create <rows>                          create new table",
+	"/rowcount <expected>                    get number of rows",
+	"/addrow                                 append row",
+	"/removerow <row>                        remove row",
+	"/addcolumn <name> <type>                add column (int64, double, bool or string)",
+	"/removecolumn <name>                    remove column",
+	"/columntype <name> <expected>           get column type",
+	"/set <name> <row> <value>               set value (NULL unsets strings)",
+	"/get <name> <row> <expected>            get value",
+	"/samestring <name> <row> <row> [YES/NO] check if rows share the same string",
+	"/select <name> <cmp> <value> <expected> count rows that satisfy comparison",
+	"/selected <index> <expected>            get row selected by last /select",
+	"/sum <name> <expected>                  sum values of numeric column",
+	"/range <name> <min> <max>               get range of numeric column",
+	"/count <name> <expected>                count true values of boolean column",
+	NULL,
+};
+
+static yadsl_GraphAttrTableHandle* table = NULL;
+static size_t* selected = NULL;
+static size_t selected_count = 0;
+static char buffer[BUFSIZ], buffer2[BUFSIZ], buffer3[BUFSIZ];
+
+static bool parse_type(const char* str, yadsl_GraphAttrType* type_ptr);
+static bool parse_cmp(const char* str, yadsl_GraphAttrCmp* cmp_ptr);
+static yadsl_TesterRet convert_graphattr_ret(yadsl_GraphAttrRet ret);
+
+yadsl_TesterRet yadsl_tester_init()
+{
+	table = yadsl_graphattr_table_create(0);
+	return table ? YADSL_TESTER_RET_OK : YADSL_TESTER_RET_MALLOC;
+}
+
+yadsl_TesterRet yadsl_tester_parse(const char* command)
+{
+	yadsl_GraphAttrRet ret = YADSL_GRAPHATTR_RET_OK;
+	yadsl_GraphAttrColumnHandle* column;
+	yadsl_GraphAttrType type;
+	size_t row;
+	if (yadsl_testerutils_match(command, "create")) {
+		yadsl_GraphAttrTableHandle* temp;
+		size_t rows;
+		if (yadsl_tester_parse_arguments("z", &rows) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if ((temp = yadsl_graphattr_table_create(rows)) == NULL)
+			return YADSL_TESTER_RET_MALLOC;
+		yadsl_graphattr_table_destroy(table);
+		table = temp;
+	} else if (yadsl_testerutils_match(command, "rowcount")) {
+		size_t actual, expected;
+		if (yadsl_tester_parse_arguments("z", &expected) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		ret = yadsl_graphattr_row_count_get(table, &actual);
+		if (ret == YADSL_GRAPHATTR_RET_OK && actual != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "addrow")) {
+		ret = yadsl_graphattr_row_add(table);
+	} else if (yadsl_testerutils_match(command, "removerow")) {
+		if (yadsl_tester_parse_arguments("z", &row) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		ret = yadsl_graphattr_row_remove(table, row);
+	} else if (yadsl_testerutils_match(command, "addcolumn")) {
+		if (yadsl_tester_parse_arguments("ss", buffer, buffer2) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!parse_type(buffer2, &type))
+			return YADSL_TESTER_RET_ARGUMENT;
+		ret = yadsl_graphattr_column_add(table, buffer, type, NULL);
+	} else if (yadsl_testerutils_match(command, "removecolumn")) {
+		if (yadsl_tester_parse_arguments("s", buffer) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		ret = yadsl_graphattr_column_remove(table, buffer);
+	} else if (yadsl_testerutils_match(command, "columntype")) {
+		yadsl_GraphAttrType expected;
+		if (yadsl_tester_parse_arguments("ss", buffer, buffer2) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!parse_type(buffer2, &expected))
+			return YADSL_TESTER_RET_ARGUMENT;
+		if ((ret = yadsl_graphattr_column_get(table, buffer, &column)) == YADSL_GRAPHATTR_RET_OK) {
+			if (yadsl_graphattr_column_type_get(column, &type))
+				return YADSL_TESTER_RET_RETURN;
+			if (type != expected)
+				return YADSL_TESTER_RET_RETURN;
+		}
+	} else if (yadsl_testerutils_match(command, "set")) {
+		if (yadsl_tester_parse_arguments("szs", buffer, &row, buffer2) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (ret = yadsl_graphattr_column_get(table, buffer, &column))
+			return convert_graphattr_ret(ret);
+		if (yadsl_graphattr_column_type_get(column, &type))
+			return YADSL_TESTER_RET_RETURN;
+		switch (type) {
+		case YADSL_GRAPHATTR_TYPE_INT64:
+			ret = yadsl_graphattr_int64_set(column, row, strtoll(buffer2, NULL, 10));
+			break;
+		case YADSL_GRAPHATTR_TYPE_DOUBLE:
+			ret = yadsl_graphattr_double_set(column, row, strtod(buffer2, NULL));
+			break;
+		case YADSL_GRAPHATTR_TYPE_BOOL:
+			ret = yadsl_graphattr_bool_set(column, row, yadsl_testerutils_str_to_bool(buffer2));
+			break;
+		case YADSL_GRAPHATTR_TYPE_STRING:
+			ret = yadsl_graphattr_string_set(column, row,
+				strcmp(buffer2, "NULL") ? buffer2 : NULL);
+			break;
+		default:
+			return YADSL_TESTER_RET_RETURN;
+		}
+	} else if (yadsl_testerutils_match(command, "get")) {
+		bool equal = true;
+		if (yadsl_tester_parse_arguments("szs", buffer, &row, buffer2) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (ret = yadsl_graphattr_column_get(table, buffer, &column))
+			return convert_graphattr_ret(ret);
+		if (yadsl_graphattr_column_type_get(column, &type))
+			return YADSL_TESTER_RET_RETURN;
+		switch (type) {
+		case YADSL_GRAPHATTR_TYPE_INT64:
+		{
+			int64_t actual;
+			if ((ret = yadsl_graphattr_int64_get(column, row, &actual)) == YADSL_GRAPHATTR_RET_OK)
+				equal = actual == strtoll(buffer2, NULL, 10);
+			break;
+		}
+		case YADSL_GRAPHATTR_TYPE_DOUBLE:
+		{
+			double actual;
+			if ((ret = yadsl_graphattr_double_get(column, row, &actual)) == YADSL_GRAPHATTR_RET_OK)
+				equal = actual == strtod(buffer2, NULL);
+			break;
+		}
+		case YADSL_GRAPHATTR_TYPE_BOOL:
+		{
+			bool actual;
+			if ((ret = yadsl_graphattr_bool_get(column, row, &actual)) == YADSL_GRAPHATTR_RET_OK)
+				equal = actual == yadsl_testerutils_str_to_bool(buffer2);
+			break;
+		}
+		case YADSL_GRAPHATTR_TYPE_STRING:
+		{
+			const char* actual;
+			if ((ret = yadsl_graphattr_string_get(column, row, &actual)) == YADSL_GRAPHATTR_RET_OK)
+				equal = actual ? !strcmp(actual, buffer2) : !strcmp(buffer2, "NULL");
+			break;
+		}
+		default:
+			return YADSL_TESTER_RET_RETURN;
+		}
+		if (!equal)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "samestring")) {
+		size_t row2;
+		const char* a, * b;
+		if (yadsl_tester_parse_arguments("szzs", buffer, &row, &row2, buffer2) != 4)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (ret = yadsl_graphattr_column_get(table, buffer, &column))
+			return convert_graphattr_ret(ret);
+		if (ret = yadsl_graphattr_string_get(column, row, &a))
+			return convert_graphattr_ret(ret);
+		if (ret = yadsl_graphattr_string_get(column, row2, &b))
+			return convert_graphattr_ret(ret);
+		if ((a == b) != yadsl_testerutils_str_to_bool(buffer2))
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "select")) {
+		yadsl_GraphAttrCmp cmp;
+		size_t expected, row_count;
+		size_t* temp;
+		if (yadsl_tester_parse_arguments("sssz", buffer, buffer2, buffer3, &expected) != 4)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (!parse_cmp(buffer2, &cmp))
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (ret = yadsl_graphattr_column_get(table, buffer, &column))
+			return convert_graphattr_ret(ret);
+		if (yadsl_graphattr_column_type_get(column, &type))
+			return YADSL_TESTER_RET_RETURN;
+		if (yadsl_graphattr_row_count_get(table, &row_count))
+			return YADSL_TESTER_RET_RETURN;
+		if ((temp = malloc((row_count + 1) * sizeof(size_t))) == NULL)
+			return YADSL_TESTER_RET_MALLOC;
+		if (selected)
+			free(selected);
+		selected = temp;
+		selected_count = 0;
+		switch (type) {
+		case YADSL_GRAPHATTR_TYPE_INT64:
+			ret = yadsl_graphattr_int64_select(column, cmp,
+				strtoll(buffer3, NULL, 10), selected, &selected_count);
+			break;
+		case YADSL_GRAPHATTR_TYPE_DOUBLE:
+			ret = yadsl_graphattr_double_select(column, cmp,
+				strtod(buffer3, NULL), selected, &selected_count);
+			break;
+		case YADSL_GRAPHATTR_TYPE_BOOL:
+			if (cmp != YADSL_GRAPHATTR_CMP_EQ)
+				return YADSL_TESTER_RET_ARGUMENT;
+			ret = yadsl_graphattr_bool_select(column,
+				yadsl_testerutils_str_to_bool(buffer3), selected, &selected_count);
+			break;
+		case YADSL_GRAPHATTR_TYPE_STRING:
+			if (cmp != YADSL_GRAPHATTR_CMP_EQ)
+				return YADSL_TESTER_RET_ARGUMENT;
+			ret = yadsl_graphattr_string_select(column,
+				strcmp(buffer3, "NULL") ? buffer3 : NULL, selected, &selected_count);
+			break;
+		default:
+			return YADSL_TESTER_RET_RETURN;
+		}
+		if (ret == YADSL_GRAPHATTR_RET_OK && selected_count != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "selected")) {
+		size_t index, expected;
+		if (yadsl_tester_parse_arguments("zz", &index, &expected) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (index >= selected_count)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (selected[index] != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "sum")) {
+		if (yadsl_tester_parse_arguments("ss", buffer, buffer2) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (ret = yadsl_graphattr_column_get(table, buffer, &column))
+			return convert_graphattr_ret(ret);
+		if (yadsl_graphattr_column_type_get(column, &type))
+			return YADSL_TESTER_RET_RETURN;
+		if (type == YADSL_GRAPHATTR_TYPE_DOUBLE) {
+			double actual;
+			if ((ret = yadsl_graphattr_double_sum(column, &actual)) == YADSL_GRAPHATTR_RET_OK)
+				if (actual != strtod(buffer2, NULL))
+					return YADSL_TESTER_RET_RETURN;
+		} else {
+			int64_t actual;
+			if ((ret = yadsl_graphattr_int64_sum(column, &actual)) == YADSL_GRAPHATTR_RET_OK)
+				if (actual != strtoll(buffer2, NULL, 10))
+					return YADSL_TESTER_RET_RETURN;
+		}
+	} else if (yadsl_testerutils_match(command, "range")) {
+		if (yadsl_tester_parse_arguments("sss", buffer, buffer2, buffer3) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (ret = yadsl_graphattr_column_get(table, buffer, &column))
+			return convert_graphattr_ret(ret);
+		if (yadsl_graphattr_column_type_get(column, &type))
+			return YADSL_TESTER_RET_RETURN;
+		if (type == YADSL_GRAPHATTR_TYPE_DOUBLE) {
+			double min, max;
+			if ((ret = yadsl_graphattr_double_range(column, &min, &max)) == YADSL_GRAPHATTR_RET_OK)
+				if (min != strtod(buffer2, NULL) || max != strtod(buffer3, NULL))
+					return YADSL_TESTER_RET_RETURN;
+		} else {
+			int64_t min, max;
+			if ((ret = yadsl_graphattr_int64_range(column, &min, &max)) == YADSL_GRAPHATTR_RET_OK)
+				if (min != strtoll(buffer2, NULL, 10) || max != strtoll(buffer3, NULL, 10))
+					return YADSL_TESTER_RET_RETURN;
+		}
+	} else if (yadsl_testerutils_match(command, "count")) {
+		size_t actual, expected;
+		if (yadsl_tester_parse_arguments("sz", buffer, &expected) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (ret = yadsl_graphattr_column_get(table, buffer, &column))
+			return convert_graphattr_ret(ret);
+		ret = yadsl_graphattr_bool_count(column, &actual);
+		if (ret == YADSL_GRAPHATTR_RET_OK && actual != expected)
+			return YADSL_TESTER_RET_RETURN;
+	} else {
+		return YADSL_TESTER_RET_COUNT;
+	}
+	return convert_graphattr_ret(ret);
+}
+
+yadsl_TesterRet yadsl_tester_release()
+{
+	yadsl_graphattr_table_destroy(table);
+	if (selected)
+		free(selected);
+	return YADSL_TESTER_RET_OK;
+}
+
+bool parse_type(const char* str, yadsl_GraphAttrType* type_ptr)
+{
+	if (yadsl_testerutils_match(str, "int64")) {
+		*type_ptr = YADSL_GRAPHATTR_TYPE_INT64;
+	} else if (yadsl_testerutils_match(str, "double")) {
+		*type_ptr = YADSL_GRAPHATTR_TYPE_DOUBLE;
+	} else if (yadsl_testerutils_match(str, "bool")) {
+		*type_ptr = YADSL_GRAPHATTR_TYPE_BOOL;
+	} else if (yadsl_testerutils_match(str, "string")) {
+		*type_ptr = YADSL_GRAPHATTR_TYPE_STRING;
+	} else {
+		yadsl_tester_log("Unknown column type \"%s\"", str);
+		return false;
+	}
+	return true;
+}
+
+bool parse_cmp(const char* str, yadsl_GraphAttrCmp* cmp_ptr)
+{
+	if (!strcmp(str, "==")) {
+		*cmp_ptr = YADSL_GRAPHATTR_CMP_EQ;
+	} else if (!strcmp(str, "!=")) {
+		*cmp_ptr = YADSL_GRAPHATTR_CMP_NE;
+	} else if (!strcmp(str, "<")) {
+		*cmp_ptr = YADSL_GRAPHATTR_CMP_LT;
+	} else if (!strcmp(str, "<=")) {
+		*cmp_ptr = YADSL_GRAPHATTR_CMP_LE;
+	} else if (!strcmp(str, ">")) {
+		*cmp_ptr = YADSL_GRAPHATTR_CMP_GT;
+	} else if (!strcmp(str, ">=")) {
+		*cmp_ptr = YADSL_GRAPHATTR_CMP_GE;
+	} else {
+		yadsl_tester_log("Unknown comparison operator \"%s\"", str);
+		return false;
+	}
+	return true;
+}
+
+yadsl_TesterRet convert_graphattr_ret(yadsl_GraphAttrRet ret)
+{
+	switch (ret) {
+	case YADSL_GRAPHATTR_RET_OK:
+		return YADSL_TESTER_RET_OK;
+	case YADSL_GRAPHATTR_RET_MEMORY:
+		return YADSL_TESTER_RET_MALLOC;
+	case YADSL_GRAPHATTR_RET_PARAMETER:
+		return yadsl_tester_return_external_value("parameter");
+	case YADSL_GRAPHATTR_RET_EMPTY:
+		return yadsl_tester_return_external_value("empty");
+	case YADSL_GRAPHATTR_RET_EXISTS:
+		return yadsl_tester_return_external_value("exists");
+	case YADSL_GRAPHATTR_RET_DOES_NOT_EXIST:
+		return yadsl_tester_return_external_value("does not exist");
+	case YADSL_GRAPHATTR_RET_TYPE:
+		return yadsl_tester_return_external_value("type");
+	default:
+		return yadsl_tester_return_external_value("unknown");
+	}
+}
@@ -0,0 +1,539 @@
+#include <graphcolor/graphcolor.h>
+
+#include <assert.h>
+#include <stdint.h>
+
+#ifdef YADSL_DEBUG
+#include <memdb/memdb.h>
+#else
+#include <stdlib.h>
+#endif
+
+#define YADSL_GRAPHCOLOR_NONE ((size_t) -1)
+
+///////////////////////////////////////////////
+// Symmetric adjacency lists, by vertex id
+// (self-loops are left out)
+///////////////////////////////////////////////
+
+typedef struct
+{
+	size_t vertex_count;
+	size_t* offsets;
+	size_t* neighbours;
+}
+yadsl_GraphColorAdjacency;
+
+///////////////////////////////////////////////
+// DSATUR heap entry
+///////////////////////////////////////////////
+
+typedef struct
+{
+	size_t saturation;
+	size_t degree;
+	size_t vertex;
+}
+yadsl_GraphColorDsaturEntry;
+
+///////////////////////////////////////////////
+// Set of (vertex, colour) pairs
+// (open addressing, vertex + 1 so that 0 is empty)
+///////////////////////////////////////////////
+
+typedef struct
+{
+	size_t* vertices;
+	size_t* colors;
+	size_t mask;
+}
+yadsl_GraphColorPairSet;
+
+/**********************************/
+/*  Private functions prototypes  */
+/**********************************/
+
+static bool yadsl_graphcolor_adjacency_create_internal(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphColorAdjacency* adj);
+
+static void yadsl_graphcolor_adjacency_destroy_internal(
+	yadsl_GraphColorAdjacency* adj);
+
+static size_t yadsl_graphcolor_first_fit_internal(
+	yadsl_GraphColorAdjacency* adj,
+	size_t v,
+	const size_t* colors,
+	size_t* stamps);
+
+static void yadsl_graphcolor_output_internal(
+	yadsl_GraphHandle* graph,
+	const size_t* colors,
+	size_t vertex_count);
+
+static bool yadsl_graphcolor_dsatur_entry_before_internal(
+	const yadsl_GraphColorDsaturEntry* a,
+	const yadsl_GraphColorDsaturEntry* b);
+
+static void yadsl_graphcolor_dsatur_push_internal(
+	yadsl_GraphColorDsaturEntry* heap,
+	size_t* size_ptr,
+	yadsl_GraphColorDsaturEntry entry);
+
+static yadsl_GraphColorDsaturEntry yadsl_graphcolor_dsatur_pop_internal(
+	yadsl_GraphColorDsaturEntry* heap,
+	size_t* size_ptr);
+
+static bool yadsl_graphcolor_pair_set_insert_internal(
+	yadsl_GraphColorPairSet* set,
+	size_t vertex,
+	size_t color);
+
+static uint64_t yadsl_graphcolor_random_internal(
+	uint64_t* state_ptr);
+
+/**********************/
+/*  Public functions  */
+/**********************/
+
+yadsl_GraphColorRet yadsl_graphcolor_greedy(
+	yadsl_GraphHandle* graph,
+	const size_t* order,
+	size_t* colors,
+	size_t* color_count_ptr)
+{
+	yadsl_GraphColorAdjacency adj;
+	size_t* result = colors, * stamps = NULL;
+	size_t vertex_count, color_count = 0, i, v, c;
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (vertex_count == 0) {
+		*color_count_ptr = 0;
+		return YADSL_GRAPHCOLOR_RET_OK;
+	}
+	stamps = malloc(vertex_count * sizeof(*stamps));
+	if (stamps == NULL)
+		return YADSL_GRAPHCOLOR_RET_MEMORY;
+	if (order) {
+		/* Check that order is a permutation */
+		for (v = 0; v < vertex_count; ++v)
+			stamps[v] = 0;
+		for (i = 0; i < vertex_count; ++i) {
+			if (order[i] >= vertex_count || stamps[order[i]]) {
+				free(stamps);
+				return YADSL_GRAPHCOLOR_RET_PARAMETER;
+			}
+			stamps[order[i]] = 1;
+		}
+	}
+	if (result == NULL) {
+		result = malloc(vertex_count * sizeof(*result));
+		if (result == NULL) {
+			free(stamps);
+			return YADSL_GRAPHCOLOR_RET_MEMORY;
+		}
+	}
+	if (!yadsl_graphcolor_adjacency_create_internal(graph, &adj)) {
+		if (result != colors)
+			free(result);
+		free(stamps);
+		return YADSL_GRAPHCOLOR_RET_MEMORY;
+	}
+	for (v = 0; v < vertex_count; ++v) {
+		result[v] = YADSL_GRAPHCOLOR_NONE;
+		stamps[v] = 0;
+	}
+	for (i = 0; i < vertex_count; ++i) {
+		v = order ? order[i] : i;
+		c = yadsl_graphcolor_first_fit_internal(&adj, v, result, stamps);
+		result[v] = c;
+		if (c >= color_count)
+			color_count = c + 1;
+	}
+	if (result != colors) {
+		yadsl_graphcolor_output_internal(graph, result, vertex_count);
+		free(result);
+	}
+	yadsl_graphcolor_adjacency_destroy_internal(&adj);
+	free(stamps);
+	*color_count_ptr = color_count;
+	return YADSL_GRAPHCOLOR_RET_OK;
+}
+
+yadsl_GraphColorRet yadsl_graphcolor_dsatur(
+	yadsl_GraphHandle* graph,
+	size_t* colors,
+	size_t* color_count_ptr)
+{
+	yadsl_GraphColorAdjacency adj;
+	yadsl_GraphColorDsaturEntry* heap = NULL, entry;
+	yadsl_GraphColorPairSet pairs;
+	size_t* result = colors, * stamps = NULL, * saturation = NULL;
+	size_t vertex_count, entry_count, capacity, heap_size = 0;
+	size_t color_count = 0, v, w, c, i;
+	yadsl_GraphColorRet ret = YADSL_GRAPHCOLOR_RET_MEMORY;
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (vertex_count == 0) {
+		*color_count_ptr = 0;
+		return YADSL_GRAPHCOLOR_RET_OK;
+	}
+	if (!yadsl_graphcolor_adjacency_create_internal(graph, &adj))
+		return YADSL_GRAPHCOLOR_RET_MEMORY;
+	entry_count = adj.offsets[vertex_count];
+	/* Every neighbour entry adds at most one pair and one heap entry */
+	for (capacity = 16; capacity < 2 * entry_count; capacity *= 2);
+	pairs.vertices = NULL;
+	pairs.colors = NULL;
+	pairs.mask = capacity - 1;
+	if (!(pairs.vertices = malloc(capacity * sizeof(*pairs.vertices))))
+		goto exit;
+	if (!(pairs.colors = malloc(capacity * sizeof(*pairs.colors))))
+		goto exit;
+	if (!(heap = malloc((vertex_count + entry_count) * sizeof(*heap))))
+		goto exit;
+	if (!(stamps = malloc(vertex_count * sizeof(*stamps))))
+		goto exit;
+	if (!(saturation = malloc(vertex_count * sizeof(*saturation))))
+		goto exit;
+	if (result == NULL && !(result = malloc(vertex_count * sizeof(*result))))
+		goto exit;
+	for (i = 0; i < capacity; ++i)
+		pairs.vertices[i] = 0;
+	for (v = 0; v < vertex_count; ++v) {
+		result[v] = YADSL_GRAPHCOLOR_NONE;
+		stamps[v] = 0;
+		saturation[v] = 0;
+		entry.saturation = 0;
+		entry.degree = adj.offsets[v + 1] - adj.offsets[v];
+		entry.vertex = v;
+		yadsl_graphcolor_dsatur_push_internal(heap, &heap_size, entry);
+	}
+	while (heap_size > 0) {
+		entry = yadsl_graphcolor_dsatur_pop_internal(heap, &heap_size);
+		v = entry.vertex;
+		/* Skip stale entries (superseded by one with higher saturation) */
+		if (result[v] != YADSL_GRAPHCOLOR_NONE || entry.saturation != saturation[v])
+			continue;
+		c = yadsl_graphcolor_first_fit_internal(&adj, v, result, stamps);
+		result[v] = c;
+		if (c >= color_count)
+			color_count = c + 1;
+		for (i = adj.offsets[v]; i < adj.offsets[v + 1]; ++i) {
+			w = adj.neighbours[i];
+			if (result[w] != YADSL_GRAPHCOLOR_NONE)
+				continue;
+			if (yadsl_graphcolor_pair_set_insert_internal(&pairs, w, c)) {
+				entry.saturation = ++saturation[w];
+				entry.degree = adj.offsets[w + 1] - adj.offsets[w];
+				entry.vertex = w;
+				yadsl_graphcolor_dsatur_push_internal(heap, &heap_size, entry);
+			}
+		}
+	}
+	if (result != colors)
+		yadsl_graphcolor_output_internal(graph, result, vertex_count);
+	*color_count_ptr = color_count;
+	ret = YADSL_GRAPHCOLOR_RET_OK;
+exit:
+	if (result && result != colors)
+		free(result);
+	if (saturation)
+		free(saturation);
+	if (stamps)
+		free(stamps);
+	if (heap)
+		free(heap);
+	if (pairs.colors)
+		free(pairs.colors);
+	if (pairs.vertices)
+		free(pairs.vertices);
+	yadsl_graphcolor_adjacency_destroy_internal(&adj);
+	return ret;
+}
+
+yadsl_GraphColorRet yadsl_graphcolor_jones_plassmann(
+	yadsl_GraphHandle* graph,
+	unsigned long seed,
+	size_t* colors,
+	size_t* color_count_ptr,
+	size_t* round_count_ptr)
+{
+	yadsl_GraphColorAdjacency adj;
+	uint64_t* priorities = NULL, state;
+	size_t* result = colors, * stamps = NULL, * waiting = NULL, * queue = NULL;
+	size_t vertex_count, color_count = 0, round_count = 0;
+	size_t begin, end, tail, v, w, c, i, j;
+	yadsl_GraphColorRet ret = YADSL_GRAPHCOLOR_RET_MEMORY;
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (vertex_count == 0) {
+		*color_count_ptr = 0;
+		if (round_count_ptr)
+			*round_count_ptr = 0;
+		return YADSL_GRAPHCOLOR_RET_OK;
+	}
+	if (!yadsl_graphcolor_adjacency_create_internal(graph, &adj))
+		return YADSL_GRAPHCOLOR_RET_MEMORY;
+	if (!(priorities = malloc(vertex_count * sizeof(*priorities))))
+		goto exit;
+	if (!(stamps = malloc(vertex_count * sizeof(*stamps))))
+		goto exit;
+	if (!(waiting = malloc(vertex_count * sizeof(*waiting))))
+		goto exit;
+	if (!(queue = malloc(vertex_count * sizeof(*queue))))
+		goto exit;
+	if (result == NULL && !(result = malloc(vertex_count * sizeof(*result))))
+		goto exit;
+
+/* Whether vertex a comes before vertex b (priority, then id) */
+#define YADSL_GRAPHCOLOR_JP_BEFORE(a, b) \
+	(priorities[a] > priorities[b] || (priorities[a] == priorities[b] && (a) < (b)))
+
+	state = (uint64_t) seed ^ UINT64_C(0x9E3779B97F4A7C15);
+	for (v = 0; v < vertex_count; ++v) {
+		priorities[v] = yadsl_graphcolor_random_internal(&state);
+		result[v] = YADSL_GRAPHCOLOR_NONE;
+		stamps[v] = 0;
+	}
+	/* A vertex is coloured once every neighbour before it is */
+	tail = 0;
+	for (v = 0; v < vertex_count; ++v) {
+		waiting[v] = 0;
+		for (i = adj.offsets[v]; i < adj.offsets[v + 1]; ++i)
+			if (YADSL_GRAPHCOLOR_JP_BEFORE(adj.neighbours[i], v))
+				++waiting[v];
+		if (waiting[v] == 0)
+			queue[tail++] = v;
+	}
+	for (begin = 0; begin < tail; begin = end) {
+		/* Vertices of the same round are pairwise non-adjacent */
+		end = tail;
+		++round_count;
+		for (j = begin; j < end; ++j) {
+			v = queue[j];
+			c = yadsl_graphcolor_first_fit_internal(&adj, v, result, stamps);
+			result[v] = c;
+			if (c >= color_count)
+				color_count = c + 1;
+		}
+		for (j = begin; j < end; ++j) {
+			v = queue[j];
+			for (i = adj.offsets[v]; i < adj.offsets[v + 1]; ++i) {
+				w = adj.neighbours[i];
+				if (YADSL_GRAPHCOLOR_JP_BEFORE(v, w) && --waiting[w] == 0)
+					queue[tail++] = w;
+			}
+		}
+	}
+	assert(tail == vertex_count);
+
+#undef YADSL_GRAPHCOLOR_JP_BEFORE
+
+	if (result != colors)
+		yadsl_graphcolor_output_internal(graph, result, vertex_count);
+	*color_count_ptr = color_count;
+	if (round_count_ptr)
+		*round_count_ptr = round_count;
+	ret = YADSL_GRAPHCOLOR_RET_OK;
+exit:
+	if (result && result != colors)
+		free(result);
+	if (queue)
+		free(queue);
+	if (waiting)
+		free(waiting);
+	if (stamps)
+		free(stamps);
+	if (priorities)
+		free(priorities);
+	yadsl_graphcolor_adjacency_destroy_internal(&adj);
+	return ret;
+}
+
+yadsl_GraphColorRet yadsl_graphcolor_check(
+	yadsl_GraphHandle* graph,
+	const size_t* colors,
+	bool* is_valid_ptr)
+{
+	size_t edge_count, id, u, v;
+	yadsl_GraphEdgeWeight weight;
+	if (yadsl_graph_edge_count_get(graph, &edge_count)) assert(0);
+	for (id = 0; id < edge_count; ++id) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+		if (u != v && colors[u] == colors[v]) {
+			*is_valid_ptr = false;
+			return YADSL_GRAPHCOLOR_RET_OK;
+		}
+	}
+	*is_valid_ptr = true;
+	return YADSL_GRAPHCOLOR_RET_OK;
+}
+
+/**************************************/
+/*  Private functions implementation  */
+/**************************************/
+
+// Builds adjacency lists from the edge endpoints (by id)
+bool yadsl_graphcolor_adjacency_create_internal(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphColorAdjacency* adj)
+{
+	size_t vertex_count, edge_count, entry_count, id, u, v;
+	yadsl_GraphEdgeWeight weight;
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (yadsl_graph_edge_count_get(graph, &edge_count)) assert(0);
+	adj->vertex_count = vertex_count;
+	adj->neighbours = NULL;
+	adj->offsets = malloc((vertex_count + 1) * sizeof(*adj->offsets));
+	if (adj->offsets == NULL)
+		return false;
+	for (u = 0; u <= vertex_count; ++u)
+		adj->offsets[u] = 0;
+	for (id = 0; id < edge_count; ++id) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+		if (u != v) {
+			++adj->offsets[u + 1];
+			++adj->offsets[v + 1];
+		}
+	}
+	for (u = 0; u < vertex_count; ++u)
+		adj->offsets[u + 1] += adj->offsets[u];
+	entry_count = adj->offsets[vertex_count];
+	if (entry_count > 0) {
+		adj->neighbours = malloc(entry_count * sizeof(*adj->neighbours));
+		if (adj->neighbours == NULL) {
+			free(adj->offsets);
+			adj->offsets = NULL;
+			return false;
+		}
+	}
+	/* Fill rows backwards, so that offsets end up at the start of each row */
+	for (id = edge_count; id-- > 0;) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+		if (u != v) {
+			adj->neighbours[--adj->offsets[u + 1]] = v;
+			adj->neighbours[--adj->offsets[v + 1]] = u;
+		}
+	}
+	/* Row u now starts at offsets[u + 1], so shift them back */
+	for (u = 0; u < vertex_count; ++u)
+		adj->offsets[u] = adj->offsets[u + 1];
+	adj->offsets[vertex_count] = entry_count;
+	return true;
+}
+
+void yadsl_graphcolor_adjacency_destroy_internal(
+	yadsl_GraphColorAdjacency* adj)
+{
+	if (adj->offsets)
+		free(adj->offsets);
+	if (adj->neighbours)
+		free(adj->neighbours);
+}
+
+// Smallest colour not used by the coloured neighbours of v
+// (stamps must have vertex_count entries, never equal to v + 1 on entry)
+size_t yadsl_graphcolor_first_fit_internal(
+	yadsl_GraphColorAdjacency* adj,
+	size_t v,
+	const size_t* colors,
+	size_t* stamps)
+{
+	size_t i, c;
+	for (i = adj->offsets[v]; i < adj->offsets[v + 1]; ++i) {
+		c = colors[adj->neighbours[i]];
+		if (c != YADSL_GRAPHCOLOR_NONE && c < adj->vertex_count)
+			stamps[c] = v + 1;
+	}
+	for (c = 0; stamps[c] == v + 1; ++c);
+	return c;
+}
+
+// Writes colours to vertex flags
+void yadsl_graphcolor_output_internal(
+	yadsl_GraphHandle* graph,
+	const size_t* colors,
+	size_t vertex_count)
+{
+	size_t v;
+	for (v = 0; v < vertex_count; ++v)
+		if (yadsl_graph_vertex_flag_by_id_set(graph, v, (yadsl_GraphVertexFlag) colors[v]))
+			assert(0);
+}
+
+// Higher saturation first, then higher degree, then lower id
+bool yadsl_graphcolor_dsatur_entry_before_internal(
+	const yadsl_GraphColorDsaturEntry* a,
+	const yadsl_GraphColorDsaturEntry* b)
+{
+	if (a->saturation != b->saturation)
+		return a->saturation > b->saturation;
+	if (a->degree != b->degree)
+		return a->degree > b->degree;
+	return a->vertex < b->vertex;
+}
+
+void yadsl_graphcolor_dsatur_push_internal(
+	yadsl_GraphColorDsaturEntry* heap,
+	size_t* size_ptr,
+	yadsl_GraphColorDsaturEntry entry)
+{
+	size_t i = (*size_ptr)++, parent;
+	while (i > 0) {
+		parent = (i - 1) / 2;
+		if (!yadsl_graphcolor_dsatur_entry_before_internal(&entry, &heap[parent]))
+			break;
+		heap[i] = heap[parent];
+		i = parent;
+	}
+	heap[i] = entry;
+}
+
+yadsl_GraphColorDsaturEntry yadsl_graphcolor_dsatur_pop_internal(
+	yadsl_GraphColorDsaturEntry* heap,
+	size_t* size_ptr)
+{
+	yadsl_GraphColorDsaturEntry top = heap[0], last = heap[--(*size_ptr)];
+	size_t size = *size_ptr, i = 0, child;
+	while ((child = 2 * i + 1) < size) {
+		if (child + 1 < size &&
+			yadsl_graphcolor_dsatur_entry_before_internal(&heap[child + 1], &heap[child]))
+			++child;
+		if (!yadsl_graphcolor_dsatur_entry_before_internal(&heap[child], &last))
+			break;
+		heap[i] = heap[child];
+		i = child;
+	}
+	if (size > 0)
+		heap[i] = last;
+	return top;
+}
+
+// Inserts (vertex, colour) and returns whether it was not in the set
+bool yadsl_graphcolor_pair_set_insert_internal(
+	yadsl_GraphColorPairSet* set,
+	size_t vertex,
+	size_t color)
+{
+	uint64_t hash = ((uint64_t) vertex * UINT64_C(0x9E3779B97F4A7C15)) ^
+		((uint64_t) color * UINT64_C(0xC2B2AE3D27D4EB4F));
+	size_t i = (size_t) (hash ^ (hash >> 29)) & set->mask;
+	while (set->vertices[i]) {
+		if (set->vertices[i] == vertex + 1 && set->colors[i] == color)
+			return false;
+		i = (i + 1) & set->mask;
+	}
+	set->vertices[i] = vertex + 1;
+	set->colors[i] = color;
+	return true;
+}
+
+// xorshift64*
+uint64_t yadsl_graphcolor_random_internal(
+	uint64_t* state_ptr)
+{
+	uint64_t x = *state_ptr;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state_ptr = x;
+	return x * UINT64_C(0x2545F4914F6CDD1D);
+}
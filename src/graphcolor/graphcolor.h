@@ -0,0 +1,118 @@
+#ifndef __YADSL_GRAPHCOLOR_H__
+#define __YADSL_GRAPHCOLOR_H__
+
+/**
+ * \defgroup graphcolor Graph Colouring
+ * @brief Auxiliary module for colouring the vertices of Graphs.
+ *
+ * A colouring assigns a colour (0, 1, 2...) to every vertex so that
+ * no two adjacent vertices share the same colour. Edge direction is
+ * ignored, and so are self-loops. Vertices of the same colour form
+ * an independent set.
+ *
+ * Colours are written to an array indexed by vertex id (see \ref graph)
+ * or, if no array is given, to the vertex flags.
+ *
+ * @{
+*/
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <graph/graph.h>
+
+/**
+ * @brief Return condition of Graph Colouring functions
+*/
+typedef enum
+{
+	YADSL_GRAPHCOLOR_RET_OK = 0, /**< All went ok */
+	YADSL_GRAPHCOLOR_RET_MEMORY, /**< Could not allocate memory */
+	YADSL_GRAPHCOLOR_RET_PARAMETER, /**< Invalid parameter */
+}
+yadsl_GraphColorRet;
+
+/**
+ * @brief Colour vertices greedily, in a given order
+ *
+ * Every vertex gets the smallest colour not used by its
+ * already coloured neighbours. Runs in O(n + m).
+ *
+ * @param graph graph
+ * @param order permutation of the vertex ids, or NULL for increasing id order
+ * @param colors colour of each vertex (by id), or NULL for vertex flags
+ * @param color_count_ptr number of colours used
+ * @return
+ * * ::YADSL_GRAPHCOLOR_RET_OK, and colours and *color_count_ptr are updated
+ * * ::YADSL_GRAPHCOLOR_RET_PARAMETER, if order is not a permutation
+ * * ::YADSL_GRAPHCOLOR_RET_MEMORY
+*/
+yadsl_GraphColorRet
+yadsl_graphcolor_greedy(
+	yadsl_GraphHandle* graph,
+	const size_t* order,
+	size_t* colors,
+	size_t* color_count_ptr);
+
+/**
+ * @brief Colour vertices with the DSATUR heuristic
+ *
+ * Vertices are coloured greedily, always picking next the vertex with
+ * the most distinct colours among its neighbours (saturation), breaking
+ * ties by degree and then by id. Runs in O((n + m) log(n + m)).
+ *
+ * @param graph graph
+ * @param colors colour of each vertex (by id), or NULL for vertex flags
+ * @param color_count_ptr number of colours used
+ * @return
+ * * ::YADSL_GRAPHCOLOR_RET_OK, and colours and *color_count_ptr are updated
+ * * ::YADSL_GRAPHCOLOR_RET_MEMORY
+*/
+yadsl_GraphColorRet
+yadsl_graphcolor_dsatur(
+	yadsl_GraphHandle* graph,
+	size_t* colors,
+	size_t* color_count_ptr);
+
+/**
+ * @brief Colour vertices with the Jones-Plassmann algorithm
+ *
+ * Every vertex gets a pseudo-random priority. In each round, the
+ * uncoloured vertices with higher priority than all of their uncoloured
+ * neighbours form an independent set, and are coloured greedily.
+ * Runs in O(n + m).
+ *
+ * @param graph graph
+ * @param seed seed of the priorities
+ * @param colors colour of each vertex (by id), or NULL for vertex flags
+ * @param color_count_ptr number of colours used
+ * @param round_count_ptr number of rounds (nullable)
+ * @return
+ * * ::YADSL_GRAPHCOLOR_RET_OK, and colours and *color_count_ptr are updated
+ * * ::YADSL_GRAPHCOLOR_RET_MEMORY
+*/
+yadsl_GraphColorRet
+yadsl_graphcolor_jones_plassmann(
+	yadsl_GraphHandle* graph,
+	unsigned long seed,
+	size_t* colors,
+	size_t* color_count_ptr,
+	size_t* round_count_ptr);
+
+/**
+ * @brief Check whether no two adjacent vertices share the same colour
+ * @param graph graph
+ * @param colors colour of each vertex (by id)
+ * @param is_valid_ptr whether colouring is valid
+ * @return
+ * * ::YADSL_GRAPHCOLOR_RET_OK, and *is_valid_ptr is updated
+*/
+yadsl_GraphColorRet
+yadsl_graphcolor_check(
+	yadsl_GraphHandle* graph,
+	const size_t* colors,
+	bool* is_valid_ptr);
+
+/** @} */
+
+#endif
@@ -0,0 +1,710 @@
+#include <graphcsr/graphcsr.h>
+
+#include <assert.h>
+#include <string.h>
+
+#ifdef YADSL_DEBUG
+#include <memdb/memdb.h>
+#else
+#include <stdlib.h>
+#endif
+
+/*******************************************************************************
+* Graph CSR data structure invariants
+********************************************************************************
+*
+* I) The snapshot row of vertex u spans the positions offsets[u] (inclusive)
+* to offsets[u + 1] (exclusive) of targets and weights, sorted by target.
+*
+* II) A vertex has a delta iff it has pending changes, that is, iff its
+* insertion or tombstone logs are not empty.
+*
+* III) The insertion log of u is sorted and never contains a target that is
+* in the snapshot row of u (tombstoned or not). Re-adding a tombstoned edge
+* removes its tombstone instead.
+*
+* IV) The tombstone log of u holds positions of the snapshot row of u,
+* sorted in increasing order.
+*
+* V) On undirected graphs, the row of u contains v iff the row of v contains u.
+*
+*******************************************************************************/
+
+typedef struct
+{
+	size_t* targets; /**< inserted neighbours (sorted) */
+	yadsl_GraphEdgeWeight* weights; /**< weights of inserted neighbours */
+	size_t insert_count; /**< size of the insertion log */
+	size_t insert_capacity; /**< capacity of the insertion log */
+	size_t* tombstones; /**< removed snapshot positions (sorted) */
+	size_t tombstone_count; /**< size of the tombstone log */
+	size_t tombstone_capacity; /**< capacity of the tombstone log */
+}
+yadsl_GraphCsrDelta;
+
+typedef struct
+{
+	bool is_directed; /**< whether graph is directed or not */
+	yadsl_GraphEdgeWeightType weight_type; /**< type of edge weights */
+	size_t vertex_count; /**< number of vertices */
+	size_t edge_count; /**< number of edges (including pending changes) */
+	size_t* offsets; /**< start of each row (vertex_count + 1 entries) */
+	size_t* targets; /**< neighbours of every row */
+	yadsl_GraphEdgeWeight* weights; /**< weights of every row */
+	yadsl_GraphCsrDelta** deltas; /**< pending changes of each vertex (or NULL) */
+	size_t delta_size; /**< total size of every log */
+}
+yadsl_GraphCsr;
+
+typedef struct
+{
+	size_t source;
+	size_t target;
+	yadsl_GraphEdgeWeight weight;
+}
+yadsl_GraphCsrEntry;
+
+#define cast_(csr) yadsl_GraphCsr* csr ## _ = (yadsl_GraphCsr*) csr
+
+/**********************************/
+/*  Private functions prototypes  */
+/**********************************/
+
+static bool yadsl_graphcsr_search_internal(
+	const size_t* array,
+	size_t count,
+	size_t value,
+	size_t* index_ptr);
+
+static bool yadsl_graphcsr_base_find_internal(
+	yadsl_GraphCsr* csr,
+	size_t u,
+	size_t v,
+	size_t* pos_ptr);
+
+static yadsl_GraphEdgeWeight* yadsl_graphcsr_edge_find_internal(
+	yadsl_GraphCsr* csr,
+	size_t u,
+	size_t v);
+
+static bool yadsl_graphcsr_array_reserve_internal(
+	void** array_ptr,
+	size_t* capacity_ptr,
+	size_t count,
+	size_t size);
+
+static bool yadsl_graphcsr_row_reserve_internal(
+	yadsl_GraphCsr* csr,
+	size_t u,
+	size_t v,
+	bool is_insertion);
+
+static void yadsl_graphcsr_row_add_internal(
+	yadsl_GraphCsr* csr,
+	size_t u,
+	size_t v,
+	yadsl_GraphEdgeWeight weight);
+
+static void yadsl_graphcsr_row_remove_internal(
+	yadsl_GraphCsr* csr,
+	size_t u,
+	size_t v);
+
+static void yadsl_graphcsr_delta_trim_internal(
+	yadsl_GraphCsr* csr,
+	size_t u);
+
+static void yadsl_graphcsr_delta_free_internal(
+	yadsl_GraphCsrDelta* delta);
+
+/**********************/
+/*  Public functions  */
+/**********************/
+
+yadsl_GraphCsrRet yadsl_graphcsr_create(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphCsrHandle** csr_ptr)
+{
+	yadsl_GraphCsr* csr;
+	yadsl_GraphCsrEntry* entries = NULL, * sorted = NULL;
+	size_t* counts = NULL;
+	size_t vertex_count, edge_count, entry_count, i, u, v;
+	yadsl_GraphEdgeWeight weight;
+	csr = malloc(sizeof(*csr));
+	if (csr == NULL)
+		return YADSL_GRAPHCSR_RET_MEMORY;
+	if (yadsl_graph_is_directed_check(graph, &csr->is_directed)) assert(0);
+	if (yadsl_graph_edge_weight_type_get(graph, &csr->weight_type)) assert(0);
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (yadsl_graph_edge_count_get(graph, &edge_count)) assert(0);
+	csr->vertex_count = vertex_count;
+	csr->edge_count = edge_count;
+	csr->delta_size = 0;
+	csr->targets = NULL;
+	csr->weights = NULL;
+	csr->deltas = NULL;
+	csr->offsets = malloc((vertex_count + 1) * sizeof(*csr->offsets));
+	if (csr->offsets == NULL)
+		goto fail;
+	if (vertex_count > 0) {
+		csr->deltas = malloc(vertex_count * sizeof(*csr->deltas));
+		if (csr->deltas == NULL)
+			goto fail;
+		for (u = 0; u < vertex_count; ++u)
+			csr->deltas[u] = NULL;
+	}
+
+	/* One entry per edge, and another for the reverse of undirected edges */
+	entry_count = 0;
+	if (edge_count > 0) {
+		entries = malloc(2 * edge_count * sizeof(*entries));
+		if (entries == NULL)
+			goto fail;
+	}
+	for (i = 0; i < edge_count; ++i) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, i, &u, &v, &weight)) assert(0);
+		entries[entry_count].source = u;
+		entries[entry_count].target = v;
+		entries[entry_count++].weight = weight;
+		if (!csr->is_directed && u != v) {
+			entries[entry_count].source = v;
+			entries[entry_count].target = u;
+			entries[entry_count++].weight = weight;
+		}
+	}
+	if (entry_count > 0) {
+		sorted = malloc(entry_count * sizeof(*sorted));
+		if (sorted == NULL)
+			goto fail;
+		csr->targets = malloc(entry_count * sizeof(*csr->targets));
+		if (csr->targets == NULL)
+			goto fail;
+		csr->weights = malloc(entry_count * sizeof(*csr->weights));
+		if (csr->weights == NULL)
+			goto fail;
+	}
+	counts = malloc((vertex_count + 1) * sizeof(*counts));
+	if (counts == NULL)
+		goto fail;
+
+	/* Counting sort by target, and then (stably) by source */
+	for (u = 0; u <= vertex_count; ++u)
+		counts[u] = 0;
+	for (i = 0; i < entry_count; ++i)
+		++counts[entries[i].target + 1];
+	for (u = 0; u < vertex_count; ++u)
+		counts[u + 1] += counts[u];
+	for (i = 0; i < entry_count; ++i)
+		sorted[counts[entries[i].target]++] = entries[i];
+	for (u = 0; u <= vertex_count; ++u)
+		csr->offsets[u] = 0;
+	for (i = 0; i < entry_count; ++i)
+		++csr->offsets[sorted[i].source + 1];
+	for (u = 0; u < vertex_count; ++u) {
+		csr->offsets[u + 1] += csr->offsets[u];
+		counts[u] = csr->offsets[u];
+	}
+	for (i = 0; i < entry_count; ++i) {
+		size_t pos = counts[sorted[i].source]++;
+		csr->targets[pos] = sorted[i].target;
+		csr->weights[pos] = sorted[i].weight;
+	}
+
+	free(counts);
+	if (entries)
+		free(entries);
+	if (sorted)
+		free(sorted);
+	*csr_ptr = csr;
+	return YADSL_GRAPHCSR_RET_OK;
+fail:
+	if (counts)
+		free(counts);
+	if (entries)
+		free(entries);
+	if (sorted)
+		free(sorted);
+	yadsl_graphcsr_destroy(csr);
+	return YADSL_GRAPHCSR_RET_MEMORY;
+}
+
+yadsl_GraphCsrRet yadsl_graphcsr_vertex_count_get(
+	yadsl_GraphCsrHandle* csr,
+	size_t* vertex_count_ptr)
+{
+	cast_(csr);
+	*vertex_count_ptr = csr_->vertex_count;
+	return YADSL_GRAPHCSR_RET_OK;
+}
+
+yadsl_GraphCsrRet yadsl_graphcsr_edge_count_get(
+	yadsl_GraphCsrHandle* csr,
+	size_t* edge_count_ptr)
+{
+	cast_(csr);
+	*edge_count_ptr = csr_->edge_count;
+	return YADSL_GRAPHCSR_RET_OK;
+}
+
+yadsl_GraphCsrRet yadsl_graphcsr_delta_size_get(
+	yadsl_GraphCsrHandle* csr,
+	size_t* delta_size_ptr)
+{
+	cast_(csr);
+	*delta_size_ptr = csr_->delta_size;
+	return YADSL_GRAPHCSR_RET_OK;
+}
+
+yadsl_GraphCsrRet yadsl_graphcsr_edge_add(
+	yadsl_GraphCsrHandle* csr,
+	size_t u,
+	size_t v,
+	yadsl_GraphEdgeWeight weight)
+{
+	bool is_symmetric;
+	cast_(csr);
+	if (u >= csr_->vertex_count || v >= csr_->vertex_count)
+		return YADSL_GRAPHCSR_RET_PARAMETER;
+	if (yadsl_graphcsr_edge_find_internal(csr_, u, v))
+		return YADSL_GRAPHCSR_RET_CONTAINS_EDGE;
+	if (csr_->weight_type == YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE)
+		weight = yadsl_graph_edge_weight_from_double(csr_->weight_type, 0);
+	is_symmetric = !csr_->is_directed && u != v;
+	/* Allocate first, so that both rows are updated or neither is */
+	if (!yadsl_graphcsr_row_reserve_internal(csr_, u, v, true) ||
+		(is_symmetric && !yadsl_graphcsr_row_reserve_internal(csr_, v, u, true))) {
+		yadsl_graphcsr_delta_trim_internal(csr_, u);
+		yadsl_graphcsr_delta_trim_internal(csr_, v);
+		return YADSL_GRAPHCSR_RET_MEMORY;
+	}
+	yadsl_graphcsr_row_add_internal(csr_, u, v, weight);
+	if (is_symmetric)
+		yadsl_graphcsr_row_add_internal(csr_, v, u, weight);
+	yadsl_graphcsr_delta_trim_internal(csr_, u);
+	yadsl_graphcsr_delta_trim_internal(csr_, v);
+	++csr_->edge_count;
+	return YADSL_GRAPHCSR_RET_OK;
+}
+
+yadsl_GraphCsrRet yadsl_graphcsr_edge_remove(
+	yadsl_GraphCsrHandle* csr,
+	size_t u,
+	size_t v)
+{
+	bool is_symmetric;
+	cast_(csr);
+	if (u >= csr_->vertex_count || v >= csr_->vertex_count)
+		return YADSL_GRAPHCSR_RET_PARAMETER;
+	if (!yadsl_graphcsr_edge_find_internal(csr_, u, v))
+		return YADSL_GRAPHCSR_RET_DOES_NOT_CONTAIN_EDGE;
+	is_symmetric = !csr_->is_directed && u != v;
+	if (!yadsl_graphcsr_row_reserve_internal(csr_, u, v, false) ||
+		(is_symmetric && !yadsl_graphcsr_row_reserve_internal(csr_, v, u, false))) {
+		yadsl_graphcsr_delta_trim_internal(csr_, u);
+		yadsl_graphcsr_delta_trim_internal(csr_, v);
+		return YADSL_GRAPHCSR_RET_MEMORY;
+	}
+	yadsl_graphcsr_row_remove_internal(csr_, u, v);
+	if (is_symmetric)
+		yadsl_graphcsr_row_remove_internal(csr_, v, u);
+	yadsl_graphcsr_delta_trim_internal(csr_, u);
+	yadsl_graphcsr_delta_trim_internal(csr_, v);
+	--csr_->edge_count;
+	return YADSL_GRAPHCSR_RET_OK;
+}
+
+yadsl_GraphCsrRet yadsl_graphcsr_edge_exists_check(
+	yadsl_GraphCsrHandle* csr,
+	size_t u,
+	size_t v,
+	bool* contains_ptr)
+{
+	cast_(csr);
+	if (u >= csr_->vertex_count || v >= csr_->vertex_count)
+		return YADSL_GRAPHCSR_RET_PARAMETER;
+	*contains_ptr = yadsl_graphcsr_edge_find_internal(csr_, u, v) != NULL;
+	return YADSL_GRAPHCSR_RET_OK;
+}
+
+yadsl_GraphCsrRet yadsl_graphcsr_edge_weight_get(
+	yadsl_GraphCsrHandle* csr,
+	size_t u,
+	size_t v,
+	yadsl_GraphEdgeWeight* weight_ptr)
+{
+	yadsl_GraphEdgeWeight* weight;
+	cast_(csr);
+	if (u >= csr_->vertex_count || v >= csr_->vertex_count)
+		return YADSL_GRAPHCSR_RET_PARAMETER;
+	if (!(weight = yadsl_graphcsr_edge_find_internal(csr_, u, v)))
+		return YADSL_GRAPHCSR_RET_DOES_NOT_CONTAIN_EDGE;
+	*weight_ptr = *weight;
+	return YADSL_GRAPHCSR_RET_OK;
+}
+
+yadsl_GraphCsrRet yadsl_graphcsr_vertex_degree_get(
+	yadsl_GraphCsrHandle* csr,
+	size_t u,
+	size_t* degree_ptr)
+{
+	yadsl_GraphCsrDelta* delta;
+	size_t degree;
+	cast_(csr);
+	if (u >= csr_->vertex_count)
+		return YADSL_GRAPHCSR_RET_PARAMETER;
+	degree = csr_->offsets[u + 1] - csr_->offsets[u];
+	if (delta = csr_->deltas[u])
+		degree = degree - delta->tombstone_count + delta->insert_count;
+	*degree_ptr = degree;
+	return YADSL_GRAPHCSR_RET_OK;
+}
+
+yadsl_GraphCsrRet yadsl_graphcsr_nb_iter_begin(
+	yadsl_GraphCsrHandle* csr,
+	size_t u,
+	yadsl_GraphCsrNbIter* iter)
+{
+	cast_(csr);
+	if (u >= csr_->vertex_count)
+		return YADSL_GRAPHCSR_RET_PARAMETER;
+	iter->csr = csr;
+	iter->vertex = u;
+	iter->base = csr_->offsets[u];
+	iter->tombstone = 0;
+	iter->insert = 0;
+	return YADSL_GRAPHCSR_RET_OK;
+}
+
+yadsl_GraphCsrRet yadsl_graphcsr_nb_iter_next(
+	yadsl_GraphCsrNbIter* iter,
+	size_t* v_ptr,
+	yadsl_GraphEdgeWeight* weight_ptr)
+{
+	yadsl_GraphCsr* csr_ = (yadsl_GraphCsr*) iter->csr;
+	yadsl_GraphCsrDelta* delta = csr_->deltas[iter->vertex];
+	size_t end = csr_->offsets[iter->vertex + 1];
+	if (delta) {
+		/* Skip removed neighbours (see invariant IV) */
+		while (iter->base < end &&
+			iter->tombstone < delta->tombstone_count &&
+			delta->tombstones[iter->tombstone] == iter->base) {
+			++iter->base;
+			++iter->tombstone;
+		}
+		if (iter->insert < delta->insert_count &&
+			(iter->base == end || delta->targets[iter->insert] < csr_->targets[iter->base])) {
+			*v_ptr = delta->targets[iter->insert];
+			*weight_ptr = delta->weights[iter->insert];
+			++iter->insert;
+			return YADSL_GRAPHCSR_RET_OK;
+		}
+	}
+	if (iter->base == end)
+		return YADSL_GRAPHCSR_RET_OUT_OF_BOUNDS;
+	*v_ptr = csr_->targets[iter->base];
+	*weight_ptr = csr_->weights[iter->base];
+	++iter->base;
+	return YADSL_GRAPHCSR_RET_OK;
+}
+
+yadsl_GraphCsrRet yadsl_graphcsr_compact(
+	yadsl_GraphCsrHandle* csr)
+{
+	size_t* offsets, * targets = NULL;
+	yadsl_GraphEdgeWeight* weights = NULL;
+	yadsl_GraphCsrNbIter iter;
+	size_t entry_count, u, pos;
+	cast_(csr);
+	if (csr_->delta_size == 0)
+		return YADSL_GRAPHCSR_RET_OK;
+	offsets = malloc((csr_->vertex_count + 1) * sizeof(*offsets));
+	if (offsets == NULL)
+		return YADSL_GRAPHCSR_RET_MEMORY;
+	entry_count = csr_->offsets[csr_->vertex_count];
+	for (u = 0; u < csr_->vertex_count; ++u)
+		if (csr_->deltas[u])
+			entry_count = entry_count - csr_->deltas[u]->tombstone_count
+				+ csr_->deltas[u]->insert_count;
+	if (entry_count > 0) {
+		targets = malloc(entry_count * sizeof(*targets));
+		weights = malloc(entry_count * sizeof(*weights));
+		if (targets == NULL || weights == NULL) {
+			if (targets)
+				free(targets);
+			if (weights)
+				free(weights);
+			free(offsets);
+			return YADSL_GRAPHCSR_RET_MEMORY;
+		}
+	}
+	pos = 0;
+	for (u = 0; u < csr_->vertex_count; ++u) {
+		offsets[u] = pos;
+		if (yadsl_graphcsr_nb_iter_begin(csr, u, &iter)) assert(0);
+		while (yadsl_graphcsr_nb_iter_next(&iter, &targets[pos], &weights[pos]) == YADSL_GRAPHCSR_RET_OK)
+			++pos;
+	}
+	offsets[csr_->vertex_count] = pos;
+	assert(pos == entry_count);
+	for (u = 0; u < csr_->vertex_count; ++u) {
+		if (csr_->deltas[u]) {
+			yadsl_graphcsr_delta_free_internal(csr_->deltas[u]);
+			csr_->deltas[u] = NULL;
+		}
+	}
+	free(csr_->offsets);
+	if (csr_->targets)
+		free(csr_->targets);
+	if (csr_->weights)
+		free(csr_->weights);
+	csr_->offsets = offsets;
+	csr_->targets = targets;
+	csr_->weights = weights;
+	csr_->delta_size = 0;
+	return YADSL_GRAPHCSR_RET_OK;
+}
+
+void yadsl_graphcsr_destroy(
+	yadsl_GraphCsrHandle* csr)
+{
+	size_t u;
+	cast_(csr);
+	if (csr == NULL)
+		return;
+	if (csr_->deltas) {
+		for (u = 0; u < csr_->vertex_count; ++u)
+			if (csr_->deltas[u])
+				yadsl_graphcsr_delta_free_internal(csr_->deltas[u]);
+		free(csr_->deltas);
+	}
+	if (csr_->offsets)
+		free(csr_->offsets);
+	if (csr_->targets)
+		free(csr_->targets);
+	if (csr_->weights)
+		free(csr_->weights);
+	free(csr_);
+}
+
+/**************************************/
+/*  Private functions implementation  */
+/**************************************/
+
+// Binary search for value in a sorted array
+// Returns whether value was found, and *index_ptr is either
+// its index, or the index where it should be inserted
+bool yadsl_graphcsr_search_internal(
+	const size_t* array,
+	size_t count,
+	size_t value,
+	size_t* index_ptr)
+{
+	size_t low = 0, high = count, mid;
+	while (low < high) {
+		mid = low + (high - low) / 2;
+		if (array[mid] < value)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	*index_ptr = low;
+	return low < count && array[low] == value;
+}
+
+// Finds v in the snapshot row of u (tombstoned or not)
+bool yadsl_graphcsr_base_find_internal(
+	yadsl_GraphCsr* csr,
+	size_t u,
+	size_t v,
+	size_t* pos_ptr)
+{
+	size_t begin = csr->offsets[u], index;
+	bool found = yadsl_graphcsr_search_internal(
+		csr->targets + begin,
+		csr->offsets[u + 1] - begin,
+		v,
+		&index);
+	*pos_ptr = begin + index;
+	return found;
+}
+
+// Returns the weight of edge uv, or NULL if there is no such edge
+yadsl_GraphEdgeWeight* yadsl_graphcsr_edge_find_internal(
+	yadsl_GraphCsr* csr,
+	size_t u,
+	size_t v)
+{
+	yadsl_GraphCsrDelta* delta = csr->deltas[u];
+	size_t pos, index;
+	if (yadsl_graphcsr_base_find_internal(csr, u, v, &pos)) {
+		if (delta && yadsl_graphcsr_search_internal(
+			delta->tombstones, delta->tombstone_count, pos, &index))
+			return NULL;
+		return &csr->weights[pos];
+	}
+	if (delta && yadsl_graphcsr_search_internal(
+		delta->targets, delta->insert_count, v, &index))
+		return &delta->weights[index];
+	return NULL;
+}
+
+// Grows array so that it fits at least count elements of a given size
+bool yadsl_graphcsr_array_reserve_internal(
+	void** array_ptr,
+	size_t* capacity_ptr,
+	size_t count,
+	size_t size)
+{
+	size_t new_capacity;
+	void* new_array;
+	if (count <= *capacity_ptr)
+		return true;
+	new_capacity = *capacity_ptr ? *capacity_ptr * 2 : 4;
+	if (new_capacity < count)
+		new_capacity = count;
+	if (*array_ptr)
+		new_array = realloc(*array_ptr, new_capacity * size);
+	else
+		new_array = malloc(new_capacity * size);
+	if (new_array == NULL)
+		return false;
+	*array_ptr = new_array;
+	*capacity_ptr = new_capacity;
+	return true;
+}
+
+// Ensures that adding (or removing) v to (or from) the row of u
+// won't need to allocate memory
+bool yadsl_graphcsr_row_reserve_internal(
+	yadsl_GraphCsr* csr,
+	size_t u,
+	size_t v,
+	bool is_insertion)
+{
+	yadsl_GraphCsrDelta* delta = csr->deltas[u];
+	size_t pos, capacity;
+	if (yadsl_graphcsr_base_find_internal(csr, u, v, &pos) == is_insertion)
+		return true; /* only touches the tombstone log (insertion)
+		                or the insertion log (removal) */
+	if (delta == NULL) {
+		delta = malloc(sizeof(*delta));
+		if (delta == NULL)
+			return false;
+		delta->targets = NULL;
+		delta->weights = NULL;
+		delta->insert_count = 0;
+		delta->insert_capacity = 0;
+		delta->tombstones = NULL;
+		delta->tombstone_count = 0;
+		delta->tombstone_capacity = 0;
+		csr->deltas[u] = delta;
+	}
+	if (is_insertion) {
+		capacity = delta->insert_capacity;
+		if (!yadsl_graphcsr_array_reserve_internal((void**) &delta->targets,
+			&capacity, delta->insert_count + 1, sizeof(*delta->targets)))
+			return false;
+		capacity = delta->insert_capacity;
+		if (!yadsl_graphcsr_array_reserve_internal((void**) &delta->weights,
+			&capacity, delta->insert_count + 1, sizeof(*delta->weights)))
+			return false;
+		delta->insert_capacity = capacity;
+	} else {
+		capacity = delta->tombstone_capacity;
+		if (!yadsl_graphcsr_array_reserve_internal((void**) &delta->tombstones,
+			&capacity, delta->tombstone_count + 1, sizeof(*delta->tombstones)))
+			return false;
+		delta->tombstone_capacity = capacity;
+	}
+	return true;
+}
+
+// Adds v to the row of u (assumes it is not there and that
+// yadsl_graphcsr_row_reserve_internal was called before)
+void yadsl_graphcsr_row_add_internal(
+	yadsl_GraphCsr* csr,
+	size_t u,
+	size_t v,
+	yadsl_GraphEdgeWeight weight)
+{
+	yadsl_GraphCsrDelta* delta = csr->deltas[u];
+	size_t pos, index;
+	if (yadsl_graphcsr_base_find_internal(csr, u, v, &pos)) {
+		/* Tombstoned (see invariant III) */
+		if (!yadsl_graphcsr_search_internal(
+			delta->tombstones, delta->tombstone_count, pos, &index))
+			assert(0);
+		memmove(delta->tombstones + index, delta->tombstones + index + 1,
+			(delta->tombstone_count - index - 1) * sizeof(*delta->tombstones));
+		--delta->tombstone_count;
+		--csr->delta_size;
+		csr->weights[pos] = weight;
+	} else {
+		if (yadsl_graphcsr_search_internal(
+			delta->targets, delta->insert_count, v, &index))
+			assert(0);
+		memmove(delta->targets + index + 1, delta->targets + index,
+			(delta->insert_count - index) * sizeof(*delta->targets));
+		memmove(delta->weights + index + 1, delta->weights + index,
+			(delta->insert_count - index) * sizeof(*delta->weights));
+		delta->targets[index] = v;
+		delta->weights[index] = weight;
+		++delta->insert_count;
+		++csr->delta_size;
+	}
+}
+
+// Removes v from the row of u (assumes it is there and that
+// yadsl_graphcsr_row_reserve_internal was called before)
+void yadsl_graphcsr_row_remove_internal(
+	yadsl_GraphCsr* csr,
+	size_t u,
+	size_t v)
+{
+	yadsl_GraphCsrDelta* delta = csr->deltas[u];
+	size_t pos, index;
+	if (yadsl_graphcsr_base_find_internal(csr, u, v, &pos)) {
+		if (yadsl_graphcsr_search_internal(
+			delta->tombstones, delta->tombstone_count, pos, &index))
+			assert(0);
+		memmove(delta->tombstones + index + 1, delta->tombstones + index,
+			(delta->tombstone_count - index) * sizeof(*delta->tombstones));
+		delta->tombstones[index] = pos;
+		++delta->tombstone_count;
+		++csr->delta_size;
+	} else {
+		if (!yadsl_graphcsr_search_internal(
+			delta->targets, delta->insert_count, v, &index))
+			assert(0);
+		memmove(delta->targets + index, delta->targets + index + 1,
+			(delta->insert_count - index - 1) * sizeof(*delta->targets));
+		memmove(delta->weights + index, delta->weights + index + 1,
+			(delta->insert_count - index - 1) * sizeof(*delta->weights));
+		--delta->insert_count;
+		--csr->delta_size;
+	}
+}
+
+// Frees the delta of u if it has no pending changes (see invariant II)
+void yadsl_graphcsr_delta_trim_internal(
+	yadsl_GraphCsr* csr,
+	size_t u)
+{
+	yadsl_GraphCsrDelta* delta = csr->deltas[u];
+	if (delta && delta->insert_count == 0 && delta->tombstone_count == 0) {
+		yadsl_graphcsr_delta_free_internal(delta);
+		csr->deltas[u] = NULL;
+	}
+}
+
+void yadsl_graphcsr_delta_free_internal(
+	yadsl_GraphCsrDelta* delta)
+{
+	if (delta->targets)
+		free(delta->targets);
+	if (delta->weights)
+		free(delta->weights);
+	if (delta->tombstones)
+		free(delta->tombstones);
+	free(delta);
+}
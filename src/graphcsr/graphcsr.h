@@ -0,0 +1,269 @@
+#ifndef __YADSL_GRAPHCSR_H__
+#define __YADSL_GRAPHCSR_H__
+
+/**
+ * \defgroup graphcsr Graph CSR
+ * @brief Read-optimised snapshot of a graph with a mutable delta layer
+ *
+ * A CSR (compressed sparse row) graph stores the neighbours of every
+ * vertex contiguously, sorted by id, in a single array. Vertices are
+ * identified by the dense ids of the graph they were created from
+ * (see \ref graph). On undirected graphs, every edge is stored in the
+ * rows of both of its endpoints.
+ *
+ * Edges can still be added and removed after the snapshot is taken.
+ * These changes are recorded in small per-vertex logs (inserted
+ * neighbours and tombstones for removed ones), which neighbour
+ * iteration merges on the fly. Vertices without pending changes
+ * are read straight from the snapshot. Calling ::yadsl_graphcsr_compact
+ * folds every log back into the snapshot.
+ *
+ * Complexity
+ * ----------
+ *
+ * Where d is the degree of a vertex and k is the size of its logs:
+ *
+ * | Function | Time |
+ * | :-: | :-: |
+ * | ::yadsl_graphcsr_create            | O(n + m) |
+ * | ::yadsl_graphcsr_edge_add          | O(log d + k) |
+ * | ::yadsl_graphcsr_edge_remove       | O(log d + k) |
+ * | ::yadsl_graphcsr_edge_exists_check | O(log d + log k) |
+ * | ::yadsl_graphcsr_nb_iter_next      | O(1) amortized |
+ * | ::yadsl_graphcsr_compact           | O(n + m) |
+ *
+ * @{
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <graph/graph.h>
+
+/**
+ * @brief Return condition of Graph CSR functions
+*/
+typedef enum
+{
+	YADSL_GRAPHCSR_RET_OK = 0, /**< All went ok */
+	YADSL_GRAPHCSR_RET_MEMORY, /**< Could not allocate memory */
+	YADSL_GRAPHCSR_RET_PARAMETER, /**< Invalid parameter (e.g. vertex id out of range) */
+	YADSL_GRAPHCSR_RET_CONTAINS_EDGE, /**< Graph (already) contains edge */
+	YADSL_GRAPHCSR_RET_DOES_NOT_CONTAIN_EDGE, /**< Graph does not contain edge */
+	YADSL_GRAPHCSR_RET_OUT_OF_BOUNDS, /**< Iteration reached the last neighbour */
+}
+yadsl_GraphCsrRet;
+
+typedef void yadsl_GraphCsrHandle; /**< Graph CSR handle */
+
+/**
+ * @brief Neighbour iterator
+ *
+ * Every field is private. An iterator is invalidated by any
+ * change to the graph it iterates on.
+*/
+typedef struct
+{
+	yadsl_GraphCsrHandle* csr; /**< graph being iterated */
+	size_t vertex; /**< vertex whose neighbours are visited */
+	size_t base; /**< position in the snapshot */
+	size_t tombstone; /**< position in the tombstone log */
+	size_t insert; /**< position in the insertion log */
+}
+yadsl_GraphCsrNbIter;
+
+/**
+ * @brief Create a CSR snapshot of a graph
+ * @param graph graph
+ * @param csr_ptr newly created CSR graph
+ * @return
+ * * ::YADSL_GRAPHCSR_RET_OK, and *csr_ptr is updated
+ * * ::YADSL_GRAPHCSR_RET_MEMORY
+ * @note The snapshot does not keep any reference to graph, and has
+ * the same vertices (by id), edges and edge weights at the time of
+ * creation.
+ * @see yadsl_graphcsr_destroy
+*/
+yadsl_GraphCsrRet
+yadsl_graphcsr_create(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphCsrHandle** csr_ptr);
+
+/**
+ * @brief Get the number of vertices
+ * @param csr CSR graph
+ * @param vertex_count_ptr vertex count
+ * @return
+ * * ::YADSL_GRAPHCSR_RET_OK, and *vertex_count_ptr is updated
+*/
+yadsl_GraphCsrRet
+yadsl_graphcsr_vertex_count_get(
+	yadsl_GraphCsrHandle* csr,
+	size_t* vertex_count_ptr);
+
+/**
+ * @brief Get the number of edges (including pending changes)
+ * @param csr CSR graph
+ * @param edge_count_ptr edge count
+ * @return
+ * * ::YADSL_GRAPHCSR_RET_OK, and *edge_count_ptr is updated
+*/
+yadsl_GraphCsrRet
+yadsl_graphcsr_edge_count_get(
+	yadsl_GraphCsrHandle* csr,
+	size_t* edge_count_ptr);
+
+/**
+ * @brief Get the number of pending changes
+ *
+ * This is the total size of the insertion and tombstone logs, and
+ * can be used to decide when to call ::yadsl_graphcsr_compact.
+ *
+ * @param csr CSR graph
+ * @param delta_size_ptr number of log entries
+ * @return
+ * * ::YADSL_GRAPHCSR_RET_OK, and *delta_size_ptr is updated
+*/
+yadsl_GraphCsrRet
+yadsl_graphcsr_delta_size_get(
+	yadsl_GraphCsrHandle* csr,
+	size_t* delta_size_ptr);
+
+/**
+ * @brief Add edge uv
+ * @param csr CSR graph
+ * @param u source vertex id
+ * @param v destination vertex id
+ * @param weight edge weight (ignored if graph is not weighted)
+ * @return
+ * * ::YADSL_GRAPHCSR_RET_OK, and edge is added
+ * * ::YADSL_GRAPHCSR_RET_PARAMETER
+ * * ::YADSL_GRAPHCSR_RET_CONTAINS_EDGE
+ * * ::YADSL_GRAPHCSR_RET_MEMORY
+*/
+yadsl_GraphCsrRet
+yadsl_graphcsr_edge_add(
+	yadsl_GraphCsrHandle* csr,
+	size_t u,
+	size_t v,
+	yadsl_GraphEdgeWeight weight);
+
+/**
+ * @brief Remove edge uv
+ * @param csr CSR graph
+ * @param u source vertex id
+ * @param v destination vertex id
+ * @return
+ * * ::YADSL_GRAPHCSR_RET_OK, and edge is removed
+ * * ::YADSL_GRAPHCSR_RET_PARAMETER
+ * * ::YADSL_GRAPHCSR_RET_DOES_NOT_CONTAIN_EDGE
+ * * ::YADSL_GRAPHCSR_RET_MEMORY
+*/
+yadsl_GraphCsrRet
+yadsl_graphcsr_edge_remove(
+	yadsl_GraphCsrHandle* csr,
+	size_t u,
+	size_t v);
+
+/**
+ * @brief Check whether graph contains edge uv
+ * @param csr CSR graph
+ * @param u source vertex id
+ * @param v destination vertex id
+ * @param contains_ptr whether graph contains edge uv
+ * @return
+ * * ::YADSL_GRAPHCSR_RET_OK, and *contains_ptr is updated
+ * * ::YADSL_GRAPHCSR_RET_PARAMETER
+*/
+yadsl_GraphCsrRet
+yadsl_graphcsr_edge_exists_check(
+	yadsl_GraphCsrHandle* csr,
+	size_t u,
+	size_t v,
+	bool* contains_ptr);
+
+/**
+ * @brief Get the weight of edge uv
+ * @param csr CSR graph
+ * @param u source vertex id
+ * @param v destination vertex id
+ * @param weight_ptr edge weight
+ * @return
+ * * ::YADSL_GRAPHCSR_RET_OK, and *weight_ptr is updated
+ * * ::YADSL_GRAPHCSR_RET_PARAMETER
+ * * ::YADSL_GRAPHCSR_RET_DOES_NOT_CONTAIN_EDGE
+*/
+yadsl_GraphCsrRet
+yadsl_graphcsr_edge_weight_get(
+	yadsl_GraphCsrHandle* csr,
+	size_t u,
+	size_t v,
+	yadsl_GraphEdgeWeight* weight_ptr);
+
+/**
+ * @brief Get the number of neighbours of a vertex
+ * @param csr CSR graph
+ * @param u vertex id
+ * @param degree_ptr number of neighbours (out neighbours, if directed)
+ * @return
+ * * ::YADSL_GRAPHCSR_RET_OK, and *degree_ptr is updated
+ * * ::YADSL_GRAPHCSR_RET_PARAMETER
+*/
+yadsl_GraphCsrRet
+yadsl_graphcsr_vertex_degree_get(
+	yadsl_GraphCsrHandle* csr,
+	size_t u,
+	size_t* degree_ptr);
+
+/**
+ * @brief Start iterating through the neighbours of a vertex
+ * @param csr CSR graph
+ * @param u vertex id
+ * @param iter iterator
+ * @return
+ * * ::YADSL_GRAPHCSR_RET_OK, and iter is initialized
+ * * ::YADSL_GRAPHCSR_RET_PARAMETER
+*/
+yadsl_GraphCsrRet
+yadsl_graphcsr_nb_iter_begin(
+	yadsl_GraphCsrHandle* csr,
+	size_t u,
+	yadsl_GraphCsrNbIter* iter);
+
+/**
+ * @brief Get the next neighbour, in increasing order of id
+ * @param iter iterator
+ * @param v_ptr neighbour id
+ * @param weight_ptr edge weight
+ * @return
+ * * ::YADSL_GRAPHCSR_RET_OK, and *v_ptr and *weight_ptr are updated
+ * * ::YADSL_GRAPHCSR_RET_OUT_OF_BOUNDS, if there are no more neighbours
+*/
+yadsl_GraphCsrRet
+yadsl_graphcsr_nb_iter_next(
+	yadsl_GraphCsrNbIter* iter,
+	size_t* v_ptr,
+	yadsl_GraphEdgeWeight* weight_ptr);
+
+/**
+ * @brief Fold every pending change into the snapshot
+ * @param csr CSR graph
+ * @return
+ * * ::YADSL_GRAPHCSR_RET_OK, and there are no more pending changes
+ * * ::YADSL_GRAPHCSR_RET_MEMORY, and graph is left unchanged
+*/
+yadsl_GraphCsrRet
+yadsl_graphcsr_compact(
+	yadsl_GraphCsrHandle* csr);
+
+/**
+ * @brief Destroy a CSR graph
+ * @param csr CSR graph
+*/
+void
+yadsl_graphcsr_destroy(
+	yadsl_GraphCsrHandle* csr);
+
+/** @} */
+
+#endif
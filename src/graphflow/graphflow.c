@@ -0,0 +1,308 @@
+#include <graphflow/graphflow.h>
+
+#include <assert.h>
+
+#ifdef YADSL_DEBUG
+#include <memdb/memdb.h>
+#else
+#include <stdlib.h>
+#endif
+
+#define YADSL_GRAPHFLOW_NONE ((size_t) -1)
+
+///////////////////////////////////////////////
+// Residual network
+//
+// Arcs leaving vertex u are stored between
+// offsets[u] and offsets[u + 1]. Every edge
+// has a forward arc and a reverse arc.
+///////////////////////////////////////////////
+
+typedef struct
+{
+	size_t vertex_count;
+	size_t edge_count;
+	size_t* offsets; /* by vertex, plus one */
+	size_t* heads; /* by arc */
+	size_t* reverses; /* by arc */
+	double* residuals; /* by arc */
+	size_t* edge_arcs; /* by edge (forward arc, or none for self-loops) */
+	double* capacities; /* by edge */
+	size_t* levels; /* by vertex (BFS distance from source) */
+	size_t* cursors; /* by vertex (next arc to be tried) */
+	size_t* queue; /* by vertex (BFS queue) */
+	size_t* path; /* by vertex (arcs from source) */
+}
+yadsl_GraphFlowNetwork;
+
+/**********************************/
+/*  Private functions prototypes  */
+/**********************************/
+
+static yadsl_GraphFlowRet yadsl_graphflow_network_create_internal(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphFlowCapacityFunc capacity_func,
+	void* arg,
+	yadsl_GraphFlowNetwork* network);
+
+static void yadsl_graphflow_network_destroy_internal(
+	yadsl_GraphFlowNetwork* network);
+
+static bool yadsl_graphflow_levels_compute_internal(
+	yadsl_GraphFlowNetwork* network,
+	size_t source,
+	size_t sink);
+
+static double yadsl_graphflow_blocking_flow_internal(
+	yadsl_GraphFlowNetwork* network,
+	size_t source,
+	size_t sink);
+
+/**********************/
+/*  Public functions  */
+/**********************/
+
+yadsl_GraphFlowRet yadsl_graphflow_max_flow(
+	yadsl_GraphHandle* graph,
+	size_t source,
+	size_t sink,
+	yadsl_GraphFlowCapacityFunc capacity_func,
+	void* arg,
+	double* flow_value_ptr,
+	double* edge_flows,
+	bool* source_side)
+{
+	yadsl_GraphFlowNetwork network;
+	yadsl_GraphFlowRet ret;
+	double flow_value = 0.0;
+	size_t vertex_count, id;
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (source >= vertex_count || sink >= vertex_count || source == sink)
+		return YADSL_GRAPHFLOW_RET_PARAMETER;
+	if (ret = yadsl_graphflow_network_create_internal(graph, capacity_func, arg, &network))
+		return ret;
+	while (yadsl_graphflow_levels_compute_internal(&network, source, sink))
+		flow_value += yadsl_graphflow_blocking_flow_internal(&network, source, sink);
+	if (edge_flows) {
+		for (id = 0; id < network.edge_count; ++id) {
+			if (network.edge_arcs[id] == YADSL_GRAPHFLOW_NONE)
+				edge_flows[id] = 0.0;
+			else
+				edge_flows[id] = network.capacities[id] -
+					network.residuals[network.edge_arcs[id]];
+		}
+	}
+	if (source_side) {
+		/* The last search could not reach the sink */
+		for (id = 0; id < vertex_count; ++id)
+			source_side[id] = network.levels[id] != YADSL_GRAPHFLOW_NONE;
+	}
+	yadsl_graphflow_network_destroy_internal(&network);
+	*flow_value_ptr = flow_value;
+	return YADSL_GRAPHFLOW_RET_OK;
+}
+
+/**************************************/
+/*  Private functions implementation  */
+/**************************************/
+
+yadsl_GraphFlowRet yadsl_graphflow_network_create_internal(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphFlowCapacityFunc capacity_func,
+	void* arg,
+	yadsl_GraphFlowNetwork* network)
+{
+	yadsl_GraphEdgeWeightType weight_type;
+	yadsl_GraphEdgeWeight weight;
+	yadsl_GraphVertexObject* u_obj, * v_obj;
+	yadsl_GraphEdgeObject* uv_obj;
+	size_t vertex_count, edge_count, arc_count = 0, id, u, v, a, b;
+	bool is_directed;
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (yadsl_graph_edge_count_get(graph, &edge_count)) assert(0);
+	if (yadsl_graph_is_directed_check(graph, &is_directed)) assert(0);
+	if (yadsl_graph_edge_weight_type_get(graph, &weight_type)) assert(0);
+	if (capacity_func == NULL && weight_type == YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE)
+		return YADSL_GRAPHFLOW_RET_PARAMETER;
+	network->vertex_count = vertex_count;
+	network->edge_count = edge_count;
+	network->heads = NULL;
+	network->reverses = NULL;
+	network->residuals = NULL;
+	network->edge_arcs = NULL;
+	network->capacities = NULL;
+	network->levels = NULL;
+	network->cursors = NULL;
+	network->queue = NULL;
+	network->path = NULL;
+	if (!(network->offsets = malloc((vertex_count + 1) * sizeof(*network->offsets))))
+		goto memory;
+	if (!(network->levels = malloc(vertex_count * sizeof(*network->levels))))
+		goto memory;
+	if (!(network->cursors = malloc(vertex_count * sizeof(*network->cursors))))
+		goto memory;
+	if (!(network->queue = malloc(vertex_count * sizeof(*network->queue))))
+		goto memory;
+	if (!(network->path = malloc(vertex_count * sizeof(*network->path))))
+		goto memory;
+	if (edge_count > 0) {
+		if (!(network->edge_arcs = malloc(edge_count * sizeof(*network->edge_arcs))))
+			goto memory;
+		if (!(network->capacities = malloc(edge_count * sizeof(*network->capacities))))
+			goto memory;
+	}
+	for (u = 0; u <= vertex_count; ++u)
+		network->offsets[u] = 0;
+	for (id = 0; id < edge_count; ++id) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+		if (capacity_func) {
+			if (yadsl_graph_edge_by_id_get(graph, id, &u_obj, &v_obj, &uv_obj)) assert(0);
+			network->capacities[id] = capacity_func(uv_obj, arg);
+		} else {
+			network->capacities[id] = yadsl_graph_edge_weight_to_double(weight_type, weight);
+		}
+		if (!(network->capacities[id] >= 0.0)) {
+			yadsl_graphflow_network_destroy_internal(network);
+			return YADSL_GRAPHFLOW_RET_PARAMETER;
+		}
+		if (u != v) {
+			++network->offsets[u + 1];
+			++network->offsets[v + 1];
+			arc_count += 2;
+		}
+	}
+	if (arc_count > 0) {
+		if (!(network->heads = malloc(arc_count * sizeof(*network->heads))))
+			goto memory;
+		if (!(network->reverses = malloc(arc_count * sizeof(*network->reverses))))
+			goto memory;
+		if (!(network->residuals = malloc(arc_count * sizeof(*network->residuals))))
+			goto memory;
+	}
+	for (u = 0; u < vertex_count; ++u) {
+		network->offsets[u + 1] += network->offsets[u];
+		network->cursors[u] = network->offsets[u];
+	}
+	for (id = 0; id < edge_count; ++id) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+		if (u == v) {
+			network->edge_arcs[id] = YADSL_GRAPHFLOW_NONE;
+			continue;
+		}
+		a = network->cursors[u]++;
+		b = network->cursors[v]++;
+		network->heads[a] = v;
+		network->heads[b] = u;
+		network->reverses[a] = b;
+		network->reverses[b] = a;
+		network->residuals[a] = network->capacities[id];
+		network->residuals[b] = is_directed ? 0.0 : network->capacities[id];
+		network->edge_arcs[id] = a;
+	}
+	return YADSL_GRAPHFLOW_RET_OK;
+memory:
+	yadsl_graphflow_network_destroy_internal(network);
+	return YADSL_GRAPHFLOW_RET_MEMORY;
+}
+
+void yadsl_graphflow_network_destroy_internal(
+	yadsl_GraphFlowNetwork* network)
+{
+	if (network->offsets)
+		free(network->offsets);
+	if (network->heads)
+		free(network->heads);
+	if (network->reverses)
+		free(network->reverses);
+	if (network->residuals)
+		free(network->residuals);
+	if (network->edge_arcs)
+		free(network->edge_arcs);
+	if (network->capacities)
+		free(network->capacities);
+	if (network->levels)
+		free(network->levels);
+	if (network->cursors)
+		free(network->cursors);
+	if (network->queue)
+		free(network->queue);
+	if (network->path)
+		free(network->path);
+}
+
+// Labels vertices by their distance from the source in the residual
+// network, and returns whether the sink is reachable
+bool yadsl_graphflow_levels_compute_internal(
+	yadsl_GraphFlowNetwork* network,
+	size_t source,
+	size_t sink)
+{
+	size_t head = 0, tail = 0, u, v, a;
+	for (u = 0; u < network->vertex_count; ++u) {
+		network->levels[u] = YADSL_GRAPHFLOW_NONE;
+		network->cursors[u] = network->offsets[u];
+	}
+	network->levels[source] = 0;
+	network->queue[tail++] = source;
+	while (head < tail) {
+		u = network->queue[head++];
+		for (a = network->offsets[u]; a < network->offsets[u + 1]; ++a) {
+			v = network->heads[a];
+			if (network->residuals[a] > 0.0 && network->levels[v] == YADSL_GRAPHFLOW_NONE) {
+				network->levels[v] = network->levels[u] + 1;
+				network->queue[tail++] = v;
+			}
+		}
+	}
+	return network->levels[sink] != YADSL_GRAPHFLOW_NONE;
+}
+
+// Saturates every shortest augmenting path, and returns the flow added
+double yadsl_graphflow_blocking_flow_internal(
+	yadsl_GraphFlowNetwork* network,
+	size_t source,
+	size_t sink)
+{
+	size_t* path = network->path, * cursors = network->cursors;
+	size_t* levels = network->levels, * heads = network->heads;
+	double* residuals = network->residuals;
+	double total = 0.0, bottleneck;
+	size_t depth = 0, u = source, a, k;
+	for (;;) {
+		if (u == sink) {
+			bottleneck = residuals[path[0]];
+			for (k = 1; k < depth; ++k)
+				if (residuals[path[k]] < bottleneck)
+					bottleneck = residuals[path[k]];
+			for (k = 0; k < depth; ++k) {
+				residuals[path[k]] -= bottleneck;
+				residuals[network->reverses[path[k]]] += bottleneck;
+			}
+			total += bottleneck;
+			/* Retreat to the tail of the first saturated arc */
+			for (k = 0; residuals[path[k]] > 0.0; ++k);
+			depth = k;
+			u = depth ? heads[path[depth - 1]] : source;
+			continue;
+		}
+		/* Advance along an admissible arc */
+		for (; cursors[u] < network->offsets[u + 1]; ++cursors[u]) {
+			a = cursors[u];
+			if (residuals[a] > 0.0 && levels[heads[a]] == levels[u] + 1)
+				break;
+		}
+		if (cursors[u] < network->offsets[u + 1]) {
+			path[depth++] = cursors[u];
+			u = heads[cursors[u]];
+		} else if (u == source) {
+			break;
+		} else {
+			/* Dead end, so no path goes through u anymore */
+			levels[u] = YADSL_GRAPHFLOW_NONE;
+			a = path[--depth];
+			u = heads[network->reverses[a]];
+			++cursors[u];
+		}
+	}
+	return total;
+}
@@ -0,0 +1,83 @@
+#ifndef __YADSL_GRAPHFLOW_H__
+#define __YADSL_GRAPHFLOW_H__
+
+/**
+ * \defgroup graphflow Graph Flow
+ * @brief Auxiliary module for maximum flows and minimum cuts on Graphs.
+ *
+ * Every edge is an arc from its source to its destination vertex, with a
+ * non-negative capacity, either given by a callback or read from the inline
+ * edge weights (see ::yadsl_graph_create_weighted). On undirected graphs,
+ * every edge can carry flow in both directions, up to its capacity.
+ * Self-loops never carry flow.
+ *
+ * The flow is computed with Dinic's algorithm, over a residual graph stored
+ * in flat arrays (indexed by vertex and edge ids, see \ref graph), in
+ * O(n^2 m) time. Once the maximum flow is found, the vertices still
+ * reachable from the source in the residual graph form the source side of
+ * a minimum cut.
+ *
+ * @{
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <graph/graph.h>
+
+/**
+ * @brief Return condition of Graph Flow functions
+*/
+typedef enum
+{
+	YADSL_GRAPHFLOW_RET_OK = 0, /**< All went ok */
+	YADSL_GRAPHFLOW_RET_MEMORY, /**< Could not allocate memory */
+	YADSL_GRAPHFLOW_RET_PARAMETER, /**< Invalid parameter */
+}
+yadsl_GraphFlowRet;
+
+/**
+ * @brief Edge capacity function
+ * @param edge edge object
+ * @param arg user argument
+ * @return capacity of edge (must be non-negative)
+*/
+typedef double
+(*yadsl_GraphFlowCapacityFunc)(
+	yadsl_GraphEdgeObject* edge,
+	void* arg);
+
+/**
+ * @brief Compute a maximum flow and a minimum cut
+ * @param graph graph
+ * @param source source vertex id
+ * @param sink sink vertex id
+ * @param capacity_func edge capacity function, or NULL for inline edge weights
+ * @param arg argument passed to capacity_func
+ * @param flow_value_ptr value of the maximum flow
+ * @param edge_flows flow on each edge (by id), or NULL. On undirected graphs,
+ * the flow is negative if it goes from the destination to the source vertex,
+ * as given by ::yadsl_graph_edge_endpoint_ids_get.
+ * @param source_side whether each vertex (by id) is on the source side of
+ * the minimum cut, or NULL
+ * @return
+ * * ::YADSL_GRAPHFLOW_RET_OK, and *flow_value_ptr, edge_flows and source_side are updated
+ * * ::YADSL_GRAPHFLOW_RET_PARAMETER, if source or sink are not valid and
+ * distinct vertex ids, if a capacity is negative, or if capacity_func is
+ * NULL and graph is not weighted
+ * * ::YADSL_GRAPHFLOW_RET_MEMORY
+*/
+yadsl_GraphFlowRet
+yadsl_graphflow_max_flow(
+	yadsl_GraphHandle* graph,
+	size_t source,
+	size_t sink,
+	yadsl_GraphFlowCapacityFunc capacity_func,
+	void* arg,
+	double* flow_value_ptr,
+	double* edge_flows,
+	bool* source_side);
+
+/** @} */
+
+#endif
@@ -0,0 +1,622 @@
+#include <graphgen/graphgen.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+
+#ifdef YADSL_DEBUG
+#include <memdb/memdb.h>
+#else
+#include <stdlib.h>
+#endif
+
+#define YADSL_GRAPHGEN_MAX_VERTEX_COUNT ((uint64_t) 1 << 32)
+
+///////////////////////////////////////////////
+// Edge list builder
+//
+// Edges are appended to a growing array of
+// build edges, which is then handed over to
+// yadsl_graph_build together with the
+// vertex objects.
+///////////////////////////////////////////////
+
+typedef struct
+{
+	const yadsl_GraphGenParams* params;
+	yadsl_GraphEdgeWeightType weight_type;
+	uint64_t state; /* random number generator */
+	yadsl_GraphBuildEdge* edges;
+	size_t edge_count;
+	size_t edge_capacity;
+}
+yadsl_GraphGenBuilder;
+
+/**********************************/
+/*  Private functions prototypes  */
+/**********************************/
+
+static yadsl_GraphGenRet yadsl_graphgen_builder_init_internal(
+	yadsl_GraphHandle* graph,
+	const yadsl_GraphGenParams* params,
+	yadsl_GraphGenBuilder* builder);
+
+static bool yadsl_graphgen_builder_reserve_internal(
+	yadsl_GraphGenBuilder* builder,
+	size_t edge_capacity);
+
+static bool yadsl_graphgen_builder_edge_add_internal(
+	yadsl_GraphGenBuilder* builder,
+	size_t u,
+	size_t v);
+
+static yadsl_GraphGenRet yadsl_graphgen_builder_finish_internal(
+	yadsl_GraphGenBuilder* builder,
+	yadsl_GraphHandle* graph,
+	size_t vertex_count);
+
+static void yadsl_graphgen_builder_discard_internal(
+	yadsl_GraphGenBuilder* builder);
+
+static bool yadsl_graphgen_regular_pairing_internal(
+	yadsl_GraphGenBuilder* builder,
+	size_t vertex_count,
+	size_t degree,
+	bool is_directed,
+	size_t* neighbours,
+	size_t* stubs);
+
+static bool yadsl_graphgen_regular_pair_check_internal(
+	const size_t* neighbours,
+	const size_t* counts,
+	size_t degree,
+	size_t u,
+	size_t v);
+
+static uint64_t yadsl_graphgen_random_internal(
+	uint64_t* state_ptr);
+
+static double yadsl_graphgen_random_double_internal(
+	uint64_t* state_ptr);
+
+static size_t yadsl_graphgen_random_below_internal(
+	uint64_t* state_ptr,
+	size_t bound);
+
+/**********************/
+/*  Public functions  */
+/**********************/
+
+yadsl_GraphGenRet yadsl_graphgen_erdos_renyi(
+	yadsl_GraphHandle* graph,
+	const yadsl_GraphGenParams* params,
+	size_t vertex_count,
+	double probability)
+{
+	yadsl_GraphGenBuilder builder;
+	yadsl_GraphGenRet ret;
+	uint64_t u, w, row_length;
+	double pair_count, expected, log_q, skip;
+	bool is_directed;
+	if (!(probability >= 0.0 && probability <= 1.0) ||
+		(uint64_t) vertex_count > YADSL_GRAPHGEN_MAX_VERTEX_COUNT)
+		return YADSL_GRAPHGEN_RET_PARAMETER;
+	if (ret = yadsl_graphgen_builder_init_internal(graph, params, &builder))
+		return ret;
+	if (vertex_count < 2 || probability == 0.0)
+		return yadsl_graphgen_builder_finish_internal(&builder, graph, vertex_count);
+	if (yadsl_graph_is_directed_check(graph, &is_directed)) assert(0);
+	pair_count = (double) vertex_count * (double) (vertex_count - 1);
+	if (!is_directed)
+		pair_count /= 2.0;
+	expected = pair_count * probability;
+	expected += 3.0 * sqrt(expected) + 16.0;
+	if (expected > pair_count)
+		expected = pair_count;
+	if (expected * sizeof(*builder.edges) > (double) SIZE_MAX ||
+		!yadsl_graphgen_builder_reserve_internal(&builder, (size_t) expected))
+		goto memory;
+	/* The gap between consecutive pairs joined by an edge follows a
+	geometric distribution, which is sampled by inversion. Pairs are
+	visited row by row: (u, w) for w < u on undirected graphs, and for
+	w < n - 1 on directed graphs, where w skips over u. */
+	log_q = log(1.0 - probability);
+	u = is_directed ? 0 : 1;
+	w = 0;
+	for (;;) {
+		skip = floor(log(1.0 - yadsl_graphgen_random_double_internal(&builder.state)) / log_q);
+		if (skip >= pair_count)
+			break;
+		w += (uint64_t) skip;
+		row_length = is_directed ? vertex_count - 1 : u;
+		while (w >= row_length && u < vertex_count) {
+			w -= row_length;
+			++u;
+			row_length = is_directed ? vertex_count - 1 : u;
+		}
+		if (u >= vertex_count)
+			break;
+		if (!yadsl_graphgen_builder_edge_add_internal(&builder, (size_t) u,
+			(size_t) (is_directed && w >= u ? w + 1 : w)))
+			goto memory;
+		++w;
+	}
+	return yadsl_graphgen_builder_finish_internal(&builder, graph, vertex_count);
+memory:
+	yadsl_graphgen_builder_discard_internal(&builder);
+	return YADSL_GRAPHGEN_RET_MEMORY;
+}
+
+yadsl_GraphGenRet yadsl_graphgen_rmat(
+	yadsl_GraphHandle* graph,
+	const yadsl_GraphGenParams* params,
+	size_t scale,
+	size_t edge_count,
+	double a,
+	double b,
+	double c)
+{
+	yadsl_GraphGenBuilder builder;
+	yadsl_GraphGenRet ret;
+	size_t vertex_count, i, level, bit, u, v;
+	double r;
+	if (scale > 32 || scale >= sizeof(size_t) * 8 ||
+		!(a >= 0.0 && b >= 0.0 && c >= 0.0 && a + b + c <= 1.0))
+		return YADSL_GRAPHGEN_RET_PARAMETER;
+	if (ret = yadsl_graphgen_builder_init_internal(graph, params, &builder))
+		return ret;
+	vertex_count = (size_t) 1 << scale;
+	if (edge_count > SIZE_MAX / sizeof(*builder.edges) ||
+		!yadsl_graphgen_builder_reserve_internal(&builder, edge_count))
+		goto memory;
+	for (i = 0; i < edge_count; ++i) {
+		u = 0;
+		v = 0;
+		for (level = 0; level < scale; ++level) {
+			bit = (size_t) 1 << (scale - level - 1);
+			r = yadsl_graphgen_random_double_internal(&builder.state);
+			if (r < a) {
+				/* top-left quadrant */
+			} else if (r < a + b) {
+				v |= bit;
+			} else if (r < a + b + c) {
+				u |= bit;
+			} else {
+				u |= bit;
+				v |= bit;
+			}
+		}
+		if (!yadsl_graphgen_builder_edge_add_internal(&builder, u, v))
+			goto memory;
+	}
+	return yadsl_graphgen_builder_finish_internal(&builder, graph, vertex_count);
+memory:
+	yadsl_graphgen_builder_discard_internal(&builder);
+	return YADSL_GRAPHGEN_RET_MEMORY;
+}
+
+yadsl_GraphGenRet yadsl_graphgen_grid(
+	yadsl_GraphHandle* graph,
+	const yadsl_GraphGenParams* params,
+	size_t row_count,
+	size_t column_count)
+{
+	yadsl_GraphGenBuilder builder;
+	yadsl_GraphGenRet ret;
+	size_t vertex_count, edge_count, r, c, u;
+	bool is_directed;
+	if (row_count > 0 && column_count > SIZE_MAX / row_count)
+		return YADSL_GRAPHGEN_RET_PARAMETER;
+	vertex_count = row_count * column_count;
+	if ((uint64_t) vertex_count > YADSL_GRAPHGEN_MAX_VERTEX_COUNT)
+		return YADSL_GRAPHGEN_RET_PARAMETER;
+	if (ret = yadsl_graphgen_builder_init_internal(graph, params, &builder))
+		return ret;
+	if (vertex_count == 0)
+		return yadsl_graphgen_builder_finish_internal(&builder, graph, vertex_count);
+	if (yadsl_graph_is_directed_check(graph, &is_directed)) assert(0);
+	edge_count = row_count * (column_count - 1) + (row_count - 1) * column_count;
+	if (is_directed)
+		edge_count *= 2;
+	if (!yadsl_graphgen_builder_reserve_internal(&builder, edge_count))
+		goto memory;
+	for (r = 0; r < row_count; ++r) {
+		for (c = 0; c < column_count; ++c) {
+			u = r * column_count + c;
+			if (c + 1 < column_count) {
+				if (!yadsl_graphgen_builder_edge_add_internal(&builder, u, u + 1))
+					goto memory;
+				if (is_directed && !yadsl_graphgen_builder_edge_add_internal(&builder, u + 1, u))
+					goto memory;
+			}
+			if (r + 1 < row_count) {
+				if (!yadsl_graphgen_builder_edge_add_internal(&builder, u, u + column_count))
+					goto memory;
+				if (is_directed && !yadsl_graphgen_builder_edge_add_internal(&builder, u + column_count, u))
+					goto memory;
+			}
+		}
+	}
+	return yadsl_graphgen_builder_finish_internal(&builder, graph, vertex_count);
+memory:
+	yadsl_graphgen_builder_discard_internal(&builder);
+	return YADSL_GRAPHGEN_RET_MEMORY;
+}
+
+yadsl_GraphGenRet yadsl_graphgen_barabasi_albert(
+	yadsl_GraphHandle* graph,
+	const yadsl_GraphGenParams* params,
+	size_t vertex_count,
+	size_t edges_per_vertex)
+{
+	yadsl_GraphGenBuilder builder;
+	yadsl_GraphGenRet ret;
+	size_t m = edges_per_vertex, edge_count, repeated_count = 0, s, i, j, t;
+	size_t* targets = NULL, * repeated = NULL;
+	if (m == 0 || m >= vertex_count ||
+		(uint64_t) vertex_count > YADSL_GRAPHGEN_MAX_VERTEX_COUNT ||
+		vertex_count - m > SIZE_MAX / 2 / m)
+		return YADSL_GRAPHGEN_RET_PARAMETER;
+	if (ret = yadsl_graphgen_builder_init_internal(graph, params, &builder))
+		return ret;
+	edge_count = (vertex_count - m) * m;
+	if (!yadsl_graphgen_builder_reserve_internal(&builder, edge_count))
+		goto memory;
+	if (!(targets = malloc(m * sizeof(*targets))))
+		goto memory;
+	/* Every vertex occurs in the repeated list once per edge, so that
+	sampling the list uniformly is sampling proportionally to degree */
+	if (!(repeated = malloc(2 * edge_count * sizeof(*repeated))))
+		goto memory;
+	for (i = 0; i < m; ++i)
+		targets[i] = i;
+	for (s = m; s < vertex_count; ++s) {
+		for (i = 0; i < m; ++i) {
+			if (!yadsl_graphgen_builder_edge_add_internal(&builder, s, targets[i]))
+				goto memory;
+			repeated[repeated_count++] = targets[i];
+			repeated[repeated_count++] = s;
+		}
+		if (s + 1 == vertex_count)
+			break;
+		/* The list has at least m + 1 distinct vertices */
+		for (i = 0; i < m; ++i) {
+			do {
+				t = repeated[yadsl_graphgen_random_below_internal(&builder.state, repeated_count)];
+				for (j = 0; j < i && targets[j] != t; ++j);
+			} while (j < i);
+			targets[i] = t;
+		}
+	}
+	free(targets);
+	free(repeated);
+	return yadsl_graphgen_builder_finish_internal(&builder, graph, vertex_count);
+memory:
+	if (targets)
+		free(targets);
+	if (repeated)
+		free(repeated);
+	yadsl_graphgen_builder_discard_internal(&builder);
+	return YADSL_GRAPHGEN_RET_MEMORY;
+}
+
+yadsl_GraphGenRet yadsl_graphgen_random_regular(
+	yadsl_GraphHandle* graph,
+	const yadsl_GraphGenParams* params,
+	size_t vertex_count,
+	size_t degree)
+{
+	yadsl_GraphGenBuilder builder;
+	yadsl_GraphGenRet ret;
+	size_t d = degree, stub_count, u, i, v;
+	size_t* neighbours = NULL, * stubs = NULL;
+	bool* marks = NULL;
+	bool is_directed, is_complement;
+	if (degree >= vertex_count ||
+		(uint64_t) vertex_count > YADSL_GRAPHGEN_MAX_VERTEX_COUNT ||
+		degree > SIZE_MAX / vertex_count)
+		return YADSL_GRAPHGEN_RET_PARAMETER;
+	if (ret = yadsl_graphgen_builder_init_internal(graph, params, &builder))
+		return ret;
+	if (yadsl_graph_is_directed_check(graph, &is_directed)) assert(0);
+	/* Dense graphs are complements of sparse ones, which are easier to pair */
+	is_complement = d > (vertex_count - 1) / 2;
+	if (is_complement)
+		d = vertex_count - 1 - d;
+	if (d > 0 && vertex_count > SIZE_MAX / 2 / d / sizeof(size_t)) {
+		yadsl_graphgen_builder_discard_internal(&builder);
+		return YADSL_GRAPHGEN_RET_PARAMETER;
+	}
+	stub_count = vertex_count * d;
+	if (!is_directed && stub_count % 2 != 0) {
+		yadsl_graphgen_builder_discard_internal(&builder);
+		return YADSL_GRAPHGEN_RET_PARAMETER;
+	}
+	if (!yadsl_graphgen_builder_reserve_internal(&builder,
+		is_directed ? vertex_count * degree : vertex_count * degree / 2))
+		goto memory;
+	if (stub_count > 0) {
+		if (!(neighbours = malloc(stub_count * sizeof(*neighbours))))
+			goto memory;
+		if (!(stubs = malloc((is_directed ? 2 : 1) * stub_count * sizeof(*stubs))))
+			goto memory;
+		if (!yadsl_graphgen_regular_pairing_internal(&builder, vertex_count, d,
+			is_directed, neighbours, stubs))
+			goto memory;
+	}
+	if (is_complement) {
+		if (!(marks = malloc(vertex_count * sizeof(*marks))))
+			goto memory;
+		for (v = 0; v < vertex_count; ++v)
+			marks[v] = false;
+		for (u = 0; u < vertex_count; ++u) {
+			for (i = 0; i < d; ++i)
+				marks[neighbours[u * d + i]] = true;
+			for (v = is_directed ? 0 : u + 1; v < vertex_count; ++v)
+				if (v != u && !marks[v] && !yadsl_graphgen_builder_edge_add_internal(&builder, u, v))
+					goto memory;
+			for (i = 0; i < d; ++i)
+				marks[neighbours[u * d + i]] = false;
+		}
+	} else {
+		for (u = 0; u < vertex_count; ++u) {
+			for (i = 0; i < d; ++i) {
+				v = neighbours[u * d + i];
+				if ((is_directed || u < v) && !yadsl_graphgen_builder_edge_add_internal(&builder, u, v))
+					goto memory;
+			}
+		}
+	}
+	if (neighbours)
+		free(neighbours);
+	if (stubs)
+		free(stubs);
+	if (marks)
+		free(marks);
+	return yadsl_graphgen_builder_finish_internal(&builder, graph, vertex_count);
+memory:
+	if (neighbours)
+		free(neighbours);
+	if (stubs)
+		free(stubs);
+	if (marks)
+		free(marks);
+	yadsl_graphgen_builder_discard_internal(&builder);
+	return YADSL_GRAPHGEN_RET_MEMORY;
+}
+
+/**************************************/
+/*  Private functions implementation  */
+/**************************************/
+
+yadsl_GraphGenRet yadsl_graphgen_builder_init_internal(
+	yadsl_GraphHandle* graph,
+	const yadsl_GraphGenParams* params,
+	yadsl_GraphGenBuilder* builder)
+{
+	size_t vertex_count;
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (yadsl_graph_edge_weight_type_get(graph, &builder->weight_type)) assert(0);
+	if (vertex_count > 0 || params->vertex_func == NULL)
+		return YADSL_GRAPHGEN_RET_PARAMETER;
+	if (builder->weight_type != YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE &&
+		!(params->min_weight <= params->max_weight))
+		return YADSL_GRAPHGEN_RET_PARAMETER;
+	builder->params = params;
+	builder->state = (uint64_t) params->seed;
+	builder->edges = NULL;
+	builder->edge_count = 0;
+	builder->edge_capacity = 0;
+	return YADSL_GRAPHGEN_RET_OK;
+}
+
+bool yadsl_graphgen_builder_reserve_internal(
+	yadsl_GraphGenBuilder* builder,
+	size_t edge_capacity)
+{
+	yadsl_GraphBuildEdge* edges;
+	if (edge_capacity <= builder->edge_capacity)
+		return true;
+	if (edge_capacity > SIZE_MAX / sizeof(*edges))
+		return false;
+	if (builder->edges)
+		edges = realloc(builder->edges, edge_capacity * sizeof(*edges));
+	else
+		edges = malloc(edge_capacity * sizeof(*edges));
+	if (edges == NULL)
+		return false;
+	builder->edges = edges;
+	builder->edge_capacity = edge_capacity;
+	return true;
+}
+
+bool yadsl_graphgen_builder_edge_add_internal(
+	yadsl_GraphGenBuilder* builder,
+	size_t u,
+	size_t v)
+{
+	const yadsl_GraphGenParams* params = builder->params;
+	yadsl_GraphBuildEdge* edge;
+	double weight;
+	if (builder->edge_count == builder->edge_capacity &&
+		!yadsl_graphgen_builder_reserve_internal(builder,
+			builder->edge_capacity ? 2 * builder->edge_capacity : 16))
+		return false;
+	edge = &builder->edges[builder->edge_count];
+	edge->u = u;
+	edge->v = v;
+	if (builder->weight_type != YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE) {
+		weight = params->min_weight;
+		if (params->max_weight > params->min_weight)
+			weight += (params->max_weight - params->min_weight) *
+				yadsl_graphgen_random_double_internal(&builder->state);
+		edge->weight = yadsl_graph_edge_weight_from_double(builder->weight_type, weight);
+	} else {
+		edge->weight = yadsl_graph_edge_weight_from_double(builder->weight_type, 0);
+	}
+	if (params->edge_func) {
+		if (!(edge->item = params->edge_func(u, v, params->arg)))
+			return false;
+	} else {
+		edge->item = NULL;
+	}
+	++builder->edge_count;
+	return true;
+}
+
+yadsl_GraphGenRet yadsl_graphgen_builder_finish_internal(
+	yadsl_GraphGenBuilder* builder,
+	yadsl_GraphHandle* graph,
+	size_t vertex_count)
+{
+	const yadsl_GraphGenParams* params = builder->params;
+	yadsl_GraphVertexObject** vertices = NULL;
+	yadsl_GraphRet graph_ret;
+	size_t i, created_count = 0;
+	if (vertex_count > 0) {
+		if (vertex_count > SIZE_MAX / sizeof(*vertices) ||
+			!(vertices = malloc(vertex_count * sizeof(*vertices))))
+			goto memory;
+		for (; created_count < vertex_count; ++created_count)
+			if (!(vertices[created_count] = params->vertex_func(created_count, params->arg)))
+				goto memory;
+	}
+	graph_ret = yadsl_graph_build(graph, vertices, vertex_count,
+		builder->edges, builder->edge_count);
+	if (graph_ret == YADSL_GRAPH_RET_OK) {
+		/* The graph owns every object now */
+		if (vertices)
+			free(vertices);
+		if (builder->edges)
+			free(builder->edges);
+		return YADSL_GRAPHGEN_RET_OK;
+	}
+	assert(graph_ret == YADSL_GRAPH_RET_MEMORY);
+memory:
+	if (params->free_vertex_func)
+		for (i = 0; i < created_count; ++i)
+			params->free_vertex_func(vertices[i]);
+	if (vertices)
+		free(vertices);
+	yadsl_graphgen_builder_discard_internal(builder);
+	return YADSL_GRAPHGEN_RET_MEMORY;
+}
+
+void yadsl_graphgen_builder_discard_internal(
+	yadsl_GraphGenBuilder* builder)
+{
+	yadsl_GraphFreeEdgeObjFunc free_edge_func = builder->params->free_edge_func;
+	size_t i;
+	if (free_edge_func && builder->params->edge_func)
+		for (i = 0; i < builder->edge_count; ++i)
+			free_edge_func(builder->edges[i].item);
+	if (builder->edges)
+		free(builder->edges);
+	builder->edges = NULL;
+	builder->edge_count = 0;
+	builder->edge_capacity = 0;
+}
+
+// Pairs the d endpoints of every vertex at random (out-endpoints with
+// in-endpoints, on directed graphs), writing the d neighbours of vertex u
+// to neighbours[u * d] (out-neighbours, on directed graphs)
+bool yadsl_graphgen_regular_pairing_internal(
+	yadsl_GraphGenBuilder* builder,
+	size_t vertex_count,
+	size_t degree,
+	bool is_directed,
+	size_t* neighbours,
+	size_t* stubs)
+{
+	size_t stub_count = vertex_count * degree, remaining, failures, u, v, i, j, k;
+	size_t* ends = is_directed ? stubs + stub_count : stubs;
+	size_t* counts;
+	bool found;
+	if (!(counts = malloc(vertex_count * sizeof(*counts))))
+		return false;
+restart:
+	for (u = 0; u < vertex_count; ++u)
+		counts[u] = 0;
+	for (k = 0; k < stub_count; ++k)
+		stubs[k] = ends[k] = k / degree;
+	remaining = stub_count;
+	failures = 0;
+	while (remaining > 0) {
+		i = yadsl_graphgen_random_below_internal(&builder->state, remaining);
+		j = yadsl_graphgen_random_below_internal(&builder->state, remaining);
+		found = (is_directed || i != j) &&
+			yadsl_graphgen_regular_pair_check_internal(neighbours, counts,
+				degree, stubs[i], ends[j]);
+		if (!found && ++failures > remaining + 64) {
+			/* Look for any valid pair, or start over */
+			for (i = 0; !found && i < remaining; ++i)
+				for (j = is_directed ? 0 : i + 1; !found && j < remaining; ++j)
+					found = yadsl_graphgen_regular_pair_check_internal(neighbours,
+						counts, degree, stubs[i], ends[j]);
+			if (!found)
+				goto restart;
+			--i;
+			--j;
+		}
+		if (!found)
+			continue;
+		failures = 0;
+		u = stubs[i];
+		v = ends[j];
+		neighbours[u * degree + counts[u]++] = v;
+		if (!is_directed)
+			neighbours[v * degree + counts[v]++] = u;
+		/* Remove both endpoints, the greater position first */
+		if (!is_directed && i < j) {
+			k = i;
+			i = j;
+			j = k;
+		}
+		stubs[i] = stubs[--remaining];
+		if (is_directed)
+			ends[j] = ends[remaining];
+		else
+			stubs[j] = stubs[--remaining];
+	}
+	free(counts);
+	return true;
+}
+
+bool yadsl_graphgen_regular_pair_check_internal(
+	const size_t* neighbours,
+	const size_t* counts,
+	size_t degree,
+	size_t u,
+	size_t v)
+{
+	size_t i;
+	if (u == v)
+		return false;
+	for (i = 0; i < counts[u]; ++i)
+		if (neighbours[u * degree + i] == v)
+			return false;
+	return true;
+}
+
+// splitmix64
+uint64_t yadsl_graphgen_random_internal(
+	uint64_t* state_ptr)
+{
+	uint64_t z = (*state_ptr += UINT64_C(0x9E3779B97F4A7C15));
+	z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+	z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+	return z ^ (z >> 31);
+}
+
+double yadsl_graphgen_random_double_internal(
+	uint64_t* state_ptr)
+{
+	return (double) (yadsl_graphgen_random_internal(state_ptr) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+size_t yadsl_graphgen_random_below_internal(
+	uint64_t* state_ptr,
+	size_t bound)
+{
+	return (size_t) (yadsl_graphgen_random_internal(state_ptr) % bound);
+}
@@ -0,0 +1,221 @@
+#ifndef __YADSL_GRAPHGEN_H__
+#define __YADSL_GRAPHGEN_H__
+
+/**
+ * \defgroup graphgen Graph Generators
+ * @brief Seeded generators of synthetic graphs
+ *
+ * Every generator populates an empty graph with ::yadsl_graph_build, so
+ * vertex i of the model is given id i, and the cost of building is linear
+ * in the number of edges. Generators are deterministic: the same
+ * parameters and seed always yield the same graph.
+ *
+ * Vertex and edge objects are created by callbacks. Edge objects may be
+ * left NULL, which saves one allocation per edge on large graphs. On
+ * weighted graphs, every edge weight is drawn uniformly from
+ * [min_weight, max_weight) and converted with
+ * ::yadsl_graph_edge_weight_from_double.
+ *
+ * Edges generated more than once (or, on undirected graphs, in both
+ * directions) are kept only once, as documented in ::yadsl_graph_build.
+ * Generating m edges takes O(m) time, plus O(m) temporary memory for the
+ * edge array, so graphs of 10^8 edges are practical on machines with
+ * enough memory for the graph itself.
+ *
+ * @{
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <graph/graph.h>
+
+/**
+ * @brief Return condition of Graph Generator functions
+*/
+typedef enum
+{
+	YADSL_GRAPHGEN_RET_OK = 0, /**< All went ok */
+	YADSL_GRAPHGEN_RET_MEMORY, /**< Could not allocate memory */
+	YADSL_GRAPHGEN_RET_PARAMETER, /**< Invalid parameter */
+}
+yadsl_GraphGenRet;
+
+/**
+ * @brief Vertex object creation function
+ * @param index vertex index
+ * @param arg user argument
+ * @return newly created object, or NULL if could not allocate memory
+*/
+typedef yadsl_GraphVertexObject*
+(*yadsl_GraphGenVertexObjFunc)(
+	size_t index,
+	void* arg);
+
+/**
+ * @brief Edge object creation function
+ * @param u source vertex index
+ * @param v destination vertex index
+ * @param arg user argument
+ * @return newly created object, or NULL if could not allocate memory
+*/
+typedef yadsl_GraphEdgeObject*
+(*yadsl_GraphGenEdgeObjFunc)(
+	size_t u,
+	size_t v,
+	void* arg);
+
+/**
+ * @brief Parameters shared by every generator
+*/
+typedef struct
+{
+	yadsl_GraphGenVertexObjFunc vertex_func; /**< creates vertex objects */
+	yadsl_GraphFreeVertexObjFunc free_vertex_func; /**< frees vertex objects on failure (may be NULL) */
+	yadsl_GraphGenEdgeObjFunc edge_func; /**< creates edge objects (may be NULL, for NULL objects) */
+	yadsl_GraphFreeEdgeObjFunc free_edge_func; /**< frees edge objects on failure (may be NULL) */
+	void* arg; /**< argument passed to vertex_func and edge_func */
+	double min_weight; /**< lower bound of edge weights (inclusive) */
+	double max_weight; /**< upper bound of edge weights (exclusive, unless equal to min_weight) */
+	unsigned long seed; /**< seed of the random number generator */
+}
+yadsl_GraphGenParams;
+
+/**
+ * @brief Generate an Erdős–Rényi graph G(n, p)
+ *
+ * Every pair of distinct vertices (ordered, on directed graphs) is joined
+ * independently with probability p. Gaps between consecutive edges are
+ * sampled directly, so the running time is linear in the number of edges
+ * rather than in the number of pairs.
+ *
+ * @param graph graph with no vertices
+ * @param params generator parameters
+ * @param vertex_count number of vertices (n)
+ * @param probability edge probability (p), between zero and one
+ * @return
+ * * ::YADSL_GRAPHGEN_RET_OK, and graph is populated
+ * * ::YADSL_GRAPHGEN_RET_PARAMETER, if graph is not empty, or if any
+ * parameter is invalid
+ * * ::YADSL_GRAPHGEN_RET_MEMORY
+*/
+yadsl_GraphGenRet
+yadsl_graphgen_erdos_renyi(
+	yadsl_GraphHandle* graph,
+	const yadsl_GraphGenParams* params,
+	size_t vertex_count,
+	double probability);
+
+/**
+ * @brief Generate an R-MAT (recursive matrix) graph
+ *
+ * Each edge is placed by descending scale levels of the adjacency matrix,
+ * choosing at every level the top-left, top-right, bottom-left or
+ * bottom-right quadrant with probabilities a, b, c and 1 - a - b - c.
+ * Skewed probabilities (such as 0.57, 0.19 and 0.19) yield the power-law
+ * degrees of Kronecker graphs. Self-loops may be generated.
+ *
+ * @param graph graph with no vertices
+ * @param params generator parameters
+ * @param scale base-two logarithm of the number of vertices (at most 32)
+ * @param edge_count number of edges to be generated, before duplicates are removed
+ * @param a probability of the top-left quadrant
+ * @param b probability of the top-right quadrant
+ * @param c probability of the bottom-left quadrant
+ * @return
+ * * ::YADSL_GRAPHGEN_RET_OK, and graph is populated
+ * * ::YADSL_GRAPHGEN_RET_PARAMETER, if graph is not empty, or if any
+ * parameter is invalid
+ * * ::YADSL_GRAPHGEN_RET_MEMORY
+*/
+yadsl_GraphGenRet
+yadsl_graphgen_rmat(
+	yadsl_GraphHandle* graph,
+	const yadsl_GraphGenParams* params,
+	size_t scale,
+	size_t edge_count,
+	double a,
+	double b,
+	double c);
+
+/**
+ * @brief Generate a two-dimensional grid
+ *
+ * The vertex at row r and column c has index r * column_count + c, and
+ * is joined to the vertices below and to the right of it. On directed
+ * graphs, neighbouring vertices are joined in both directions. The seed
+ * is only used for edge weights.
+ *
+ * @param graph graph with no vertices
+ * @param params generator parameters
+ * @param row_count number of rows
+ * @param column_count number of columns
+ * @return
+ * * ::YADSL_GRAPHGEN_RET_OK, and graph is populated
+ * * ::YADSL_GRAPHGEN_RET_PARAMETER, if graph is not empty, or if any
+ * parameter is invalid
+ * * ::YADSL_GRAPHGEN_RET_MEMORY
+*/
+yadsl_GraphGenRet
+yadsl_graphgen_grid(
+	yadsl_GraphHandle* graph,
+	const yadsl_GraphGenParams* params,
+	size_t row_count,
+	size_t column_count);
+
+/**
+ * @brief Generate a Barabási–Albert preferential attachment graph
+ *
+ * Vertex m is joined to vertices 0 to m - 1, and every following vertex
+ * is joined to m distinct earlier vertices, each chosen with probability
+ * proportional to its degree. On directed graphs, edges go from the newer
+ * vertex to the older one. The graph has (n - m) * m edges.
+ *
+ * @param graph graph with no vertices
+ * @param params generator parameters
+ * @param vertex_count number of vertices (n)
+ * @param edges_per_vertex number of edges added with every vertex (m),
+ * between one and n - 1
+ * @return
+ * * ::YADSL_GRAPHGEN_RET_OK, and graph is populated
+ * * ::YADSL_GRAPHGEN_RET_PARAMETER, if graph is not empty, or if any
+ * parameter is invalid
+ * * ::YADSL_GRAPHGEN_RET_MEMORY
+*/
+yadsl_GraphGenRet
+yadsl_graphgen_barabasi_albert(
+	yadsl_GraphHandle* graph,
+	const yadsl_GraphGenParams* params,
+	size_t vertex_count,
+	size_t edges_per_vertex);
+
+/**
+ * @brief Generate a random regular graph, without self-loops
+ *
+ * On undirected graphs, every vertex has degree d, and n * d must be
+ * even. On directed graphs, every vertex has both in-degree and
+ * out-degree d. Edge endpoints are paired at random, rejecting pairs that
+ * would form self-loops or parallel edges, and starting over in the rare
+ * event that no valid pair is left. When d is more than half of n - 1,
+ * the complement of a random (n - 1 - d)-regular graph is generated.
+ *
+ * @param graph graph with no vertices
+ * @param params generator parameters
+ * @param vertex_count number of vertices (n)
+ * @param degree degree of every vertex (d), less than n
+ * @return
+ * * ::YADSL_GRAPHGEN_RET_OK, and graph is populated
+ * * ::YADSL_GRAPHGEN_RET_PARAMETER, if graph is not empty, or if any
+ * parameter is invalid
+ * * ::YADSL_GRAPHGEN_RET_MEMORY
+*/
+yadsl_GraphGenRet
+yadsl_graphgen_random_regular(
+	yadsl_GraphHandle* graph,
+	const yadsl_GraphGenParams* params,
+	size_t vertex_count,
+	size_t degree);
+
+/** @} */
+
+#endif
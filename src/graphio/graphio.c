@@ -1,7 +1,33 @@
+#if defined(__unix__) || defined(__APPLE__)
+# define _POSIX_C_SOURCE 200809L
+# define YADSL_GRAPHIO_MMAP
+# define YADSL_GRAPHIO_MEMSTREAM
+#endif
+
 #include <graphio/graphio.h>
 
 #include <string.h>
 #include <assert.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdint.h>
+
+#ifdef YADSL_GRAPHIO_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef YADSL_GRAPHIO_MEMSTREAM
+#include <stdlib.h>
+/* Memory stream buffers are allocated by the C library, so they
+ * are freed here, out of reach of the memdb macros */
+static void yadsl_graphio_stream_data_free_internal(char* data)
+{
+	free(data);
+}
+#endif
 
 #ifdef YADSL_DEBUG
 #include <memdb/memdb.h>
@@ -9,35 +35,212 @@
 #include <stdlib.h>
 #endif
 
-#include <map/map.h>
-
 #if defined(_MSC_VER)
 # pragma warning(disable : 4996)
 # pragma warning(disable : 4022)
 #endif
 
-#define YADSL_GRAPHIO_WRITE(file, format, arg) do { \
-	if (fprintf(file, format, arg) < 0) \
-		return YADSL_GRAPHIO_RET_FILE_ERROR; \
-} while(0)
-
-#define YADSL_GRAPHIO_WRITE_NL(file, format, arg) \
-	YADSL_GRAPHIO_WRITE(file, format "\n", arg)
-
 #define YADSL_GRAPHIO_READ(file, format, arg) do { \
 	if (fscanf(file, " " format " ", arg) != 1) \
 		return YADSL_GRAPHIO_RET_FILE_ERROR; \
 } while(0)
 
-#define YADSL_GRAPHIO_FILE_FORMAT_VERSION 5
+#define YADSL_GRAPHIO_FILE_FORMAT_VERSION 6
+#define YADSL_GRAPHIO_UNWEIGHTED_FILE_FORMAT_VERSION 5
 
 #define YADSL_GRAPHIO_VERSION_STR     "VERSION %u"
 #define YADSL_GRAPHIO_DIRECTED_STR    "IS_DIRECTED %d"
+#define YADSL_GRAPHIO_WEIGHT_TYPE_STR "WEIGHT_TYPE %d"
 #define YADSL_GRAPHIO_VCOUNT_STR      "%zu "
 #define YADSL_GRAPHIO_VFLAG_STR       " %d "
 #define YADSL_GRAPHIO_VERTEX_IDX_STR  "%zu "
 #define YADSL_GRAPHIO_NBCOUNT_STR	   "%zu"
 #define YADSL_GRAPHIO_NB_IDX_STR      " %zu "
+#define YADSL_GRAPHIO_INT32_STR       "%" PRId32 " "
+#define YADSL_GRAPHIO_INT64_STR       "%" PRId64 " "
+#define YADSL_GRAPHIO_FLOAT_STR       "%.9g "
+#define YADSL_GRAPHIO_DOUBLE_STR      "%.17g "
+
+#define YADSL_GRAPHIO_STREAM_BUFFER_SIZE (1 << 20)
+
+/*
+ * Binary format (all integers in little-endian byte order)
+ *
+ * | Field          | Size                 |
+ * | :------------- | :------------------- |
+ * | magic          | 8 bytes ("YADSLGB")  |
+ * | version        | 4 bytes              |
+ * | flags          | 4 bytes              |
+ * | weight type    | 4 bytes              |
+ * | reserved       | 4 bytes              |
+ * | vertex count   | 8 bytes (n)          |
+ * | edge count     | 8 bytes (m)          |
+ * | entry count    | 8 bytes (E)          |
+ * | objects offset | 8 bytes              |
+ * | offsets        | 8 bytes * (n + 1)    |
+ * | weights        | 0, 4 or 8 bytes * E  |
+ * | destinations   | 4 bytes * E          |
+ * | vertex flags   | 4 bytes * n          |
+ * | objects        | (callbacks)          |
+ *
+ * Neighbour lists are sorted by id. On undirected graphs, every edge is
+ * stored at both of its endpoints (self-loops only once), so that the
+ * neighbours of any vertex can be read in place, without loading the
+ * whole file. The objects offset is relative to the start of the header.
+*/
+
+#define YADSL_GRAPHIO_BINARY_MAGIC "YADSLGB"
+#define YADSL_GRAPHIO_BINARY_FILE_FORMAT_VERSION 2
+#define YADSL_GRAPHIO_BINARY_HEADER_SIZE 56
+#define YADSL_GRAPHIO_BINARY_DIRECTED 0x1
+#define YADSL_GRAPHIO_BINARY_EDGE_OBJECTS 0x2
+#define YADSL_GRAPHIO_BINARY_BUFFER_SIZE 65536
+
+typedef struct
+{
+	FILE* file_ptr;
+	unsigned char* data;
+	size_t size;
+}
+yadsl_GraphIoBinaryWriter;
+
+typedef struct
+{
+	const unsigned char* data;
+	void* mapping;
+	size_t mapping_size;
+	unsigned char* buffer;
+}
+yadsl_GraphIoBinarySection;
+
+/* Neighbour lists of a graph, by vertex id */
+typedef struct
+{
+	size_t* offsets; /* n + 1 */
+	size_t* nbs; /* neighbour ids */
+	size_t* edges; /* edge ids */
+	size_t entry_count;
+}
+yadsl_GraphIoAdjacency;
+
+/* Binary file whose adjacency is accessed in place */
+typedef struct
+{
+	yadsl_GraphIoBinarySection section;
+	const unsigned char* offsets;
+	const unsigned char* weights;
+	const unsigned char* destinations;
+	const unsigned char* vertex_flags;
+	long base; /* file position of the header */
+	uint64_t objects_offset;
+	size_t vertex_count;
+	size_t edge_count;
+	size_t entry_count;
+	size_t weight_width;
+	yadsl_GraphEdgeWeightType weight_type;
+	uint32_t flags;
+	bool is_directed;
+}
+yadsl_GraphIoBinaryView;
+
+/*
+ * Compressed format (fixed-width integers in little-endian byte order)
+ *
+ * | Field          | Size                           |
+ * | :------------- | :----------------------------- |
+ * | magic          | 8 bytes ("YADSLGC")            |
+ * | version        | 4 bytes                        |
+ * | flags          | 4 bytes                        |
+ * | weight type    | 4 bytes                        |
+ * | block size     | 4 bytes (B)                    |
+ * | vertex count   | 8 bytes (n)                    |
+ * | edge count     | 8 bytes (m)                    |
+ * | records size   | 8 bytes                        |
+ * | objects offset | 8 bytes                        |
+ * | block index    | 8 bytes * (ceil(n / B) + 1)    |
+ * | records        | (see below)                    |
+ * | objects        | (callbacks)                    |
+ *
+ * Every record holds the flag of a vertex (zigzag varint), its degree
+ * (varint), the deltas between its consecutive neighbour ids (varints,
+ * the first one from zero), and then the weights of its edges. The
+ * block index holds the offset of every B-th record, relative to the
+ * first one, followed by the records size.
+*/
+
+#define YADSL_GRAPHIO_COMPRESSED_MAGIC "YADSLGC"
+#define YADSL_GRAPHIO_COMPRESSED_FILE_FORMAT_VERSION 1
+#define YADSL_GRAPHIO_COMPRESSED_HEADER_SIZE 56
+#define YADSL_GRAPHIO_COMPRESSED_BLOCK_SIZE 64
+
+#define YADSL_GRAPHIO_ZIGZAG(value) \
+	((uint64_t) (((uint32_t) (value) << 1) ^ ((value) < 0 ? UINT32_MAX : 0)))
+
+#define YADSL_GRAPHIO_UNZIGZAG(value) \
+	((int) (int32_t) ((uint32_t) ((value) >> 1) ^ (uint32_t) (0 - ((value) & 1))))
+
+#define YADSL_GRAPHIO_IMPORT_CHUNK_SIZE (1 << 20)
+
+typedef struct
+{
+	yadsl_GraphIoBinarySection section;
+	const unsigned char* index;
+	const unsigned char* data;
+	long base; /* file position of the header */
+	uint64_t data_size;
+	uint64_t objects_offset;
+	size_t vertex_count;
+	size_t edge_count;
+	size_t block_size;
+	size_t block_count;
+	size_t weight_width;
+	yadsl_GraphEdgeWeightType weight_type;
+	uint32_t flags;
+	bool is_directed;
+}
+yadsl_GraphIoCompressedView;
+
+typedef enum
+{
+	YADSL_GRAPHIO_IMPORT_STATE_HEADER = 0, /* Expecting banner or problem line */
+	YADSL_GRAPHIO_IMPORT_STATE_SIZE, /* Expecting Matrix Market size line */
+	YADSL_GRAPHIO_IMPORT_STATE_ENTRIES, /* Expecting edges */
+}
+yadsl_GraphIoImportState;
+
+typedef struct
+{
+	const yadsl_GraphIoImportParams* params;
+	yadsl_GraphBuildEdge* edges;
+	size_t edge_count;
+	size_t edge_capacity;
+	size_t vertex_count; /* declared, or largest id plus one */
+	size_t entry_count; /* declared number of entries */
+	size_t read_entry_count;
+	yadsl_GraphIoImportState state;
+	bool is_symmetric;
+	bool is_skew_symmetric;
+	bool has_values;
+}
+yadsl_GraphIoImporter;
+
+/* Text writer that formats rows into chunks held in memory,
+ * or straight into the file */
+typedef struct
+{
+	FILE* file_ptr;
+	FILE* chunk_ptr; /* memory stream, or file_ptr where there are none */
+	bool is_chunked; /* false to write every row straight to file_ptr */
+	char* chunk_data;
+	size_t chunk_size;
+	long chunk_start; /* position of the chunk in chunk_ptr */
+	size_t buffer_size;
+	size_t row_count; /* rows written so far (two per vertex) */
+	size_t total_row_count;
+	yadsl_GraphIoProgressFunc progress_func;
+	void* arg;
+}
+yadsl_GraphIoStreamWriter;
 
 /* Private functions prototypes */
 
@@ -46,7 +249,114 @@ static yadsl_GraphIoRet yadsl_graphio_write_internal(
 	FILE* file_ptr,
 	yadsl_GraphIoVertexWriteFunc write_vertex_func,
 	yadsl_GraphIoEdgeWriteFunc write_edge_func,
-	yadsl_MapHandle* address_map);
+	const yadsl_GraphIoWriteParams* params,
+	bool is_chunked);
+
+static yadsl_GraphIoRet yadsl_graphio_weight_read_internal(
+	FILE* file_ptr,
+	yadsl_GraphEdgeWeightType weight_type,
+	yadsl_GraphEdgeWeight* weight_ptr);
+
+static yadsl_GraphIoRet yadsl_graphio_stream_chunk_open_internal(
+	yadsl_GraphIoStreamWriter* writer);
+
+static yadsl_GraphIoRet yadsl_graphio_stream_chunk_close_internal(
+	yadsl_GraphIoStreamWriter* writer,
+	bool is_written);
+
+static yadsl_GraphIoRet yadsl_graphio_stream_row_end_internal(
+	yadsl_GraphIoStreamWriter* writer);
+
+static yadsl_GraphIoRet yadsl_graphio_stream_put_internal(
+	yadsl_GraphIoStreamWriter* writer,
+	const char* text,
+	size_t length);
+
+static yadsl_GraphIoRet yadsl_graphio_stream_integer_put_internal(
+	yadsl_GraphIoStreamWriter* writer,
+	uint64_t magnitude,
+	bool is_negative,
+	char before,
+	char after);
+
+static yadsl_GraphIoRet yadsl_graphio_stream_weight_put_internal(
+	yadsl_GraphIoStreamWriter* writer,
+	yadsl_GraphEdgeWeightType weight_type,
+	yadsl_GraphEdgeWeight weight);
+
+static size_t yadsl_graphio_compressed_varint_length_internal(
+	uint64_t value);
+
+static bool yadsl_graphio_compressed_varint_put_internal(
+	yadsl_GraphIoBinaryWriter* writer,
+	uint64_t value);
+
+static bool yadsl_graphio_compressed_varint_get_internal(
+	const unsigned char** p_ptr,
+	const unsigned char* end,
+	uint64_t* value_ptr);
+
+static yadsl_GraphIoRet yadsl_graphio_compressed_open_internal(
+	FILE* file_ptr,
+	yadsl_GraphIoCompressedView* view);
+
+static void yadsl_graphio_compressed_block_get_internal(
+	yadsl_GraphIoCompressedView* view,
+	size_t block,
+	const unsigned char** p_ptr,
+	const unsigned char** end_ptr);
+
+static yadsl_GraphIoRet yadsl_graphio_compressed_record_find_internal(
+	yadsl_GraphIoCompressedView* view,
+	size_t id,
+	const unsigned char** p_ptr,
+	const unsigned char** end_ptr);
+
+static bool yadsl_graphio_compressed_record_head_internal(
+	yadsl_GraphIoCompressedView* view,
+	const unsigned char** p_ptr,
+	const unsigned char* end,
+	yadsl_GraphVertexFlag* flag_ptr,
+	size_t* degree_ptr);
+
+static yadsl_GraphIoRet yadsl_graphio_import_parse_internal(
+	yadsl_GraphIoImporter* importer,
+	FILE* file_ptr);
+
+static yadsl_GraphIoRet yadsl_graphio_import_line_internal(
+	yadsl_GraphIoImporter* importer,
+	const char* line,
+	const char* end);
+
+static yadsl_GraphIoRet yadsl_graphio_import_edge_add_internal(
+	yadsl_GraphIoImporter* importer,
+	size_t u,
+	size_t v,
+	yadsl_GraphEdgeWeight weight);
+
+static const char* yadsl_graphio_import_space_skip_internal(
+	const char* p,
+	const char* end);
+
+static bool yadsl_graphio_import_size_parse_internal(
+	const char** p_ptr,
+	const char* end,
+	size_t* value_ptr);
+
+static bool yadsl_graphio_import_weight_parse_internal(
+	const char** p_ptr,
+	const char* end,
+	yadsl_GraphEdgeWeightType weight_type,
+	yadsl_GraphEdgeWeight* weight_ptr);
+
+static yadsl_GraphEdgeWeight yadsl_graphio_import_weight_negate_internal(
+	yadsl_GraphEdgeWeightType weight_type,
+	yadsl_GraphEdgeWeight weight);
+
+static bool yadsl_graphio_import_word_match_internal(
+	const char** p_ptr,
+	const char* end,
+	const char* word);
 
 static yadsl_GraphIoRet yadsl_graphio_read_internal(
 	yadsl_GraphHandle* graph,
@@ -54,11 +364,63 @@ static yadsl_GraphIoRet yadsl_graphio_read_internal(
 	FILE* file_ptr,
 	size_t vertex_count,
 	int is_directed,
+	yadsl_GraphEdgeWeightType weight_type,
 	yadsl_GraphIoVertexReadFunc read_vertex_func,
 	yadsl_GraphIoEdgeReadFunc read_edge_func,
 	yadsl_GraphFreeVertexObjFunc free_vertex_func,
 	yadsl_GraphFreeEdgeObjFunc free_edge_func);
 
+static size_t yadsl_graphio_binary_weight_width_internal(
+	yadsl_GraphEdgeWeightType weight_type);
+
+static bool yadsl_graphio_binary_put_internal(
+	yadsl_GraphIoBinaryWriter* writer,
+	uint64_t value,
+	size_t width);
+
+static bool yadsl_graphio_binary_flush_internal(
+	yadsl_GraphIoBinaryWriter* writer);
+
+static uint64_t yadsl_graphio_binary_get_internal(
+	const unsigned char* data,
+	size_t width);
+
+static uint64_t yadsl_graphio_binary_weight_encode_internal(
+	yadsl_GraphEdgeWeightType weight_type,
+	yadsl_GraphEdgeWeight weight);
+
+static yadsl_GraphEdgeWeight yadsl_graphio_binary_weight_decode_internal(
+	yadsl_GraphEdgeWeightType weight_type,
+	uint64_t value);
+
+static yadsl_GraphIoRet yadsl_graphio_binary_section_load_internal(
+	FILE* file_ptr,
+	long offset,
+	size_t size,
+	bool is_sequential,
+	yadsl_GraphIoBinarySection* section);
+
+static void yadsl_graphio_binary_section_release_internal(
+	yadsl_GraphIoBinarySection* section);
+
+static yadsl_GraphIoRet yadsl_graphio_binary_open_internal(
+	FILE* file_ptr,
+	bool is_sequential,
+	yadsl_GraphIoBinaryView* view);
+
+static yadsl_GraphIoRet yadsl_graphio_binary_row_get_internal(
+	yadsl_GraphIoBinaryView* view,
+	size_t id,
+	size_t* begin_ptr,
+	size_t* end_ptr);
+
+static bool yadsl_graphio_adjacency_create_internal(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphIoAdjacency* adjacency);
+
+static void yadsl_graphio_adjacency_destroy_internal(
+	yadsl_GraphIoAdjacency* adjacency);
+
 /* Public functions */
 
 yadsl_GraphIoRet yadsl_graphio_write(
@@ -67,13 +429,17 @@ yadsl_GraphIoRet yadsl_graphio_write(
 	yadsl_GraphIoVertexWriteFunc write_vertex_func,
 	yadsl_GraphIoEdgeWriteFunc write_edge_func)
 {
-	yadsl_MapHandle* adress_map;
-	yadsl_GraphIoRet ret;
-	if (!(adress_map = yadsl_map_create(NULL, NULL, NULL, NULL)))
-		return YADSL_GRAPHIO_RET_MEMORY;
-	ret = yadsl_graphio_write_internal(graph, file_ptr, write_vertex_func, write_edge_func, adress_map);
-	yadsl_map_destroy(adress_map);
-	return ret;
+	return yadsl_graphio_write_internal(graph, file_ptr, write_vertex_func, write_edge_func, NULL, false);
+}
+
+yadsl_GraphIoRet yadsl_graphio_write_streamed(
+	yadsl_GraphHandle* graph,
+	FILE* file_ptr,
+	yadsl_GraphIoVertexWriteFunc write_vertex_func,
+	yadsl_GraphIoEdgeWriteFunc write_edge_func,
+	const yadsl_GraphIoWriteParams* params)
+{
+	return yadsl_graphio_write_internal(graph, file_ptr, write_vertex_func, write_edge_func, params, true);
 }
 
 yadsl_GraphIoRet yadsl_graphio_read(
@@ -89,18 +455,26 @@ yadsl_GraphIoRet yadsl_graphio_read(
 	yadsl_GraphIoRet ret;
 	unsigned int version;
 	size_t vertex_count;
-	int is_directed;
+	int is_directed, weight_type;
 	yadsl_GraphHandle* graph;
 	void** address_map;
 
 	YADSL_GRAPHIO_READ(file_ptr, YADSL_GRAPHIO_VERSION_STR, &version); /* Version */
-	if (version != YADSL_GRAPHIO_FILE_FORMAT_VERSION)
+	if (version != YADSL_GRAPHIO_FILE_FORMAT_VERSION &&
+		version != YADSL_GRAPHIO_UNWEIGHTED_FILE_FORMAT_VERSION)
 		return YADSL_GRAPHIO_RET_DEPRECATED_FILE_FORMAT;
 	YADSL_GRAPHIO_READ(file_ptr, YADSL_GRAPHIO_DIRECTED_STR, &is_directed); /* Directed */
+	if (version == YADSL_GRAPHIO_UNWEIGHTED_FILE_FORMAT_VERSION)
+		weight_type = YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE;
+	else
+		YADSL_GRAPHIO_READ(file_ptr, YADSL_GRAPHIO_WEIGHT_TYPE_STR, &weight_type); /* Weight type */
+	if (weight_type < YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE ||
+		weight_type > YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE)
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
 	YADSL_GRAPHIO_READ(file_ptr, YADSL_GRAPHIO_VCOUNT_STR, &vertex_count); /* Vertex count */
 
 	/* Graph to be created */
-	if (!(graph = yadsl_graph_create(is_directed, cmp_vertices_func, free_vertex_func, cmp_edges_func, free_edge_func)))
+	if (!(graph = yadsl_graph_create_weighted(is_directed, weight_type, cmp_vertices_func, free_vertex_func, cmp_edges_func, free_edge_func)))
 		return YADSL_GRAPHIO_RET_MEMORY;
 
 	/* Address map to store vertex items */
@@ -110,7 +484,7 @@ yadsl_GraphIoRet yadsl_graphio_read(
 		return YADSL_GRAPHIO_RET_MEMORY;
 	}
 
-	ret = yadsl_graphio_read_internal(graph, address_map, file_ptr, vertex_count, is_directed, read_vertex_func, read_edge_func, free_vertex_func, free_edge_func);
+	ret = yadsl_graphio_read_internal(graph, address_map, file_ptr, vertex_count, is_directed, weight_type, read_vertex_func, read_edge_func, free_vertex_func, free_edge_func);
 	free(address_map);
 	if (ret) {
 		yadsl_graph_destroy(graph);
@@ -120,67 +494,774 @@ yadsl_GraphIoRet yadsl_graphio_read(
 	return YADSL_GRAPHIO_RET_OK;
 }
 
-/* Private functions */
+yadsl_GraphIoRet yadsl_graphio_binary_write(
+	yadsl_GraphHandle* graph,
+	FILE* file_ptr,
+	yadsl_GraphIoVertexWriteFunc write_vertex_func,
+	yadsl_GraphIoEdgeWriteFunc write_edge_func)
+{
+	yadsl_GraphIoBinaryWriter writer;
+	yadsl_GraphIoAdjacency adjacency;
+	yadsl_GraphIoRet ret = YADSL_GRAPHIO_RET_FILE_ERROR;
+	yadsl_GraphEdgeWeightType weight_type;
+	yadsl_GraphEdgeWeight weight;
+	yadsl_GraphVertexObject* u_obj, * v_obj;
+	yadsl_GraphEdgeObject* uv_obj;
+	size_t vertex_count, edge_count, weight_width, id, u, v, k;
+	uint64_t objects_offset;
+	uint32_t flags = 0;
+	bool is_directed;
+	int flag;
 
-static yadsl_GraphIoRet yadsl_graphio_write_internal(
+	if (yadsl_graph_is_directed_check(graph, &is_directed)) assert(0);
+	if (yadsl_graph_edge_weight_type_get(graph, &weight_type)) assert(0);
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (yadsl_graph_edge_count_get(graph, &edge_count)) assert(0);
+	weight_width = yadsl_graphio_binary_weight_width_internal(weight_type);
+	if (is_directed)
+		flags |= YADSL_GRAPHIO_BINARY_DIRECTED;
+	if (write_edge_func)
+		flags |= YADSL_GRAPHIO_BINARY_EDGE_OBJECTS;
+
+	writer.file_ptr = file_ptr;
+	writer.size = 0;
+	if (!(writer.data = malloc(YADSL_GRAPHIO_BINARY_BUFFER_SIZE)))
+		return YADSL_GRAPHIO_RET_MEMORY;
+	if (!yadsl_graphio_adjacency_create_internal(graph, &adjacency)) {
+		free(writer.data);
+		return YADSL_GRAPHIO_RET_MEMORY;
+	}
+
+	objects_offset = YADSL_GRAPHIO_BINARY_HEADER_SIZE +
+		((uint64_t) vertex_count + 1) * 8 +
+		(uint64_t) adjacency.entry_count * (weight_width + 4) +
+		(uint64_t) vertex_count * 4;
+
+	/* Header */
+	for (k = 0; k < sizeof(YADSL_GRAPHIO_BINARY_MAGIC); ++k)
+		if (!yadsl_graphio_binary_put_internal(&writer, YADSL_GRAPHIO_BINARY_MAGIC[k], 1))
+			goto exit;
+	if (!yadsl_graphio_binary_put_internal(&writer, YADSL_GRAPHIO_BINARY_FILE_FORMAT_VERSION, 4) ||
+		!yadsl_graphio_binary_put_internal(&writer, flags, 4) ||
+		!yadsl_graphio_binary_put_internal(&writer, (uint64_t) weight_type, 4) ||
+		!yadsl_graphio_binary_put_internal(&writer, 0, 4) ||
+		!yadsl_graphio_binary_put_internal(&writer, vertex_count, 8) ||
+		!yadsl_graphio_binary_put_internal(&writer, edge_count, 8) ||
+		!yadsl_graphio_binary_put_internal(&writer, adjacency.entry_count, 8) ||
+		!yadsl_graphio_binary_put_internal(&writer, objects_offset, 8))
+		goto exit;
+
+	/* Adjacency */
+	for (u = 0; u <= vertex_count; ++u)
+		if (!yadsl_graphio_binary_put_internal(&writer, adjacency.offsets[u], 8))
+			goto exit;
+	if (weight_width > 0) {
+		for (k = 0; k < adjacency.entry_count; ++k) {
+			if (yadsl_graph_edge_endpoint_ids_get(graph, adjacency.edges[k], &u, &v, &weight)) assert(0);
+			if (!yadsl_graphio_binary_put_internal(&writer,
+				yadsl_graphio_binary_weight_encode_internal(weight_type, weight), weight_width))
+				goto exit;
+		}
+	}
+	for (k = 0; k < adjacency.entry_count; ++k)
+		if (!yadsl_graphio_binary_put_internal(&writer, adjacency.nbs[k], 4))
+			goto exit;
+	for (id = 0; id < vertex_count; ++id) {
+		if (yadsl_graph_vertex_flag_by_id_get(graph, id, &flag)) assert(0);
+		if (!yadsl_graphio_binary_put_internal(&writer, (uint32_t) flag, 4))
+			goto exit;
+	}
+	if (!yadsl_graphio_binary_flush_internal(&writer))
+		goto exit;
+
+	/* Objects (edges at their first entry) */
+	ret = YADSL_GRAPHIO_RET_WRITING_FAILURE;
+	for (id = 0; id < vertex_count; ++id) {
+		if (yadsl_graph_vertex_by_id_get(graph, id, &u_obj)) assert(0);
+		if (write_vertex_func(file_ptr, u_obj))
+			goto exit;
+	}
+	if (write_edge_func) {
+		for (u = 0; u < vertex_count; ++u) {
+			for (k = adjacency.offsets[u]; k < adjacency.offsets[u + 1]; ++k) {
+				if (!is_directed && adjacency.nbs[k] < u)
+					continue;
+				if (yadsl_graph_edge_by_id_get(graph, adjacency.edges[k], &u_obj, &v_obj, &uv_obj)) assert(0);
+				if (write_edge_func(file_ptr, uv_obj))
+					goto exit;
+			}
+		}
+	}
+	ret = YADSL_GRAPHIO_RET_OK;
+exit:
+	free(writer.data);
+	yadsl_graphio_adjacency_destroy_internal(&adjacency);
+	return ret;
+}
+
+yadsl_GraphIoRet yadsl_graphio_binary_read(
+	FILE* file_ptr,
+	yadsl_GraphIoVertexReadFunc read_vertex_func,
+	yadsl_GraphIoEdgeReadFunc read_edge_func,
+	yadsl_GraphCmpVertexObjsFunc cmp_vertices_func,
+	yadsl_GraphFreeVertexObjFunc free_vertex_func,
+	yadsl_GraphCmpEdgeObjsFunc cmp_edges_func,
+	yadsl_GraphFreeEdgeObjFunc free_edge_func,
+	yadsl_GraphHandle** graph_ptr)
+{
+	yadsl_GraphIoBinaryView view;
+	yadsl_GraphIoRet ret;
+	yadsl_GraphHandle* graph = NULL;
+	yadsl_GraphVertexObject** vertices = NULL;
+	yadsl_GraphBuildEdge* edges = NULL;
+	size_t u, v, k, edge_index = 0, read_vertex_count = 0, read_edge_count = 0;
+	uint64_t next;
+
+	if (ret = yadsl_graphio_binary_open_internal(file_ptr, true, &view))
+		return ret;
+	ret = YADSL_GRAPHIO_RET_CREATION_FAILURE;
+	if ((view.flags & YADSL_GRAPHIO_BINARY_EDGE_OBJECTS) && read_edge_func == NULL)
+		goto exit;
+	ret = YADSL_GRAPHIO_RET_MEMORY;
+	if (!(vertices = malloc(view.vertex_count * sizeof(*vertices) + 1)))
+		goto exit;
+	if (view.edge_count > 0 && !(edges = malloc(view.edge_count * sizeof(*edges))))
+		goto exit;
+
+	/* Adjacency */
+	ret = YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	if (yadsl_graphio_binary_get_internal(view.offsets, 8) != 0)
+		goto exit;
+	for (u = 0, k = 0; u < view.vertex_count; ++u) {
+		next = yadsl_graphio_binary_get_internal(view.offsets + (u + 1) * 8, 8);
+		if (next < k || next > view.entry_count)
+			goto exit;
+		for (; k < next; ++k) {
+			v = (size_t) yadsl_graphio_binary_get_internal(view.destinations + k * 4, 4);
+			if (v >= view.vertex_count)
+				goto exit;
+			if (!view.is_directed && v < u)
+				continue;
+			if (edge_index == view.edge_count)
+				goto exit;
+			edges[edge_index].u = u;
+			edges[edge_index].v = v;
+			edges[edge_index].item = NULL;
+			if (view.weight_width > 0)
+				edges[edge_index].weight = yadsl_graphio_binary_weight_decode_internal(view.weight_type,
+					yadsl_graphio_binary_get_internal(view.weights + k * view.weight_width, view.weight_width));
+			else
+				edges[edge_index].weight = yadsl_graph_edge_weight_from_double(view.weight_type, 0);
+			++edge_index;
+		}
+	}
+	if (k != view.entry_count || edge_index != view.edge_count)
+		goto exit;
+
+	/* Objects */
+	if (fseek(file_ptr, view.base + (long) view.objects_offset, SEEK_SET)) {
+		ret = YADSL_GRAPHIO_RET_FILE_ERROR;
+		goto exit;
+	}
+	ret = YADSL_GRAPHIO_RET_CREATION_FAILURE;
+	for (; read_vertex_count < view.vertex_count; ++read_vertex_count)
+		if (read_vertex_func(file_ptr, &vertices[read_vertex_count]))
+			goto exit;
+	if (view.flags & YADSL_GRAPHIO_BINARY_EDGE_OBJECTS)
+		for (; read_edge_count < view.edge_count; ++read_edge_count)
+			if (read_edge_func(file_ptr, &edges[read_edge_count].item))
+				goto exit;
+
+	/* Graph */
+	ret = YADSL_GRAPHIO_RET_MEMORY;
+	if (!(graph = yadsl_graph_create_weighted(view.is_directed, view.weight_type,
+		cmp_vertices_func, free_vertex_func, cmp_edges_func, free_edge_func)))
+		goto exit;
+	if (yadsl_graph_build(graph, vertices, view.vertex_count, edges, view.edge_count))
+		goto exit;
+	/* The graph owns every object now */
+	read_vertex_count = 0;
+	read_edge_count = 0;
+	if (yadsl_graph_edge_count_get(graph, &k)) assert(0);
+	if (k != view.edge_count) {
+		/* Duplicate edges were dropped by the build */
+		ret = YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		goto exit;
+	}
+	for (u = 0; u < view.vertex_count; ++u)
+		if (yadsl_graph_vertex_flag_by_id_set(graph, u,
+			(int) (int32_t) (uint32_t) yadsl_graphio_binary_get_internal(view.vertex_flags + u * 4, 4))) assert(0);
+	*graph_ptr = graph;
+	graph = NULL;
+	ret = YADSL_GRAPHIO_RET_OK;
+exit:
+	if (free_vertex_func)
+		for (u = 0; u < read_vertex_count; ++u)
+			free_vertex_func(vertices[u]);
+	if (free_edge_func)
+		for (k = 0; k < read_edge_count; ++k)
+			free_edge_func(edges[k].item);
+	if (graph)
+		yadsl_graph_destroy(graph);
+	if (vertices)
+		free(vertices);
+	if (edges)
+		free(edges);
+	yadsl_graphio_binary_section_release_internal(&view.section);
+	return ret;
+}
+
+yadsl_GraphIoRet yadsl_graphio_mapped_open(
+	FILE* file_ptr,
+	yadsl_GraphIoMappedHandle** handle_ptr)
+{
+	yadsl_GraphIoBinaryView* view;
+	yadsl_GraphIoRet ret;
+	if (!(view = malloc(sizeof(*view))))
+		return YADSL_GRAPHIO_RET_MEMORY;
+	if (ret = yadsl_graphio_binary_open_internal(file_ptr, false, view)) {
+		free(view);
+		return ret;
+	}
+	*handle_ptr = view;
+	return YADSL_GRAPHIO_RET_OK;
+}
+
+void yadsl_graphio_mapped_vertex_count_get(
+	yadsl_GraphIoMappedHandle* handle,
+	size_t* vertex_count_ptr)
+{
+	*vertex_count_ptr = ((yadsl_GraphIoBinaryView*) handle)->vertex_count;
+}
+
+void yadsl_graphio_mapped_edge_count_get(
+	yadsl_GraphIoMappedHandle* handle,
+	size_t* edge_count_ptr)
+{
+	*edge_count_ptr = ((yadsl_GraphIoBinaryView*) handle)->edge_count;
+}
+
+void yadsl_graphio_mapped_is_directed_check(
+	yadsl_GraphIoMappedHandle* handle,
+	bool* is_directed_ptr)
+{
+	*is_directed_ptr = ((yadsl_GraphIoBinaryView*) handle)->is_directed;
+}
+
+void yadsl_graphio_mapped_edge_weight_type_get(
+	yadsl_GraphIoMappedHandle* handle,
+	yadsl_GraphEdgeWeightType* weight_type_ptr)
+{
+	*weight_type_ptr = ((yadsl_GraphIoBinaryView*) handle)->weight_type;
+}
+
+yadsl_GraphIoRet yadsl_graphio_mapped_vertex_flag_get(
+	yadsl_GraphIoMappedHandle* handle,
+	size_t id,
+	yadsl_GraphVertexFlag* flag_ptr)
+{
+	yadsl_GraphIoBinaryView* view = (yadsl_GraphIoBinaryView*) handle;
+	if (id >= view->vertex_count)
+		return YADSL_GRAPHIO_RET_PARAMETER;
+	*flag_ptr = (int) (int32_t) (uint32_t) yadsl_graphio_binary_get_internal(view->vertex_flags + id * 4, 4);
+	return YADSL_GRAPHIO_RET_OK;
+}
+
+yadsl_GraphIoRet yadsl_graphio_mapped_vertex_degree_get(
+	yadsl_GraphIoMappedHandle* handle,
+	size_t id,
+	size_t* degree_ptr)
+{
+	yadsl_GraphIoBinaryView* view = (yadsl_GraphIoBinaryView*) handle;
+	size_t begin, end;
+	yadsl_GraphIoRet ret;
+	if (ret = yadsl_graphio_binary_row_get_internal(view, id, &begin, &end))
+		return ret;
+	*degree_ptr = end - begin;
+	return YADSL_GRAPHIO_RET_OK;
+}
+
+yadsl_GraphIoRet yadsl_graphio_mapped_vertex_nb_get(
+	yadsl_GraphIoMappedHandle* handle,
+	size_t id,
+	size_t index,
+	size_t* nb_ptr,
+	yadsl_GraphEdgeWeight* weight_ptr)
+{
+	yadsl_GraphIoBinaryView* view = (yadsl_GraphIoBinaryView*) handle;
+	size_t begin, end, nb;
+	yadsl_GraphIoRet ret;
+	if (ret = yadsl_graphio_binary_row_get_internal(view, id, &begin, &end))
+		return ret;
+	if (index >= end - begin)
+		return YADSL_GRAPHIO_RET_PARAMETER;
+	begin += index;
+	nb = (size_t) yadsl_graphio_binary_get_internal(view->destinations + begin * 4, 4);
+	if (nb >= view->vertex_count)
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	*nb_ptr = nb;
+	if (weight_ptr) {
+		if (view->weight_width > 0)
+			*weight_ptr = yadsl_graphio_binary_weight_decode_internal(view->weight_type,
+				yadsl_graphio_binary_get_internal(view->weights + begin * view->weight_width, view->weight_width));
+		else
+			*weight_ptr = yadsl_graph_edge_weight_from_double(view->weight_type, 0);
+	}
+	return YADSL_GRAPHIO_RET_OK;
+}
+
+void yadsl_graphio_mapped_close(
+	yadsl_GraphIoMappedHandle* handle)
+{
+	yadsl_GraphIoBinaryView* view = (yadsl_GraphIoBinaryView*) handle;
+	if (view == NULL)
+		return;
+	yadsl_graphio_binary_section_release_internal(&view->section);
+	free(view);
+}
+
+yadsl_GraphIoRet yadsl_graphio_compressed_write(
 	yadsl_GraphHandle* graph,
 	FILE* file_ptr,
 	yadsl_GraphIoVertexWriteFunc write_vertex_func,
-	yadsl_GraphIoEdgeWriteFunc write_edge_func,
-	yadsl_MapHandle* address_map)
+	yadsl_GraphIoEdgeWriteFunc write_edge_func)
 {
+	yadsl_GraphIoBinaryWriter writer;
+	yadsl_GraphIoRet ret = YADSL_GRAPHIO_RET_FILE_ERROR;
+	yadsl_GraphEdgeWeightType weight_type;
+	yadsl_GraphEdgeWeight weight;
+	yadsl_GraphVertexObject* u_obj, * v_obj;
+	yadsl_GraphEdgeObject* uv_obj;
+	yadsl_GraphIoAdjacency adjacency;
+	size_t vertex_count, edge_count, block_count, weight_width;
+	size_t id, u, v, k, i;
+	size_t* offsets, * nbs;
+	uint64_t* block_offsets = NULL;
+	uint64_t size = 0, objects_offset;
+	uint32_t flags = 0;
 	bool is_directed;
-	yadsl_MapRet map_ret;
-	void* previous_value;
-	size_t vertex_count, nb_count, i, j, index;
-	void* vertex, * nb, * edge;
+	int flag;
 
 	if (yadsl_graph_is_directed_check(graph, &is_directed)) assert(0);
+	if (yadsl_graph_edge_weight_type_get(graph, &weight_type)) assert(0);
 	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (yadsl_graph_edge_count_get(graph, &edge_count)) assert(0);
+	weight_width = yadsl_graphio_binary_weight_width_internal(weight_type);
+	block_count = (vertex_count + YADSL_GRAPHIO_COMPRESSED_BLOCK_SIZE - 1) / YADSL_GRAPHIO_COMPRESSED_BLOCK_SIZE;
+	if (is_directed)
+		flags |= YADSL_GRAPHIO_BINARY_DIRECTED;
+	if (write_edge_func)
+		flags |= YADSL_GRAPHIO_BINARY_EDGE_OBJECTS;
+
+	writer.file_ptr = file_ptr;
+	writer.size = 0;
+	if (!(writer.data = malloc(YADSL_GRAPHIO_BINARY_BUFFER_SIZE)))
+		return YADSL_GRAPHIO_RET_MEMORY;
+	if (!(block_offsets = malloc((block_count + 1) * sizeof(*block_offsets)))) {
+		free(writer.data);
+		return YADSL_GRAPHIO_RET_MEMORY;
+	}
+	if (!yadsl_graphio_adjacency_create_internal(graph, &adjacency)) {
+		free(writer.data);
+		free(block_offsets);
+		return YADSL_GRAPHIO_RET_MEMORY;
+	}
+	offsets = adjacency.offsets;
+	nbs = adjacency.nbs;
 
-	YADSL_GRAPHIO_WRITE_NL(file_ptr, YADSL_GRAPHIO_VERSION_STR, YADSL_GRAPHIO_FILE_FORMAT_VERSION); /* Version */
-	YADSL_GRAPHIO_WRITE_NL(file_ptr, YADSL_GRAPHIO_DIRECTED_STR, is_directed); /* Directed */
-	YADSL_GRAPHIO_WRITE(file_ptr, YADSL_GRAPHIO_VCOUNT_STR, vertex_count); /* Vertex count */
+	/* Block index */
+	for (u = 0; u < vertex_count; ++u) {
+		if (u % YADSL_GRAPHIO_COMPRESSED_BLOCK_SIZE == 0)
+			block_offsets[u / YADSL_GRAPHIO_COMPRESSED_BLOCK_SIZE] = size;
+		if (yadsl_graph_vertex_flag_by_id_get(graph, u, &flag)) assert(0);
+		size += yadsl_graphio_compressed_varint_length_internal(YADSL_GRAPHIO_ZIGZAG(flag));
+		size += yadsl_graphio_compressed_varint_length_internal(offsets[u + 1] - offsets[u]);
+		for (k = offsets[u]; k < offsets[u + 1]; ++k)
+			size += yadsl_graphio_compressed_varint_length_internal(
+				k == offsets[u] ? nbs[k] : nbs[k] - nbs[k - 1]) + weight_width;
+	}
+	block_offsets[block_count] = size;
+	objects_offset = YADSL_GRAPHIO_COMPRESSED_HEADER_SIZE + ((uint64_t) block_count + 1) * 8 + size;
 
-	for (i = 0; i < vertex_count; ++i) {
-		int flag;
-		bool overwrite;
-		if (yadsl_graph_vertex_iter(graph, YADSL_GRAPH_ITER_DIR_NEXT, &vertex)) assert(0);
-		if (map_ret = yadsl_map_entry_add(address_map, vertex, (yadsl_MapEntryValue*) i, &overwrite, &previous_value)) {
-			assert(!overwrite);
-			return YADSL_GRAPHIO_RET_MEMORY;
+	/* Header */
+	for (i = 0; i < sizeof(YADSL_GRAPHIO_COMPRESSED_MAGIC); ++i)
+		if (!yadsl_graphio_binary_put_internal(&writer, YADSL_GRAPHIO_COMPRESSED_MAGIC[i], 1))
+			goto exit;
+	if (!yadsl_graphio_binary_put_internal(&writer, YADSL_GRAPHIO_COMPRESSED_FILE_FORMAT_VERSION, 4) ||
+		!yadsl_graphio_binary_put_internal(&writer, flags, 4) ||
+		!yadsl_graphio_binary_put_internal(&writer, (uint64_t) weight_type, 4) ||
+		!yadsl_graphio_binary_put_internal(&writer, YADSL_GRAPHIO_COMPRESSED_BLOCK_SIZE, 4) ||
+		!yadsl_graphio_binary_put_internal(&writer, vertex_count, 8) ||
+		!yadsl_graphio_binary_put_internal(&writer, edge_count, 8) ||
+		!yadsl_graphio_binary_put_internal(&writer, size, 8) ||
+		!yadsl_graphio_binary_put_internal(&writer, objects_offset, 8))
+		goto exit;
+	for (i = 0; i <= block_count; ++i)
+		if (!yadsl_graphio_binary_put_internal(&writer, block_offsets[i], 8))
+			goto exit;
+
+	/* Records */
+	for (u = 0; u < vertex_count; ++u) {
+		if (yadsl_graph_vertex_flag_by_id_get(graph, u, &flag)) assert(0);
+		if (!yadsl_graphio_compressed_varint_put_internal(&writer, YADSL_GRAPHIO_ZIGZAG(flag)) ||
+			!yadsl_graphio_compressed_varint_put_internal(&writer, offsets[u + 1] - offsets[u]))
+			goto exit;
+		for (k = offsets[u]; k < offsets[u + 1]; ++k)
+			if (!yadsl_graphio_compressed_varint_put_internal(&writer,
+				k == offsets[u] ? nbs[k] : nbs[k] - nbs[k - 1]))
+				goto exit;
+		if (weight_width > 0) {
+			for (k = offsets[u]; k < offsets[u + 1]; ++k) {
+				if (yadsl_graph_edge_endpoint_ids_get(graph, adjacency.edges[k], &id, &v, &weight)) assert(0);
+				if (!yadsl_graphio_binary_put_internal(&writer,
+					yadsl_graphio_binary_weight_encode_internal(weight_type, weight), weight_width))
+					goto exit;
+			}
 		}
-		if (write_vertex_func(file_ptr, vertex)) /* Vertex item */
-			return YADSL_GRAPHIO_RET_WRITING_FAILURE;
-		if (yadsl_graph_vertex_flag_get(graph, vertex, &flag)) assert(0);
-		YADSL_GRAPHIO_WRITE(file_ptr, YADSL_GRAPHIO_VFLAG_STR, flag);
 	}
+	if (!yadsl_graphio_binary_flush_internal(&writer))
+		goto exit;
 
-	YADSL_GRAPHIO_WRITE(file_ptr, "%c", '\n');
-	for (i = vertex_count; i; --i) {
-		if (yadsl_graph_vertex_iter(graph, YADSL_GRAPH_ITER_DIR_NEXT, &vertex)) assert(0);
-		if (yadsl_graph_vertex_degree_get(graph, vertex, YADSL_GRAPH_EDGE_DIR_OUT, &nb_count)) assert(0);
-		YADSL_GRAPHIO_WRITE(file_ptr, YADSL_GRAPHIO_NBCOUNT_STR, nb_count); /* Vertex degree */
-		for (j = nb_count; j; --j) {
-			if (yadsl_graph_vertex_nb_iter(graph, vertex, YADSL_GRAPH_EDGE_DIR_OUT, YADSL_GRAPH_ITER_DIR_NEXT, &nb, &edge))
-				assert(0);
-			if (yadsl_map_entry_get(address_map, nb, &previous_value)) assert(0);
-			index = (size_t) previous_value;
-			YADSL_GRAPHIO_WRITE(file_ptr, YADSL_GRAPHIO_NB_IDX_STR, index); /* Neighbour index */
-			if (write_edge_func(file_ptr, edge)) /* Edge item */
-				return YADSL_GRAPHIO_RET_WRITING_FAILURE;
+	/* Objects (edges at their first entry) */
+	ret = YADSL_GRAPHIO_RET_WRITING_FAILURE;
+	for (id = 0; id < vertex_count; ++id) {
+		if (yadsl_graph_vertex_by_id_get(graph, id, &u_obj)) assert(0);
+		if (write_vertex_func(file_ptr, u_obj))
+			goto exit;
+	}
+	if (write_edge_func) {
+		for (u = 0; u < vertex_count; ++u) {
+			for (k = offsets[u]; k < offsets[u + 1]; ++k) {
+				if (!is_directed && nbs[k] < u)
+					continue;
+				if (yadsl_graph_edge_by_id_get(graph, adjacency.edges[k], &u_obj, &v_obj, &uv_obj)) assert(0);
+				if (write_edge_func(file_ptr, uv_obj))
+					goto exit;
+			}
 		}
-		YADSL_GRAPHIO_WRITE(file_ptr, "%c", '\n');
 	}
+	ret = YADSL_GRAPHIO_RET_OK;
+exit:
+	free(writer.data);
+	free(block_offsets);
+	yadsl_graphio_adjacency_destroy_internal(&adjacency);
+	return ret;
+}
+
+yadsl_GraphIoRet yadsl_graphio_compressed_read(
+	FILE* file_ptr,
+	yadsl_GraphIoVertexReadFunc read_vertex_func,
+	yadsl_GraphIoEdgeReadFunc read_edge_func,
+	yadsl_GraphCmpVertexObjsFunc cmp_vertices_func,
+	yadsl_GraphFreeVertexObjFunc free_vertex_func,
+	yadsl_GraphCmpEdgeObjsFunc cmp_edges_func,
+	yadsl_GraphFreeEdgeObjFunc free_edge_func,
+	yadsl_GraphHandle** graph_ptr)
+{
+	yadsl_GraphIoCompressedView view;
+	yadsl_GraphIoRet ret;
+	yadsl_GraphHandle* graph = NULL;
+	yadsl_GraphVertexObject** vertices = NULL;
+	yadsl_GraphBuildEdge* edges = NULL;
+	yadsl_GraphVertexFlag* flags = NULL;
+	const unsigned char* p = NULL, * end = NULL, * weights;
+	size_t u, k, degree, nb, edge_index = 0, read_vertex_count = 0, read_edge_count = 0;
+	uint64_t value;
+
+	if (ret = yadsl_graphio_compressed_open_internal(file_ptr, &view))
+		return ret;
+	ret = YADSL_GRAPHIO_RET_MEMORY;
+	if (!(vertices = malloc(view.vertex_count * sizeof(*vertices) + 1)))
+		goto exit;
+	if (!(flags = malloc(view.vertex_count * sizeof(*flags) + 1)))
+		goto exit;
+	if (view.edge_count > 0 && !(edges = malloc(view.edge_count * sizeof(*edges))))
+		goto exit;
+
+	/* Records */
+	ret = YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	for (u = 0; u < view.vertex_count; ++u) {
+		if (u % view.block_size == 0) {
+			if (u > 0 && p != end)
+				goto exit;
+			yadsl_graphio_compressed_block_get_internal(&view, u / view.block_size, &p, &end);
+		}
+		if (!yadsl_graphio_compressed_record_head_internal(&view, &p, end, &flags[u], &degree))
+			goto exit;
+		for (k = 0, nb = 0; k < degree; ++k) {
+			if (!yadsl_graphio_compressed_varint_get_internal(&p, end, &value) ||
+				(k > 0 && value == 0) || value >= view.vertex_count - nb)
+				goto exit;
+			nb += (size_t) value;
+			if (!view.is_directed && nb < u)
+				continue;
+			if (edge_index == view.edge_count)
+				goto exit;
+			edges[edge_index].u = u;
+			edges[edge_index].v = nb;
+			edges[edge_index].item = NULL;
+			edges[edge_index++].weight = yadsl_graph_edge_weight_from_double(view.weight_type, 0);
+		}
+		if (view.weight_width > 0) {
+			if ((size_t) (end - p) / view.weight_width < degree)
+				goto exit;
+			/* Weights of the edges kept above are the last ones of the record */
+			weights = p + degree * view.weight_width;
+			for (k = edge_index; k > 0 && edges[k - 1].u == u; --k) {
+				weights -= view.weight_width;
+				edges[k - 1].weight = yadsl_graphio_binary_weight_decode_internal(view.weight_type,
+					yadsl_graphio_binary_get_internal(weights, view.weight_width));
+			}
+		}
+		p += degree * view.weight_width;
+	}
+	if (view.vertex_count > 0 && p != end)
+		goto exit;
+	if (edge_index != view.edge_count)
+		goto exit;
+
+	/* Objects */
+	if (fseek(file_ptr, view.base + (long) view.objects_offset, SEEK_SET)) {
+		ret = YADSL_GRAPHIO_RET_FILE_ERROR;
+		goto exit;
+	}
+	ret = YADSL_GRAPHIO_RET_CREATION_FAILURE;
+	if ((view.flags & YADSL_GRAPHIO_BINARY_EDGE_OBJECTS) && read_edge_func == NULL)
+		goto exit;
+	for (; read_vertex_count < view.vertex_count; ++read_vertex_count)
+		if (read_vertex_func(file_ptr, &vertices[read_vertex_count]))
+			goto exit;
+	if (view.flags & YADSL_GRAPHIO_BINARY_EDGE_OBJECTS)
+		for (; read_edge_count < view.edge_count; ++read_edge_count)
+			if (read_edge_func(file_ptr, &edges[read_edge_count].item))
+				goto exit;
+
+	/* Graph */
+	ret = YADSL_GRAPHIO_RET_MEMORY;
+	if (!(graph = yadsl_graph_create_weighted(view.is_directed, view.weight_type,
+		cmp_vertices_func, free_vertex_func, cmp_edges_func, free_edge_func)))
+		goto exit;
+	if (yadsl_graph_build(graph, vertices, view.vertex_count, edges, view.edge_count))
+		goto exit;
+	/* The graph owns every object now */
+	read_vertex_count = 0;
+	read_edge_count = 0;
+	if (yadsl_graph_edge_count_get(graph, &k)) assert(0);
+	if (k != view.edge_count) {
+		ret = YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		goto exit;
+	}
+	for (u = 0; u < view.vertex_count; ++u)
+		if (yadsl_graph_vertex_flag_by_id_set(graph, u, flags[u])) assert(0);
+	*graph_ptr = graph;
+	graph = NULL;
+	ret = YADSL_GRAPHIO_RET_OK;
+exit:
+	if (free_vertex_func)
+		for (u = 0; u < read_vertex_count; ++u)
+			free_vertex_func(vertices[u]);
+	if (free_edge_func)
+		for (k = 0; k < read_edge_count; ++k)
+			free_edge_func(edges[k].item);
+	if (graph)
+		yadsl_graph_destroy(graph);
+	if (vertices)
+		free(vertices);
+	if (flags)
+		free(flags);
+	if (edges)
+		free(edges);
+	yadsl_graphio_binary_section_release_internal(&view.section);
+	return ret;
+}
+
+yadsl_GraphIoRet yadsl_graphio_compressed_open(
+	FILE* file_ptr,
+	yadsl_GraphIoCompressedHandle** handle_ptr)
+{
+	yadsl_GraphIoCompressedView* view;
+	yadsl_GraphIoRet ret;
+	if (!(view = malloc(sizeof(*view))))
+		return YADSL_GRAPHIO_RET_MEMORY;
+	if (ret = yadsl_graphio_compressed_open_internal(file_ptr, view)) {
+		free(view);
+		return ret;
+	}
+	*handle_ptr = view;
+	return YADSL_GRAPHIO_RET_OK;
+}
+
+void yadsl_graphio_compressed_vertex_count_get(
+	yadsl_GraphIoCompressedHandle* handle,
+	size_t* vertex_count_ptr)
+{
+	*vertex_count_ptr = ((yadsl_GraphIoCompressedView*) handle)->vertex_count;
+}
+
+yadsl_GraphIoRet yadsl_graphio_compressed_degree_get(
+	yadsl_GraphIoCompressedHandle* handle,
+	size_t id,
+	size_t* degree_ptr)
+{
+	yadsl_GraphIoCompressedView* view = (yadsl_GraphIoCompressedView*) handle;
+	const unsigned char* p, * end;
+	yadsl_GraphVertexFlag flag;
+	yadsl_GraphIoRet ret;
+	if (ret = yadsl_graphio_compressed_record_find_internal(view, id, &p, &end))
+		return ret;
+	if (!yadsl_graphio_compressed_record_head_internal(view, &p, end, &flag, degree_ptr))
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
 	return YADSL_GRAPHIO_RET_OK;
 }
 
+yadsl_GraphIoRet yadsl_graphio_compressed_nbs_get(
+	yadsl_GraphIoCompressedHandle* handle,
+	size_t id,
+	size_t* nbs,
+	yadsl_GraphEdgeWeight* weights)
+{
+	yadsl_GraphIoCompressedView* view = (yadsl_GraphIoCompressedView*) handle;
+	const unsigned char* p, * end;
+	yadsl_GraphVertexFlag flag;
+	yadsl_GraphIoRet ret;
+	size_t degree, k, nb;
+	uint64_t value;
+	if (ret = yadsl_graphio_compressed_record_find_internal(view, id, &p, &end))
+		return ret;
+	if (!yadsl_graphio_compressed_record_head_internal(view, &p, end, &flag, &degree))
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	for (k = 0, nb = 0; k < degree; ++k) {
+		if (!yadsl_graphio_compressed_varint_get_internal(&p, end, &value) ||
+			(k > 0 && value == 0) || value >= view->vertex_count - nb)
+			return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		nb += (size_t) value;
+		nbs[k] = nb;
+	}
+	if (weights) {
+		if (view->weight_width > 0 && (size_t) (end - p) / view->weight_width < degree)
+			return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		for (k = 0; k < degree; ++k, p += view->weight_width)
+			weights[k] = view->weight_width ?
+				yadsl_graphio_binary_weight_decode_internal(view->weight_type,
+					yadsl_graphio_binary_get_internal(p, view->weight_width)) :
+				yadsl_graph_edge_weight_from_double(view->weight_type, 0);
+	}
+	return YADSL_GRAPHIO_RET_OK;
+}
+
+void yadsl_graphio_compressed_close(
+	yadsl_GraphIoCompressedHandle* handle)
+{
+	yadsl_GraphIoCompressedView* view = (yadsl_GraphIoCompressedView*) handle;
+	if (view == NULL)
+		return;
+	yadsl_graphio_binary_section_release_internal(&view->section);
+	free(view);
+}
+
+yadsl_GraphIoRet yadsl_graphio_import(
+	FILE* file_ptr,
+	const yadsl_GraphIoImportParams* params,
+	yadsl_GraphCmpVertexObjsFunc cmp_vertices_func,
+	yadsl_GraphFreeVertexObjFunc free_vertex_func,
+	yadsl_GraphCmpEdgeObjsFunc cmp_edges_func,
+	yadsl_GraphFreeEdgeObjFunc free_edge_func,
+	yadsl_GraphHandle** graph_ptr)
+{
+	yadsl_GraphIoImporter importer;
+	yadsl_GraphIoRet ret;
+	yadsl_GraphHandle* graph = NULL;
+	yadsl_GraphVertexObject** vertices = NULL;
+	size_t i, vertex_obj_count = 0, edge_obj_count = 0;
+
+	switch (params->format) {
+	case YADSL_GRAPHIO_IMPORT_FORMAT_EDGE_LIST:
+	case YADSL_GRAPHIO_IMPORT_FORMAT_MATRIX_MARKET:
+	case YADSL_GRAPHIO_IMPORT_FORMAT_DIMACS:
+		break;
+	default:
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	}
+
+	importer.params = params;
+	importer.edges = NULL;
+	importer.edge_count = 0;
+	importer.edge_capacity = 0;
+	importer.vertex_count = 0;
+	importer.entry_count = 0;
+	importer.read_entry_count = 0;
+	importer.state = YADSL_GRAPHIO_IMPORT_STATE_HEADER;
+	importer.is_symmetric = false;
+	importer.is_skew_symmetric = false;
+	importer.has_values = false;
+	if (params->format == YADSL_GRAPHIO_IMPORT_FORMAT_EDGE_LIST)
+		importer.state = YADSL_GRAPHIO_IMPORT_STATE_ENTRIES;
+
+	if (ret = yadsl_graphio_import_parse_internal(&importer, file_ptr))
+		goto exit;
+	ret = YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	if (importer.state != YADSL_GRAPHIO_IMPORT_STATE_ENTRIES)
+		goto exit;
+	if (params->format != YADSL_GRAPHIO_IMPORT_FORMAT_EDGE_LIST &&
+		importer.read_entry_count != importer.entry_count)
+		goto exit;
+
+	/* Objects */
+	ret = YADSL_GRAPHIO_RET_MEMORY;
+	if (importer.vertex_count > SIZE_MAX / sizeof(*vertices) - 1)
+		goto exit;
+	if (!(vertices = malloc((importer.vertex_count + 1) * sizeof(*vertices))))
+		goto exit;
+	ret = YADSL_GRAPHIO_RET_CREATION_FAILURE;
+	for (; vertex_obj_count < importer.vertex_count; ++vertex_obj_count)
+		if (!(vertices[vertex_obj_count] = params->create_vertex_func(vertex_obj_count, params->arg)))
+			goto exit;
+	if (params->create_edge_func) {
+		for (; edge_obj_count < importer.edge_count; ++edge_obj_count) {
+			yadsl_GraphBuildEdge* edge = &importer.edges[edge_obj_count];
+			if (!(edge->item = params->create_edge_func(edge->u, edge->v, params->arg)))
+				goto exit;
+		}
+	}
+
+	/* Graph */
+	ret = YADSL_GRAPHIO_RET_MEMORY;
+	if (!(graph = yadsl_graph_create_weighted(params->is_directed, params->weight_type,
+		cmp_vertices_func, free_vertex_func, cmp_edges_func, free_edge_func)))
+		goto exit;
+	if (yadsl_graph_build(graph, vertices, importer.vertex_count, importer.edges, importer.edge_count))
+		goto exit;
+	/* The graph owns every object now */
+	vertex_obj_count = 0;
+	edge_obj_count = 0;
+	*graph_ptr = graph;
+	graph = NULL;
+	ret = YADSL_GRAPHIO_RET_OK;
+exit:
+	if (free_vertex_func)
+		for (i = 0; i < vertex_obj_count; ++i)
+			free_vertex_func(vertices[i]);
+	if (free_edge_func)
+		for (i = 0; i < edge_obj_count; ++i)
+			free_edge_func(importer.edges[i].item);
+	if (graph)
+		yadsl_graph_destroy(graph);
+	if (vertices)
+		free(vertices);
+	if (importer.edges)
+		free(importer.edges);
+	return ret;
+}
+
+/* Private functions */
+
 static yadsl_GraphIoRet yadsl_graphio_read_internal(
 	yadsl_GraphHandle* graph,
 	void** address_map,
 	FILE* file_ptr,
 	size_t vertex_count,
 	int is_directed,
+	yadsl_GraphEdgeWeightType weight_type,
 	yadsl_GraphIoVertexReadFunc read_vertex_func,
 	yadsl_GraphIoEdgeReadFunc read_edge_func,
 	yadsl_GraphFreeVertexObjFunc free_vertex_func,
@@ -188,6 +1269,8 @@ static yadsl_GraphIoRet yadsl_graphio_read_internal(
 {
 	size_t nb_count, i, j, index;
 	yadsl_GraphRet graph_ret;
+	yadsl_GraphIoRet graphio_ret;
+	yadsl_GraphEdgeWeight weight;
 	void* vertex_item, * nb_item, * edge_item;
 
 	for (i = 0; i < vertex_count; ++i) {
@@ -217,11 +1300,15 @@ static yadsl_GraphIoRet yadsl_graphio_read_internal(
 		YADSL_GRAPHIO_READ(file_ptr, YADSL_GRAPHIO_NBCOUNT_STR, &nb_count); /* Vertex degree */
 		for (j = 0; j < nb_count; ++j) {
 			YADSL_GRAPHIO_READ(file_ptr, YADSL_GRAPHIO_NB_IDX_STR, &index); /* Neighbour index */
+			if (index >= vertex_count)
+				return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
 			nb_item = address_map[index];
+			if (graphio_ret = yadsl_graphio_weight_read_internal(file_ptr, weight_type, &weight)) /* Edge weight */
+				return graphio_ret;
 			if (read_edge_func(file_ptr, &edge_item)) /* Edge item */
 				return YADSL_GRAPHIO_RET_CREATION_FAILURE;
-			if (graph_ret = yadsl_graph_edge_add(graph, vertex_item, nb_item,
-				edge_item)) {
+			if (graph_ret = yadsl_graph_edge_weighted_add(graph, vertex_item, nb_item,
+				edge_item, weight)) {
 				if (free_edge_func)
 					free_edge_func(edge_item);
 				switch (graph_ret) {
@@ -237,3 +1324,1114 @@ static yadsl_GraphIoRet yadsl_graphio_read_internal(
 	}
 	return YADSL_GRAPHIO_RET_OK;
 }
+
+static yadsl_GraphIoRet yadsl_graphio_weight_read_internal(
+	FILE* file_ptr,
+	yadsl_GraphEdgeWeightType weight_type,
+	yadsl_GraphEdgeWeight* weight_ptr)
+{
+	double temp;
+	weight_ptr->i64 = 0;
+	switch (weight_type) {
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE:
+		break;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32:
+		YADSL_GRAPHIO_READ(file_ptr, "%" SCNd32, &weight_ptr->i32);
+		break;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT64:
+		YADSL_GRAPHIO_READ(file_ptr, "%" SCNd64, &weight_ptr->i64);
+		break;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_FLOAT:
+		YADSL_GRAPHIO_READ(file_ptr, "%lf", &temp);
+		weight_ptr->f32 = (float) temp;
+		break;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE:
+		YADSL_GRAPHIO_READ(file_ptr, "%lf", &weight_ptr->f64);
+		break;
+	default:
+		assert(0);
+	}
+	return YADSL_GRAPHIO_RET_OK;
+}
+
+static size_t yadsl_graphio_binary_weight_width_internal(
+	yadsl_GraphEdgeWeightType weight_type)
+{
+	switch (weight_type) {
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32:
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_FLOAT:
+		return 4;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT64:
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE:
+		return 8;
+	default:
+		return 0;
+	}
+}
+
+static bool yadsl_graphio_binary_put_internal(
+	yadsl_GraphIoBinaryWriter* writer,
+	uint64_t value,
+	size_t width)
+{
+	size_t i;
+	if (writer->size + width > YADSL_GRAPHIO_BINARY_BUFFER_SIZE &&
+		!yadsl_graphio_binary_flush_internal(writer))
+		return false;
+	for (i = 0; i < width; ++i) {
+		writer->data[writer->size++] = (unsigned char) (value & 0xff);
+		value >>= 8;
+	}
+	return true;
+}
+
+static bool yadsl_graphio_binary_flush_internal(
+	yadsl_GraphIoBinaryWriter* writer)
+{
+	size_t size = writer->size;
+	writer->size = 0;
+	return fwrite(writer->data, 1, size, writer->file_ptr) == size;
+}
+
+static uint64_t yadsl_graphio_binary_get_internal(
+	const unsigned char* data,
+	size_t width)
+{
+	uint64_t value = 0;
+	while (width--)
+		value = (value << 8) | data[width];
+	return value;
+}
+
+static uint64_t yadsl_graphio_binary_weight_encode_internal(
+	yadsl_GraphEdgeWeightType weight_type,
+	yadsl_GraphEdgeWeight weight)
+{
+	uint32_t u32;
+	uint64_t u64;
+	switch (weight_type) {
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32:
+		return (uint32_t) weight.i32;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT64:
+		return (uint64_t) weight.i64;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_FLOAT:
+		memcpy(&u32, &weight.f32, sizeof(u32));
+		return u32;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE:
+		memcpy(&u64, &weight.f64, sizeof(u64));
+		return u64;
+	default:
+		return 0;
+	}
+}
+
+static yadsl_GraphEdgeWeight yadsl_graphio_binary_weight_decode_internal(
+	yadsl_GraphEdgeWeightType weight_type,
+	uint64_t value)
+{
+	yadsl_GraphEdgeWeight weight;
+	uint32_t u32 = (uint32_t) value;
+	weight.i64 = 0;
+	switch (weight_type) {
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32:
+		weight.i32 = (int32_t) u32;
+		break;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT64:
+		weight.i64 = (int64_t) value;
+		break;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_FLOAT:
+		memcpy(&weight.f32, &u32, sizeof(u32));
+		break;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE:
+		memcpy(&weight.f64, &value, sizeof(value));
+		break;
+	default:
+		break;
+	}
+	return weight;
+}
+
+// Gives access to size bytes of the file, from offset on, by mapping
+// them into memory where possible, or by reading them into a buffer,
+// advising the kernel of whether they will be read sequentially
+static yadsl_GraphIoRet yadsl_graphio_binary_section_load_internal(
+	FILE* file_ptr,
+	long offset,
+	size_t size,
+	bool is_sequential,
+	yadsl_GraphIoBinarySection* section)
+{
+#ifdef YADSL_GRAPHIO_MMAP
+	struct stat file_stat;
+	long page_size = sysconf(_SC_PAGESIZE);
+	off_t aligned_offset;
+	int fd = fileno(file_ptr);
+	if (fd >= 0 && page_size > 0 && fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode)) {
+		if ((uint64_t) file_stat.st_size < (uint64_t) offset + size)
+			return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		aligned_offset = (off_t) (offset - offset % page_size);
+		section->mapping_size = size + (size_t) (offset - aligned_offset);
+		section->mapping = mmap(NULL, section->mapping_size, PROT_READ, MAP_PRIVATE, fd, aligned_offset);
+		if (section->mapping != MAP_FAILED) {
+			posix_madvise(section->mapping, section->mapping_size,
+				is_sequential ? POSIX_MADV_SEQUENTIAL : POSIX_MADV_RANDOM);
+			section->data = (const unsigned char*) section->mapping + (offset - aligned_offset);
+			return YADSL_GRAPHIO_RET_OK;
+		}
+		section->mapping = NULL;
+	}
+#endif
+	if (fseek(file_ptr, offset, SEEK_SET))
+		return YADSL_GRAPHIO_RET_FILE_ERROR;
+	if (!(section->buffer = malloc(size + 1)))
+		return YADSL_GRAPHIO_RET_MEMORY;
+	if (fread(section->buffer, 1, size, file_ptr) != size)
+		return feof(file_ptr) ? YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT : YADSL_GRAPHIO_RET_FILE_ERROR;
+	section->data = section->buffer;
+	return YADSL_GRAPHIO_RET_OK;
+}
+
+static void yadsl_graphio_binary_section_release_internal(
+	yadsl_GraphIoBinarySection* section)
+{
+#ifdef YADSL_GRAPHIO_MMAP
+	if (section->mapping)
+		munmap(section->mapping, section->mapping_size);
+#endif
+	if (section->buffer)
+		free(section->buffer);
+}
+
+// Builds the neighbour lists of every vertex (by id), sorted by id,
+// by grouping entries by destination and then, stably, by source
+static bool yadsl_graphio_adjacency_create_internal(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphIoAdjacency* adjacency)
+{
+	yadsl_GraphEdgeWeight weight;
+	size_t vertex_count, edge_count, id, u, v, k;
+	size_t* counts = NULL, * sources = NULL, * edges = NULL;
+	bool is_directed;
+
+	if (yadsl_graph_is_directed_check(graph, &is_directed)) assert(0);
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (yadsl_graph_edge_count_get(graph, &edge_count)) assert(0);
+
+	/* Two entries per edge on undirected graphs, except for self-loops */
+	adjacency->entry_count = edge_count;
+	if (!is_directed) {
+		for (id = 0; id < edge_count; ++id) {
+			if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+			if (u != v)
+				++adjacency->entry_count;
+		}
+	}
+	adjacency->nbs = NULL;
+	adjacency->edges = NULL;
+	if (!(adjacency->offsets = malloc((vertex_count + 1) * sizeof(*adjacency->offsets))))
+		return false;
+	if (!(counts = malloc((vertex_count + 1) * sizeof(*counts))))
+		goto fail;
+	if (adjacency->entry_count > 0) {
+		if (!(sources = malloc(adjacency->entry_count * sizeof(*sources))))
+			goto fail;
+		if (!(edges = malloc(adjacency->entry_count * sizeof(*edges))))
+			goto fail;
+		if (!(adjacency->nbs = malloc(adjacency->entry_count * sizeof(*adjacency->nbs))))
+			goto fail;
+		if (!(adjacency->edges = malloc(adjacency->entry_count * sizeof(*adjacency->edges))))
+			goto fail;
+	}
+
+	for (u = 0; u <= vertex_count; ++u)
+		counts[u] = adjacency->offsets[u] = 0;
+	for (id = 0; id < edge_count; ++id) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+		++counts[v + 1];
+		++adjacency->offsets[u + 1];
+		if (!is_directed && u != v) {
+			++counts[u + 1];
+			++adjacency->offsets[v + 1];
+		}
+	}
+	for (u = 0; u < vertex_count; ++u) {
+		counts[u + 1] += counts[u];
+		adjacency->offsets[u + 1] += adjacency->offsets[u];
+	}
+	for (id = 0; id < edge_count; ++id) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+		sources[counts[v]] = u;
+		edges[counts[v]++] = id;
+		if (!is_directed && u != v) {
+			sources[counts[u]] = v;
+			edges[counts[u]++] = id;
+		}
+	}
+	/* counts[v] is now the end of the entries of destination v */
+	for (v = 0, k = 0; v < vertex_count; ++v) {
+		for (; k < counts[v]; ++k) {
+			u = sources[k];
+			adjacency->nbs[adjacency->offsets[u]] = v;
+			adjacency->edges[adjacency->offsets[u]++] = edges[k];
+		}
+	}
+	/* offsets[u] is now the end of row u */
+	for (u = vertex_count; u > 0; --u)
+		adjacency->offsets[u] = adjacency->offsets[u - 1];
+	adjacency->offsets[0] = 0;
+	free(counts);
+	if (sources)
+		free(sources);
+	if (edges)
+		free(edges);
+	return true;
+fail:
+	if (counts)
+		free(counts);
+	if (sources)
+		free(sources);
+	if (edges)
+		free(edges);
+	yadsl_graphio_adjacency_destroy_internal(adjacency);
+	return false;
+}
+
+static void yadsl_graphio_adjacency_destroy_internal(
+	yadsl_GraphIoAdjacency* adjacency)
+{
+	free(adjacency->offsets);
+	if (adjacency->nbs)
+		free(adjacency->nbs);
+	if (adjacency->edges)
+		free(adjacency->edges);
+}
+
+static yadsl_GraphIoRet yadsl_graphio_binary_open_internal(
+	FILE* file_ptr,
+	bool is_sequential,
+	yadsl_GraphIoBinaryView* view)
+{
+	unsigned char header[YADSL_GRAPHIO_BINARY_HEADER_SIZE];
+	yadsl_GraphIoRet ret;
+	uint64_t value;
+
+	view->section.data = NULL;
+	view->section.mapping = NULL;
+	view->section.buffer = NULL;
+
+	/* Header */
+	if ((view->base = ftell(file_ptr)) < 0)
+		return YADSL_GRAPHIO_RET_FILE_ERROR;
+	if (fread(header, 1, sizeof(header), file_ptr) != sizeof(header))
+		return feof(file_ptr) ? YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT : YADSL_GRAPHIO_RET_FILE_ERROR;
+	if (memcmp(header, YADSL_GRAPHIO_BINARY_MAGIC, sizeof(YADSL_GRAPHIO_BINARY_MAGIC)))
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	if (yadsl_graphio_binary_get_internal(header + 8, 4) != YADSL_GRAPHIO_BINARY_FILE_FORMAT_VERSION)
+		return YADSL_GRAPHIO_RET_DEPRECATED_FILE_FORMAT;
+	view->flags = (uint32_t) yadsl_graphio_binary_get_internal(header + 12, 4);
+	value = yadsl_graphio_binary_get_internal(header + 16, 4);
+	if (view->flags & ~(YADSL_GRAPHIO_BINARY_DIRECTED | YADSL_GRAPHIO_BINARY_EDGE_OBJECTS) ||
+		value > YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE)
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	view->is_directed = view->flags & YADSL_GRAPHIO_BINARY_DIRECTED;
+	view->weight_type = (yadsl_GraphEdgeWeightType) value;
+	view->weight_width = yadsl_graphio_binary_weight_width_internal(view->weight_type);
+	value = yadsl_graphio_binary_get_internal(header + 24, 8);
+	if (value > ((uint64_t) 1 << 32))
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	view->vertex_count = (size_t) value;
+	value = yadsl_graphio_binary_get_internal(header + 32, 8);
+	if (value > SIZE_MAX / sizeof(yadsl_GraphBuildEdge))
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	view->edge_count = (size_t) value;
+	value = yadsl_graphio_binary_get_internal(header + 40, 8);
+	if (view->is_directed ? value != view->edge_count :
+		value < view->edge_count || value > 2 * (uint64_t) view->edge_count)
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	view->entry_count = (size_t) value;
+	view->objects_offset = yadsl_graphio_binary_get_internal(header + 48, 8);
+	if (view->objects_offset != YADSL_GRAPHIO_BINARY_HEADER_SIZE +
+		((uint64_t) view->vertex_count + 1) * 8 +
+		(uint64_t) view->entry_count * (view->weight_width + 4) +
+		(uint64_t) view->vertex_count * 4 ||
+		view->objects_offset > (uint64_t) (LONG_MAX - view->base))
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+
+	/* Adjacency */
+	if (ret = yadsl_graphio_binary_section_load_internal(file_ptr,
+		view->base + YADSL_GRAPHIO_BINARY_HEADER_SIZE,
+		(size_t) (view->objects_offset - YADSL_GRAPHIO_BINARY_HEADER_SIZE),
+		is_sequential, &view->section))
+		goto fail;
+	view->offsets = view->section.data;
+	view->weights = view->offsets + (view->vertex_count + 1) * 8;
+	view->destinations = view->weights + view->entry_count * view->weight_width;
+	view->vertex_flags = view->destinations + view->entry_count * 4;
+	ret = YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	if (yadsl_graphio_binary_get_internal(view->offsets + view->vertex_count * 8, 8) != view->entry_count)
+		goto fail;
+	return YADSL_GRAPHIO_RET_OK;
+fail:
+	yadsl_graphio_binary_section_release_internal(&view->section);
+	return ret;
+}
+
+static yadsl_GraphIoRet yadsl_graphio_binary_row_get_internal(
+	yadsl_GraphIoBinaryView* view,
+	size_t id,
+	size_t* begin_ptr,
+	size_t* end_ptr)
+{
+	uint64_t begin, end;
+	if (id >= view->vertex_count)
+		return YADSL_GRAPHIO_RET_PARAMETER;
+	begin = yadsl_graphio_binary_get_internal(view->offsets + id * 8, 8);
+	end = yadsl_graphio_binary_get_internal(view->offsets + (id + 1) * 8, 8);
+	if (begin > end || end > view->entry_count)
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	*begin_ptr = (size_t) begin;
+	*end_ptr = (size_t) end;
+	return YADSL_GRAPHIO_RET_OK;
+}
+
+// Writes rows in chunks (if is_chunked is true), or straight to file_ptr,
+// which is then also the file given to the serialization functions
+static yadsl_GraphIoRet yadsl_graphio_write_internal(
+	yadsl_GraphHandle* graph,
+	FILE* file_ptr,
+	yadsl_GraphIoVertexWriteFunc write_vertex_func,
+	yadsl_GraphIoEdgeWriteFunc write_edge_func,
+	const yadsl_GraphIoWriteParams* params,
+	bool is_chunked)
+{
+	yadsl_GraphIoStreamWriter writer;
+	yadsl_GraphIoRet ret = YADSL_GRAPHIO_RET_MEMORY;
+	yadsl_GraphEdgeWeightType weight_type;
+	yadsl_GraphEdgeWeight weight;
+	yadsl_GraphVertexObject* u_obj, * v_obj;
+	yadsl_GraphEdgeObject* uv_obj;
+	size_t vertex_count, edge_count, id, u, v, k;
+	size_t* offsets = NULL, * order = NULL;
+	bool is_directed;
+	char header[128];
+	int flag, length;
+
+	if (yadsl_graph_is_directed_check(graph, &is_directed)) assert(0);
+	if (yadsl_graph_edge_weight_type_get(graph, &weight_type)) assert(0);
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (yadsl_graph_edge_count_get(graph, &edge_count)) assert(0);
+
+	writer.file_ptr = file_ptr;
+	writer.chunk_ptr = NULL;
+	writer.is_chunked = is_chunked;
+	writer.chunk_data = NULL;
+	writer.buffer_size = YADSL_GRAPHIO_STREAM_BUFFER_SIZE;
+	writer.progress_func = NULL;
+	writer.arg = NULL;
+	writer.row_count = 0;
+	writer.total_row_count = 2 * vertex_count;
+	if (params) {
+		if (params->buffer_size > 0)
+			writer.buffer_size = params->buffer_size;
+		writer.progress_func = params->progress_func;
+		writer.arg = params->arg;
+	}
+
+	/* Group edges by the endpoint they are written at */
+	if (!(offsets = malloc((vertex_count + 1) * sizeof(*offsets))))
+		goto exit;
+	if (edge_count > 0 && !(order = malloc(edge_count * sizeof(*order))))
+		goto exit;
+	for (u = 0; u <= vertex_count; ++u)
+		offsets[u] = 0;
+	for (id = 0; id < edge_count; ++id) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+		++offsets[u + 1];
+	}
+	for (u = 0; u < vertex_count; ++u)
+		offsets[u + 1] += offsets[u];
+	for (id = edge_count; id > 0; --id) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id - 1, &u, &v, &weight)) assert(0);
+		order[--offsets[u + 1]] = id - 1;
+	}
+	for (u = 0; u < vertex_count; ++u)
+		offsets[u] = offsets[u + 1];
+	offsets[vertex_count] = edge_count;
+
+	/* Header */
+	length = sprintf(header, YADSL_GRAPHIO_VERSION_STR "\n" YADSL_GRAPHIO_DIRECTED_STR "\n"
+		YADSL_GRAPHIO_WEIGHT_TYPE_STR "\n" YADSL_GRAPHIO_VCOUNT_STR,
+		YADSL_GRAPHIO_FILE_FORMAT_VERSION, is_directed, (int) weight_type, vertex_count);
+	if ((ret = yadsl_graphio_stream_chunk_open_internal(&writer)) ||
+		(ret = yadsl_graphio_stream_put_internal(&writer, header, (size_t) length)))
+		goto exit;
+
+	/* Vertex objects and flags */
+	for (u = 0; u < vertex_count; ++u) {
+		if (!writer.chunk_ptr && (ret = yadsl_graphio_stream_chunk_open_internal(&writer)))
+			goto exit;
+		if (yadsl_graph_vertex_by_id_get(graph, u, &u_obj)) assert(0);
+		if (write_vertex_func(writer.chunk_ptr, u_obj)) {
+			ret = YADSL_GRAPHIO_RET_WRITING_FAILURE;
+			goto exit;
+		}
+		if (yadsl_graph_vertex_flag_by_id_get(graph, u, &flag)) assert(0);
+		if ((ret = yadsl_graphio_stream_integer_put_internal(&writer,
+			flag < 0 ? 0 - (uint64_t) flag : (uint64_t) flag, flag < 0, ' ', ' ')) ||
+			(ret = yadsl_graphio_stream_row_end_internal(&writer)))
+			goto exit;
+	}
+	if (!writer.chunk_ptr && (ret = yadsl_graphio_stream_chunk_open_internal(&writer)))
+		goto exit;
+	if (ret = yadsl_graphio_stream_put_internal(&writer, "\n", 1))
+		goto exit;
+
+	/* Neighbours, with edge weights and objects */
+	for (u = 0; u < vertex_count; ++u) {
+		if (!writer.chunk_ptr && (ret = yadsl_graphio_stream_chunk_open_internal(&writer)))
+			goto exit;
+		if (ret = yadsl_graphio_stream_integer_put_internal(&writer,
+			offsets[u + 1] - offsets[u], false, '\0', '\0'))
+			goto exit;
+		for (k = offsets[u]; k < offsets[u + 1]; ++k) {
+			if (yadsl_graph_edge_endpoint_ids_get(graph, order[k], &id, &v, &weight)) assert(0);
+			if (yadsl_graph_edge_by_id_get(graph, order[k], &u_obj, &v_obj, &uv_obj)) assert(0);
+			if ((ret = yadsl_graphio_stream_integer_put_internal(&writer, v, false, ' ', ' ')) ||
+				(ret = yadsl_graphio_stream_weight_put_internal(&writer, weight_type, weight)))
+				goto exit;
+			if (write_edge_func(writer.chunk_ptr, uv_obj)) {
+				ret = YADSL_GRAPHIO_RET_WRITING_FAILURE;
+				goto exit;
+			}
+		}
+		if ((ret = yadsl_graphio_stream_put_internal(&writer, "\n", 1)) ||
+			(ret = yadsl_graphio_stream_row_end_internal(&writer)))
+			goto exit;
+	}
+	if (writer.chunk_ptr)
+		ret = yadsl_graphio_stream_chunk_close_internal(&writer, true);
+exit:
+	if (writer.chunk_ptr)
+		yadsl_graphio_stream_chunk_close_internal(&writer, false);
+	if (offsets)
+		free(offsets);
+	if (order)
+		free(order);
+	return ret;
+}
+
+static yadsl_GraphIoRet yadsl_graphio_stream_chunk_open_internal(
+	yadsl_GraphIoStreamWriter* writer)
+{
+#ifdef YADSL_GRAPHIO_MEMSTREAM
+	if (writer->is_chunked) {
+		if (!(writer->chunk_ptr = open_memstream(&writer->chunk_data, &writer->chunk_size)))
+			return YADSL_GRAPHIO_RET_MEMORY;
+		writer->chunk_start = 0;
+		return YADSL_GRAPHIO_RET_OK;
+	}
+#endif
+	writer->chunk_ptr = writer->file_ptr;
+	writer->chunk_start = writer->is_chunked ? ftell(writer->file_ptr) : 0;
+	return YADSL_GRAPHIO_RET_OK;
+}
+
+// Copies the chunk to the file with a single write (unless is_written
+// is false, on failure) and reports progress
+static yadsl_GraphIoRet yadsl_graphio_stream_chunk_close_internal(
+	yadsl_GraphIoStreamWriter* writer,
+	bool is_written)
+{
+	yadsl_GraphIoRet ret = YADSL_GRAPHIO_RET_OK;
+#ifdef YADSL_GRAPHIO_MEMSTREAM
+	if (writer->is_chunked) {
+		if (fclose(writer->chunk_ptr))
+			ret = YADSL_GRAPHIO_RET_MEMORY;
+		else if (is_written && writer->chunk_size > 0 &&
+			fwrite(writer->chunk_data, 1, writer->chunk_size, writer->file_ptr) != writer->chunk_size)
+			ret = YADSL_GRAPHIO_RET_FILE_ERROR;
+		/* chunk_data is only valid after the stream is closed */
+		if (writer->chunk_data)
+			yadsl_graphio_stream_data_free_internal(writer->chunk_data);
+		writer->chunk_data = NULL;
+	}
+#endif
+	writer->chunk_ptr = NULL;
+	if (!is_written || !writer->is_chunked)
+		return ret;
+	if (ret == YADSL_GRAPHIO_RET_OK && fflush(writer->file_ptr))
+		ret = YADSL_GRAPHIO_RET_FILE_ERROR;
+	if (ret == YADSL_GRAPHIO_RET_OK && writer->progress_func)
+		writer->progress_func(writer->row_count, writer->total_row_count, writer->arg);
+	return ret;
+}
+
+static yadsl_GraphIoRet yadsl_graphio_stream_row_end_internal(
+	yadsl_GraphIoStreamWriter* writer)
+{
+	long position;
+	++writer->row_count;
+	if (!writer->is_chunked)
+		return YADSL_GRAPHIO_RET_OK;
+	position = ftell(writer->chunk_ptr);
+	/* Position is unknown on pipes, so every row gets its own chunk */
+	if (position >= 0 && (size_t) (position - writer->chunk_start) < writer->buffer_size)
+		return YADSL_GRAPHIO_RET_OK;
+	return yadsl_graphio_stream_chunk_close_internal(writer, true);
+}
+
+static yadsl_GraphIoRet yadsl_graphio_stream_put_internal(
+	yadsl_GraphIoStreamWriter* writer,
+	const char* text,
+	size_t length)
+{
+	if (fwrite(text, 1, length, writer->chunk_ptr) == length)
+		return YADSL_GRAPHIO_RET_OK;
+#ifdef YADSL_GRAPHIO_MEMSTREAM
+	if (writer->is_chunked)
+		return YADSL_GRAPHIO_RET_MEMORY;
+#endif
+	return YADSL_GRAPHIO_RET_FILE_ERROR;
+}
+
+// Formats an integer without the overhead of fprintf, between the
+// characters before and after, which are left out if null
+static yadsl_GraphIoRet yadsl_graphio_stream_integer_put_internal(
+	yadsl_GraphIoStreamWriter* writer,
+	uint64_t magnitude,
+	bool is_negative,
+	char before,
+	char after)
+{
+	char text[32], * start = text + sizeof(text);
+	if (after)
+		*--start = after;
+	do {
+		*--start = (char) ('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude);
+	if (is_negative)
+		*--start = '-';
+	if (before)
+		*--start = before;
+	return yadsl_graphio_stream_put_internal(writer, start, (size_t) (text + sizeof(text) - start));
+}
+
+static yadsl_GraphIoRet yadsl_graphio_stream_weight_put_internal(
+	yadsl_GraphIoStreamWriter* writer,
+	yadsl_GraphEdgeWeightType weight_type,
+	yadsl_GraphEdgeWeight weight)
+{
+	char text[64];
+	int length;
+	switch (weight_type) {
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE:
+		return YADSL_GRAPHIO_RET_OK;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32:
+		return yadsl_graphio_stream_integer_put_internal(writer, weight.i32 < 0 ?
+			0 - (uint64_t) weight.i32 : (uint64_t) weight.i32, weight.i32 < 0, '\0', ' ');
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT64:
+		return yadsl_graphio_stream_integer_put_internal(writer, weight.i64 < 0 ?
+			0 - (uint64_t) weight.i64 : (uint64_t) weight.i64, weight.i64 < 0, '\0', ' ');
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_FLOAT:
+		length = sprintf(text, YADSL_GRAPHIO_FLOAT_STR, weight.f32);
+		break;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE:
+		length = sprintf(text, YADSL_GRAPHIO_DOUBLE_STR, weight.f64);
+		break;
+	default:
+		assert(0);
+		return YADSL_GRAPHIO_RET_OK;
+	}
+	return yadsl_graphio_stream_put_internal(writer, text, (size_t) length);
+}
+
+static size_t yadsl_graphio_compressed_varint_length_internal(
+	uint64_t value)
+{
+	size_t length = 1;
+	while (value >= 0x80) {
+		value >>= 7;
+		++length;
+	}
+	return length;
+}
+
+static bool yadsl_graphio_compressed_varint_put_internal(
+	yadsl_GraphIoBinaryWriter* writer,
+	uint64_t value)
+{
+	if (writer->size + 10 > YADSL_GRAPHIO_BINARY_BUFFER_SIZE &&
+		!yadsl_graphio_binary_flush_internal(writer))
+		return false;
+	while (value >= 0x80) {
+		writer->data[writer->size++] = (unsigned char) (value | 0x80);
+		value >>= 7;
+	}
+	writer->data[writer->size++] = (unsigned char) value;
+	return true;
+}
+
+static bool yadsl_graphio_compressed_varint_get_internal(
+	const unsigned char** p_ptr,
+	const unsigned char* end,
+	uint64_t* value_ptr)
+{
+	const unsigned char* p = *p_ptr;
+	uint64_t value = 0;
+	unsigned int shift = 0;
+	do {
+		if (p == end || shift > 63)
+			return false;
+		value |= (uint64_t) (*p & 0x7f) << shift;
+		shift += 7;
+	} while (*p++ & 0x80);
+	*p_ptr = p;
+	*value_ptr = value;
+	return true;
+}
+
+static yadsl_GraphIoRet yadsl_graphio_compressed_open_internal(
+	FILE* file_ptr,
+	yadsl_GraphIoCompressedView* view)
+{
+	unsigned char header[YADSL_GRAPHIO_COMPRESSED_HEADER_SIZE];
+	yadsl_GraphIoRet ret;
+	uint64_t value, previous, index_size;
+	size_t i;
+
+	view->section.data = NULL;
+	view->section.mapping = NULL;
+	view->section.buffer = NULL;
+
+	/* Header */
+	if ((view->base = ftell(file_ptr)) < 0)
+		return YADSL_GRAPHIO_RET_FILE_ERROR;
+	if (fread(header, 1, sizeof(header), file_ptr) != sizeof(header))
+		return feof(file_ptr) ? YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT : YADSL_GRAPHIO_RET_FILE_ERROR;
+	if (memcmp(header, YADSL_GRAPHIO_COMPRESSED_MAGIC, sizeof(YADSL_GRAPHIO_COMPRESSED_MAGIC)))
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	if (yadsl_graphio_binary_get_internal(header + 8, 4) != YADSL_GRAPHIO_COMPRESSED_FILE_FORMAT_VERSION)
+		return YADSL_GRAPHIO_RET_DEPRECATED_FILE_FORMAT;
+	view->flags = (uint32_t) yadsl_graphio_binary_get_internal(header + 12, 4);
+	value = yadsl_graphio_binary_get_internal(header + 16, 4);
+	if (view->flags & ~(YADSL_GRAPHIO_BINARY_DIRECTED | YADSL_GRAPHIO_BINARY_EDGE_OBJECTS) ||
+		value > YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE)
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	view->is_directed = view->flags & YADSL_GRAPHIO_BINARY_DIRECTED;
+	view->weight_type = (yadsl_GraphEdgeWeightType) value;
+	view->weight_width = yadsl_graphio_binary_weight_width_internal(view->weight_type);
+	view->block_size = (size_t) yadsl_graphio_binary_get_internal(header + 20, 4);
+	value = yadsl_graphio_binary_get_internal(header + 24, 8);
+	if (view->block_size == 0 || value > ((uint64_t) 1 << 32))
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	view->vertex_count = (size_t) value;
+	value = yadsl_graphio_binary_get_internal(header + 32, 8);
+	if (value > SIZE_MAX / sizeof(yadsl_GraphBuildEdge))
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	view->edge_count = (size_t) value;
+	view->data_size = yadsl_graphio_binary_get_internal(header + 40, 8);
+	view->objects_offset = yadsl_graphio_binary_get_internal(header + 48, 8);
+	view->block_count = (view->vertex_count + view->block_size - 1) / view->block_size;
+	index_size = ((uint64_t) view->block_count + 1) * 8;
+	if (view->data_size > (uint64_t) LONG_MAX ||
+		view->objects_offset != YADSL_GRAPHIO_COMPRESSED_HEADER_SIZE + index_size + view->data_size ||
+		view->objects_offset > (uint64_t) (LONG_MAX - view->base))
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+
+	/* Block index and records */
+	if (ret = yadsl_graphio_binary_section_load_internal(file_ptr,
+		view->base + YADSL_GRAPHIO_COMPRESSED_HEADER_SIZE,
+		(size_t) (index_size + view->data_size), true, &view->section))
+		goto fail;
+	view->index = view->section.data;
+	view->data = view->section.data + index_size;
+	ret = YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	for (i = 0, previous = 0; i <= view->block_count; ++i) {
+		value = yadsl_graphio_binary_get_internal(view->index + i * 8, 8);
+		if (value < previous || value > view->data_size || (i == 0 && value != 0))
+			goto fail;
+		previous = value;
+	}
+	if (previous != view->data_size)
+		goto fail;
+	return YADSL_GRAPHIO_RET_OK;
+fail:
+	yadsl_graphio_binary_section_release_internal(&view->section);
+	return ret;
+}
+
+static void yadsl_graphio_compressed_block_get_internal(
+	yadsl_GraphIoCompressedView* view,
+	size_t block,
+	const unsigned char** p_ptr,
+	const unsigned char** end_ptr)
+{
+	*p_ptr = view->data + yadsl_graphio_binary_get_internal(view->index + block * 8, 8);
+	*end_ptr = view->data + yadsl_graphio_binary_get_internal(view->index + (block + 1) * 8, 8);
+}
+
+static yadsl_GraphIoRet yadsl_graphio_compressed_record_find_internal(
+	yadsl_GraphIoCompressedView* view,
+	size_t id,
+	const unsigned char** p_ptr,
+	const unsigned char** end_ptr)
+{
+	yadsl_GraphVertexFlag flag;
+	size_t skip, degree, k;
+	uint64_t value;
+	if (id >= view->vertex_count)
+		return YADSL_GRAPHIO_RET_PARAMETER;
+	yadsl_graphio_compressed_block_get_internal(view, id / view->block_size, p_ptr, end_ptr);
+	for (skip = id % view->block_size; skip > 0; --skip) {
+		if (!yadsl_graphio_compressed_record_head_internal(view, p_ptr, *end_ptr, &flag, &degree))
+			return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		for (k = 0; k < degree; ++k)
+			if (!yadsl_graphio_compressed_varint_get_internal(p_ptr, *end_ptr, &value))
+				return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		if (view->weight_width > 0 && (size_t) (*end_ptr - *p_ptr) / view->weight_width < degree)
+			return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		*p_ptr += view->weight_width * degree;
+	}
+	return YADSL_GRAPHIO_RET_OK;
+}
+
+static bool yadsl_graphio_compressed_record_head_internal(
+	yadsl_GraphIoCompressedView* view,
+	const unsigned char** p_ptr,
+	const unsigned char* end,
+	yadsl_GraphVertexFlag* flag_ptr,
+	size_t* degree_ptr)
+{
+	uint64_t flag, degree;
+	if (!yadsl_graphio_compressed_varint_get_internal(p_ptr, end, &flag) || flag > UINT32_MAX ||
+		!yadsl_graphio_compressed_varint_get_internal(p_ptr, end, &degree) ||
+		degree > view->vertex_count || degree > (uint64_t) (end - *p_ptr))
+		return false;
+	*flag_ptr = YADSL_GRAPHIO_UNZIGZAG(flag);
+	*degree_ptr = (size_t) degree;
+	return true;
+}
+
+static yadsl_GraphIoRet yadsl_graphio_import_parse_internal(
+	yadsl_GraphIoImporter* importer,
+	FILE* file_ptr)
+{
+	yadsl_GraphIoRet ret = YADSL_GRAPHIO_RET_OK;
+	char* buffer, * line, * newline, * temp;
+	size_t capacity = YADSL_GRAPHIO_IMPORT_CHUNK_SIZE, size = 0, requested, read;
+	bool is_at_end = false;
+
+	if (!(buffer = malloc(capacity + 1)))
+		return YADSL_GRAPHIO_RET_MEMORY;
+	while (!is_at_end) {
+		if (size == capacity) {
+			/* A single line fills the whole buffer */
+			if (!(temp = realloc(buffer, 2 * capacity + 1))) {
+				ret = YADSL_GRAPHIO_RET_MEMORY;
+				break;
+			}
+			buffer = temp;
+			capacity *= 2;
+		}
+		requested = capacity - size;
+		read = fread(buffer + size, 1, requested, file_ptr);
+		if (read < requested) {
+			if (ferror(file_ptr)) {
+				ret = YADSL_GRAPHIO_RET_FILE_ERROR;
+				break;
+			}
+			is_at_end = true;
+		}
+		size += read;
+		buffer[size] = '\0'; /* Bounds number parsing at the last line */
+		line = buffer;
+		while ((newline = memchr(line, '\n', buffer + size - line))) {
+			if (ret = yadsl_graphio_import_line_internal(importer, line, newline))
+				break;
+			line = newline + 1;
+		}
+		if (ret)
+			break;
+		if (is_at_end) {
+			if (line < buffer + size)
+				ret = yadsl_graphio_import_line_internal(importer, line, buffer + size);
+		} else {
+			/* Keep the incomplete line for the next chunk */
+			size = buffer + size - line;
+			memmove(buffer, line, size);
+		}
+	}
+	free(buffer);
+	return ret;
+}
+
+static yadsl_GraphIoRet yadsl_graphio_import_line_internal(
+	yadsl_GraphIoImporter* importer,
+	const char* line,
+	const char* end)
+{
+	const yadsl_GraphIoImportParams* params = importer->params;
+	yadsl_GraphEdgeWeight weight;
+	size_t u, v, row_count, column_count;
+	bool has_weight;
+
+	if (end > line && end[-1] == '\r')
+		--end;
+	line = yadsl_graphio_import_space_skip_internal(line, end);
+	weight = yadsl_graph_edge_weight_from_double(params->weight_type, 1.0);
+
+	switch (params->format) {
+	case YADSL_GRAPHIO_IMPORT_FORMAT_EDGE_LIST:
+		if (line == end || *line == '#' || *line == '%')
+			return YADSL_GRAPHIO_RET_OK;
+		if (!yadsl_graphio_import_size_parse_internal(&line, end, &u) ||
+			!yadsl_graphio_import_size_parse_internal(&line, end, &v) ||
+			u == SIZE_MAX || v == SIZE_MAX)
+			return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		if (params->weight_type != YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE &&
+			yadsl_graphio_import_space_skip_internal(line, end) != end &&
+			!yadsl_graphio_import_weight_parse_internal(&line, end, params->weight_type, &weight))
+			return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		if (u >= importer->vertex_count)
+			importer->vertex_count = u + 1;
+		if (v >= importer->vertex_count)
+			importer->vertex_count = v + 1;
+		return yadsl_graphio_import_edge_add_internal(importer, u, v, weight);
+	case YADSL_GRAPHIO_IMPORT_FORMAT_MATRIX_MARKET:
+		if (importer->state == YADSL_GRAPHIO_IMPORT_STATE_HEADER) {
+			/* %%MatrixMarket matrix coordinate <field> <symmetry> */
+			if (!yadsl_graphio_import_word_match_internal(&line, end, "%%MatrixMarket") ||
+				!yadsl_graphio_import_word_match_internal(&line, end, "matrix") ||
+				!yadsl_graphio_import_word_match_internal(&line, end, "coordinate"))
+				return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+			if (yadsl_graphio_import_word_match_internal(&line, end, "real") ||
+				yadsl_graphio_import_word_match_internal(&line, end, "double") ||
+				yadsl_graphio_import_word_match_internal(&line, end, "integer"))
+				importer->has_values = true;
+			else if (!yadsl_graphio_import_word_match_internal(&line, end, "pattern"))
+				return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+			if (yadsl_graphio_import_word_match_internal(&line, end, "symmetric"))
+				importer->is_symmetric = true;
+			else if (yadsl_graphio_import_word_match_internal(&line, end, "skew-symmetric"))
+				importer->is_symmetric = importer->is_skew_symmetric = true;
+			else if (!yadsl_graphio_import_word_match_internal(&line, end, "general"))
+				return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+			importer->state = YADSL_GRAPHIO_IMPORT_STATE_SIZE;
+			return YADSL_GRAPHIO_RET_OK;
+		}
+		if (line == end || *line == '%')
+			return YADSL_GRAPHIO_RET_OK;
+		if (importer->state == YADSL_GRAPHIO_IMPORT_STATE_SIZE) {
+			if (!yadsl_graphio_import_size_parse_internal(&line, end, &row_count) ||
+				!yadsl_graphio_import_size_parse_internal(&line, end, &column_count) ||
+				!yadsl_graphio_import_size_parse_internal(&line, end, &importer->entry_count))
+				return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+			importer->vertex_count = row_count > column_count ? row_count : column_count;
+			importer->state = YADSL_GRAPHIO_IMPORT_STATE_ENTRIES;
+			return YADSL_GRAPHIO_RET_OK;
+		}
+		if (!yadsl_graphio_import_size_parse_internal(&line, end, &u) ||
+			!yadsl_graphio_import_size_parse_internal(&line, end, &v) ||
+			u == 0 || v == 0 || u > importer->vertex_count || v > importer->vertex_count)
+			return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		if (importer->has_values) {
+			if (params->weight_type == YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE)
+				has_weight = yadsl_graphio_import_space_skip_internal(line, end) != end;
+			else
+				has_weight = yadsl_graphio_import_weight_parse_internal(&line, end, params->weight_type, &weight);
+			if (!has_weight)
+				return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		}
+		++importer->read_entry_count;
+		if (yadsl_graphio_import_edge_add_internal(importer, u - 1, v - 1, weight))
+			return YADSL_GRAPHIO_RET_MEMORY;
+		if (importer->is_symmetric && params->is_directed && u != v) {
+			if (importer->is_skew_symmetric)
+				weight = yadsl_graphio_import_weight_negate_internal(params->weight_type, weight);
+			return yadsl_graphio_import_edge_add_internal(importer, v - 1, u - 1, weight);
+		}
+		return YADSL_GRAPHIO_RET_OK;
+	case YADSL_GRAPHIO_IMPORT_FORMAT_DIMACS:
+		if (line == end || *line == 'c')
+			return YADSL_GRAPHIO_RET_OK;
+		if (*line == 'p') {
+			/* p <problem> <vertex count> <edge count> */
+			if (importer->state != YADSL_GRAPHIO_IMPORT_STATE_HEADER)
+				return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+			line = yadsl_graphio_import_space_skip_internal(line + 1, end);
+			while (line < end && *line != ' ' && *line != '\t')
+				++line;
+			if (!yadsl_graphio_import_size_parse_internal(&line, end, &importer->vertex_count) ||
+				!yadsl_graphio_import_size_parse_internal(&line, end, &importer->entry_count))
+				return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+			importer->state = YADSL_GRAPHIO_IMPORT_STATE_ENTRIES;
+			return YADSL_GRAPHIO_RET_OK;
+		}
+		if ((*line != 'a' && *line != 'e') || importer->state != YADSL_GRAPHIO_IMPORT_STATE_ENTRIES)
+			return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		has_weight = *line == 'a';
+		++line;
+		if (!yadsl_graphio_import_size_parse_internal(&line, end, &u) ||
+			!yadsl_graphio_import_size_parse_internal(&line, end, &v) ||
+			u == 0 || v == 0 || u > importer->vertex_count || v > importer->vertex_count)
+			return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		if (has_weight && params->weight_type != YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE &&
+			!yadsl_graphio_import_weight_parse_internal(&line, end, params->weight_type, &weight))
+			return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+		++importer->read_entry_count;
+		return yadsl_graphio_import_edge_add_internal(importer, u - 1, v - 1, weight);
+	default:
+		assert(0);
+		return YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT;
+	}
+}
+
+static yadsl_GraphIoRet yadsl_graphio_import_edge_add_internal(
+	yadsl_GraphIoImporter* importer,
+	size_t u,
+	size_t v,
+	yadsl_GraphEdgeWeight weight)
+{
+	yadsl_GraphBuildEdge* edge;
+	if (importer->edge_count == importer->edge_capacity) {
+		size_t capacity = importer->edge_capacity ? 2 * importer->edge_capacity : 1024;
+		if (capacity > SIZE_MAX / sizeof(*edge))
+			return YADSL_GRAPHIO_RET_MEMORY;
+		if (importer->edges)
+			edge = realloc(importer->edges, capacity * sizeof(*edge));
+		else
+			edge = malloc(capacity * sizeof(*edge));
+		if (!edge)
+			return YADSL_GRAPHIO_RET_MEMORY;
+		importer->edges = edge;
+		importer->edge_capacity = capacity;
+	}
+	edge = &importer->edges[importer->edge_count++];
+	edge->u = u;
+	edge->v = v;
+	edge->weight = weight;
+	edge->item = NULL;
+	return YADSL_GRAPHIO_RET_OK;
+}
+
+static const char* yadsl_graphio_import_space_skip_internal(
+	const char* p,
+	const char* end)
+{
+	while (p < end && (*p == ' ' || *p == '\t'))
+		++p;
+	return p;
+}
+
+static bool yadsl_graphio_import_size_parse_internal(
+	const char** p_ptr,
+	const char* end,
+	size_t* value_ptr)
+{
+	const char* p = yadsl_graphio_import_space_skip_internal(*p_ptr, end);
+	size_t value = 0, digit;
+	if (p == end || *p < '0' || *p > '9')
+		return false;
+	do {
+		digit = (size_t) (*p - '0');
+		if (value > (SIZE_MAX - digit) / 10)
+			return false;
+		value = value * 10 + digit;
+	} while (++p < end && *p >= '0' && *p <= '9');
+	if (p < end && *p != ' ' && *p != '\t')
+		return false;
+	*p_ptr = p;
+	*value_ptr = value;
+	return true;
+}
+
+static bool yadsl_graphio_import_weight_parse_internal(
+	const char** p_ptr,
+	const char* end,
+	yadsl_GraphEdgeWeightType weight_type,
+	yadsl_GraphEdgeWeight* weight_ptr)
+{
+	const char* p = yadsl_graphio_import_space_skip_internal(*p_ptr, end);
+	const char* q;
+	char* number_end;
+	uint64_t magnitude = 0, limit, digit;
+	bool is_negative;
+	double value;
+	if (p == end)
+		return false;
+	if (weight_type == YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32 ||
+		weight_type == YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT64) {
+		limit = weight_type == YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32 ? INT32_MAX : INT64_MAX;
+		q = p;
+		is_negative = *q == '-';
+		if (*q == '-' || *q == '+')
+			++q;
+		if (q < end && *q >= '0' && *q <= '9') {
+			limit += is_negative;
+			do {
+				digit = (uint64_t) (*q - '0');
+				if (magnitude > (limit - digit) / 10)
+					return false;
+				magnitude = magnitude * 10 + digit;
+			} while (++q < end && *q >= '0' && *q <= '9');
+			if (q == end || *q == ' ' || *q == '\t') {
+				if (weight_type == YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32)
+					weight_ptr->i32 = is_negative ? (int32_t) (0 - magnitude) : (int32_t) magnitude;
+				else
+					weight_ptr->i64 = is_negative ? (int64_t) (0 - magnitude) : (int64_t) magnitude;
+				*p_ptr = q;
+				return true;
+			}
+		}
+		/* Not an integer, such as "2.5" or "1e3" */
+	}
+	if (*p == ' ' || *p == '\t')
+		return false;
+	value = strtod(p, &number_end);
+	if (number_end == p || number_end > end ||
+		(number_end < end && *number_end != ' ' && *number_end != '\t'))
+		return false;
+	*weight_ptr = yadsl_graph_edge_weight_from_double(weight_type, value);
+	*p_ptr = number_end;
+	return true;
+}
+
+static yadsl_GraphEdgeWeight yadsl_graphio_import_weight_negate_internal(
+	yadsl_GraphEdgeWeightType weight_type,
+	yadsl_GraphEdgeWeight weight)
+{
+	switch (weight_type) {
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT32:
+		weight.i32 = (int32_t) (0 - (uint32_t) weight.i32);
+		break;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_INT64:
+		weight.i64 = (int64_t) (0 - (uint64_t) weight.i64);
+		break;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_FLOAT:
+		weight.f32 = -weight.f32;
+		break;
+	case YADSL_GRAPH_EDGE_WEIGHT_TYPE_DOUBLE:
+		weight.f64 = -weight.f64;
+		break;
+	default:
+		break;
+	}
+	return weight;
+}
+
+// Matches a whole word, ignoring case
+static bool yadsl_graphio_import_word_match_internal(
+	const char** p_ptr,
+	const char* end,
+	const char* word)
+{
+	const char* p = yadsl_graphio_import_space_skip_internal(*p_ptr, end);
+	for (; *word; ++word, ++p)
+		if (p == end || tolower((unsigned char) *p) != tolower((unsigned char) *word))
+			return false;
+	if (p < end && *p != ' ' && *p != '\t')
+		return false;
+	*p_ptr = p;
+	return true;
+}
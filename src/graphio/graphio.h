@@ -7,6 +7,8 @@
  * @{
 */
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 
 #include <graph/graph.h>
@@ -24,6 +26,7 @@ typedef enum
 	YADSL_GRAPHIO_RET_FILE_ERROR, /**< Could not write to or read from file */
 	YADSL_GRAPHIO_RET_DEPRECATED_FILE_FORMAT, /**< File format is incompatible */
 	YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT, /**< File format is corrupted */
+	YADSL_GRAPHIO_RET_PARAMETER, /**< Invalid parameter */
 }
 yadsl_GraphIoRet;
 
@@ -59,8 +62,89 @@ typedef int
 	FILE*,
 	yadsl_GraphEdgeObject**);
 
+typedef void yadsl_GraphIoCompressedHandle; /**< Compressed graph file handle */
+typedef void yadsl_GraphIoMappedHandle; /**< Memory-mapped graph file handle */
+
+/**
+ * @brief Formats of files made by other tools
+*/
+typedef enum
+{
+	YADSL_GRAPHIO_IMPORT_FORMAT_EDGE_LIST = 0, /**< "u v [weight]" lines, with 0-based ids */
+	YADSL_GRAPHIO_IMPORT_FORMAT_MATRIX_MARKET, /**< Matrix Market coordinate format (.mtx) */
+	YADSL_GRAPHIO_IMPORT_FORMAT_DIMACS, /**< DIMACS shortest path format (.gr) */
+}
+yadsl_GraphIoImportFormat;
+
+/**
+ * @brief Function responsible for creating the object of an imported vertex
+ * @param index vertex index (0-based)
+ * @param arg user argument
+ * @return newly created object, or NULL if could not allocate memory
+*/
+typedef yadsl_GraphVertexObject*
+(*yadsl_GraphIoVertexCreateFunc)(
+	size_t index,
+	void* arg);
+
+/**
+ * @brief Function responsible for creating the object of an imported edge
+ * @param u source vertex index
+ * @param v destination vertex index
+ * @param arg user argument
+ * @return newly created object, or NULL if could not allocate memory
+*/
+typedef yadsl_GraphEdgeObject*
+(*yadsl_GraphIoEdgeCreateFunc)(
+	size_t u,
+	size_t v,
+	void* arg);
+
+/**
+ * @brief Import parameters
+*/
+typedef struct
+{
+	yadsl_GraphIoImportFormat format; /**< file format */
+	bool is_directed; /**< whether the graph is directed */
+	yadsl_GraphEdgeWeightType weight_type; /**< inline edge weight type */
+	yadsl_GraphIoVertexCreateFunc create_vertex_func; /**< creates vertex objects */
+	yadsl_GraphIoEdgeCreateFunc create_edge_func; /**< creates edge objects (may be NULL, for NULL objects) */
+	void* arg; /**< argument passed to create_vertex_func and create_edge_func */
+}
+yadsl_GraphIoImportParams;
+
+/**
+ * @brief Text writer progress function
+ * @param written_count number of rows written so far
+ * @param total_count total number of rows (two per vertex: one with its
+ * object and flag, and another with its neighbours)
+ * @param arg user argument
+*/
+typedef void
+(*yadsl_GraphIoProgressFunc)(
+	size_t written_count,
+	size_t total_count,
+	void* arg);
+
+/**
+ * @brief Text writer parameters
+*/
+typedef struct
+{
+	size_t buffer_size; /**< bytes of rows gathered before every write (zero for the default of 1 MiB) */
+	yadsl_GraphIoProgressFunc progress_func; /**< called after every write (may be NULL) */
+	void* arg; /**< argument passed to progress_func */
+}
+yadsl_GraphIoWriteParams;
+
 /**
  * @brief Serialize graph structure to file
+ *
+ * Writes the same text as ::yadsl_graphio_write_streamed, but every row
+ * goes straight to file_ptr, which is also the file given to the
+ * serialization functions.
+ *
  * @param graph graph
  * @param file_ptr file pointer opened in writing mode
  * @param write_vertex_func vertex serialization function
@@ -78,6 +162,38 @@ yadsl_graphio_write(
 	yadsl_GraphIoVertexWriteFunc write_vertex_func,
 	yadsl_GraphIoEdgeWriteFunc write_edge_func);
 
+/**
+ * @brief Serialize graph structure to file, in chunks
+ *
+ * Vertices are written in order of id (see \ref graph), so flags,
+ * objects and neighbours are reached in constant time. Numbers are
+ * formatted without fprintf, and rows are gathered in memory streams
+ * of about buffer_size bytes, which are then copied to the file with a
+ * single write each (on POSIX systems; elsewhere, rows go straight to
+ * the file). Every chunk only depends on the ids of its rows.
+ *
+ * @param graph graph
+ * @param file_ptr file pointer opened in writing mode
+ * @param write_vertex_func vertex serialization function
+ * @param write_edge_func edge serialization function
+ * @param params writer parameters (may be NULL, for the defaults)
+ * @return
+ * * ::YADSL_GRAPHIO_RET_OK, and file is successfuly written
+ * * ::YADSL_GRAPHIO_RET_FILE_ERROR
+ * * ::YADSL_GRAPHIO_RET_WRITING_FAILURE
+ * * ::YADSL_GRAPHIO_RET_MEMORY
+ * @note On POSIX systems, serialization functions are given the memory
+ * stream of the current chunk rather than file_ptr, so they should only
+ * write to the file they are given, and not depend on its position.
+*/
+yadsl_GraphIoRet
+yadsl_graphio_write_streamed(
+	yadsl_GraphHandle* graph,
+	FILE* file_ptr,
+	yadsl_GraphIoVertexWriteFunc write_vertex_func,
+	yadsl_GraphIoEdgeWriteFunc write_edge_func,
+	const yadsl_GraphIoWriteParams* params);
+
 /**
  * @brief Deserialize graph structure from file
  * @param file_ptr file pointer opened for reading
@@ -108,6 +224,402 @@ yadsl_graphio_read(
 	yadsl_GraphFreeEdgeObjFunc free_edge_func,
 	yadsl_GraphHandle** graph_ptr);
 
+/**
+ * @brief Serialize graph structure to file, in binary format
+ *
+ * The binary format starts with a fixed header, followed by the
+ * adjacency of the graph in compressed sparse row form: an offset array
+ * of n + 1 entries, and then the weights and the destination ids of the
+ * neighbours of each vertex, sorted by id, in increasing order of
+ * source id. Vertex
+ * flags come next, and the vertex and edge objects last. Every count,
+ * id, offset, weight and flag is stored in little-endian byte order
+ * and fixed width, so that files are portable across platforms and
+ * can be loaded without any parsing.
+ *
+ * Vertex i of the file is the vertex of id i (see \ref graph). Edges of
+ * directed graphs are stored at their source, and edges of undirected
+ * graphs at both endpoints, so that files can also be opened with
+ * ::yadsl_graphio_mapped_open.
+ *
+ * @param graph graph
+ * @param file_ptr file pointer opened in binary writing mode
+ * @param write_vertex_func vertex serialization function
+ * @param write_edge_func edge serialization function, or NULL to
+ * leave edge objects out
+ * @return
+ * * ::YADSL_GRAPHIO_RET_OK, and file is successfuly written
+ * * ::YADSL_GRAPHIO_RET_FILE_ERROR
+ * * ::YADSL_GRAPHIO_RET_WRITING_FAILURE
+ * * ::YADSL_GRAPHIO_RET_MEMORY
+*/
+yadsl_GraphIoRet
+yadsl_graphio_binary_write(
+	yadsl_GraphHandle* graph,
+	FILE* file_ptr,
+	yadsl_GraphIoVertexWriteFunc write_vertex_func,
+	yadsl_GraphIoEdgeWriteFunc write_edge_func);
+
+/**
+ * @brief Deserialize graph structure from file, in binary format
+ *
+ * On POSIX systems, the adjacency is read straight from a memory
+ * mapping of the file, and otherwise from a single buffered read. The
+ * graph is then populated with ::yadsl_graph_build, so loading takes
+ * linear time. Vertex objects are not compared with each other, so
+ * they are assumed to be distinct, like when they were written.
+ *
+ * @param file_ptr file pointer opened for reading in binary mode,
+ * at the start of the graph
+ * @param read_vertex_func vertex deserialization function
+ * @param read_edge_func edge deserialization function (may be NULL
+ * if the file has no edge objects, in which case edge objects are NULL)
+ * @param cmp_vertices_func vertex comparison function
+ * @param free_vertex_func vertex freeing function
+ * @param cmp_edges_func edge comparison function
+ * @param free_edge_func edge freeing function
+ * @param graph_ptr pointer to graph
+ * @return
+ * * ::YADSL_GRAPHIO_RET_OK, and file is successfuly read and *graph_ptr is updated
+ * * ::YADSL_GRAPHIO_RET_FILE_ERROR
+ * * ::YADSL_GRAPHIO_RET_CREATION_FAILURE
+ * * ::YADSL_GRAPHIO_RET_DEPRECATED_FILE_FORMAT
+ * * ::YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT
+ * * ::YADSL_GRAPHIO_RET_MEMORY
+*/
+yadsl_GraphIoRet
+yadsl_graphio_binary_read(
+	FILE* file_ptr,
+	yadsl_GraphIoVertexReadFunc read_vertex_func,
+	yadsl_GraphIoEdgeReadFunc read_edge_func,
+	yadsl_GraphCmpVertexObjsFunc cmp_vertices_func,
+	yadsl_GraphFreeVertexObjFunc free_vertex_func,
+	yadsl_GraphCmpEdgeObjsFunc cmp_edges_func,
+	yadsl_GraphFreeEdgeObjFunc free_edge_func,
+	yadsl_GraphHandle** graph_ptr);
+
+/**
+ * @brief Open a file in binary format as a read-only graph view
+ *
+ * The adjacency is memory-mapped (with random access advice) and read
+ * in place, so graphs larger than the available memory can be traversed,
+ * with the kernel paging neighbour lists in and out as needed. Only the
+ * header is checked on opening. Offsets and ids are checked on every
+ * access instead, so corrupted files are reported as they are read.
+ * Where memory mapping is not available, the adjacency is read into
+ * memory. Objects are not read.
+ *
+ * @param file_ptr file pointer opened for reading in binary mode,
+ * at the start of the graph
+ * @param handle_ptr newly created handle
+ * @return
+ * * ::YADSL_GRAPHIO_RET_OK, and *handle_ptr is updated
+ * * ::YADSL_GRAPHIO_RET_FILE_ERROR
+ * * ::YADSL_GRAPHIO_RET_DEPRECATED_FILE_FORMAT
+ * * ::YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT
+ * * ::YADSL_GRAPHIO_RET_MEMORY
+ * @note The handle does not keep any reference to the file.
+ * @see yadsl_graphio_mapped_close
+*/
+yadsl_GraphIoRet
+yadsl_graphio_mapped_open(
+	FILE* file_ptr,
+	yadsl_GraphIoMappedHandle** handle_ptr);
+
+/**
+ * @brief Get the number of vertices of a mapped graph
+ * @param handle mapped graph handle
+ * @param vertex_count_ptr vertex count
+*/
+void
+yadsl_graphio_mapped_vertex_count_get(
+	yadsl_GraphIoMappedHandle* handle,
+	size_t* vertex_count_ptr);
+
+/**
+ * @brief Get the number of edges of a mapped graph
+ * @param handle mapped graph handle
+ * @param edge_count_ptr edge count
+*/
+void
+yadsl_graphio_mapped_edge_count_get(
+	yadsl_GraphIoMappedHandle* handle,
+	size_t* edge_count_ptr);
+
+/**
+ * @brief Check whether a mapped graph is directed
+ * @param handle mapped graph handle
+ * @param is_directed_ptr whether graph is directed
+*/
+void
+yadsl_graphio_mapped_is_directed_check(
+	yadsl_GraphIoMappedHandle* handle,
+	bool* is_directed_ptr);
+
+/**
+ * @brief Get the edge weight type of a mapped graph
+ * @param handle mapped graph handle
+ * @param weight_type_ptr edge weight type
+*/
+void
+yadsl_graphio_mapped_edge_weight_type_get(
+	yadsl_GraphIoMappedHandle* handle,
+	yadsl_GraphEdgeWeightType* weight_type_ptr);
+
+/**
+ * @brief Get the flag of a vertex of a mapped graph
+ * @param handle mapped graph handle
+ * @param id vertex id
+ * @param flag_ptr vertex flag
+ * @return
+ * * ::YADSL_GRAPHIO_RET_OK, and *flag_ptr is updated
+ * * ::YADSL_GRAPHIO_RET_PARAMETER, if there is no vertex with such id
+*/
+yadsl_GraphIoRet
+yadsl_graphio_mapped_vertex_flag_get(
+	yadsl_GraphIoMappedHandle* handle,
+	size_t id,
+	yadsl_GraphVertexFlag* flag_ptr);
+
+/**
+ * @brief Get the degree of a vertex of a mapped graph
+ * @param handle mapped graph handle
+ * @param id vertex id
+ * @param degree_ptr number of neighbours (out-neighbours, on
+ * directed graphs)
+ * @return
+ * * ::YADSL_GRAPHIO_RET_OK, and *degree_ptr is updated
+ * * ::YADSL_GRAPHIO_RET_PARAMETER, if there is no vertex with such id
+ * * ::YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT
+*/
+yadsl_GraphIoRet
+yadsl_graphio_mapped_vertex_degree_get(
+	yadsl_GraphIoMappedHandle* handle,
+	size_t id,
+	size_t* degree_ptr);
+
+/**
+ * @brief Get a neighbour of a vertex of a mapped graph
+ * @param handle mapped graph handle
+ * @param id vertex id
+ * @param index neighbour index, less than the degree of the vertex
+ * (neighbours are sorted by id)
+ * @param nb_ptr neighbour id
+ * @param weight_ptr edge weight, or NULL (zero if the graph is not weighted)
+ * @return
+ * * ::YADSL_GRAPHIO_RET_OK, and *nb_ptr and *weight_ptr are updated
+ * * ::YADSL_GRAPHIO_RET_PARAMETER, if there is no vertex with such id,
+ * or if index is out of range
+ * * ::YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT
+*/
+yadsl_GraphIoRet
+yadsl_graphio_mapped_vertex_nb_get(
+	yadsl_GraphIoMappedHandle* handle,
+	size_t id,
+	size_t index,
+	size_t* nb_ptr,
+	yadsl_GraphEdgeWeight* weight_ptr);
+
+/**
+ * @brief Close a mapped graph handle
+ * @param handle mapped graph handle (may be NULL)
+*/
+void
+yadsl_graphio_mapped_close(
+	yadsl_GraphIoMappedHandle* handle);
+
+/**
+ * @brief Import graph from a file made by another tool
+ *
+ * The file is read in large chunks and parsed line by line with a
+ * dedicated number parser, and the graph is then populated at once with
+ * ::yadsl_graph_build, so vertex i of the file is given id i. Lines may
+ * end with "\n" or "\r\n".
+ *
+ * | Format | Comments | Header | Edges | Ids |
+ * | :-: | :-: | :-: | :-: | :-: |
+ * | Edge list | "#" or "%" | | u v [w] | 0-based |
+ * | Matrix Market | "%" | banner, then rows columns entries | i j [w] | 1-based |
+ * | DIMACS | "c" | p sp n m | a u v w | 1-based |
+ *
+ * Edge lists have as many vertices as the largest id plus one, and may
+ * have further columns, which are ignored. Matrix Market files must be in
+ * coordinate format, with real, integer or pattern values. Entries of
+ * symmetric (or skew-symmetric) matrices are added in both directions on
+ * directed graphs. Missing weights (such as those of pattern matrices)
+ * are taken as one, and weights are ignored on unweighted graphs.
+ * Repeated edges are kept only once, as documented in ::yadsl_graph_build.
+ *
+ * @param file_ptr file pointer opened in reading mode
+ * @param params import parameters
+ * @param cmp_vertices_func vertex comparison function
+ * @param free_vertex_func vertex freeing function
+ * @param cmp_edges_func edge comparison function
+ * @param free_edge_func edge freeing function
+ * @param graph_ptr pointer to graph
+ * @return
+ * * ::YADSL_GRAPHIO_RET_OK, and file is successfuly read and *graph_ptr is updated
+ * * ::YADSL_GRAPHIO_RET_FILE_ERROR
+ * * ::YADSL_GRAPHIO_RET_CREATION_FAILURE
+ * * ::YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT, if a line cannot be parsed,
+ * an id is out of range, or the number of edges does not match the header
+ * * ::YADSL_GRAPHIO_RET_MEMORY
+*/
+yadsl_GraphIoRet
+yadsl_graphio_import(
+	FILE* file_ptr,
+	const yadsl_GraphIoImportParams* params,
+	yadsl_GraphCmpVertexObjsFunc cmp_vertices_func,
+	yadsl_GraphFreeVertexObjFunc free_vertex_func,
+	yadsl_GraphCmpEdgeObjsFunc cmp_edges_func,
+	yadsl_GraphFreeEdgeObjFunc free_edge_func,
+	yadsl_GraphHandle** graph_ptr);
+
+/**
+ * @brief Serialize graph structure to file, in compressed format
+ *
+ * Like in the binary format, vertex i of the file is the vertex of id i.
+ * The neighbours of every vertex are sorted by id and stored as
+ * variable-length deltas, so the size of each edge is usually one or two
+ * bytes instead of the several digits of the text format. On undirected
+ * graphs, every edge is stored at both of its endpoints (self-loops at
+ * their single endpoint), so the whole neighbourhood of a vertex can be
+ * decoded from its own record. An index holds the position of every
+ * block of 64 records, so any vertex can be decoded on its own (see
+ * ::yadsl_graphio_compressed_open).
+ *
+ * @param graph graph
+ * @param file_ptr file pointer opened in binary writing mode
+ * @param write_vertex_func vertex serialization function
+ * @param write_edge_func edge serialization function, or NULL to
+ * leave edge objects out
+ * @return
+ * * ::YADSL_GRAPHIO_RET_OK, and file is successfuly written
+ * * ::YADSL_GRAPHIO_RET_FILE_ERROR
+ * * ::YADSL_GRAPHIO_RET_WRITING_FAILURE
+ * * ::YADSL_GRAPHIO_RET_MEMORY
+*/
+yadsl_GraphIoRet
+yadsl_graphio_compressed_write(
+	yadsl_GraphHandle* graph,
+	FILE* file_ptr,
+	yadsl_GraphIoVertexWriteFunc write_vertex_func,
+	yadsl_GraphIoEdgeWriteFunc write_edge_func);
+
+/**
+ * @brief Deserialize graph structure from file, in compressed format
+ *
+ * Like ::yadsl_graphio_binary_read, the file is memory-mapped where
+ * possible and the graph is populated with ::yadsl_graph_build.
+ *
+ * @param file_ptr file pointer opened for reading in binary mode,
+ * at the start of the graph
+ * @param read_vertex_func vertex deserialization function
+ * @param read_edge_func edge deserialization function (may be NULL
+ * if the file has no edge objects, in which case edge objects are NULL)
+ * @param cmp_vertices_func vertex comparison function
+ * @param free_vertex_func vertex freeing function
+ * @param cmp_edges_func edge comparison function
+ * @param free_edge_func edge freeing function
+ * @param graph_ptr pointer to graph
+ * @return
+ * * ::YADSL_GRAPHIO_RET_OK, and file is successfuly read and *graph_ptr is updated
+ * * ::YADSL_GRAPHIO_RET_FILE_ERROR
+ * * ::YADSL_GRAPHIO_RET_CREATION_FAILURE
+ * * ::YADSL_GRAPHIO_RET_DEPRECATED_FILE_FORMAT
+ * * ::YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT
+ * * ::YADSL_GRAPHIO_RET_MEMORY
+*/
+yadsl_GraphIoRet
+yadsl_graphio_compressed_read(
+	FILE* file_ptr,
+	yadsl_GraphIoVertexReadFunc read_vertex_func,
+	yadsl_GraphIoEdgeReadFunc read_edge_func,
+	yadsl_GraphCmpVertexObjsFunc cmp_vertices_func,
+	yadsl_GraphFreeVertexObjFunc free_vertex_func,
+	yadsl_GraphCmpEdgeObjsFunc cmp_edges_func,
+	yadsl_GraphFreeEdgeObjFunc free_edge_func,
+	yadsl_GraphHandle** graph_ptr);
+
+/**
+ * @brief Open a file in compressed format for lazy decoding
+ *
+ * Only the header and the block index are checked. Records are decoded
+ * on demand, by skipping at most 63 records from the start of their
+ * block. Objects are not read.
+ *
+ * @param file_ptr file pointer opened for reading in binary mode,
+ * at the start of the graph
+ * @param handle_ptr newly created handle
+ * @return
+ * * ::YADSL_GRAPHIO_RET_OK, and *handle_ptr is updated
+ * * ::YADSL_GRAPHIO_RET_FILE_ERROR
+ * * ::YADSL_GRAPHIO_RET_DEPRECATED_FILE_FORMAT
+ * * ::YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT
+ * * ::YADSL_GRAPHIO_RET_MEMORY
+ * @note The handle does not keep any reference to the file.
+ * @see yadsl_graphio_compressed_close
+*/
+yadsl_GraphIoRet
+yadsl_graphio_compressed_open(
+	FILE* file_ptr,
+	yadsl_GraphIoCompressedHandle** handle_ptr);
+
+/**
+ * @brief Get the number of vertices of a compressed graph
+ * @param handle compressed graph handle
+ * @param vertex_count_ptr vertex count
+*/
+void
+yadsl_graphio_compressed_vertex_count_get(
+	yadsl_GraphIoCompressedHandle* handle,
+	size_t* vertex_count_ptr);
+
+/**
+ * @brief Decode the degree of a vertex of a compressed graph
+ * @param handle compressed graph handle
+ * @param id vertex id
+ * @param degree_ptr number of neighbours (out-neighbours, on
+ * directed graphs)
+ * @return
+ * * ::YADSL_GRAPHIO_RET_OK, and *degree_ptr is updated
+ * * ::YADSL_GRAPHIO_RET_PARAMETER, if there is no vertex with such id
+ * * ::YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT
+*/
+yadsl_GraphIoRet
+yadsl_graphio_compressed_degree_get(
+	yadsl_GraphIoCompressedHandle* handle,
+	size_t id,
+	size_t* degree_ptr);
+
+/**
+ * @brief Decode the neighbours of a vertex of a compressed graph
+ * @param handle compressed graph handle
+ * @param id vertex id
+ * @param nbs neighbour ids, in increasing order, with room for as many
+ * ids as the degree of the vertex
+ * @param weights edge weights, with as much room as nbs, or NULL
+ * (zero if the graph is not weighted)
+ * @return
+ * * ::YADSL_GRAPHIO_RET_OK, and nbs and weights are updated
+ * * ::YADSL_GRAPHIO_RET_PARAMETER, if there is no vertex with such id
+ * * ::YADSL_GRAPHIO_RET_CORRUPTED_FILE_FORMAT
+*/
+yadsl_GraphIoRet
+yadsl_graphio_compressed_nbs_get(
+	yadsl_GraphIoCompressedHandle* handle,
+	size_t id,
+	size_t* nbs,
+	yadsl_GraphEdgeWeight* weights);
+
+/**
+ * @brief Close a compressed graph handle
+ * @param handle compressed graph handle (may be NULL)
+*/
+void
+yadsl_graphio_compressed_close(
+	yadsl_GraphIoCompressedHandle* handle);
+
 /** @} */
 
 #endif
@@ -1,6 +1,7 @@
 #include <graphsearch/graphsearch.h>
 
 #include <stdio.h>
+#include <stdint.h>
 #include <assert.h>
 
 #ifdef YADSL_DEBUG
@@ -23,6 +24,35 @@ typedef struct
 }
 yadsl_GraphSearchBFSTreeNode;
 
+/* Visiting functions without context, adapted to the ones with context */
+typedef struct
+{
+	yadsl_GraphSearchVertexVisitFunc visit_vertex_func;
+	yadsl_GraphSearchEdgeVisitFunc visit_edge_func;
+}
+yadsl_GraphSearchVisitors;
+
+/* Neighbours of every vertex (by id), in search direction, either
+ * copied from a graph or read in place from a mapped graph file */
+typedef struct
+{
+	size_t vertex_count;
+	size_t* offsets;
+	size_t* neighbours;
+	yadsl_GraphIoMappedHandle* mapped;
+	bool is_directed;
+}
+yadsl_GraphSearchAdjacency;
+
+/* Vertex in the depth-first search stack, and its next neighbour */
+typedef struct
+{
+	size_t vertex;
+	size_t next;
+	size_t end;
+}
+yadsl_GraphSearchDfsFrame;
+
 /* Private functions prototypes */
 
 static yadsl_GraphSearchBFSTreeNode* yadsl_graphsearch_allocate_node_internal(
@@ -33,20 +63,103 @@ static yadsl_GraphSearchBFSTreeNode* yadsl_graphsearch_allocate_node_internal(
 static void yadsl_graphsearch_free_node_internal(
 	yadsl_QueueItemObj* item);
 
+static void yadsl_graphsearch_visit_vertex_adapter_internal(
+	void* ctx,
+	yadsl_GraphVertexObject* vertex);
+
+static void yadsl_graphsearch_visit_edge_adapter_internal(
+	void* ctx,
+	yadsl_GraphVertexObject* source,
+	yadsl_GraphEdgeObject* edge,
+	yadsl_GraphVertexObject* dest);
+
+static yadsl_GraphSearchRet yadsl_graphsearch_initial_vertex_check_internal(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* initial_vertex,
+	yadsl_GraphVertexFlag visited_flag);
+
 static yadsl_GraphSearchRet yadsl_graphsearch_dfs_internal(
 	yadsl_GraphHandle* graph,
 	yadsl_GraphVertexFlag visited_flag,
 	yadsl_GraphVertexObject* vertex,
-	yadsl_GraphSearchVertexVisitFunc visit_vertex_func,
-	yadsl_GraphSearchEdgeVisitFunc visit_edge_func);
+	yadsl_GraphSearchVertexVisitCtxFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeVisitCtxFunc visit_edge_func,
+	void* ctx);
 
 static yadsl_GraphSearchRet yadsl_graphsearch_bfs_internal(
 	yadsl_GraphHandle* graph,
 	yadsl_QueueHandle* bfs_queue,
 	yadsl_GraphVertexFlag visited_flag,
 	yadsl_GraphVertexObject* vertex,
-	yadsl_GraphSearchVertexVisitFunc visit_vertex_func,
-	yadsl_GraphSearchEdgeVisitFunc visit_edge_func);
+	yadsl_GraphSearchVertexVisitCtxFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeVisitCtxFunc visit_edge_func,
+	void* ctx);
+
+static bool yadsl_graphsearch_adjacency_create_internal(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphSearchAdjacency* adj);
+
+static void yadsl_graphsearch_adjacency_map_internal(
+	yadsl_GraphIoMappedHandle* mapped,
+	yadsl_GraphSearchAdjacency* adj);
+
+static void yadsl_graphsearch_adjacency_destroy_internal(
+	yadsl_GraphSearchAdjacency* adj);
+
+static bool yadsl_graphsearch_adjacency_row_get_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	size_t u,
+	size_t* begin_ptr,
+	size_t* end_ptr);
+
+static bool yadsl_graphsearch_adjacency_nb_get_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	size_t u,
+	size_t index,
+	size_t* nb_ptr);
+
+static yadsl_GraphSearchRet yadsl_graphsearch_initial_id_check_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	size_t initial_vertex,
+	const bool* visited);
+
+static yadsl_GraphSearchRet yadsl_graphsearch_dfs_ids_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	size_t initial_vertex,
+	bool* visited,
+	yadsl_GraphSearchVertexIdVisitFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeIdVisitFunc visit_edge_func,
+	void* ctx);
+
+static yadsl_GraphSearchRet yadsl_graphsearch_bfs_ids_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	size_t initial_vertex,
+	bool* visited,
+	yadsl_GraphSearchVertexIdVisitFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeIdVisitFunc visit_edge_func,
+	yadsl_GraphSearchLevelIdVisitFunc visit_level_func,
+	void* ctx);
+
+static yadsl_GraphSearchRet yadsl_graphsearch_bfs_multi_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	const size_t* seeds,
+	size_t seed_count,
+	size_t max_depth,
+	size_t* distances,
+	size_t* nearest_seeds);
+
+static yadsl_GraphSearchRet yadsl_graphsearch_betweenness_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	const size_t* sources,
+	size_t source_count,
+	double scale,
+	double* centrality);
+
+static yadsl_GraphSearchRet yadsl_graphsearch_betweenness_sampled_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	size_t sample_count,
+	unsigned long seed,
+	double* centrality);
 
 /* Public functions */
 
@@ -57,21 +170,13 @@ yadsl_GraphSearchRet yadsl_graphsearch_dfs(
 	yadsl_GraphSearchVertexVisitFunc visit_vertex_func,
 	yadsl_GraphSearchEdgeVisitFunc visit_edge_func)
 {
-	yadsl_GraphRet graph_ret;
-	yadsl_GraphVertexFlag flag;
-
-	if (graph_ret = yadsl_graph_vertex_flag_get(graph, initial_vertex, &flag)) {
-		switch (graph_ret) {
-		case YADSL_GRAPH_RET_DOES_NOT_CONTAIN_VERTEX:
-			return YADSL_GRAPHSEARCH_RET_DOES_NOT_CONTAIN_VERTEX;
-		default:
-			assert(0);
-		}
-	}
-	if (flag == visited_flag)
-		return YADSL_GRAPHSEARCH_RET_VERTEX_ALREADY_VISITED;
-
-	return yadsl_graphsearch_dfs_internal(graph, visited_flag, initial_vertex, visit_vertex_func, visit_edge_func);
+	yadsl_GraphSearchVisitors visitors;
+	visitors.visit_vertex_func = visit_vertex_func;
+	visitors.visit_edge_func = visit_edge_func;
+	return yadsl_graphsearch_dfs_ctx(graph, initial_vertex, visited_flag,
+		visit_vertex_func ? yadsl_graphsearch_visit_vertex_adapter_internal : NULL,
+		visit_edge_func ? yadsl_graphsearch_visit_edge_adapter_internal : NULL,
+		&visitors);
 }
 
 yadsl_GraphSearchRet yadsl_graphsearch_bfs(
@@ -80,10 +185,297 @@ yadsl_GraphSearchRet yadsl_graphsearch_bfs(
 	yadsl_GraphVertexFlag visited_flag,
 	yadsl_GraphSearchVertexVisitFunc visit_vertex_func,
 	yadsl_GraphSearchEdgeVisitFunc visit_edge_func)
+{
+	yadsl_GraphSearchVisitors visitors;
+	visitors.visit_vertex_func = visit_vertex_func;
+	visitors.visit_edge_func = visit_edge_func;
+	return yadsl_graphsearch_bfs_ctx(graph, initial_vertex, visited_flag,
+		visit_vertex_func ? yadsl_graphsearch_visit_vertex_adapter_internal : NULL,
+		visit_edge_func ? yadsl_graphsearch_visit_edge_adapter_internal : NULL,
+		&visitors);
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_dfs_ctx(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* initial_vertex,
+	yadsl_GraphVertexFlag visited_flag,
+	yadsl_GraphSearchVertexVisitCtxFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeVisitCtxFunc visit_edge_func,
+	void* ctx)
+{
+	yadsl_GraphSearchRet graph_search_ret;
+
+	if (graph_search_ret = yadsl_graphsearch_initial_vertex_check_internal(graph, initial_vertex, visited_flag))
+		return graph_search_ret;
+
+	return yadsl_graphsearch_dfs_internal(graph, visited_flag, initial_vertex, visit_vertex_func, visit_edge_func, ctx);
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_bfs_ctx(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* initial_vertex,
+	yadsl_GraphVertexFlag visited_flag,
+	yadsl_GraphSearchVertexVisitCtxFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeVisitCtxFunc visit_edge_func,
+	void* ctx)
 {
 	yadsl_QueueHandle* bfs_queue;
-	yadsl_GraphRet graph_ret;
 	yadsl_GraphSearchRet graph_search_ret;
+
+	if (graph_search_ret = yadsl_graphsearch_initial_vertex_check_internal(graph, initial_vertex, visited_flag))
+		return graph_search_ret;
+
+	if (!(bfs_queue = yadsl_queue_create(yadsl_graphsearch_free_node_internal)))
+		return YADSL_GRAPHSEARCH_RET_MEMORY;
+
+	graph_search_ret = yadsl_graphsearch_bfs_internal(graph, bfs_queue, visited_flag, initial_vertex, visit_vertex_func, visit_edge_func, ctx);
+
+	yadsl_queue_destroy(bfs_queue);
+	return graph_search_ret;
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_bfs_batch(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* initial_vertex,
+	yadsl_GraphVertexFlag visited_flag,
+	yadsl_GraphSearchLevelVisitFunc visit_level_func,
+	void* ctx)
+{
+	yadsl_GraphSearchBfsTriple* triples;
+	yadsl_GraphSearchRet graph_search_ret;
+	yadsl_GraphEdgeDirection edge_direction;
+	yadsl_GraphVertexObject* vertex, * nb;
+	yadsl_GraphEdgeObject* edge;
+	yadsl_GraphVertexFlag flag;
+	size_t vertex_count, degree, begin, end, tail, depth, i;
+	bool is_directed;
+
+	if (graph_search_ret = yadsl_graphsearch_initial_vertex_check_internal(graph, initial_vertex, visited_flag))
+		return graph_search_ret;
+
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (yadsl_graph_is_directed_check(graph, &is_directed)) assert(0);
+	edge_direction = is_directed ? YADSL_GRAPH_EDGE_DIR_OUT : YADSL_GRAPH_EDGE_DIR_BOTH;
+
+	/* Every vertex is reached at most once, so levels are stored back to back */
+	if (!(triples = malloc(vertex_count * sizeof(*triples))))
+		return YADSL_GRAPHSEARCH_RET_MEMORY;
+	if (yadsl_graph_vertex_flag_set(graph, initial_vertex, visited_flag)) assert(0);
+	triples[0].parent = NULL;
+	triples[0].edge = NULL;
+	triples[0].child = initial_vertex;
+	tail = 1;
+	for (begin = 0, depth = 0; begin < tail; begin = end, ++depth) {
+		end = tail;
+		if (visit_level_func)
+			visit_level_func(ctx, depth, triples + begin, end - begin);
+		for (i = begin; i < end; ++i) {
+			vertex = triples[i].child;
+			if (yadsl_graph_vertex_degree_get(graph, vertex, edge_direction, &degree)) assert(0);
+			while (degree--) {
+				if (yadsl_graph_vertex_nb_iter(graph, vertex, edge_direction, YADSL_GRAPH_ITER_DIR_NEXT, &nb, &edge)) assert(0);
+				if (yadsl_graph_vertex_flag_get(graph, nb, &flag)) assert(0);
+				if (flag == visited_flag)
+					continue;
+				if (yadsl_graph_vertex_flag_set(graph, nb, visited_flag)) assert(0);
+				triples[tail].parent = vertex;
+				triples[tail].edge = edge;
+				triples[tail].child = nb;
+				++tail;
+			}
+		}
+	}
+
+	free(triples);
+	return YADSL_GRAPHSEARCH_RET_OK;
+}
+
+yadsl_GraphSearchAdjacencyHandle* yadsl_graphsearch_adjacency_create(
+	yadsl_GraphHandle* graph)
+{
+	yadsl_GraphSearchAdjacency* adj = malloc(sizeof(*adj));
+	if (adj && !yadsl_graphsearch_adjacency_create_internal(graph, adj)) {
+		free(adj);
+		adj = NULL;
+	}
+	return adj;
+}
+
+yadsl_GraphSearchAdjacencyHandle* yadsl_graphsearch_adjacency_create_mapped(
+	yadsl_GraphIoMappedHandle* mapped)
+{
+	yadsl_GraphSearchAdjacency* adj = malloc(sizeof(*adj));
+	if (adj)
+		yadsl_graphsearch_adjacency_map_internal(mapped, adj);
+	return adj;
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_adjacency_vertex_count_get(
+	yadsl_GraphSearchAdjacencyHandle* adj,
+	size_t* vertex_count_ptr)
+{
+	*vertex_count_ptr = ((yadsl_GraphSearchAdjacency*) adj)->vertex_count;
+	return YADSL_GRAPHSEARCH_RET_OK;
+}
+
+void yadsl_graphsearch_adjacency_destroy(
+	yadsl_GraphSearchAdjacencyHandle* adj)
+{
+	if (adj) {
+		yadsl_graphsearch_adjacency_destroy_internal(adj);
+		free(adj);
+	}
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_dfs_ids(
+	yadsl_GraphSearchAdjacencyHandle* adj,
+	size_t initial_vertex,
+	bool* visited,
+	yadsl_GraphSearchVertexIdVisitFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeIdVisitFunc visit_edge_func,
+	void* ctx)
+{
+	yadsl_GraphSearchRet graph_search_ret;
+	if (graph_search_ret = yadsl_graphsearch_initial_id_check_internal(adj, initial_vertex, visited))
+		return graph_search_ret;
+	return yadsl_graphsearch_dfs_ids_internal(adj, initial_vertex, visited,
+		visit_vertex_func, visit_edge_func, ctx);
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_bfs_ids(
+	yadsl_GraphSearchAdjacencyHandle* adj,
+	size_t initial_vertex,
+	bool* visited,
+	yadsl_GraphSearchVertexIdVisitFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeIdVisitFunc visit_edge_func,
+	void* ctx)
+{
+	yadsl_GraphSearchRet graph_search_ret;
+	if (graph_search_ret = yadsl_graphsearch_initial_id_check_internal(adj, initial_vertex, visited))
+		return graph_search_ret;
+	return yadsl_graphsearch_bfs_ids_internal(adj, initial_vertex, visited,
+		visit_vertex_func, visit_edge_func, NULL, ctx);
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_bfs_ids_batch(
+	yadsl_GraphSearchAdjacencyHandle* adj,
+	size_t initial_vertex,
+	bool* visited,
+	yadsl_GraphSearchLevelIdVisitFunc visit_level_func,
+	void* ctx)
+{
+	yadsl_GraphSearchRet graph_search_ret;
+	if (graph_search_ret = yadsl_graphsearch_initial_id_check_internal(adj, initial_vertex, visited))
+		return graph_search_ret;
+	return yadsl_graphsearch_bfs_ids_internal(adj, initial_vertex, visited,
+		NULL, NULL, visit_level_func, ctx);
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_bfs_multi(
+	yadsl_GraphHandle* graph,
+	const size_t* seeds,
+	size_t seed_count,
+	size_t max_depth,
+	size_t* distances,
+	size_t* nearest_seeds)
+{
+	yadsl_GraphSearchAdjacency adj;
+	yadsl_GraphSearchRet graph_search_ret;
+	if (!yadsl_graphsearch_adjacency_create_internal(graph, &adj))
+		return YADSL_GRAPHSEARCH_RET_MEMORY;
+	graph_search_ret = yadsl_graphsearch_bfs_multi_internal(&adj, seeds, seed_count,
+		max_depth, distances, nearest_seeds);
+	yadsl_graphsearch_adjacency_destroy_internal(&adj);
+	return graph_search_ret;
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_bfs_multi_mapped(
+	yadsl_GraphIoMappedHandle* mapped,
+	const size_t* seeds,
+	size_t seed_count,
+	size_t max_depth,
+	size_t* distances,
+	size_t* nearest_seeds)
+{
+	yadsl_GraphSearchAdjacency adj;
+	yadsl_graphsearch_adjacency_map_internal(mapped, &adj);
+	return yadsl_graphsearch_bfs_multi_internal(&adj, seeds, seed_count,
+		max_depth, distances, nearest_seeds);
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_betweenness(
+	yadsl_GraphHandle* graph,
+	double* centrality)
+{
+	yadsl_GraphSearchAdjacency adj;
+	yadsl_GraphSearchRet graph_search_ret;
+	if (!yadsl_graphsearch_adjacency_create_internal(graph, &adj))
+		return YADSL_GRAPHSEARCH_RET_MEMORY;
+	graph_search_ret = yadsl_graphsearch_betweenness_internal(&adj, NULL, adj.vertex_count, 1.0, centrality);
+	yadsl_graphsearch_adjacency_destroy_internal(&adj);
+	return graph_search_ret;
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_betweenness_mapped(
+	yadsl_GraphIoMappedHandle* mapped,
+	double* centrality)
+{
+	yadsl_GraphSearchAdjacency adj;
+	yadsl_graphsearch_adjacency_map_internal(mapped, &adj);
+	return yadsl_graphsearch_betweenness_internal(&adj, NULL, adj.vertex_count, 1.0, centrality);
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_betweenness_sampled(
+	yadsl_GraphHandle* graph,
+	size_t sample_count,
+	unsigned long seed,
+	double* centrality)
+{
+	yadsl_GraphSearchAdjacency adj;
+	yadsl_GraphSearchRet graph_search_ret;
+	if (!yadsl_graphsearch_adjacency_create_internal(graph, &adj))
+		return YADSL_GRAPHSEARCH_RET_MEMORY;
+	graph_search_ret = yadsl_graphsearch_betweenness_sampled_internal(&adj, sample_count, seed, centrality);
+	yadsl_graphsearch_adjacency_destroy_internal(&adj);
+	return graph_search_ret;
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_betweenness_sampled_mapped(
+	yadsl_GraphIoMappedHandle* mapped,
+	size_t sample_count,
+	unsigned long seed,
+	double* centrality)
+{
+	yadsl_GraphSearchAdjacency adj;
+	yadsl_graphsearch_adjacency_map_internal(mapped, &adj);
+	return yadsl_graphsearch_betweenness_sampled_internal(&adj, sample_count, seed, centrality);
+}
+
+/* Private functions */
+
+void yadsl_graphsearch_visit_vertex_adapter_internal(
+	void* ctx,
+	yadsl_GraphVertexObject* vertex)
+{
+	((yadsl_GraphSearchVisitors*) ctx)->visit_vertex_func(vertex);
+}
+
+void yadsl_graphsearch_visit_edge_adapter_internal(
+	void* ctx,
+	yadsl_GraphVertexObject* source,
+	yadsl_GraphEdgeObject* edge,
+	yadsl_GraphVertexObject* dest)
+{
+	((yadsl_GraphSearchVisitors*) ctx)->visit_edge_func(source, edge, dest);
+}
+
+// Check that the initial vertex exists and was not visited yet
+yadsl_GraphSearchRet yadsl_graphsearch_initial_vertex_check_internal(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* initial_vertex,
+	yadsl_GraphVertexFlag visited_flag)
+{
+	yadsl_GraphRet graph_ret;
 	yadsl_GraphVertexFlag flag;
 
 	if (graph_ret = yadsl_graph_vertex_flag_get(graph, initial_vertex, &flag)) {
@@ -97,24 +489,17 @@ yadsl_GraphSearchRet yadsl_graphsearch_bfs(
 	if (flag == visited_flag)
 		return YADSL_GRAPHSEARCH_RET_VERTEX_ALREADY_VISITED;
 
-	if (!(bfs_queue = yadsl_queue_create(yadsl_graphsearch_free_node_internal)))
-		return YADSL_GRAPHSEARCH_RET_MEMORY;
-
-	graph_search_ret = yadsl_graphsearch_bfs_internal(graph, bfs_queue, visited_flag, initial_vertex, visit_vertex_func, visit_edge_func);
-
-	yadsl_queue_destroy(bfs_queue);
-	return graph_search_ret;
+	return YADSL_GRAPHSEARCH_RET_OK;
 }
 
-/* Private functions */
-
 // Run yadsl_graphsearch_dfs_internal on unvisited vertex
 yadsl_GraphSearchRet yadsl_graphsearch_dfs_internal(
 	yadsl_GraphHandle* graph,
 	yadsl_GraphVertexFlag visited_flag,
 	yadsl_GraphVertexObject* vertex,
-	yadsl_GraphSearchVertexVisitFunc visit_vertex_func,
-	yadsl_GraphSearchEdgeVisitFunc visit_edge_func)
+	yadsl_GraphSearchVertexVisitCtxFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeVisitCtxFunc visit_edge_func,
+	void* ctx)
 {
 	yadsl_GraphSearchRet graph_search_ret;
 	yadsl_GraphVertexObject* nb;
@@ -124,7 +509,7 @@ yadsl_GraphSearchRet yadsl_graphsearch_dfs_internal(
 	yadsl_GraphVertexFlag flag;
 
 	if (visit_vertex_func)
-		visit_vertex_func(vertex);
+		visit_vertex_func(ctx, vertex);
 	if (yadsl_graph_vertex_flag_set(graph, vertex, visited_flag)) assert(0);
 	if (yadsl_graph_is_directed_check(graph, &is_directed)) assert(0);
 	if (is_directed) {
@@ -136,8 +521,8 @@ yadsl_GraphSearchRet yadsl_graphsearch_dfs_internal(
 			if (flag == visited_flag)
 				continue;
 			if (visit_edge_func)
-				visit_edge_func(vertex, edge, nb);
-			if (graph_search_ret = yadsl_graphsearch_dfs_internal(graph, visited_flag, nb, visit_vertex_func, visit_edge_func))
+				visit_edge_func(ctx, vertex, edge, nb);
+			if (graph_search_ret = yadsl_graphsearch_dfs_internal(graph, visited_flag, nb, visit_vertex_func, visit_edge_func, ctx))
 				return graph_search_ret;
 		}
 	} else {
@@ -150,8 +535,8 @@ yadsl_GraphSearchRet yadsl_graphsearch_dfs_internal(
 			if (flag == visited_flag)
 				continue;
 			if (visit_edge_func)
-				visit_edge_func(vertex, edge, nb);
-			if (graph_search_ret = yadsl_graphsearch_dfs_internal(graph, visited_flag, nb, visit_vertex_func, visit_edge_func))
+				visit_edge_func(ctx, vertex, edge, nb);
+			if (graph_search_ret = yadsl_graphsearch_dfs_internal(graph, visited_flag, nb, visit_vertex_func, visit_edge_func, ctx))
 				return graph_search_ret;
 		}
 	}
@@ -196,8 +581,9 @@ yadsl_GraphSearchRet yadsl_graphsearch_bfs_internal(
 	yadsl_QueueHandle* bfs_queue,
 	yadsl_GraphVertexFlag visited_flag,
 	yadsl_GraphVertexObject* vertex,
-	yadsl_GraphSearchVertexVisitFunc visit_vertex_func,
-	yadsl_GraphSearchEdgeVisitFunc visit_edge_func)
+	yadsl_GraphSearchVertexVisitCtxFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeVisitCtxFunc visit_edge_func,
+	void* ctx)
 {
 	bool is_directed;
 	yadsl_GraphSearchBFSTreeNode* node = NULL;
@@ -212,14 +598,14 @@ yadsl_GraphSearchRet yadsl_graphsearch_bfs_internal(
 	}
 	if (yadsl_graph_vertex_flag_set(graph, vertex, visited_flag)) assert(0);
 	if (visit_vertex_func)
-		visit_vertex_func(vertex);
+		visit_vertex_func(ctx, vertex);
 	if (graph_search_ret = yadsl_graphsearch_add_nb_to_queue_internal(graph, bfs_queue, visited_flag, vertex, edge_direction))
 		return graph_search_ret;
 	while (yadsl_queue_dequeue(bfs_queue, (yadsl_QueueItemObj**) &node) == YADSL_QUEUE_RET_OK) {
 		if (visit_edge_func)
-			visit_edge_func(node->parent, node->edge, node->child);
+			visit_edge_func(ctx, node->parent, node->edge, node->child);
 		if (visit_vertex_func)
-			visit_vertex_func(node->child);
+			visit_vertex_func(ctx, node->child);
 		vertex = node->child;
 		yadsl_graphsearch_free_node_internal(node);
 		if (graph_search_ret = yadsl_graphsearch_add_nb_to_queue_internal(graph, bfs_queue, visited_flag, vertex, edge_direction))
@@ -260,6 +646,404 @@ void yadsl_graphsearch_free_node_internal(yadsl_QueueItemObj* item)
 	free(node);
 }
 
+// Builds the neighbour lists from the edge endpoints (by id),
+// leaving out self-loops
+bool yadsl_graphsearch_adjacency_create_internal(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphSearchAdjacency* adj)
+{
+	yadsl_GraphEdgeWeight weight;
+	size_t vertex_count, edge_count, entry_count, id, u, v;
+	bool is_directed;
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (yadsl_graph_edge_count_get(graph, &edge_count)) assert(0);
+	if (yadsl_graph_is_directed_check(graph, &is_directed)) assert(0);
+	adj->vertex_count = vertex_count;
+	adj->neighbours = NULL;
+	adj->mapped = NULL;
+	adj->is_directed = is_directed;
+	if (!(adj->offsets = malloc((vertex_count + 1) * sizeof(*adj->offsets))))
+		return false;
+	for (u = 0; u <= vertex_count; ++u)
+		adj->offsets[u] = 0;
+	for (id = 0; id < edge_count; ++id) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+		if (u == v)
+			continue;
+		++adj->offsets[u + 1];
+		if (!is_directed)
+			++adj->offsets[v + 1];
+	}
+	for (u = 0; u < vertex_count; ++u)
+		adj->offsets[u + 1] += adj->offsets[u];
+	entry_count = adj->offsets[vertex_count];
+	if (entry_count > 0 && !(adj->neighbours = malloc(entry_count * sizeof(*adj->neighbours)))) {
+		free(adj->offsets);
+		return false;
+	}
+	/* Fill rows from their ends, leaving offsets[u + 1] at the start of row u */
+	for (id = edge_count; id-- > 0;) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+		if (u == v)
+			continue;
+		adj->neighbours[--adj->offsets[u + 1]] = v;
+		if (!is_directed)
+			adj->neighbours[--adj->offsets[v + 1]] = u;
+	}
+	for (u = 0; u < vertex_count; ++u)
+		adj->offsets[u] = adj->offsets[u + 1];
+	adj->offsets[vertex_count] = entry_count;
+	return true;
+}
+
+// Reads the neighbour lists straight from a mapped graph file,
+// which are sorted by id and may include self-loops
+void yadsl_graphsearch_adjacency_map_internal(
+	yadsl_GraphIoMappedHandle* mapped,
+	yadsl_GraphSearchAdjacency* adj)
+{
+	yadsl_graphio_mapped_vertex_count_get(mapped, &adj->vertex_count);
+	yadsl_graphio_mapped_is_directed_check(mapped, &adj->is_directed);
+	adj->offsets = NULL;
+	adj->neighbours = NULL;
+	adj->mapped = mapped;
+}
+
+void yadsl_graphsearch_adjacency_destroy_internal(
+	yadsl_GraphSearchAdjacency* adj)
+{
+	if (adj->offsets)
+		free(adj->offsets);
+	if (adj->neighbours)
+		free(adj->neighbours);
+}
+
+// Gets the range of neighbour indices of vertex u, which
+// is only possible to fail on mapped graph files
+bool yadsl_graphsearch_adjacency_row_get_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	size_t u,
+	size_t* begin_ptr,
+	size_t* end_ptr)
+{
+	if (adj->mapped) {
+		*begin_ptr = 0;
+		return yadsl_graphio_mapped_vertex_degree_get(adj->mapped, u, end_ptr) == YADSL_GRAPHIO_RET_OK;
+	}
+	*begin_ptr = adj->offsets[u];
+	*end_ptr = adj->offsets[u + 1];
+	return true;
+}
+
+bool yadsl_graphsearch_adjacency_nb_get_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	size_t u,
+	size_t index,
+	size_t* nb_ptr)
+{
+	if (adj->mapped)
+		return yadsl_graphio_mapped_vertex_nb_get(adj->mapped, u, index, nb_ptr, NULL) == YADSL_GRAPHIO_RET_OK;
+	*nb_ptr = adj->neighbours[index];
+	return true;
+}
+
+// Check that the initial vertex id is valid and was not visited yet
+yadsl_GraphSearchRet yadsl_graphsearch_initial_id_check_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	size_t initial_vertex,
+	const bool* visited)
+{
+	if (initial_vertex >= adj->vertex_count)
+		return YADSL_GRAPHSEARCH_RET_PARAMETER;
+	if (visited[initial_vertex])
+		return YADSL_GRAPHSEARCH_RET_VERTEX_ALREADY_VISITED;
+	return YADSL_GRAPHSEARCH_RET_OK;
+}
+
+// Every vertex is pushed at most once, so the stack
+// never holds more than vertex_count frames
+yadsl_GraphSearchRet yadsl_graphsearch_dfs_ids_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	size_t initial_vertex,
+	bool* visited,
+	yadsl_GraphSearchVertexIdVisitFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeIdVisitFunc visit_edge_func,
+	void* ctx)
+{
+	yadsl_GraphSearchRet graph_search_ret = YADSL_GRAPHSEARCH_RET_CORRUPTED_FILE_FORMAT;
+	yadsl_GraphSearchDfsFrame* frames, * frame;
+	size_t top, v;
+	if (!(frames = malloc(adj->vertex_count * sizeof(*frames))))
+		return YADSL_GRAPHSEARCH_RET_MEMORY;
+	visited[initial_vertex] = true;
+	if (visit_vertex_func)
+		visit_vertex_func(ctx, initial_vertex);
+	frame = &frames[0];
+	frame->vertex = initial_vertex;
+	if (!yadsl_graphsearch_adjacency_row_get_internal(adj, initial_vertex, &frame->next, &frame->end))
+		goto exit;
+	top = 1;
+	while (top > 0) {
+		frame = &frames[top - 1];
+		if (frame->next == frame->end) {
+			--top;
+			continue;
+		}
+		if (!yadsl_graphsearch_adjacency_nb_get_internal(adj, frame->vertex, frame->next++, &v))
+			goto exit;
+		if (visited[v])
+			continue;
+		visited[v] = true;
+		if (visit_edge_func)
+			visit_edge_func(ctx, frame->vertex, v);
+		if (visit_vertex_func)
+			visit_vertex_func(ctx, v);
+		frame = &frames[top++];
+		frame->vertex = v;
+		if (!yadsl_graphsearch_adjacency_row_get_internal(adj, v, &frame->next, &frame->end))
+			goto exit;
+	}
+	graph_search_ret = YADSL_GRAPHSEARCH_RET_OK;
+exit:
+	free(frames);
+	return graph_search_ret;
+}
+
+// Every vertex is reached at most once, so levels are stored back to back,
+// and visited either one vertex or one level at a time
+yadsl_GraphSearchRet yadsl_graphsearch_bfs_ids_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	size_t initial_vertex,
+	bool* visited,
+	yadsl_GraphSearchVertexIdVisitFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeIdVisitFunc visit_edge_func,
+	yadsl_GraphSearchLevelIdVisitFunc visit_level_func,
+	void* ctx)
+{
+	yadsl_GraphSearchRet graph_search_ret = YADSL_GRAPHSEARCH_RET_MEMORY;
+	size_t* queue = NULL, * parents = NULL;
+	size_t tail, level_begin, level_end, depth, begin, end, i, j, u, v;
+	if (!(queue = malloc(adj->vertex_count * sizeof(*queue))))
+		goto exit;
+	if (!(parents = malloc(adj->vertex_count * sizeof(*parents))))
+		goto exit;
+	graph_search_ret = YADSL_GRAPHSEARCH_RET_CORRUPTED_FILE_FORMAT;
+	visited[initial_vertex] = true;
+	queue[0] = initial_vertex;
+	parents[0] = YADSL_GRAPHSEARCH_NONE;
+	tail = 1;
+	for (level_begin = 0, depth = 0; level_begin < tail; level_begin = level_end, ++depth) {
+		level_end = tail;
+		if (visit_level_func)
+			visit_level_func(ctx, depth, parents + level_begin, queue + level_begin, level_end - level_begin);
+		for (i = level_begin; i < level_end; ++i) {
+			u = queue[i];
+			if (visit_edge_func && i > 0)
+				visit_edge_func(ctx, parents[i], u);
+			if (visit_vertex_func)
+				visit_vertex_func(ctx, u);
+			if (!yadsl_graphsearch_adjacency_row_get_internal(adj, u, &begin, &end))
+				goto exit;
+			for (j = begin; j < end; ++j) {
+				if (!yadsl_graphsearch_adjacency_nb_get_internal(adj, u, j, &v))
+					goto exit;
+				if (visited[v])
+					continue;
+				visited[v] = true;
+				parents[tail] = u;
+				queue[tail++] = v;
+			}
+		}
+	}
+	graph_search_ret = YADSL_GRAPHSEARCH_RET_OK;
+exit:
+	if (parents)
+		free(parents);
+	if (queue)
+		free(queue);
+	return graph_search_ret;
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_bfs_multi_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	const size_t* seeds,
+	size_t seed_count,
+	size_t max_depth,
+	size_t* distances,
+	size_t* nearest_seeds)
+{
+	yadsl_GraphSearchRet graph_search_ret = YADSL_GRAPHSEARCH_RET_CORRUPTED_FILE_FORMAT;
+	size_t* queue;
+	size_t head = 0, tail = 0, i, begin, end, u, v;
+	for (i = 0; i < seed_count; ++i)
+		if (seeds[i] >= adj->vertex_count)
+			return YADSL_GRAPHSEARCH_RET_PARAMETER;
+	for (v = 0; v < adj->vertex_count; ++v) {
+		distances[v] = YADSL_GRAPHSEARCH_DISTANCE_INFINITE;
+		if (nearest_seeds)
+			nearest_seeds[v] = YADSL_GRAPHSEARCH_NONE;
+	}
+	if (seed_count == 0)
+		return YADSL_GRAPHSEARCH_RET_OK;
+	if (!(queue = malloc(adj->vertex_count * sizeof(*queue))))
+		return YADSL_GRAPHSEARCH_RET_MEMORY;
+	for (i = 0; i < seed_count; ++i) {
+		v = seeds[i];
+		if (distances[v] == YADSL_GRAPHSEARCH_DISTANCE_INFINITE) {
+			distances[v] = 0;
+			if (nearest_seeds)
+				nearest_seeds[v] = v;
+			queue[tail++] = v;
+		}
+	}
+	while (head < tail) {
+		u = queue[head++];
+		/* The queue is sorted by distance, so the rest is at least as far */
+		if (distances[u] >= max_depth)
+			break;
+		if (!yadsl_graphsearch_adjacency_row_get_internal(adj, u, &begin, &end))
+			goto exit;
+		for (i = begin; i < end; ++i) {
+			if (!yadsl_graphsearch_adjacency_nb_get_internal(adj, u, i, &v))
+				goto exit;
+			if (distances[v] != YADSL_GRAPHSEARCH_DISTANCE_INFINITE)
+				continue;
+			distances[v] = distances[u] + 1;
+			if (nearest_seeds)
+				nearest_seeds[v] = nearest_seeds[u];
+			queue[tail++] = v;
+		}
+	}
+	graph_search_ret = YADSL_GRAPHSEARCH_RET_OK;
+exit:
+	free(queue);
+	return graph_search_ret;
+}
+
+// Accumulates pair dependencies from every source (or every vertex, if
+// sources is NULL), following Brandes' successor-based formulation
+yadsl_GraphSearchRet yadsl_graphsearch_betweenness_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	const size_t* sources,
+	size_t source_count,
+	double scale,
+	double* centrality)
+{
+	yadsl_GraphSearchRet graph_search_ret = YADSL_GRAPHSEARCH_RET_MEMORY;
+	size_t* distances = NULL, * order = NULL;
+	double* paths = NULL, * dependencies = NULL;
+	size_t vertex_count = adj->vertex_count, i, j, k, begin, end, head, tail, s, v, w;
+	for (v = 0; v < vertex_count; ++v)
+		centrality[v] = 0.0;
+	if (vertex_count == 0)
+		return YADSL_GRAPHSEARCH_RET_OK;
+	if (!(distances = malloc(vertex_count * sizeof(*distances))))
+		goto exit;
+	if (!(order = malloc(vertex_count * sizeof(*order))))
+		goto exit;
+	if (!(paths = malloc(vertex_count * sizeof(*paths))))
+		goto exit;
+	if (!(dependencies = malloc(vertex_count * sizeof(*dependencies))))
+		goto exit;
+	graph_search_ret = YADSL_GRAPHSEARCH_RET_CORRUPTED_FILE_FORMAT;
+	for (i = 0; i < source_count; ++i) {
+		s = sources ? sources[i] : i;
+		for (v = 0; v < vertex_count; ++v) {
+			distances[v] = YADSL_GRAPHSEARCH_DISTANCE_INFINITE;
+			paths[v] = 0.0;
+		}
+		/* Count shortest paths from s, in BFS order */
+		distances[s] = 0;
+		paths[s] = 1.0;
+		head = tail = 0;
+		order[tail++] = s;
+		while (head < tail) {
+			v = order[head++];
+			if (!yadsl_graphsearch_adjacency_row_get_internal(adj, v, &begin, &end))
+				goto exit;
+			for (j = begin; j < end; ++j) {
+				if (!yadsl_graphsearch_adjacency_nb_get_internal(adj, v, j, &w))
+					goto exit;
+				if (distances[w] == YADSL_GRAPHSEARCH_DISTANCE_INFINITE) {
+					distances[w] = distances[v] + 1;
+					order[tail++] = w;
+				}
+				if (distances[w] == distances[v] + 1)
+					paths[w] += paths[v];
+			}
+		}
+		/* Successors are settled before their predecessors */
+		for (k = tail; k-- > 0;) {
+			v = order[k];
+			dependencies[v] = 0.0;
+			if (!yadsl_graphsearch_adjacency_row_get_internal(adj, v, &begin, &end))
+				goto exit;
+			for (j = begin; j < end; ++j) {
+				if (!yadsl_graphsearch_adjacency_nb_get_internal(adj, v, j, &w))
+					goto exit;
+				if (distances[w] == distances[v] + 1)
+					dependencies[v] += paths[v] / paths[w] * (1.0 + dependencies[w]);
+			}
+			if (v != s)
+				centrality[v] += dependencies[v];
+		}
+	}
+	/* Every undirected pair was counted from both ends */
+	if (!adj->is_directed)
+		scale /= 2.0;
+	for (v = 0; v < vertex_count; ++v)
+		centrality[v] *= scale;
+	graph_search_ret = YADSL_GRAPHSEARCH_RET_OK;
+exit:
+	if (dependencies)
+		free(dependencies);
+	if (paths)
+		free(paths);
+	if (order)
+		free(order);
+	if (distances)
+		free(distances);
+	return graph_search_ret;
+}
+
+yadsl_GraphSearchRet yadsl_graphsearch_betweenness_sampled_internal(
+	yadsl_GraphSearchAdjacency* adj,
+	size_t sample_count,
+	unsigned long seed,
+	double* centrality)
+{
+	yadsl_GraphSearchRet graph_search_ret;
+	size_t vertex_count = adj->vertex_count, i, j, temp;
+	size_t* sources;
+	uint64_t state;
+	if (sample_count >= vertex_count)
+		return yadsl_graphsearch_betweenness_internal(adj, NULL, vertex_count, 1.0, centrality);
+	if (sample_count == 0) {
+		for (i = 0; i < vertex_count; ++i)
+			centrality[i] = 0.0;
+		return YADSL_GRAPHSEARCH_RET_OK;
+	}
+	if (!(sources = malloc(vertex_count * sizeof(*sources))))
+		return YADSL_GRAPHSEARCH_RET_MEMORY;
+	for (i = 0; i < vertex_count; ++i)
+		sources[i] = i;
+	/* Partial Fisher-Yates shuffle, with xorshift64* */
+	state = (uint64_t) seed ^ UINT64_C(0x9E3779B97F4A7C15);
+	for (i = 0; i < sample_count; ++i) {
+		state ^= state >> 12;
+		state ^= state << 25;
+		state ^= state >> 27;
+		j = i + (size_t) ((state * UINT64_C(0x2545F4914F6CDD1D)) % (vertex_count - i));
+		temp = sources[i];
+		sources[i] = sources[j];
+		sources[j] = temp;
+	}
+	graph_search_ret = yadsl_graphsearch_betweenness_internal(adj, sources, sample_count,
+		(double) vertex_count / (double) sample_count, centrality);
+	free(sources);
+	return graph_search_ret;
+}
+
 #ifdef YADSL_DEBUG
 int yadsl_graphsearch_get_node_ref_count()
 {
@@ -4,10 +4,19 @@
 /**
  * \defgroup graphsearch Graph Search
  * @brief Auxiliary module for searching in Graphs.
+ *
+ * Searches that only need vertex ids run on an adjacency handle, which
+ * is either built from a graph or reads the neighbour lists of a graph file
+ * opened with ::yadsl_graphio_mapped_open in place, without loading the
+ * whole graph. The same search then works on both.
+ *
  * @{
 */
 
+#include <stddef.h>
+
 #include <graph/graph.h>
+#include <graphio/graphio.h>
 
 /**
  * @brief Return condition of Graph Search functions
@@ -18,9 +27,22 @@ typedef enum
 	YADSL_GRAPHSEARCH_RET_DOES_NOT_CONTAIN_VERTEX, /**< Graph doesn't contain vertex */
 	YADSL_GRAPHSEARCH_RET_VERTEX_ALREADY_VISITED, /**< Vertex was already visited */
 	YADSL_GRAPHSEARCH_RET_MEMORY, /**< Could not allocate memory */
+	YADSL_GRAPHSEARCH_RET_PARAMETER, /**< Invalid parameter */
+	YADSL_GRAPHSEARCH_RET_CORRUPTED_FILE_FORMAT, /**< Mapped graph file is corrupted */
 }
 yadsl_GraphSearchRet;
 
+/**
+ * @brief Distance of unreached vertices, and depth limit of unlimited searches
+*/
+#define YADSL_GRAPHSEARCH_DISTANCE_INFINITE ((size_t) -1)
+
+/**
+ * @brief Vertex id standing for no vertex, such as the parent of the
+ * initial vertex, or the nearest seed of an unreached vertex
+*/
+#define YADSL_GRAPHSEARCH_NONE ((size_t) -1)
+
 /**
  * @brief Function responsible for visiting each vertex in a graph search
  * @param vertex visited vertex
@@ -35,6 +57,75 @@ typedef void (*yadsl_GraphSearchVertexVisitFunc)(yadsl_GraphVertexObject* vertex
 */
 typedef void (*yadsl_GraphSearchEdgeVisitFunc)(yadsl_GraphVertexObject* source, yadsl_GraphEdgeObject* edge, yadsl_GraphVertexObject* dest);
 
+/**
+ * @brief Function responsible for visiting each vertex in a graph search,
+ * with a user context
+ * @param ctx user context
+ * @param vertex visited vertex
+*/
+typedef void (*yadsl_GraphSearchVertexVisitCtxFunc)(void* ctx, yadsl_GraphVertexObject* vertex);
+
+/**
+ * @brief Function responsible for visiting each edge in a graph search,
+ * with a user context
+ * @param ctx user context
+ * @param source edge source vertex
+ * @param edge visited edge
+ * @param dest edge destination vertex
+*/
+typedef void (*yadsl_GraphSearchEdgeVisitCtxFunc)(void* ctx, yadsl_GraphVertexObject* source, yadsl_GraphEdgeObject* edge, yadsl_GraphVertexObject* dest);
+
+/**
+ * @brief Vertex reached by a breadth-first search, and how
+*/
+typedef struct
+{
+	yadsl_GraphVertexObject* parent; /**< vertex it was reached from (NULL for the initial vertex) */
+	yadsl_GraphEdgeObject* edge; /**< edge it was reached through (NULL for the initial vertex) */
+	yadsl_GraphVertexObject* child; /**< vertex reached */
+}
+yadsl_GraphSearchBfsTriple;
+
+/**
+ * @brief Function responsible for visiting each level of a breadth-first search
+ * @param ctx user context
+ * @param depth distance from the initial vertex (zero for the initial vertex itself)
+ * @param triples vertices in the level, in visiting order
+ * @param count number of vertices in the level
+ * @note The array is owned by the search and only valid during the call
+*/
+typedef void (*yadsl_GraphSearchLevelVisitFunc)(void* ctx, size_t depth, const yadsl_GraphSearchBfsTriple* triples, size_t count);
+
+typedef void yadsl_GraphSearchAdjacencyHandle; /**< Adjacency handle */
+
+/**
+ * @brief Function responsible for visiting each vertex in a search by id
+ * @param ctx user context
+ * @param vertex visited vertex id
+*/
+typedef void (*yadsl_GraphSearchVertexIdVisitFunc)(void* ctx, size_t vertex);
+
+/**
+ * @brief Function responsible for visiting each edge in a search by id
+ * @param ctx user context
+ * @param source edge source vertex id
+ * @param dest edge destination vertex id
+*/
+typedef void (*yadsl_GraphSearchEdgeIdVisitFunc)(void* ctx, size_t source, size_t dest);
+
+/**
+ * @brief Function responsible for visiting each level of a breadth-first
+ * search by id
+ * @param ctx user context
+ * @param depth distance from the initial vertex
+ * @param parents id of the vertex each one was reached from
+ * (::YADSL_GRAPHSEARCH_NONE for the initial vertex)
+ * @param vertices vertex ids in the level, in visiting order
+ * @param count number of vertices in the level
+ * @note The arrays are owned by the search and only valid during the call
+*/
+typedef void (*yadsl_GraphSearchLevelIdVisitFunc)(void* ctx, size_t depth, const size_t* parents, const size_t* vertices, size_t count);
+
 /**
  * @brief Visit the graph in a depth-first search fashion
  * @param graph graph
@@ -76,6 +167,348 @@ yadsl_graphsearch_bfs(
 	yadsl_GraphSearchVertexVisitFunc visit_vertex_func,
 	yadsl_GraphSearchEdgeVisitFunc visit_edge_func);
 
+/**
+ * @brief Visit the graph in a depth-first search fashion, passing
+ * a user context to the visiting functions
+ * @param graph graph
+ * @param initial_vertex initial vertex
+ * @param visited_flag value that will be set to visited vertices
+ * @param visit_vertex_func vertex visiting function
+ * @param visit_edge_func edge visiting function
+ * @param ctx user context
+ * @return
+ * * ::YADSL_GRAPHSEARCH_RET_OK
+ * * ::YADSL_GRAPHSEARCH_RET_VERTEX_ALREADY_VISITED
+ * * ::YADSL_GRAPHSEARCH_RET_DOES_NOT_CONTAIN_VERTEX
+*/
+yadsl_GraphSearchRet
+yadsl_graphsearch_dfs_ctx(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* initial_vertex,
+	yadsl_GraphVertexFlag visited_flag,
+	yadsl_GraphSearchVertexVisitCtxFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeVisitCtxFunc visit_edge_func,
+	void* ctx);
+
+/**
+ * @brief Visit the graph in a breadth-first search fashion, passing
+ * a user context to the visiting functions
+ * @param graph graph
+ * @param initial_vertex initial vertex
+ * @param visited_flag value that will be set to visited vertices
+ * @param visit_vertex_func vertex visiting function
+ * @param visit_edge_func edge visiting function
+ * @param ctx user context
+ * @return
+ * * ::YADSL_GRAPHSEARCH_RET_OK
+ * * ::YADSL_GRAPHSEARCH_RET_VERTEX_ALREADY_VISITED
+ * * ::YADSL_GRAPHSEARCH_RET_DOES_NOT_CONTAIN_VERTEX
+ * * ::YADSL_GRAPHSEARCH_RET_MEMORY
+*/
+yadsl_GraphSearchRet
+yadsl_graphsearch_bfs_ctx(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* initial_vertex,
+	yadsl_GraphVertexFlag visited_flag,
+	yadsl_GraphSearchVertexVisitCtxFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeVisitCtxFunc visit_edge_func,
+	void* ctx);
+
+/**
+ * @brief Visit the graph in a breadth-first search fashion, one level at a time
+ *
+ * The visiting function is called once per level, with every vertex
+ * in it, instead of once per vertex and once per edge. Vertices are
+ * visited in the same order as ::yadsl_graphsearch_bfs.
+ *
+ * @param graph graph
+ * @param initial_vertex initial vertex
+ * @param visited_flag value that will be set to visited vertices
+ * @param visit_level_func level visiting function
+ * @param ctx user context
+ * @return
+ * * ::YADSL_GRAPHSEARCH_RET_OK
+ * * ::YADSL_GRAPHSEARCH_RET_VERTEX_ALREADY_VISITED
+ * * ::YADSL_GRAPHSEARCH_RET_DOES_NOT_CONTAIN_VERTEX
+ * * ::YADSL_GRAPHSEARCH_RET_MEMORY
+*/
+yadsl_GraphSearchRet
+yadsl_graphsearch_bfs_batch(
+	yadsl_GraphHandle* graph,
+	yadsl_GraphVertexObject* initial_vertex,
+	yadsl_GraphVertexFlag visited_flag,
+	yadsl_GraphSearchLevelVisitFunc visit_level_func,
+	void* ctx);
+
+/**
+ * @brief Build the adjacency of a graph, for searches by id
+ *
+ * Neighbour lists are copied in search direction (out-going edges on
+ * directed graphs), without self-loops, in O(n + m) time and memory.
+ * The adjacency does not follow later changes to the graph.
+ *
+ * @param graph graph
+ * @return newly created adjacency or, if there is not enough memory, NULL.
+*/
+yadsl_GraphSearchAdjacencyHandle*
+yadsl_graphsearch_adjacency_create(
+	yadsl_GraphHandle* graph);
+
+/**
+ * @brief Wrap a mapped graph file, for searches by id
+ *
+ * Neighbour lists are read in place, as searches go.
+ *
+ * @param mapped mapped graph handle, which must outlive the adjacency
+ * @return newly created adjacency or, if there is not enough memory, NULL.
+*/
+yadsl_GraphSearchAdjacencyHandle*
+yadsl_graphsearch_adjacency_create_mapped(
+	yadsl_GraphIoMappedHandle* mapped);
+
+/**
+ * @brief Get the number of vertices of an adjacency
+ * @param adj adjacency
+ * @param vertex_count_ptr number of vertices
+ * @return
+ * * ::YADSL_GRAPHSEARCH_RET_OK, and *vertex_count_ptr is updated
+*/
+yadsl_GraphSearchRet
+yadsl_graphsearch_adjacency_vertex_count_get(
+	yadsl_GraphSearchAdjacencyHandle* adj,
+	size_t* vertex_count_ptr);
+
+/**
+ * @brief Destroy an adjacency
+ * @param adj adjacency
+*/
+void
+yadsl_graphsearch_adjacency_destroy(
+	yadsl_GraphSearchAdjacencyHandle* adj);
+
+/**
+ * @brief Visit vertices by id in a depth-first search fashion
+ *
+ * Vertices and edges are visited as in ::yadsl_graphsearch_dfs_ctx, but
+ * the search keeps its own stack, so its depth is not bounded by the
+ * call stack.
+ *
+ * @param adj adjacency
+ * @param initial_vertex initial vertex id
+ * @param visited whether each vertex (by id) was visited, set by the search
+ * @param visit_vertex_func vertex visiting function (nullable)
+ * @param visit_edge_func edge visiting function (nullable)
+ * @param ctx user context
+ * @return
+ * * ::YADSL_GRAPHSEARCH_RET_OK
+ * * ::YADSL_GRAPHSEARCH_RET_VERTEX_ALREADY_VISITED
+ * * ::YADSL_GRAPHSEARCH_RET_PARAMETER, if initial_vertex is not a valid id
+ * * ::YADSL_GRAPHSEARCH_RET_CORRUPTED_FILE_FORMAT
+ * * ::YADSL_GRAPHSEARCH_RET_MEMORY
+*/
+yadsl_GraphSearchRet
+yadsl_graphsearch_dfs_ids(
+	yadsl_GraphSearchAdjacencyHandle* adj,
+	size_t initial_vertex,
+	bool* visited,
+	yadsl_GraphSearchVertexIdVisitFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeIdVisitFunc visit_edge_func,
+	void* ctx);
+
+/**
+ * @brief Visit vertices by id in a breadth-first search fashion
+ * @param adj adjacency
+ * @param initial_vertex initial vertex id
+ * @param visited whether each vertex (by id) was visited, set by the search
+ * @param visit_vertex_func vertex visiting function (nullable)
+ * @param visit_edge_func edge visiting function (nullable)
+ * @param ctx user context
+ * @return
+ * * ::YADSL_GRAPHSEARCH_RET_OK
+ * * ::YADSL_GRAPHSEARCH_RET_VERTEX_ALREADY_VISITED
+ * * ::YADSL_GRAPHSEARCH_RET_PARAMETER, if initial_vertex is not a valid id
+ * * ::YADSL_GRAPHSEARCH_RET_CORRUPTED_FILE_FORMAT
+ * * ::YADSL_GRAPHSEARCH_RET_MEMORY
+*/
+yadsl_GraphSearchRet
+yadsl_graphsearch_bfs_ids(
+	yadsl_GraphSearchAdjacencyHandle* adj,
+	size_t initial_vertex,
+	bool* visited,
+	yadsl_GraphSearchVertexIdVisitFunc visit_vertex_func,
+	yadsl_GraphSearchEdgeIdVisitFunc visit_edge_func,
+	void* ctx);
+
+/**
+ * @brief Visit vertices by id in a breadth-first search fashion,
+ * one level at a time
+ * @param adj adjacency
+ * @param initial_vertex initial vertex id
+ * @param visited whether each vertex (by id) was visited, set by the search
+ * @param visit_level_func level visiting function
+ * @param ctx user context
+ * @return
+ * * ::YADSL_GRAPHSEARCH_RET_OK
+ * * ::YADSL_GRAPHSEARCH_RET_VERTEX_ALREADY_VISITED
+ * * ::YADSL_GRAPHSEARCH_RET_PARAMETER, if initial_vertex is not a valid id
+ * * ::YADSL_GRAPHSEARCH_RET_CORRUPTED_FILE_FORMAT
+ * * ::YADSL_GRAPHSEARCH_RET_MEMORY
+*/
+yadsl_GraphSearchRet
+yadsl_graphsearch_bfs_ids_batch(
+	yadsl_GraphSearchAdjacencyHandle* adj,
+	size_t initial_vertex,
+	bool* visited,
+	yadsl_GraphSearchLevelIdVisitFunc visit_level_func,
+	void* ctx);
+
+/**
+ * @brief Run a breadth-first search from several seed vertices at once
+ *
+ * Every vertex gets its distance (in hops, following edge direction on
+ * directed graphs) to the nearest seed, and which seed it is. When several
+ * seeds are equally near, the one whose search front got there first wins,
+ * which is deterministic for a given graph and seed array. Vertex flags are
+ * not used. Runs in O(n + m).
+ *
+ * @param graph graph
+ * @param seeds seed vertex ids (see \ref graph)
+ * @param seed_count number of seeds
+ * @param max_depth vertices further than this from every seed are not
+ * reached, or ::YADSL_GRAPHSEARCH_DISTANCE_INFINITE for no limit
+ * @param distances distance of each vertex (by id) to its nearest seed,
+ * or ::YADSL_GRAPHSEARCH_DISTANCE_INFINITE if not reached
+ * @param nearest_seeds id of the nearest seed of each vertex (by id),
+ * or ::YADSL_GRAPHSEARCH_NONE if not reached (nullable)
+ * @return
+ * * ::YADSL_GRAPHSEARCH_RET_OK, and distances and nearest_seeds are updated
+ * * ::YADSL_GRAPHSEARCH_RET_PARAMETER, if a seed is not a valid vertex id
+ * * ::YADSL_GRAPHSEARCH_RET_MEMORY
+*/
+yadsl_GraphSearchRet
+yadsl_graphsearch_bfs_multi(
+	yadsl_GraphHandle* graph,
+	const size_t* seeds,
+	size_t seed_count,
+	size_t max_depth,
+	size_t* distances,
+	size_t* nearest_seeds);
+
+/**
+ * @brief Run a breadth-first search from several seed vertices at once,
+ * on a mapped graph file
+ *
+ * Same as ::yadsl_graphsearch_bfs_multi, but reads the neighbour lists
+ * in place, so only O(n) memory is allocated.
+ *
+ * @param mapped mapped graph handle
+ * @param seeds seed vertex ids
+ * @param seed_count number of seeds
+ * @param max_depth maximum distance, or ::YADSL_GRAPHSEARCH_DISTANCE_INFINITE
+ * @param distances distance of each vertex (by id) to its nearest seed
+ * @param nearest_seeds id of the nearest seed of each vertex (nullable)
+ * @return
+ * * ::YADSL_GRAPHSEARCH_RET_OK, and distances and nearest_seeds are updated
+ * * ::YADSL_GRAPHSEARCH_RET_PARAMETER, if a seed is not a valid vertex id
+ * * ::YADSL_GRAPHSEARCH_RET_CORRUPTED_FILE_FORMAT
+ * * ::YADSL_GRAPHSEARCH_RET_MEMORY
+*/
+yadsl_GraphSearchRet
+yadsl_graphsearch_bfs_multi_mapped(
+	yadsl_GraphIoMappedHandle* mapped,
+	const size_t* seeds,
+	size_t seed_count,
+	size_t max_depth,
+	size_t* distances,
+	size_t* nearest_seeds);
+
+/**
+ * @brief Compute the betweenness centrality of every vertex
+ *
+ * The betweenness of a vertex v is the sum, over every pair of distinct
+ * vertices s and t (other than v), of the fraction of shortest paths
+ * from s to t that go through v. Paths are counted in hops, and follow
+ * edge direction on directed graphs. On undirected graphs, every pair
+ * is counted once.
+ *
+ * Brandes' algorithm runs one search per source vertex, in O(nm) time.
+ *
+ * @param graph graph
+ * @param centrality betweenness of each vertex (by id, see \ref graph)
+ * @return
+ * * ::YADSL_GRAPHSEARCH_RET_OK, and centrality is updated
+ * * ::YADSL_GRAPHSEARCH_RET_MEMORY
+*/
+yadsl_GraphSearchRet
+yadsl_graphsearch_betweenness(
+	yadsl_GraphHandle* graph,
+	double* centrality);
+
+/**
+ * @brief Compute the betweenness centrality of every vertex of a
+ * mapped graph file
+ *
+ * Same as ::yadsl_graphsearch_betweenness, but reads the neighbour lists
+ * in place. Self-loops stored in the file do not change the result.
+ *
+ * @param mapped mapped graph handle
+ * @param centrality betweenness of each vertex (by id)
+ * @return
+ * * ::YADSL_GRAPHSEARCH_RET_OK, and centrality is updated
+ * * ::YADSL_GRAPHSEARCH_RET_CORRUPTED_FILE_FORMAT
+ * * ::YADSL_GRAPHSEARCH_RET_MEMORY
+*/
+yadsl_GraphSearchRet
+yadsl_graphsearch_betweenness_mapped(
+	yadsl_GraphIoMappedHandle* mapped,
+	double* centrality);
+
+/**
+ * @brief Estimate the betweenness centrality of every vertex
+ *
+ * Same as ::yadsl_graphsearch_betweenness, but only runs searches from
+ * a pseudo-random sample of source vertices, and scales the result by
+ * the inverse of the sampled fraction. Runs in O(km) time.
+ *
+ * @param graph graph
+ * @param sample_count number of source vertices (if not smaller than
+ * the number of vertices, the result is exact)
+ * @param seed seed of the sample
+ * @param centrality estimated betweenness of each vertex (by id)
+ * @return
+ * * ::YADSL_GRAPHSEARCH_RET_OK, and centrality is updated
+ * * ::YADSL_GRAPHSEARCH_RET_MEMORY
+*/
+yadsl_GraphSearchRet
+yadsl_graphsearch_betweenness_sampled(
+	yadsl_GraphHandle* graph,
+	size_t sample_count,
+	unsigned long seed,
+	double* centrality);
+
+/**
+ * @brief Estimate the betweenness centrality of every vertex of a
+ * mapped graph file
+ *
+ * Same as ::yadsl_graphsearch_betweenness_sampled, but reads the
+ * neighbour lists in place.
+ *
+ * @param mapped mapped graph handle
+ * @param sample_count number of source vertices
+ * @param seed seed of the sample
+ * @param centrality estimated betweenness of each vertex (by id)
+ * @return
+ * * ::YADSL_GRAPHSEARCH_RET_OK, and centrality is updated
+ * * ::YADSL_GRAPHSEARCH_RET_CORRUPTED_FILE_FORMAT
+ * * ::YADSL_GRAPHSEARCH_RET_MEMORY
+*/
+yadsl_GraphSearchRet
+yadsl_graphsearch_betweenness_sampled_mapped(
+	yadsl_GraphIoMappedHandle* mapped,
+	size_t sample_count,
+	unsigned long seed,
+	double* centrality);
+
 #ifdef YADSL_DEBUG
 
 /**
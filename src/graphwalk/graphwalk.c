@@ -0,0 +1,376 @@
+#include <graphwalk/graphwalk.h>
+
+#include <assert.h>
+#include <stdint.h>
+
+#ifdef YADSL_DEBUG
+#include <memdb/memdb.h>
+#else
+#include <stdlib.h>
+#endif
+
+/*******************************************************************************
+* Graph walker data structure invariants
+********************************************************************************
+*
+* I) The neighbours of vertex u span the positions offsets[u] (inclusive)
+* to offsets[u + 1] (exclusive) of targets, sorted by id.
+*
+* II) On weighted walkers, position i of a row is picked with probability
+* (probabilities[i] + sum of (1 - probabilities[j]) for every j of the same
+* row such that aliases[j] = i) / d, which is its weight divided by the
+* total weight of the row (alias method).
+*
+* III) On unweighted walkers, probabilities and aliases are NULL.
+*
+*******************************************************************************/
+
+typedef struct
+{
+	size_t vertex_count; /**< number of vertices */
+	size_t* offsets; /**< start of each row (vertex_count + 1 entries) */
+	size_t* targets; /**< neighbours of every row */
+	double* probabilities; /**< alias table probabilities (or NULL) */
+	size_t* aliases; /**< alias table aliases, relative to row (or NULL) */
+}
+yadsl_GraphWalk;
+
+#define cast_(walker) yadsl_GraphWalk* walker ## _ = (yadsl_GraphWalk*) walker
+
+/**********************************/
+/*  Private functions prototypes  */
+/**********************************/
+
+static bool yadsl_graphwalk_alias_tables_build_internal(
+	yadsl_GraphWalk* walker,
+	const double* weights);
+
+static uint64_t yadsl_graphwalk_random_internal(
+	uint64_t* state_ptr);
+
+static double yadsl_graphwalk_random_double_internal(
+	uint64_t* state_ptr);
+
+static size_t yadsl_graphwalk_neighbour_sample_internal(
+	yadsl_GraphWalk* walker,
+	size_t v,
+	uint64_t* state_ptr);
+
+static bool yadsl_graphwalk_neighbour_check_internal(
+	yadsl_GraphWalk* walker,
+	size_t u,
+	size_t v);
+
+/**********************/
+/*  Public functions  */
+/**********************/
+
+yadsl_GraphWalkRet yadsl_graphwalk_create(
+	yadsl_GraphHandle* graph,
+	bool is_weighted,
+	yadsl_GraphWalkHandle** walker_ptr)
+{
+	yadsl_GraphWalk* walker;
+	yadsl_GraphEdgeWeightType weight_type;
+	yadsl_GraphEdgeWeight weight;
+	size_t vertex_count, edge_count, entry_count = 0, id, u, v, i, j;
+	size_t* sources = NULL, * targets = NULL, * counts = NULL;
+	double* weights = NULL, * sorted_weights = NULL, w;
+	yadsl_GraphWalkRet ret = YADSL_GRAPHWALK_RET_MEMORY;
+	bool is_directed;
+	if (yadsl_graph_vertex_count_get(graph, &vertex_count)) assert(0);
+	if (yadsl_graph_edge_count_get(graph, &edge_count)) assert(0);
+	if (yadsl_graph_is_directed_check(graph, &is_directed)) assert(0);
+	if (yadsl_graph_edge_weight_type_get(graph, &weight_type)) assert(0);
+	if (is_weighted && weight_type == YADSL_GRAPH_EDGE_WEIGHT_TYPE_NONE)
+		return YADSL_GRAPHWALK_RET_PARAMETER;
+	for (id = 0; id < edge_count; ++id) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+		if (is_weighted && !(yadsl_graph_edge_weight_to_double(weight_type, weight) > 0.0))
+			return YADSL_GRAPHWALK_RET_PARAMETER;
+		entry_count += (is_directed || u == v) ? 1 : 2;
+	}
+	if (!(walker = malloc(sizeof(*walker))))
+		return YADSL_GRAPHWALK_RET_MEMORY;
+	walker->vertex_count = vertex_count;
+	walker->targets = NULL;
+	walker->probabilities = NULL;
+	walker->aliases = NULL;
+	if (!(walker->offsets = malloc((vertex_count + 1) * sizeof(*walker->offsets))))
+		goto exit;
+	if (!(counts = malloc((vertex_count + 1) * sizeof(*counts))))
+		goto exit;
+	if (entry_count > 0) {
+		if (!(sources = malloc(entry_count * sizeof(*sources))))
+			goto exit;
+		if (!(targets = malloc(entry_count * sizeof(*targets))))
+			goto exit;
+		if (!(walker->targets = malloc(entry_count * sizeof(*walker->targets))))
+			goto exit;
+		if (is_weighted) {
+			if (!(weights = malloc(entry_count * sizeof(*weights))))
+				goto exit;
+			if (!(sorted_weights = malloc(entry_count * sizeof(*sorted_weights))))
+				goto exit;
+		}
+	}
+	/* Sort entries by target, and then (stably) by source */
+	for (u = 0; u <= vertex_count; ++u)
+		counts[u] = walker->offsets[u] = 0;
+	for (id = 0; id < edge_count; ++id) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+		++counts[v + 1];
+		++walker->offsets[u + 1];
+		if (!is_directed && u != v) {
+			++counts[u + 1];
+			++walker->offsets[v + 1];
+		}
+	}
+	for (u = 0; u < vertex_count; ++u) {
+		counts[u + 1] += counts[u];
+		walker->offsets[u + 1] += walker->offsets[u];
+	}
+	for (id = 0; id < edge_count; ++id) {
+		if (yadsl_graph_edge_endpoint_ids_get(graph, id, &u, &v, &weight)) assert(0);
+		w = is_weighted ? yadsl_graph_edge_weight_to_double(weight_type, weight) : 0.0;
+		i = counts[v]++;
+		sources[i] = u;
+		targets[i] = v;
+		if (is_weighted)
+			weights[i] = w;
+		if (!is_directed && u != v) {
+			i = counts[u]++;
+			sources[i] = v;
+			targets[i] = u;
+			if (is_weighted)
+				weights[i] = w;
+		}
+	}
+	for (u = 0; u < vertex_count; ++u)
+		counts[u] = walker->offsets[u];
+	for (i = 0; i < entry_count; ++i) {
+		j = counts[sources[i]]++;
+		walker->targets[j] = targets[i];
+		if (is_weighted)
+			sorted_weights[j] = weights[i];
+	}
+	if (is_weighted && entry_count > 0)
+		if (!yadsl_graphwalk_alias_tables_build_internal(walker, sorted_weights))
+			goto exit;
+	*walker_ptr = walker;
+	walker = NULL;
+	ret = YADSL_GRAPHWALK_RET_OK;
+exit:
+	if (sorted_weights)
+		free(sorted_weights);
+	if (weights)
+		free(weights);
+	if (targets)
+		free(targets);
+	if (sources)
+		free(sources);
+	if (counts)
+		free(counts);
+	if (walker)
+		yadsl_graphwalk_destroy(walker);
+	return ret;
+}
+
+yadsl_GraphWalkRet yadsl_graphwalk_walk(
+	yadsl_GraphWalkHandle* walker,
+	const yadsl_GraphWalkParams* params,
+	size_t start,
+	size_t index,
+	size_t* walk)
+{
+	cast_(walker);
+	uint64_t state;
+	double max_bias, bias;
+	size_t i, previous, v, x;
+	bool is_biased;
+	if (start >= walker_->vertex_count || !(params->p > 0.0) || !(params->q > 0.0))
+		return YADSL_GRAPHWALK_RET_PARAMETER;
+	if (params->walk_length == 0)
+		return YADSL_GRAPHWALK_RET_OK;
+	/* Every walk has its own generator */
+	state = (uint64_t) params->seed;
+	state = yadsl_graphwalk_random_internal(&state) ^ (uint64_t) start;
+	state = yadsl_graphwalk_random_internal(&state) ^ (uint64_t) index;
+	is_biased = params->p != 1.0 || params->q != 1.0;
+	max_bias = 1.0;
+	if (1.0 / params->p > max_bias)
+		max_bias = 1.0 / params->p;
+	if (1.0 / params->q > max_bias)
+		max_bias = 1.0 / params->q;
+	walk[0] = start;
+	previous = YADSL_GRAPHWALK_NONE;
+	for (i = 1; i < params->walk_length; ++i) {
+		v = walk[i - 1];
+		if (walker_->offsets[v] == walker_->offsets[v + 1]) {
+			for (; i < params->walk_length; ++i)
+				walk[i] = YADSL_GRAPHWALK_NONE;
+			break;
+		}
+		for (;;) {
+			x = yadsl_graphwalk_neighbour_sample_internal(walker_, v, &state);
+			if (!is_biased || previous == YADSL_GRAPHWALK_NONE)
+				break;
+			if (x == previous)
+				bias = 1.0 / params->p;
+			else if (yadsl_graphwalk_neighbour_check_internal(walker_, previous, x))
+				bias = 1.0;
+			else
+				bias = 1.0 / params->q;
+			if (yadsl_graphwalk_random_double_internal(&state) * max_bias < bias)
+				break;
+		}
+		walk[i] = x;
+		previous = v;
+	}
+	return YADSL_GRAPHWALK_RET_OK;
+}
+
+yadsl_GraphWalkRet yadsl_graphwalk_walks_generate(
+	yadsl_GraphWalkHandle* walker,
+	const yadsl_GraphWalkParams* params,
+	size_t* walks)
+{
+	cast_(walker);
+	size_t n = walker_->vertex_count, i, v;
+	if (!(params->p > 0.0) || !(params->q > 0.0))
+		return YADSL_GRAPHWALK_RET_PARAMETER;
+	for (i = 0; i < params->walks_per_vertex; ++i)
+		for (v = 0; v < n; ++v)
+			if (yadsl_graphwalk_walk(walker, params, v, i, walks + (i * n + v) * params->walk_length))
+				assert(0);
+	return YADSL_GRAPHWALK_RET_OK;
+}
+
+void yadsl_graphwalk_destroy(
+	yadsl_GraphWalkHandle* walker)
+{
+	cast_(walker);
+	if (walker_ == NULL)
+		return;
+	if (walker_->offsets)
+		free(walker_->offsets);
+	if (walker_->targets)
+		free(walker_->targets);
+	if (walker_->probabilities)
+		free(walker_->probabilities);
+	if (walker_->aliases)
+		free(walker_->aliases);
+	free(walker_);
+}
+
+/**************************************/
+/*  Private functions implementation  */
+/**************************************/
+
+// Builds the alias table of every row (Vose's method)
+bool yadsl_graphwalk_alias_tables_build_internal(
+	yadsl_GraphWalk* walker,
+	const double* weights)
+{
+	size_t entry_count = walker->offsets[walker->vertex_count];
+	size_t max_degree = 0, u, i, begin, degree, small_count, large_count, l, g;
+	size_t* small, * large;
+	double* scaled, total;
+	for (u = 0; u < walker->vertex_count; ++u)
+		if (walker->offsets[u + 1] - walker->offsets[u] > max_degree)
+			max_degree = walker->offsets[u + 1] - walker->offsets[u];
+	if (!(walker->probabilities = malloc(entry_count * sizeof(*walker->probabilities))))
+		return false;
+	if (!(walker->aliases = malloc(entry_count * sizeof(*walker->aliases))))
+		return false;
+	if (!(small = malloc(max_degree * sizeof(*small))))
+		return false;
+	if (!(large = malloc(max_degree * sizeof(*large)))) {
+		free(small);
+		return false;
+	}
+	for (u = 0; u < walker->vertex_count; ++u) {
+		begin = walker->offsets[u];
+		degree = walker->offsets[u + 1] - begin;
+		scaled = walker->probabilities + begin;
+		total = 0.0;
+		for (i = 0; i < degree; ++i)
+			total += weights[begin + i];
+		small_count = large_count = 0;
+		for (i = 0; i < degree; ++i) {
+			scaled[i] = weights[begin + i] * (double) degree / total;
+			walker->aliases[begin + i] = i;
+			if (scaled[i] < 1.0)
+				small[small_count++] = i;
+			else
+				large[large_count++] = i;
+		}
+		while (small_count > 0 && large_count > 0) {
+			l = small[--small_count];
+			g = large[--large_count];
+			walker->aliases[begin + l] = g;
+			scaled[g] += scaled[l] - 1.0;
+			if (scaled[g] < 1.0)
+				small[small_count++] = g;
+			else
+				large[large_count++] = g;
+		}
+		/* Left overs (up to rounding errors) are always picked */
+		while (large_count > 0)
+			scaled[large[--large_count]] = 1.0;
+		while (small_count > 0)
+			scaled[small[--small_count]] = 1.0;
+	}
+	free(large);
+	free(small);
+	return true;
+}
+
+// splitmix64
+uint64_t yadsl_graphwalk_random_internal(
+	uint64_t* state_ptr)
+{
+	uint64_t z = (*state_ptr += UINT64_C(0x9E3779B97F4A7C15));
+	z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+	z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+	return z ^ (z >> 31);
+}
+
+// Uniform in [0, 1)
+double yadsl_graphwalk_random_double_internal(
+	uint64_t* state_ptr)
+{
+	return (double) (yadsl_graphwalk_random_internal(state_ptr) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Picks a neighbour of v (which must have at least one)
+size_t yadsl_graphwalk_neighbour_sample_internal(
+	yadsl_GraphWalk* walker,
+	size_t v,
+	uint64_t* state_ptr)
+{
+	size_t begin = walker->offsets[v];
+	size_t degree = walker->offsets[v + 1] - begin;
+	size_t i = (size_t) (yadsl_graphwalk_random_internal(state_ptr) % degree);
+	if (walker->probabilities &&
+		yadsl_graphwalk_random_double_internal(state_ptr) >= walker->probabilities[begin + i])
+		i = walker->aliases[begin + i];
+	return walker->targets[begin + i];
+}
+
+// Whether v is a neighbour of u (binary search)
+bool yadsl_graphwalk_neighbour_check_internal(
+	yadsl_GraphWalk* walker,
+	size_t u,
+	size_t v)
+{
+	size_t low = walker->offsets[u], high = walker->offsets[u + 1], middle;
+	while (low < high) {
+		middle = low + (high - low) / 2;
+		if (walker->targets[middle] < v)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return low < walker->offsets[u + 1] && walker->targets[low] == v;
+}
@@ -0,0 +1,142 @@
+#ifndef __YADSL_GRAPHWALK_H__
+#define __YADSL_GRAPHWALK_H__
+
+/**
+ * \defgroup graphwalk Graph Walk
+ * @brief Random walks over Graphs (node2vec style)
+ *
+ * A walker is a read-only copy of the neighbourhoods of a graph, with the
+ * neighbours of every vertex stored contiguously and sorted by id (see
+ * \ref graph). Walks follow edge direction on directed graphs, and may go
+ * through self-loops.
+ *
+ * Each step picks a neighbour at random, with probability proportional to
+ * the edge weight (or uniformly, on unweighted walkers), in O(1) time with
+ * alias tables. Like in node2vec, the probability of a step from v to x,
+ * coming from t, is further multiplied by a bias:
+ *
+ * | Case | Bias |
+ * | :-: | :-: |
+ * | x = t | 1 / p |
+ * | x is a neighbour of t | 1 |
+ * | otherwise | 1 / q |
+ *
+ * Biased steps are sampled by rejection, so they take O(log d) expected
+ * time when p and q are not both one.
+ *
+ * Every walk draws its numbers from its own generator, seeded from the
+ * seed, the start vertex and the walk index. Walks are thus reproducible
+ * one by one, in any order, and a walker can be shared by several threads
+ * as long as none of them destroys it.
+ *
+ * @{
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <graph/graph.h>
+
+/**
+ * @brief Return condition of Graph Walk functions
+*/
+typedef enum
+{
+	YADSL_GRAPHWALK_RET_OK = 0, /**< All went ok */
+	YADSL_GRAPHWALK_RET_MEMORY, /**< Could not allocate memory */
+	YADSL_GRAPHWALK_RET_PARAMETER, /**< Invalid parameter */
+}
+yadsl_GraphWalkRet;
+
+/**
+ * @brief Vertex id written after the end of walks that reach a vertex
+ * without neighbours
+*/
+#define YADSL_GRAPHWALK_NONE ((size_t) -1)
+
+typedef void yadsl_GraphWalkHandle; /**< Graph walker handle */
+
+/**
+ * @brief Random walk parameters
+*/
+typedef struct
+{
+	size_t walk_length; /**< number of vertices in each walk, including the start */
+	size_t walks_per_vertex; /**< number of walks from each vertex */
+	double p; /**< return parameter (must be positive) */
+	double q; /**< in-out parameter (must be positive) */
+	unsigned long seed; /**< seed of the random number generators */
+}
+yadsl_GraphWalkParams;
+
+/**
+ * @brief Create a walker from a graph
+ * @param graph graph
+ * @param is_weighted whether to pick neighbours proportionally to the
+ * inline edge weights or uniformly
+ * @param walker_ptr newly created walker
+ * @return
+ * * ::YADSL_GRAPHWALK_RET_OK, and *walker_ptr is updated
+ * * ::YADSL_GRAPHWALK_RET_PARAMETER, if is_weighted is true and graph is not
+ * weighted or has a weight that is not positive
+ * * ::YADSL_GRAPHWALK_RET_MEMORY
+ * @note The walker does not keep any reference to graph.
+ * @see yadsl_graphwalk_destroy
+*/
+yadsl_GraphWalkRet
+yadsl_graphwalk_create(
+	yadsl_GraphHandle* graph,
+	bool is_weighted,
+	yadsl_GraphWalkHandle** walker_ptr);
+
+/**
+ * @brief Generate a single walk
+ * @param walker walker
+ * @param params walk parameters (walks_per_vertex is ignored)
+ * @param start start vertex id
+ * @param index walk index, which selects the random number sequence
+ * @param walk walk_length vertex ids, padded with ::YADSL_GRAPHWALK_NONE
+ * @return
+ * * ::YADSL_GRAPHWALK_RET_OK, and walk is updated
+ * * ::YADSL_GRAPHWALK_RET_PARAMETER, if start is out of range, or p or q
+ * are not positive
+*/
+yadsl_GraphWalkRet
+yadsl_graphwalk_walk(
+	yadsl_GraphWalkHandle* walker,
+	const yadsl_GraphWalkParams* params,
+	size_t start,
+	size_t index,
+	size_t* walk);
+
+/**
+ * @brief Generate walks from every vertex
+ *
+ * Walks are written in rounds: round i holds the walk of index i from
+ * every vertex, in increasing order of id. The walk of index i from vertex
+ * v starts at position (i * n + v) * walk_length.
+ *
+ * @param walker walker
+ * @param params walk parameters
+ * @param walks walks_per_vertex * n * walk_length vertex ids
+ * @return
+ * * ::YADSL_GRAPHWALK_RET_OK, and walks is updated
+ * * ::YADSL_GRAPHWALK_RET_PARAMETER, if p or q are not positive
+*/
+yadsl_GraphWalkRet
+yadsl_graphwalk_walks_generate(
+	yadsl_GraphWalkHandle* walker,
+	const yadsl_GraphWalkParams* params,
+	size_t* walks);
+
+/**
+ * @brief Destroy a walker
+ * @param walker walker
+*/
+void
+yadsl_graphwalk_destroy(
+	yadsl_GraphWalkHandle* walker);
+
+/** @} */
+
+#endif
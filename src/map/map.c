@@ -1,8 +1,10 @@
 #include <map/map.h>
 
 #include <assert.h>
+#include <stdint.h>
 
 #include <set/set.h>
+#include <avl/avl.h>
 
 #ifdef YADSL_DEBUG
 #include <memdb/memdb.h>
@@ -10,6 +12,8 @@
 #include <stdlib.h>
 #endif
 
+#define YADSL_MAP_TABLE_MIN_CAPACITY 8
+
 typedef struct
 {
 	yadsl_MapEntryKey *key;
@@ -19,8 +23,21 @@ yadsl_MapEntry;
 
 typedef struct
 {
-	yadsl_SetHandle *entry_set;
+	yadsl_MapEntry *entry; /* NULL if slot is free */
+	size_t hash; /* Key hash, kept so that it is never recomputed */
+}
+yadsl_MapSlot;
+
+typedef struct
+{
+	yadsl_SetHandle *entry_set; /* NULL if ordered or hashed */
+	yadsl_AVLTreeHandle *entry_tree; /* NULL if not ordered */
+	yadsl_MapSlot *table; /* Open-addressing table (linear probing) */
+	size_t table_capacity; /* Number of slots in table (0 or a power of two) */
+	bool is_hashed;
+	size_t entry_count; /* Only used if ordered or hashed */
 	yadsl_MapEntryKeyCmpFunc cmp_keys_func;
+	yadsl_MapEntryKeyHashFunc hash_key_func;
 	yadsl_MapEntryFreeFunc free_entry_func;
 	yadsl_MapEntryFreeArg *cmp_keys_func_arg;
 	yadsl_MapEntryFreeArg* free_entry_arg;
@@ -59,6 +76,66 @@ yadsl_map_entry_key_compare_internal(
 	yadsl_SetItemObj* item,
 	yadsl_SetItemFilterArg* arg);
 
+static int
+yadsl_map_entry_order_compare_internal(
+	yadsl_AVLTreeObject* obj1,
+	yadsl_AVLTreeObject* obj2,
+	yadsl_AVLTreeCmpObjsArg* arg);
+
+static void
+yadsl_map_entry_free_internal(
+	yadsl_AVLTreeObject* obj);
+
+static yadsl_AVLTreeVisitObjRet*
+yadsl_map_entry_visit_free_internal(
+	yadsl_AVLTreeObject* obj,
+	yadsl_AVLTreeVisitObjArg* arg);
+
+static bool
+yadsl_map_entry_key_equal_internal(
+	yadsl_Map* map,
+	yadsl_MapEntryKey* key1,
+	yadsl_MapEntryKey* key2);
+
+static size_t
+yadsl_map_entry_key_hash_internal(
+	yadsl_Map* map,
+	yadsl_MapEntryKey* key);
+
+static size_t
+yadsl_map_table_home_internal(
+	yadsl_Map* map,
+	size_t hash);
+
+static size_t
+yadsl_map_table_find_internal(
+	yadsl_Map* map,
+	yadsl_MapEntryKey* key,
+	size_t hash);
+
+static yadsl_MapRet
+yadsl_map_table_reserve_internal(
+	yadsl_Map* map,
+	size_t count);
+
+static void
+yadsl_map_table_insert_internal(
+	yadsl_Map* map,
+	yadsl_MapEntry* entry,
+	size_t hash);
+
+static void
+yadsl_map_table_remove_internal(
+	yadsl_Map* map,
+	size_t i);
+
+static yadsl_MapRet
+yadsl_map_entry_bound_get_internal(
+	yadsl_MapHandle* map,
+	yadsl_MapEntryKey* key,
+	bool is_strict,
+	yadsl_MapEntry** entry_ptr);
+
 static yadsl_MapRet
 yadsl_map_entry_get_internal(
 	yadsl_MapHandle *map,
@@ -81,7 +158,13 @@ yadsl_map_create(
 	if (!(map->entry_set = yadsl_set_create()))
 		goto fail2;
 
+	map->entry_tree = NULL;
+	map->table = NULL;
+	map->table_capacity = 0;
+	map->is_hashed = false;
+	map->entry_count = 0;
 	map->cmp_keys_func = cmp_keys_func;
+	map->hash_key_func = NULL;
 	map->free_entry_func = free_entry_func;
 	map->cmp_keys_func_arg = cmp_keys_func_arg;
 	map->free_entry_arg = free_entry_arg;
@@ -93,6 +176,69 @@ fail1:
 	return NULL;
 }
 
+yadsl_MapHandle*
+yadsl_map_create_ordered(
+	yadsl_MapEntryKeyCmpFunc cmp_keys_func,
+	yadsl_MapEntryFreeFunc free_entry_func,
+	yadsl_MapEntryFreeArg* cmp_keys_func_arg,
+	yadsl_MapEntryFreeArg* free_entry_arg)
+{
+	yadsl_Map *map = malloc(sizeof(*map));
+	if (!map)
+		goto fail1;
+
+	if (!(map->entry_tree = yadsl_avltree_tree_create(
+		yadsl_map_entry_order_compare_internal,
+		map,
+		yadsl_map_entry_free_internal)))
+		goto fail2;
+
+	map->entry_set = NULL;
+	map->table = NULL;
+	map->table_capacity = 0;
+	map->is_hashed = false;
+	map->entry_count = 0;
+	map->cmp_keys_func = cmp_keys_func;
+	map->hash_key_func = NULL;
+	map->free_entry_func = free_entry_func;
+	map->cmp_keys_func_arg = cmp_keys_func_arg;
+	map->free_entry_arg = free_entry_arg;
+
+	return map;
+fail2:
+	free(map);
+fail1:
+	return NULL;
+}
+
+yadsl_MapHandle*
+yadsl_map_create_hashed(
+	yadsl_MapEntryKeyCmpFunc cmp_keys_func,
+	yadsl_MapEntryKeyHashFunc hash_key_func,
+	yadsl_MapEntryFreeFunc free_entry_func,
+	yadsl_MapEntryFreeArg* cmp_keys_func_arg,
+	yadsl_MapEntryFreeArg* free_entry_arg)
+{
+	yadsl_Map *map = malloc(sizeof(*map));
+	if (!map)
+		return NULL;
+
+	/* The table is only allocated on the first entry */
+	map->entry_set = NULL;
+	map->entry_tree = NULL;
+	map->table = NULL;
+	map->table_capacity = 0;
+	map->is_hashed = true;
+	map->entry_count = 0;
+	map->cmp_keys_func = cmp_keys_func;
+	map->hash_key_func = hash_key_func;
+	map->free_entry_func = free_entry_func;
+	map->cmp_keys_func_arg = cmp_keys_func_arg;
+	map->free_entry_arg = free_entry_arg;
+
+	return map;
+}
+
 yadsl_MapRet
 yadsl_map_entry_add(
 	yadsl_MapHandle* map,
@@ -119,6 +265,27 @@ yadsl_map_entry_add(
 	if (!(entry = yadsl_map_entry_create_internal(key, value)))
 		return YADSL_MAP_RET_MEMORY;
 
+	if (((yadsl_Map*) map)->is_hashed) {
+		yadsl_Map* map_ = (yadsl_Map*) map;
+		if (yadsl_map_table_reserve_internal(map_, map_->entry_count + 1)) {
+			free(entry);
+			return YADSL_MAP_RET_MEMORY;
+		}
+		yadsl_map_table_insert_internal(map_, entry,
+			yadsl_map_entry_key_hash_internal(map_, key));
+		++map_->entry_count;
+		return YADSL_MAP_RET_OK;
+	}
+
+	if (((yadsl_Map*) map)->entry_tree) {
+		if (yadsl_avltree_object_insert(((yadsl_Map*) map)->entry_tree, entry, NULL)) {
+			free(entry);
+			return YADSL_MAP_RET_MEMORY;
+		}
+		++((yadsl_Map*) map)->entry_count;
+		return YADSL_MAP_RET_OK;
+	}
+
 	if (set_ret = yadsl_set_item_add(((yadsl_Map*) map)->entry_set, entry)) {
 		free(entry);
 		assert(set_ret == YADSL_SET_RET_MEMORY);
@@ -157,16 +324,39 @@ yadsl_map_entry_remove(
 	yadsl_MapEntryKey *temp_key;
 	yadsl_MapEntryValue *temp_value;
 
+	if (((yadsl_Map*) map)->is_hashed) {
+		yadsl_Map* map_ = (yadsl_Map*) map;
+		size_t i = yadsl_map_table_find_internal(map_, key,
+			yadsl_map_entry_key_hash_internal(map_, key));
+		if (i == map_->table_capacity)
+			return YADSL_MAP_RET_ENTRY_NOT_FOUND;
+		entry = map_->table[i].entry;
+		yadsl_map_table_remove_internal(map_, i);
+		--map_->entry_count;
+		*original_key_ptr = entry->key;
+		*value_ptr = entry->value;
+		free(entry);
+		return YADSL_MAP_RET_OK;
+	}
+
 	if (map_ret = yadsl_map_entry_get_internal(map, key, &entry))
 		return map_ret;
 
 	temp_key = entry->key;
 	temp_value = entry->value;
 
-	if (yadsl_set_item_remove(((yadsl_Map*) map)->entry_set, entry))
-		assert(0);
-
-	free(entry);
+	if (((yadsl_Map*) map)->entry_tree) {
+		/* The entry is freed by yadsl_map_entry_free_internal */
+		bool exists;
+		if (yadsl_avltree_object_remove(((yadsl_Map*) map)->entry_tree, entry, &exists))
+			assert(0);
+		assert(exists);
+		--((yadsl_Map*) map)->entry_count;
+	} else {
+		if (yadsl_set_item_remove(((yadsl_Map*) map)->entry_set, entry))
+			assert(0);
+		free(entry);
+	}
 
 	*original_key_ptr = temp_key;
 	*value_ptr = temp_value;
@@ -174,12 +364,54 @@ yadsl_map_entry_remove(
 	return YADSL_MAP_RET_OK;
 }
 
+yadsl_MapRet
+yadsl_map_entry_lower_bound_get(
+	yadsl_MapHandle* map,
+	yadsl_MapEntryKey* key,
+	yadsl_MapEntryKey** key_ptr,
+	yadsl_MapEntryValue** value_ptr)
+{
+	yadsl_MapRet map_ret;
+	yadsl_MapEntry *entry;
+
+	if (map_ret = yadsl_map_entry_bound_get_internal(map, key, false, &entry))
+		return map_ret;
+
+	*key_ptr = entry->key;
+	*value_ptr = entry->value;
+
+	return YADSL_MAP_RET_OK;
+}
+
+yadsl_MapRet
+yadsl_map_entry_upper_bound_get(
+	yadsl_MapHandle* map,
+	yadsl_MapEntryKey* key,
+	yadsl_MapEntryKey** key_ptr,
+	yadsl_MapEntryValue** value_ptr)
+{
+	yadsl_MapRet map_ret;
+	yadsl_MapEntry *entry;
+
+	if (map_ret = yadsl_map_entry_bound_get_internal(map, key, true, &entry))
+		return map_ret;
+
+	*key_ptr = entry->key;
+	*value_ptr = entry->value;
+
+	return YADSL_MAP_RET_OK;
+}
+
 yadsl_MapRet
 yadsl_map_entry_count_get(
 	yadsl_MapHandle* map,
 	size_t* count_ptr)
 {
 	size_t count;
+	if (((yadsl_Map*) map)->entry_set == NULL) {
+		*count_ptr = ((yadsl_Map*) map)->entry_count;
+		return YADSL_MAP_RET_OK;
+	}
 	if (yadsl_set_size_get(((yadsl_Map*) map)->entry_set, &count))
 		assert(0);
 	*count_ptr = count;
@@ -196,6 +428,34 @@ yadsl_map_destroy(
 	if (map_ == NULL)
 		return;
 
+	if (map_->is_hashed) {
+		size_t i;
+		for (i = 0; i < map_->table_capacity; ++i) {
+			yadsl_MapEntry* entry = map_->table[i].entry;
+			if (entry == NULL)
+				continue;
+			if (map_->free_entry_func)
+				map_->free_entry_func(entry->key, entry->value, map_->free_entry_arg);
+			free(entry);
+		}
+		if (map_->table)
+			free(map_->table);
+		free(map_);
+		return;
+	}
+
+	if (map_->entry_tree) {
+		yadsl_avltree_tree_traverse(
+			map_->entry_tree,
+			YADSL_AVLTREE_VISITING_IN_ORDER,
+			yadsl_map_entry_visit_free_internal,
+			map_,
+			NULL);
+		yadsl_avltree_destroy(map_->entry_tree);
+		free(map_);
+		return;
+	}
+
 	cmp_keys_func_arg.func = map_->free_entry_func;
 	cmp_keys_func_arg.arg = map_->free_entry_arg;
 	yadsl_set_destroy(
@@ -233,6 +493,200 @@ yadsl_map_entry_key_compare_internal(
 		return entry->key == par->key;
 }
 
+int
+yadsl_map_entry_order_compare_internal(
+	yadsl_AVLTreeObject* obj1,
+	yadsl_AVLTreeObject* obj2,
+	yadsl_AVLTreeCmpObjsArg* arg)
+{
+	yadsl_MapEntry* entry1 = (yadsl_MapEntry*) obj1;
+	yadsl_MapEntry* entry2 = (yadsl_MapEntry*) obj2;
+	yadsl_Map* map = (yadsl_Map*) arg;
+	if (map->cmp_keys_func)
+		return map->cmp_keys_func(entry1->key, entry2->key, map->cmp_keys_func_arg);
+	else
+		return entry1->key < entry2->key ? -1 : entry1->key > entry2->key;
+}
+
+void
+yadsl_map_entry_free_internal(
+	yadsl_AVLTreeObject* obj)
+{
+	free(obj);
+}
+
+yadsl_AVLTreeVisitObjRet*
+yadsl_map_entry_visit_free_internal(
+	yadsl_AVLTreeObject* obj,
+	yadsl_AVLTreeVisitObjArg* arg)
+{
+	yadsl_MapEntry* entry = (yadsl_MapEntry*) obj;
+	yadsl_Map* map = (yadsl_Map*) arg;
+	if (map->free_entry_func)
+		map->free_entry_func(entry->key, entry->value, map->free_entry_arg);
+	return NULL; /* Visit all entries */
+}
+
+bool
+yadsl_map_entry_key_equal_internal(
+	yadsl_Map* map,
+	yadsl_MapEntryKey* key1,
+	yadsl_MapEntryKey* key2)
+{
+	if (map->cmp_keys_func)
+		return map->cmp_keys_func(key1, key2, map->cmp_keys_func_arg);
+	else
+		return key1 == key2;
+}
+
+size_t
+yadsl_map_entry_key_hash_internal(
+	yadsl_Map* map,
+	yadsl_MapEntryKey* key)
+{
+	if (map->hash_key_func)
+		return map->hash_key_func(key, map->cmp_keys_func_arg);
+	else
+		return (size_t) (uintptr_t) key;
+}
+
+/* Maps key hash to its home slot in the table, mixing
+ * the hash so that weak user hashes still spread out */
+size_t
+yadsl_map_table_home_internal(
+	yadsl_Map* map,
+	size_t hash)
+{
+	uint64_t h = (uint64_t) hash;
+	h *= 0x9E3779B97F4A7C15ULL; /* Fibonacci hashing */
+	h ^= h >> 32;
+	return (size_t) h & (map->table_capacity - 1);
+}
+
+/* Returns the slot of the entry with key, or the table
+ * capacity if there is no such entry */
+size_t
+yadsl_map_table_find_internal(
+	yadsl_Map* map,
+	yadsl_MapEntryKey* key,
+	size_t hash)
+{
+	size_t mask, i;
+	yadsl_MapSlot* slot;
+
+	if (map->table_capacity == 0)
+		return 0;
+
+	mask = map->table_capacity - 1;
+	for (i = yadsl_map_table_home_internal(map, hash);
+		(slot = &map->table[i])->entry != NULL;
+		i = (i + 1) & mask)
+		if (slot->hash == hash &&
+			yadsl_map_entry_key_equal_internal(map, slot->entry->key, key))
+			return i;
+
+	return map->table_capacity;
+}
+
+/* Makes room in the table for count entries, keeping the
+ * load factor at most 3/4 */
+yadsl_MapRet
+yadsl_map_table_reserve_internal(
+	yadsl_Map* map,
+	size_t count)
+{
+	yadsl_MapSlot* old_table = map->table;
+	size_t old_capacity = map->table_capacity, capacity, i;
+
+	if (count * 4 <= old_capacity * 3)
+		return YADSL_MAP_RET_OK;
+
+	capacity = old_capacity ? old_capacity * 2 : YADSL_MAP_TABLE_MIN_CAPACITY;
+	while (count * 4 > capacity * 3)
+		capacity *= 2;
+	map->table = calloc(capacity, sizeof(*map->table));
+	if (map->table == NULL) {
+		map->table = old_table;
+		return YADSL_MAP_RET_MEMORY;
+	}
+	map->table_capacity = capacity;
+
+	for (i = 0; i < old_capacity; ++i)
+		if (old_table[i].entry != NULL)
+			yadsl_map_table_insert_internal(map, old_table[i].entry, old_table[i].hash);
+
+	if (old_table)
+		free(old_table);
+
+	return YADSL_MAP_RET_OK;
+}
+
+/* Stores entry in the first free slot from its home slot
+ * (assumes there is at least one free slot) */
+void
+yadsl_map_table_insert_internal(
+	yadsl_Map* map,
+	yadsl_MapEntry* entry,
+	size_t hash)
+{
+	size_t mask = map->table_capacity - 1;
+	size_t i = yadsl_map_table_home_internal(map, hash);
+	while (map->table[i].entry != NULL)
+		i = (i + 1) & mask;
+	map->table[i].entry = entry;
+	map->table[i].hash = hash;
+}
+
+/* Frees slot i by shifting back the entries of the
+ * same cluster, so that no tombstones are needed */
+void
+yadsl_map_table_remove_internal(
+	yadsl_Map* map,
+	size_t i)
+{
+	size_t mask = map->table_capacity - 1, j;
+	for (j = (i + 1) & mask; map->table[j].entry != NULL; j = (j + 1) & mask) {
+		size_t home = yadsl_map_table_home_internal(map, map->table[j].hash);
+		/* move entry at j to the hole at i if its home slot
+		 * does not lie cyclically in (i, j] */
+		if (((j - home) & mask) >= ((j - i) & mask)) {
+			map->table[i] = map->table[j];
+			i = j;
+		}
+	}
+	map->table[i].entry = NULL;
+}
+
+yadsl_MapRet
+yadsl_map_entry_bound_get_internal(
+	yadsl_MapHandle* map,
+	yadsl_MapEntryKey* key,
+	bool is_strict,
+	yadsl_MapEntry** entry_ptr)
+{
+	yadsl_Map* map_ = (yadsl_Map*) map;
+	yadsl_MapEntry probe;
+	bool exists;
+
+	if (map_->entry_tree == NULL)
+		return YADSL_MAP_RET_UNORDERED;
+
+	probe.key = key;
+	probe.value = NULL;
+
+	if (is_strict) {
+		if (yadsl_avltree_object_upper_bound(map_->entry_tree,
+			&probe, &exists, (yadsl_AVLTreeObject**) entry_ptr))
+			assert(0);
+	} else {
+		if (yadsl_avltree_object_lower_bound(map_->entry_tree,
+			&probe, &exists, (yadsl_AVLTreeObject**) entry_ptr))
+			assert(0);
+	}
+
+	return exists ? YADSL_MAP_RET_OK : YADSL_MAP_RET_ENTRY_NOT_FOUND;
+}
+
 yadsl_MapRet
 yadsl_map_entry_get_internal(
 	yadsl_MapHandle* map,
@@ -243,6 +697,25 @@ yadsl_map_entry_get_internal(
 	yadsl_Map* map_ = (yadsl_Map*) map;
 	yadsl_MapCmpEntryKeyParameter cmp_keys_func_arg;
 
+	if (map_->is_hashed) {
+		size_t i = yadsl_map_table_find_internal(map_, key,
+			yadsl_map_entry_key_hash_internal(map_, key));
+		if (i == map_->table_capacity)
+			return YADSL_MAP_RET_ENTRY_NOT_FOUND;
+		*entry_ptr = map_->table[i].entry;
+		return YADSL_MAP_RET_OK;
+	}
+
+	if (map_->entry_tree) {
+		yadsl_MapEntry probe;
+		probe.key = key;
+		probe.value = NULL;
+		if (yadsl_map_entry_bound_get_internal(map, key, false, entry_ptr) ||
+			yadsl_map_entry_order_compare_internal(*entry_ptr, &probe, map_))
+			return YADSL_MAP_RET_ENTRY_NOT_FOUND;
+		return YADSL_MAP_RET_OK;
+	}
+
 	cmp_keys_func_arg.key = key;
 	cmp_keys_func_arg.func = map_->cmp_keys_func;
 	cmp_keys_func_arg.arg = map_->cmp_keys_func_arg;
@@ -19,6 +19,24 @@
  * are equal (!=0) or not (0). If no function is
  * given, shallow comparison will be assumed.
  *
+ * Maps created with ::yadsl_map_create store their
+ * entries in a set, and so lookups take time linear
+ * on the number of entries. Maps created with
+ * ::yadsl_map_create_ordered store their entries in
+ * an AVL tree sorted by key, and so lookups take
+ * logarithmic time. Their key comparison function
+ * must instead return the order between keys, and
+ * their entries can be iterated in key order with
+ * ::yadsl_map_entry_lower_bound_get and
+ * ::yadsl_map_entry_upper_bound_get.
+ *
+ * Maps created with ::yadsl_map_create_hashed store
+ * their entries in an open-addressing hash table, and
+ * so lookups take constant time on average. Their key
+ * comparison function returns equality, like the one
+ * given to ::yadsl_map_create, and keys that are equal
+ * must have the same hash.
+ *
  * @{
 */
 
@@ -33,6 +51,7 @@ typedef enum
 	YADSL_MAP_RET_OK = 0, /**< All went ok */
 	YADSL_MAP_RET_ENTRY_NOT_FOUND, /**< Entry could not be found */
 	YADSL_MAP_RET_MEMORY, /**< Could not allocate memory */
+	YADSL_MAP_RET_UNORDERED, /**< Map entries are not ordered */
 }
 yadsl_MapRet;
 
@@ -48,7 +67,10 @@ typedef void yadsl_MapEntryFreeArg; /**< Argument passed to yadsl_MapEntryFreeFu
  * @param key1 first object
  * @param key2 second object
  * @param cmp_keys_func_arg user argument
- * @return an integer *n*, where...
+ * @return for maps created with ::yadsl_map_create
+ * or ::yadsl_map_create_hashed, whether key1 = key2 (!=0) or not (0).
+ * For maps created with ::yadsl_map_create_ordered,
+ * an integer *n*, where...
  * * *n* > 0 if key1 > key2
  * * *n* = 0 if key1 = key2
  * * *n* < 0 if key1 < key2
@@ -59,6 +81,17 @@ typedef int
 	yadsl_MapEntryKey* key2,
 	yadsl_MapEntryKeyCmpArg* cmp_objs_arg);
 
+/**
+ * @brief Function responsible for hashing keys
+ * @param key key
+ * @param cmp_keys_func_arg key comparison function argument
+ * @return key hash (equal keys must have equal hashes)
+*/
+typedef size_t
+(*yadsl_MapEntryKeyHashFunc)(
+	yadsl_MapEntryKey* key,
+	yadsl_MapEntryKeyCmpArg* cmp_keys_func_arg);
+
 /**
  * @brief Function responsible for freeing entries
  * @param key entry key (to be freed)
@@ -86,6 +119,52 @@ yadsl_map_create(
 	yadsl_MapEntryFreeArg* cmp_keys_func_arg,
 	yadsl_MapEntryFreeArg* free_entry_arg);
 
+/**
+ * @brief Create an empty map ordered by key
+ *
+ * Entries are stored in a balanced binary search tree,
+ * so that adding, getting and removing entries take
+ * time logarithmic on the number of entries.
+ * If no key comparison function is given, keys are
+ * ordered by address.
+ *
+ * @param cmp_keys_func key comparison function (three-way)
+ * @param free_entry_func entry freeing function
+ * @param cmp_keys_func_arg key comparison function argument
+ * @param free_entry_arg entry freeing function argument
+ * @return newly created map or NULL if could not allocate memory
+*/
+yadsl_MapHandle*
+yadsl_map_create_ordered(
+	yadsl_MapEntryKeyCmpFunc cmp_keys_func,
+	yadsl_MapEntryFreeFunc free_entry_func,
+	yadsl_MapEntryFreeArg* cmp_keys_func_arg,
+	yadsl_MapEntryFreeArg* free_entry_arg);
+
+/**
+ * @brief Create an empty map indexed by key hash
+ *
+ * Entries are stored in an open-addressing hash table
+ * with linear probing, so that adding, getting and
+ * removing entries take constant time on average.
+ * If no key hashing function is given, keys are
+ * hashed by address (which matches shallow comparison).
+ *
+ * @param cmp_keys_func key comparison function (equality)
+ * @param hash_key_func key hashing function
+ * @param free_entry_func entry freeing function
+ * @param cmp_keys_func_arg argument passed to cmp_keys_func and hash_key_func
+ * @param free_entry_arg entry freeing function argument
+ * @return newly created map or NULL if could not allocate memory
+*/
+yadsl_MapHandle*
+yadsl_map_create_hashed(
+	yadsl_MapEntryKeyCmpFunc cmp_keys_func,
+	yadsl_MapEntryKeyHashFunc hash_key_func,
+	yadsl_MapEntryFreeFunc free_entry_func,
+	yadsl_MapEntryFreeArg* cmp_keys_func_arg,
+	yadsl_MapEntryFreeArg* free_entry_arg);
+
 /**
  * @brief Add or overwrite entry
  * @param map map
@@ -138,6 +217,54 @@ yadsl_map_entry_remove(
 	yadsl_MapEntryKey** original_key_ptr,
 	yadsl_MapEntryValue** value_ptr);
 
+/**
+ * @brief Get entry with lowest key not less than a given key
+ *
+ * Iterating over the entries with keys in [lo, hi]
+ * can be done as follows:
+ * @code
+ * void *k, *v;
+ * yadsl_MapRet ret = yadsl_map_entry_lower_bound_get(map, lo, &k, &v);
+ * while (ret == YADSL_MAP_RET_OK && cmp(k, hi, arg) <= 0) {
+ *     visit(k, v);
+ *     ret = yadsl_map_entry_upper_bound_get(map, k, &k, &v);
+ * }
+ * @endcode
+ *
+ * @param map map created with ::yadsl_map_create_ordered
+ * @param key key to be compared with (always owned by the caller)
+ * @param key_ptr entry key (always owned by the map)
+ * @param value_ptr entry value (always owned by the map)
+ * @return
+ * * ::YADSL_MAP_RET_OK, and *key_ptr and *value_ptr are updated
+ * * ::YADSL_MAP_RET_ENTRY_NOT_FOUND
+ * * ::YADSL_MAP_RET_UNORDERED
+*/
+yadsl_MapRet
+yadsl_map_entry_lower_bound_get(
+	yadsl_MapHandle* map,
+	yadsl_MapEntryKey* key,
+	yadsl_MapEntryKey** key_ptr,
+	yadsl_MapEntryValue** value_ptr);
+
+/**
+ * @brief Get entry with lowest key greater than a given key
+ * @param map map created with ::yadsl_map_create_ordered
+ * @param key key to be compared with (always owned by the caller)
+ * @param key_ptr entry key (always owned by the map)
+ * @param value_ptr entry value (always owned by the map)
+ * @return
+ * * ::YADSL_MAP_RET_OK, and *key_ptr and *value_ptr are updated
+ * * ::YADSL_MAP_RET_ENTRY_NOT_FOUND
+ * * ::YADSL_MAP_RET_UNORDERED
+*/
+yadsl_MapRet
+yadsl_map_entry_upper_bound_get(
+	yadsl_MapHandle* map,
+	yadsl_MapEntryKey* key,
+	yadsl_MapEntryKey** key_ptr,
+	yadsl_MapEntryValue** value_ptr);
+
 /**
  * @brief Get number of entries in map
  * @param map map
@@ -17,10 +17,20 @@ const char *yadsl_tester_help_strings[] = {
 	"/get <key> <expected value>   obtain the value assigned to key K",
 	"/remove <key>                 remove entry of key K",
 	"/nentries <expected value>    obtain number of entries",
+	"/ordered                      replace map by an empty one ordered by key",
+	"/hashed                       replace map by an empty one hashed by key",
+	"                              (only the first character is hashed, so",
+	"                              that keys collide often)",
+	"/lowerbound <key> <expected>  obtain the lowest key not less than K",
+	"/upperbound <key> <expected>  obtain the lowest key greater than K",
+	"/range <lo> <hi> <expected>   obtain the keys in [lo, hi], separated by",
+	"                              spaces",
 	NULL, /* Sentinel */
 };
 
 static int cmp_keys_func(void *a, void *b, void *arg);
+static int cmp_keys_order_func(void *a, void *b, void *arg);
+static size_t hash_key_func(void *a, void *arg);
 static void free_entry_func(void *k, void *v, void *arg);
 
 yadsl_TesterRet convertReturn(yadsl_MapRet mapId)
@@ -32,13 +42,15 @@ yadsl_TesterRet convertReturn(yadsl_MapRet mapId)
 		return yadsl_tester_return_external_value("noentry");
 	case YADSL_MAP_RET_MEMORY:
 		return YADSL_TESTER_RET_MALLOC;
+	case YADSL_MAP_RET_UNORDERED:
+		return yadsl_tester_return_external_value("unordered");
 	default:
 		return yadsl_tester_return_external_value("unknown");
 	}
 }
 
 static yadsl_MapHandle *pMap;
-static char key[BUFSIZ], value[BUFSIZ], yn[BUFSIZ];
+static char key[BUFSIZ], value[BUFSIZ], yn[BUFSIZ], buffer[BUFSIZ];
 
 yadsl_TesterRet yadsl_tester_init()
 {
@@ -109,6 +121,54 @@ yadsl_TesterRet yadsl_tester_parse(const char *command)
 		mapId = yadsl_map_entry_count_get(pMap, &actual);
 		if (mapId == YADSL_MAP_RET_OK && actual != expected)
 			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "ordered")) {
+		yadsl_MapHandle *temp;
+		if ((temp = yadsl_map_create_ordered(cmp_keys_order_func, free_entry_func, NULL, NULL)) == NULL)
+			return YADSL_TESTER_RET_MALLOC;
+		yadsl_map_destroy(pMap);
+		pMap = temp;
+		mapId = YADSL_MAP_RET_OK;
+	} else if (yadsl_testerutils_match(command, "hashed")) {
+		yadsl_MapHandle *temp;
+		if ((temp = yadsl_map_create_hashed(cmp_keys_func, hash_key_func, free_entry_func, NULL, NULL)) == NULL)
+			return YADSL_TESTER_RET_MALLOC;
+		yadsl_map_destroy(pMap);
+		pMap = temp;
+		mapId = YADSL_MAP_RET_OK;
+	} else if (yadsl_testerutils_match(command, "lowerbound") ||
+		yadsl_testerutils_match(command, "upperbound")) {
+		char *keyStr, *valStr;
+		if (yadsl_tester_parse_arguments("ss", key, value) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		if (yadsl_testerutils_match(command, "lowerbound"))
+			mapId = yadsl_map_entry_lower_bound_get(pMap, key,
+				(yadsl_MapEntryKey**) &keyStr, (yadsl_MapEntryValue**) &valStr);
+		else
+			mapId = yadsl_map_entry_upper_bound_get(pMap, key,
+				(yadsl_MapEntryKey**) &keyStr, (yadsl_MapEntryValue**) &valStr);
+		if (mapId == YADSL_MAP_RET_OK && strcmp(value, keyStr))
+			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "range")) {
+		char *keyStr, *valStr;
+		size_t length = 0;
+		if (yadsl_tester_parse_arguments("sss", key, value, yn) != 3)
+			return YADSL_TESTER_RET_ARGUMENT;
+		buffer[0] = '\0';
+		mapId = yadsl_map_entry_lower_bound_get(pMap, key,
+			(yadsl_MapEntryKey**) &keyStr, (yadsl_MapEntryValue**) &valStr);
+		while (mapId == YADSL_MAP_RET_OK && strcmp(keyStr, value) <= 0) {
+			if (length + strlen(keyStr) + 2 > sizeof(buffer))
+				return YADSL_TESTER_RET_OVERFLOW;
+			length += sprintf(buffer + length, length ? " %s" : "%s", keyStr);
+			mapId = yadsl_map_entry_upper_bound_get(pMap, keyStr,
+				(yadsl_MapEntryKey**) &keyStr, (yadsl_MapEntryValue**) &valStr);
+		}
+		if (mapId == YADSL_MAP_RET_ENTRY_NOT_FOUND)
+			mapId = YADSL_MAP_RET_OK;
+		if (mapId == YADSL_MAP_RET_OK && strcmp(buffer, yn)) {
+			yadsl_tester_log("Keys in range are \"%s\"", buffer);
+			return YADSL_TESTER_RET_RETURN;
+		}
 	} else {
 		return YADSL_TESTER_RET_COMMAND;
 	}
@@ -131,3 +191,13 @@ static int cmp_keys_func(void *a, void *b, void *arg)
 {
 	return strcmp((char *) a, (char *) b) == 0;
 }
+
+static int cmp_keys_order_func(void *a, void *b, void *arg)
+{
+	return strcmp((char *) a, (char *) b);
+}
+
+static size_t hash_key_func(void *a, void *arg)
+{
+	return (size_t) ((unsigned char *) a)[0];
+}
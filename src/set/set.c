@@ -1,5 +1,7 @@
 #include <set/set.h>
 
+#include <stdint.h>
+
 #ifdef YADSL_DEBUG
 #include <memdb/memdb.h>
 #else
@@ -15,6 +17,14 @@ struct yadsl_SetItem_s
 
 typedef struct yadsl_SetItem_s yadsl_SetItem;
 
+struct yadsl_SetSlab_s
+{
+	struct yadsl_SetSlab_s* next;
+	yadsl_SetItem items[]; /* Nodes handed out through the free list */
+};
+
+typedef struct yadsl_SetSlab_s yadsl_SetSlab;
+
 typedef struct
 {
 	yadsl_SetItem* external_cursor;
@@ -22,9 +32,18 @@ typedef struct
 	yadsl_SetItem* first;
 	yadsl_SetItem* last;
 	size_t size;
+	bool is_hashed; /* Items are kept in insertion order and indexed by table */
+	yadsl_SetItem** table; /* Open-addressing table of nodes (linear probing) */
+	size_t table_capacity; /* Number of slots in table (0 or a power of two) */
+	yadsl_SetSlab* slabs; /* Blocks of nodes, freed only on destruction */
+	yadsl_SetItem* free_items; /* Unused nodes, linked through next */
+	size_t free_count; /* Number of unused nodes */
 }
 yadsl_Set;
 
+#define YADSL_SET_TABLE_MIN_CAPACITY 8
+#define YADSL_SET_SLAB_MAX_COUNT 4096
+
 
 // Private functions prototypes
 
@@ -34,6 +53,66 @@ yadsl_set_item_contains_check_internal(
 	void* item,
 	yadsl_SetItem** set_item_ptr);
 
+static void
+yadsl_set_item_unlink_internal(
+	yadsl_Set* set,
+	yadsl_SetItem* p);
+
+static yadsl_SetRet
+yadsl_set_item_link_internal(
+	yadsl_Set* set,
+	yadsl_SetItemObj* item,
+	yadsl_SetItem* next);
+
+static yadsl_SetRet
+yadsl_set_items_merge_internal(
+	yadsl_Set* set,
+	yadsl_SetItemObj** items,
+	size_t count);
+
+static yadsl_SetRet
+yadsl_set_items_sorted_get_internal(
+	yadsl_Set* set,
+	yadsl_SetItemObj*** items_ptr);
+
+static yadsl_Set*
+yadsl_set_copy_internal(
+	yadsl_Set* set);
+
+static int
+yadsl_set_address_compare_internal(
+	const void* a,
+	const void* b);
+
+static yadsl_SetRet
+yadsl_set_slab_add_internal(
+	yadsl_Set* set,
+	size_t count);
+
+static yadsl_SetItem*
+yadsl_set_node_acquire_internal(
+	yadsl_Set* set);
+
+static size_t
+yadsl_set_item_hash_internal(
+	yadsl_Set* set,
+	void* item);
+
+static yadsl_SetRet
+yadsl_set_table_reserve_internal(
+	yadsl_Set* set,
+	size_t count);
+
+static void
+yadsl_set_table_insert_internal(
+	yadsl_Set* set,
+	yadsl_SetItem* p);
+
+static void
+yadsl_set_table_remove_internal(
+	yadsl_Set* set,
+	yadsl_SetItem* p);
+
 // Public functions
 
 yadsl_SetHandle*
@@ -46,10 +125,25 @@ yadsl_set_create()
 		set->first = NULL;
 		set->last = NULL;
 		set->size = 0;
+		set->is_hashed = false;
+		set->table = NULL;
+		set->table_capacity = 0;
+		set->slabs = NULL;
+		set->free_items = NULL;
+		set->free_count = 0;
 	}
 	return set;
 }
 
+yadsl_SetHandle*
+yadsl_set_create_hashed()
+{
+	yadsl_Set* set = yadsl_set_create();
+	if (set)
+		set->is_hashed = true;
+	return set;
+}
+
 yadsl_SetRet
 yadsl_set_item_contains_check(
 	yadsl_SetHandle* set,
@@ -86,6 +180,16 @@ yadsl_SetRet
 yadsl_set_item_add(
 	yadsl_SetHandle* set,
 	yadsl_SetItemObj* item)
+{
+	yadsl_SetItemHandle* handle;
+	return yadsl_set_item_handle_add(set, item, &handle);
+}
+
+yadsl_SetRet
+yadsl_set_item_handle_add(
+	yadsl_SetHandle* set,
+	yadsl_SetItemObj* item,
+	yadsl_SetItemHandle** handle_ptr)
 {
 	yadsl_SetItem* set_item, * p;
 	yadsl_Set* set_ = (yadsl_Set*) set;
@@ -93,7 +197,15 @@ yadsl_set_item_add(
 	if (yadsl_set_item_contains_check(set, item) == YADSL_SET_RET_CONTAINS)
 		return YADSL_SET_RET_CONTAINS;
 
-	set_item = malloc(sizeof(*set_item));
+	if (set_->is_hashed) {
+		// append to the insertion-ordered list
+		if (yadsl_set_item_link_internal(set_, item, NULL))
+			return YADSL_SET_RET_MEMORY;
+		*handle_ptr = set_->last;
+		return YADSL_SET_RET_OK;
+	}
+
+	set_item = yadsl_set_node_acquire_internal(set_);
 	if (set_item == NULL)
 		return YADSL_SET_RET_MEMORY;
 
@@ -147,6 +259,7 @@ yadsl_set_item_add(
 	}
 exit:
 	(set_->size)++;
+	*handle_ptr = set_item;
 
 	return YADSL_SET_RET_OK;
 }
@@ -162,27 +275,17 @@ yadsl_set_item_remove(
 	if (yadsl_set_item_contains_check_internal(set, item, &p) == YADSL_SET_RET_DOES_NOT_CONTAIN)
 		return YADSL_SET_RET_DOES_NOT_CONTAIN;
 
-	if (p->next == NULL)
-		set_->last = p->previous;
-	if (p->previous != NULL) {
-		if (p == set_->internal_cursor)
-			set_->internal_cursor = p->previous;
-		if (p == set_->external_cursor)
-			set_->external_cursor = p->previous;
-		p->previous->next = p->next;
-	} else {
-		if (p == set_->internal_cursor)
-			set_->internal_cursor = p->next;
-		if (p == set_->external_cursor)
-			set_->external_cursor = p->next;
-		set_->first = p->next;
-	}
-	if (p->next != NULL) {
-		p->next->previous = p->previous;
-	}
+	yadsl_set_item_unlink_internal(set_, p);
 
-	free(p);
-	set_->size = set_->size - 1;
+	return YADSL_SET_RET_OK;
+}
+
+yadsl_SetRet
+yadsl_set_item_handle_remove(
+	yadsl_SetHandle* set,
+	yadsl_SetItemHandle* handle)
+{
+	yadsl_set_item_unlink_internal((yadsl_Set*) set, (yadsl_SetItem*) handle);
 
 	return YADSL_SET_RET_OK;
 }
@@ -201,6 +304,33 @@ yadsl_set_cursor_get(
 	return YADSL_SET_RET_OK;
 }
 
+yadsl_SetRet
+yadsl_set_reserve(
+	yadsl_SetHandle* set,
+	size_t capacity)
+{
+	yadsl_Set* set_ = (yadsl_Set*) set;
+	size_t available = set_->size + set_->free_count;
+
+	if (set_->is_hashed && yadsl_set_table_reserve_internal(set_, capacity))
+		return YADSL_SET_RET_MEMORY;
+
+	if (capacity <= available)
+		return YADSL_SET_RET_OK;
+
+	return yadsl_set_slab_add_internal(set_, capacity - available);
+}
+
+yadsl_SetRet
+yadsl_set_capacity_get(
+	yadsl_SetHandle* set,
+	size_t* capacity_ptr)
+{
+	yadsl_Set* set_ = (yadsl_Set*) set;
+	*capacity_ptr = set_->size + set_->free_count;
+	return YADSL_SET_RET_OK;
+}
+
 yadsl_SetRet
 yadsl_set_size_get(
 	yadsl_SetHandle* set,
@@ -272,29 +402,261 @@ yadsl_set_cursor_last(
 	return YADSL_SET_RET_OK;
 }
 
+yadsl_SetRet
+yadsl_set_items_add(
+	yadsl_SetHandle* set,
+	yadsl_SetItemObj** items,
+	size_t count)
+{
+	yadsl_Set* set_ = (yadsl_Set*) set;
+	yadsl_SetItemObj** sorted_items;
+	yadsl_SetRet ret;
+	size_t i;
+
+	if (set_->is_hashed) {
+		for (i = 0; i < count; ++i)
+			if (yadsl_set_item_add(set, items[i]) == YADSL_SET_RET_MEMORY)
+				return YADSL_SET_RET_MEMORY;
+		return YADSL_SET_RET_OK;
+	}
+
+	// sort items so that they are merged in a single pass
+	sorted_items = malloc(sizeof(*sorted_items) * (count + 1));
+	if (sorted_items == NULL)
+		return YADSL_SET_RET_MEMORY;
+	for (i = 0; i < count; ++i)
+		sorted_items[i] = items[i];
+	qsort(sorted_items, count, sizeof(*sorted_items),
+		yadsl_set_address_compare_internal);
+
+	ret = yadsl_set_items_merge_internal(set_, sorted_items, count);
+	free(sorted_items);
+	return ret;
+}
+
+yadsl_SetRet
+yadsl_set_union(
+	yadsl_SetHandle* set,
+	yadsl_SetHandle* other,
+	yadsl_SetHandle** union_ptr)
+{
+	yadsl_Set* union_ = yadsl_set_copy_internal((yadsl_Set*) set);
+	if (union_ == NULL)
+		return YADSL_SET_RET_MEMORY;
+	if (yadsl_set_union_update(union_, other)) {
+		yadsl_set_destroy(union_, NULL, NULL);
+		return YADSL_SET_RET_MEMORY;
+	}
+	*union_ptr = union_;
+	return YADSL_SET_RET_OK;
+}
+
+yadsl_SetRet
+yadsl_set_union_update(
+	yadsl_SetHandle* set,
+	yadsl_SetHandle* other)
+{
+	yadsl_Set* set_ = (yadsl_Set*) set;
+	yadsl_Set* other_ = (yadsl_Set*) other;
+	yadsl_SetItemObj** items;
+	yadsl_SetItem* p;
+	yadsl_SetRet ret;
+
+	if (set_->is_hashed) {
+		for (p = other_->first; p != NULL; p = p->next)
+			if (yadsl_set_item_contains_check_internal(set, p->item, NULL) ==
+				YADSL_SET_RET_DOES_NOT_CONTAIN &&
+				yadsl_set_item_link_internal(set_, p->item, NULL))
+				return YADSL_SET_RET_MEMORY;
+		return YADSL_SET_RET_OK;
+	}
+
+	if (yadsl_set_items_sorted_get_internal(other_, &items))
+		return YADSL_SET_RET_MEMORY;
+	ret = yadsl_set_items_merge_internal(set_, items, other_->size);
+	free(items);
+	return ret;
+}
+
+yadsl_SetRet
+yadsl_set_intersection(
+	yadsl_SetHandle* set,
+	yadsl_SetHandle* other,
+	yadsl_SetHandle** intersection_ptr)
+{
+	yadsl_Set* set_ = (yadsl_Set*) set;
+	yadsl_Set* other_ = (yadsl_Set*) other;
+	yadsl_Set* intersection, * iterated, * probed;
+	yadsl_SetItem* p, * q;
+
+	intersection = set_->is_hashed ? yadsl_set_create_hashed() : yadsl_set_create();
+	if (intersection == NULL)
+		return YADSL_SET_RET_MEMORY;
+
+	if (!set_->is_hashed && !other_->is_hashed) {
+		// walk both lists in increasing order of address
+		q = other_->first;
+		for (p = set_->first; p != NULL; p = p->next) {
+			while (q != NULL && q->item < p->item)
+				q = q->next;
+			if (q != NULL && q->item == p->item &&
+				yadsl_set_item_link_internal(intersection, p->item, NULL))
+				goto fail;
+		}
+	} else {
+		// iterate through one set and probe the other, which is hashed;
+		// a list is iterated if any, so that items are appended in order,
+		// else the smaller set is iterated
+		if (!set_->is_hashed) {
+			iterated = set_;
+			probed = other_;
+		} else if (!other_->is_hashed || other_->size < set_->size) {
+			iterated = other_;
+			probed = set_;
+		} else {
+			iterated = set_;
+			probed = other_;
+		}
+		for (p = iterated->first; p != NULL; p = p->next)
+			if (yadsl_set_item_contains_check_internal(probed, p->item, NULL) ==
+				YADSL_SET_RET_CONTAINS &&
+				yadsl_set_item_link_internal(intersection, p->item, NULL))
+				goto fail;
+	}
+
+	*intersection_ptr = intersection;
+	return YADSL_SET_RET_OK;
+fail:
+	yadsl_set_destroy(intersection, NULL, NULL);
+	return YADSL_SET_RET_MEMORY;
+}
+
+yadsl_SetRet
+yadsl_set_intersection_update(
+	yadsl_SetHandle* set,
+	yadsl_SetHandle* other)
+{
+	yadsl_Set* set_ = (yadsl_Set*) set;
+	yadsl_Set* other_ = (yadsl_Set*) other;
+	yadsl_SetItemObj** items;
+	yadsl_SetItem* p, * q, * next;
+	size_t count = other_->size;
+
+	if (other_->is_hashed) {
+		for (p = set_->first; p != NULL; p = next) {
+			next = p->next;
+			if (yadsl_set_item_contains_check_internal(other, p->item, NULL) ==
+				YADSL_SET_RET_DOES_NOT_CONTAIN)
+				yadsl_set_item_unlink_internal(set_, p);
+		}
+	} else if (set_->is_hashed) {
+		// binary search the items of the other set
+		if (yadsl_set_items_sorted_get_internal(other_, &items))
+			return YADSL_SET_RET_MEMORY;
+		for (p = set_->first; p != NULL; p = next) {
+			next = p->next;
+			if (bsearch(&p->item, items, count, sizeof(*items),
+				yadsl_set_address_compare_internal) == NULL)
+				yadsl_set_item_unlink_internal(set_, p);
+		}
+		free(items);
+	} else {
+		// walk both lists in increasing order of address
+		q = other_->first;
+		for (p = set_->first; p != NULL; p = next) {
+			next = p->next;
+			while (q != NULL && q->item < p->item)
+				q = q->next;
+			if (q == NULL || q->item != p->item)
+				yadsl_set_item_unlink_internal(set_, p);
+		}
+	}
+
+	return YADSL_SET_RET_OK;
+}
+
+yadsl_SetRet
+yadsl_set_difference(
+	yadsl_SetHandle* set,
+	yadsl_SetHandle* other,
+	yadsl_SetHandle** difference_ptr)
+{
+	yadsl_Set* difference = yadsl_set_copy_internal((yadsl_Set*) set);
+	if (difference == NULL)
+		return YADSL_SET_RET_MEMORY;
+	yadsl_set_difference_update(difference, other);
+	*difference_ptr = difference;
+	return YADSL_SET_RET_OK;
+}
+
+yadsl_SetRet
+yadsl_set_difference_update(
+	yadsl_SetHandle* set,
+	yadsl_SetHandle* other)
+{
+	yadsl_Set* set_ = (yadsl_Set*) set;
+	yadsl_Set* other_ = (yadsl_Set*) other;
+	yadsl_SetItem* p, * q, * next;
+
+	if (set_->is_hashed) {
+		for (p = other_->first; p != NULL; p = next) {
+			next = p->next;
+			if (yadsl_set_item_contains_check_internal(set, p->item, &q) ==
+				YADSL_SET_RET_CONTAINS)
+				yadsl_set_item_unlink_internal(set_, q);
+		}
+	} else if (other_->is_hashed) {
+		for (p = set_->first; p != NULL; p = next) {
+			next = p->next;
+			if (yadsl_set_item_contains_check_internal(other, p->item, NULL) ==
+				YADSL_SET_RET_CONTAINS)
+				yadsl_set_item_unlink_internal(set_, p);
+		}
+	} else {
+		// walk both lists in increasing order of address
+		q = other_->first;
+		for (p = set_->first; p != NULL; p = next) {
+			next = p->next;
+			while (q != NULL && q->item < p->item)
+				q = q->next;
+			if (q != NULL && q->item == p->item) {
+				q = q->next; /* p may be q, if both sets are the same */
+				yadsl_set_item_unlink_internal(set_, p);
+			}
+		}
+	}
+
+	return YADSL_SET_RET_OK;
+}
+
 void
 yadsl_set_destroy(
 	yadsl_SetHandle* set,
 	yadsl_SetItemFreeFunc free_item_func,
 	yadsl_SetItemFreeArg* free_item_arg)
 {
-	yadsl_SetItem* internal_cursor, * next;
+	yadsl_SetItem* internal_cursor;
+	yadsl_SetSlab* slab;
 	yadsl_Set* set_ = (yadsl_Set*) set;
 
 	if (set_ == NULL)
 		return;
 
-	internal_cursor = set_->first;
-	next = NULL;
-
-	while (internal_cursor != NULL) {
-		if (free_item_func)
+	if (free_item_func)
+		for (internal_cursor = set_->first;
+			internal_cursor != NULL;
+			internal_cursor = internal_cursor->next)
 			free_item_func(internal_cursor->item, free_item_arg);
-		next = internal_cursor->next;
-		free(internal_cursor);
-		internal_cursor = next;
+
+	while (set_->slabs != NULL) {
+		slab = set_->slabs;
+		set_->slabs = slab->next;
+		free(slab);
 	}
 
+	if (set_->table)
+		free(set_->table);
+
 	free(set_);
 }
 
@@ -309,7 +671,24 @@ yadsl_set_item_contains_check_internal(
 	yadsl_SetItem** set_item_ptr)
 {
 	char direction = 0;
-	yadsl_SetItem* p = ((yadsl_Set*) set)->internal_cursor;
+	yadsl_Set* set_ = (yadsl_Set*) set;
+	yadsl_SetItem* p = set_->internal_cursor;
+	if (set_->is_hashed) {
+		size_t mask, i;
+		if (set_->table_capacity == 0)
+			return YADSL_SET_RET_DOES_NOT_CONTAIN;
+		mask = set_->table_capacity - 1;
+		for (i = yadsl_set_item_hash_internal(set_, item);
+			(p = set_->table[i]) != NULL;
+			i = (i + 1) & mask) {
+			if (p->item == item) {
+				if (set_item_ptr)
+					*set_item_ptr = p;
+				return YADSL_SET_RET_CONTAINS;
+			}
+		}
+		return YADSL_SET_RET_DOES_NOT_CONTAIN;
+	}
 	while (p != NULL) {
 		char current_direction;
 		if (p->item > item) {
@@ -328,4 +707,288 @@ yadsl_set_item_contains_check_internal(
 		direction = current_direction;
 	}
 	return YADSL_SET_RET_DOES_NOT_CONTAIN;
-}
\ No newline at end of file
+}
+
+// Unlinks item from the set and returns its node to the free list
+void
+yadsl_set_item_unlink_internal(
+	yadsl_Set* set,
+	yadsl_SetItem* p)
+{
+	if (p->next == NULL)
+		set->last = p->previous;
+	if (p->previous != NULL) {
+		if (p == set->internal_cursor)
+			set->internal_cursor = p->previous;
+		if (p == set->external_cursor)
+			set->external_cursor = p->previous;
+		p->previous->next = p->next;
+	} else {
+		if (p == set->internal_cursor)
+			set->internal_cursor = p->next;
+		if (p == set->external_cursor)
+			set->external_cursor = p->next;
+		set->first = p->next;
+	}
+	if (p->next != NULL) {
+		p->next->previous = p->previous;
+	}
+
+	if (set->is_hashed)
+		yadsl_set_table_remove_internal(set, p);
+
+	p->next = set->free_items;
+	set->free_items = p;
+	(set->free_count)++;
+	set->size = set->size - 1;
+}
+
+// Allocates a slab of count nodes and adds them to the free list
+yadsl_SetRet
+yadsl_set_slab_add_internal(
+	yadsl_Set* set,
+	size_t count)
+{
+	yadsl_SetSlab* slab;
+	size_t i;
+
+	slab = malloc(sizeof(*slab) + count * sizeof(slab->items[0]));
+	if (slab == NULL)
+		return YADSL_SET_RET_MEMORY;
+
+	slab->next = set->slabs;
+	set->slabs = slab;
+	for (i = count; i-- > 0;) {
+		slab->items[i].next = set->free_items;
+		set->free_items = &slab->items[i];
+	}
+	set->free_count += count;
+
+	return YADSL_SET_RET_OK;
+}
+
+// Takes a node from the free list, adding a new slab if it is empty
+// (slabs grow with the set, so that few allocations are made)
+yadsl_SetItem*
+yadsl_set_node_acquire_internal(
+	yadsl_Set* set)
+{
+	yadsl_SetItem* p;
+
+	if (set->free_items == NULL) {
+		size_t count = set->size;
+		if (count == 0)
+			count = 1;
+		else if (count > YADSL_SET_SLAB_MAX_COUNT)
+			count = YADSL_SET_SLAB_MAX_COUNT;
+		if (yadsl_set_slab_add_internal(set, count))
+			return NULL;
+	}
+
+	p = set->free_items;
+	set->free_items = p->next;
+	(set->free_count)--;
+
+	return p;
+}
+
+// Maps item address to its home slot in the table
+size_t
+yadsl_set_item_hash_internal(
+	yadsl_Set* set,
+	void* item)
+{
+	uint64_t h = (uint64_t) (uintptr_t) item;
+	h *= 0x9E3779B97F4A7C15ULL; /* Fibonacci hashing */
+	h ^= h >> 32;
+	return (size_t) h & (set->table_capacity - 1);
+}
+
+// Makes room in the table for count nodes, keeping the
+// load factor at most 3/4
+yadsl_SetRet
+yadsl_set_table_reserve_internal(
+	yadsl_Set* set,
+	size_t count)
+{
+	yadsl_SetItem** old_table = set->table;
+	size_t old_capacity = set->table_capacity, capacity, i;
+
+	if (count * 4 <= old_capacity * 3)
+		return YADSL_SET_RET_OK;
+
+	capacity = old_capacity ? old_capacity * 2 : YADSL_SET_TABLE_MIN_CAPACITY;
+	while (count * 4 > capacity * 3)
+		capacity *= 2;
+	set->table = calloc(capacity, sizeof(*set->table));
+	if (set->table == NULL) {
+		set->table = old_table;
+		return YADSL_SET_RET_MEMORY;
+	}
+	set->table_capacity = capacity;
+
+	for (i = 0; i < old_capacity; ++i)
+		if (old_table[i] != NULL)
+			yadsl_set_table_insert_internal(set, old_table[i]);
+
+	if (old_table)
+		free(old_table);
+
+	return YADSL_SET_RET_OK;
+}
+
+// Stores node in the first free slot from its home slot
+// (assumes there is at least one free slot)
+void
+yadsl_set_table_insert_internal(
+	yadsl_Set* set,
+	yadsl_SetItem* p)
+{
+	size_t mask = set->table_capacity - 1;
+	size_t i = yadsl_set_item_hash_internal(set, p->item);
+	while (set->table[i] != NULL)
+		i = (i + 1) & mask;
+	set->table[i] = p;
+}
+
+// Removes node from the table by shifting back the nodes
+// of the same cluster, so that no tombstones are needed
+void
+yadsl_set_table_remove_internal(
+	yadsl_Set* set,
+	yadsl_SetItem* p)
+{
+	size_t mask = set->table_capacity - 1;
+	size_t i = yadsl_set_item_hash_internal(set, p->item), j;
+	while (set->table[i] != p)
+		i = (i + 1) & mask;
+	for (j = (i + 1) & mask; set->table[j] != NULL; j = (j + 1) & mask) {
+		size_t home = yadsl_set_item_hash_internal(set, set->table[j]->item);
+		// move node at j to the hole at i if its home slot
+		// does not lie cyclically in (i, j]
+		if (((j - home) & mask) >= ((j - i) & mask)) {
+			set->table[i] = set->table[j];
+			i = j;
+		}
+	}
+	set->table[i] = NULL;
+}
+
+// Links a new node holding item right before next
+// (or at the end of the list, if next is NULL)
+// [!] Assumes item is not in the set and that
+// the order of the list is kept
+yadsl_SetRet
+yadsl_set_item_link_internal(
+	yadsl_Set* set,
+	yadsl_SetItemObj* item,
+	yadsl_SetItem* next)
+{
+	yadsl_SetItem* set_item;
+
+	if (set->is_hashed && yadsl_set_table_reserve_internal(set, set->size + 1))
+		return YADSL_SET_RET_MEMORY;
+
+	set_item = yadsl_set_node_acquire_internal(set);
+	if (set_item == NULL)
+		return YADSL_SET_RET_MEMORY;
+
+	set_item->item = item;
+	set_item->next = next;
+	set_item->previous = next ? next->previous : set->last;
+	if (set_item->previous != NULL)
+		set_item->previous->next = set_item;
+	else
+		set->first = set_item;
+	if (next != NULL)
+		next->previous = set_item;
+	else
+		set->last = set_item;
+
+	if (set->is_hashed)
+		yadsl_set_table_insert_internal(set, set_item);
+	if (set->external_cursor == NULL)
+		set->external_cursor = set_item;
+	set->internal_cursor = set_item;
+	(set->size)++;
+
+	return YADSL_SET_RET_OK;
+}
+
+// Adds items, sorted in increasing order of address, to a list
+// in a single pass, skipping those already in the set
+yadsl_SetRet
+yadsl_set_items_merge_internal(
+	yadsl_Set* set,
+	yadsl_SetItemObj** items,
+	size_t count)
+{
+	yadsl_SetItem* p = set->first;
+	size_t i;
+	for (i = 0; i < count; ++i) {
+		if (i > 0 && items[i] == items[i - 1])
+			continue;
+		while (p != NULL && p->item < items[i])
+			p = p->next;
+		if (p != NULL && p->item == items[i])
+			continue;
+		if (yadsl_set_item_link_internal(set, items[i], p))
+			return YADSL_SET_RET_MEMORY;
+	}
+	return YADSL_SET_RET_OK;
+}
+
+// Gets the items of the set in increasing order of address
+// [!] The array must be freed by the caller
+yadsl_SetRet
+yadsl_set_items_sorted_get_internal(
+	yadsl_Set* set,
+	yadsl_SetItemObj*** items_ptr)
+{
+	yadsl_SetItemObj** items;
+	yadsl_SetItem* p;
+	size_t i = 0;
+
+	items = malloc(sizeof(*items) * (set->size + 1));
+	if (items == NULL)
+		return YADSL_SET_RET_MEMORY;
+	for (p = set->first; p != NULL; p = p->next)
+		items[i++] = p->item;
+	if (set->is_hashed)
+		qsort(items, set->size, sizeof(*items),
+			yadsl_set_address_compare_internal);
+
+	*items_ptr = items;
+	return YADSL_SET_RET_OK;
+}
+
+// Copies set, with the same backend and order
+yadsl_Set*
+yadsl_set_copy_internal(
+	yadsl_Set* set)
+{
+	yadsl_Set* copy;
+	yadsl_SetItem* p;
+
+	copy = set->is_hashed ? yadsl_set_create_hashed() : yadsl_set_create();
+	if (copy == NULL)
+		return NULL;
+	for (p = set->first; p != NULL; p = p->next) {
+		if (yadsl_set_item_link_internal(copy, p->item, NULL)) {
+			yadsl_set_destroy(copy, NULL, NULL);
+			return NULL;
+		}
+	}
+	return copy;
+}
+
+// Orders pointers by address (for qsort and bsearch)
+int
+yadsl_set_address_compare_internal(
+	const void* a,
+	const void* b)
+{
+	const void* pa = *(const void* const*) a;
+	const void* pb = *(const void* const*) b;
+	return pa < pb ? -1 : pa > pb;
+}
@@ -17,6 +17,11 @@
  *
  * Items can assume NULL (0) value.
  *
+ * By default, items are kept in a list sorted by address,
+ * and membership checks walk it from the last accessed item.
+ * A hashed set (see ::yadsl_set_create_hashed) checks membership
+ * in expected constant time and keeps items in insertion order.
+ *
  * The filtering function takes an item and the additional
  * argument as parameters and should return a boolean value
  * indicating if the item is the one to be filtered. If 'True'
@@ -49,6 +54,7 @@ yadsl_SetRet;
 
 typedef void yadsl_SetHandle; /**< Set handle */
 typedef void yadsl_SetItemObj; /**< Set item object */
+typedef void yadsl_SetItemHandle; /**< Handle to an item stored in a set */
 
 typedef void yadsl_SetItemFilterArg; /**< Argument passed to yadsl_SetFilterFunc */
 typedef void yadsl_SetItemFreeArg; /**< Argument passed to yadsl_SetItemFreeFunc */
@@ -81,6 +87,19 @@ typedef void
 yadsl_SetHandle*
 yadsl_set_create();
 
+/**
+ * @brief Create an empty hashed set
+ *
+ * Items are indexed by an open-addressing hash table on their
+ * addresses, so that checking, adding and removing items take
+ * expected constant time. The cursor walks through the items
+ * in insertion order instead of address order.
+ *
+ * @return newly created set or NULL if could not allocate memory
+*/
+yadsl_SetHandle*
+yadsl_set_create_hashed();
+
 /**
  * @brief Check whether set contains item or not
  * @param set set
@@ -137,6 +156,39 @@ yadsl_set_item_remove(
 	yadsl_SetHandle* set,
 	yadsl_SetItemObj* item);
 
+/**
+ * @brief Add item to set and get a handle to it
+ *
+ * The handle stays valid until the item is removed from the set,
+ * and allows removing it in constant time.
+ *
+ * @param set set
+ * @param item item to be added
+ * @param handle_ptr handle to the added item
+ * @return
+ * * ::YADSL_SET_RET_OK, and item is added and *handle_ptr is updated
+ * * ::YADSL_SET_RET_CONTAINS
+ * * ::YADSL_SET_RET_MEMORY
+ * @see yadsl_set_item_handle_remove
+*/
+yadsl_SetRet
+yadsl_set_item_handle_add(
+	yadsl_SetHandle* set,
+	yadsl_SetItemObj* item,
+	yadsl_SetItemHandle** handle_ptr);
+
+/**
+ * @brief Remove item from set through its handle, in constant time
+ * @param set set
+ * @param handle handle obtained from ::yadsl_set_item_handle_add
+ * @return
+ * * ::YADSL_SET_RET_OK, and item is removed
+*/
+yadsl_SetRet
+yadsl_set_item_handle_remove(
+	yadsl_SetHandle* set,
+	yadsl_SetItemHandle* handle);
+
 /**
  * @brief Get item currently pointed by the cursor
  * @param set set
@@ -150,6 +202,38 @@ yadsl_set_cursor_get(
 	yadsl_SetHandle* set,
 	yadsl_SetItemObj** item_ptr);
 
+/**
+ * @brief Reserve item nodes in advance
+ *
+ * Nodes of removed items are kept by the set and reused by later
+ * additions, so that the allocator is only called when the set
+ * grows past its capacity. Reserving makes sure that the next
+ * additions, up to the given capacity, do not allocate nodes
+ * (nor grow the table of a hashed set).
+ *
+ * @param set set
+ * @param capacity number of items the set must be able to hold
+ * @return
+ * * ::YADSL_SET_RET_OK, and nodes are reserved
+ * * ::YADSL_SET_RET_MEMORY
+*/
+yadsl_SetRet
+yadsl_set_reserve(
+	yadsl_SetHandle* set,
+	size_t capacity);
+
+/**
+ * @brief Get number of items the set can hold without allocating nodes
+ * @param set set
+ * @param capacity_ptr set capacity
+ * @return
+ * * ::YADSL_SET_RET_OK, and *capacity_ptr is updated
+*/
+yadsl_SetRet
+yadsl_set_capacity_get(
+	yadsl_SetHandle* set,
+	size_t* capacity_ptr);
+
 /**
  * @brief Get set cardinality
  * @param set set
@@ -208,6 +292,126 @@ yadsl_SetRet
 yadsl_set_cursor_last(
 	yadsl_SetHandle* set);
 
+/**
+ * @brief Add items from an array to set
+ *
+ * Items already in the set (or repeated in the array) are skipped.
+ * On a sorted set, the items are sorted and merged in a single pass.
+ * If memory runs out, some of the items may have been added.
+ *
+ * @param set set
+ * @param items array of items to be added
+ * @param count number of items in the array
+ * @return
+ * * ::YADSL_SET_RET_OK, and items are added
+ * * ::YADSL_SET_RET_MEMORY
+*/
+yadsl_SetRet
+yadsl_set_items_add(
+	yadsl_SetHandle* set,
+	yadsl_SetItemObj** items,
+	size_t count);
+
+/**
+ * @brief Create the union of two sets
+ *
+ * The new set has the same backend as set.
+ * Both sets are walked once, in linear time.
+ *
+ * @param set set
+ * @param other other set
+ * @param union_ptr union of both sets
+ * @return
+ * * ::YADSL_SET_RET_OK, and *union_ptr is updated
+ * * ::YADSL_SET_RET_MEMORY
+*/
+yadsl_SetRet
+yadsl_set_union(
+	yadsl_SetHandle* set,
+	yadsl_SetHandle* other,
+	yadsl_SetHandle** union_ptr);
+
+/**
+ * @brief Add items from other set to set
+ *
+ * If memory runs out, some of the items may have been added.
+ *
+ * @param set set
+ * @param other other set
+ * @return
+ * * ::YADSL_SET_RET_OK, and set becomes the union of both sets
+ * * ::YADSL_SET_RET_MEMORY
+*/
+yadsl_SetRet
+yadsl_set_union_update(
+	yadsl_SetHandle* set,
+	yadsl_SetHandle* other);
+
+/**
+ * @brief Create the intersection of two sets
+ *
+ * The new set has the same backend as set. Two sorted sets
+ * are walked side by side; otherwise, one set is iterated
+ * and the other hashed set is probed, in time proportional
+ * to the iterated set (the smaller, if both are hashed).
+ *
+ * @param set set
+ * @param other other set
+ * @param intersection_ptr intersection of both sets
+ * @return
+ * * ::YADSL_SET_RET_OK, and *intersection_ptr is updated
+ * * ::YADSL_SET_RET_MEMORY
+*/
+yadsl_SetRet
+yadsl_set_intersection(
+	yadsl_SetHandle* set,
+	yadsl_SetHandle* other,
+	yadsl_SetHandle** intersection_ptr);
+
+/**
+ * @brief Remove items not in other set from set
+ * @param set set
+ * @param other other set
+ * @return
+ * * ::YADSL_SET_RET_OK, and set becomes the intersection of both sets
+ * * ::YADSL_SET_RET_MEMORY, and set is not changed
+*/
+yadsl_SetRet
+yadsl_set_intersection_update(
+	yadsl_SetHandle* set,
+	yadsl_SetHandle* other);
+
+/**
+ * @brief Create the difference of two sets
+ *
+ * The new set has the same backend as set and contains
+ * the items in set that are not in other set.
+ *
+ * @param set set
+ * @param other other set
+ * @param difference_ptr difference of both sets
+ * @return
+ * * ::YADSL_SET_RET_OK, and *difference_ptr is updated
+ * * ::YADSL_SET_RET_MEMORY
+*/
+yadsl_SetRet
+yadsl_set_difference(
+	yadsl_SetHandle* set,
+	yadsl_SetHandle* other,
+	yadsl_SetHandle** difference_ptr);
+
+/**
+ * @brief Remove items in other set from set
+ * @param set set
+ * @param other other set
+ * @return
+ * * ::YADSL_SET_RET_OK, and set becomes the difference of both sets
+*/
+yadsl_SetRet
+yadsl_set_difference_update(
+	yadsl_SetHandle* set,
+	yadsl_SetHandle* other);
+
 /**
  * @brief Destroy set and its remaining items
  * @param set set
@@ -20,12 +20,30 @@ const char *yadsl_tester_help_strings[] = {
 	"/filtersave <string>       filter string and save it",
 	"/add                       add saved string to set",
 	"/remove                    remove saved string from set",
+	"/addhandle                 add saved string to set and keep its handle",
+	"/removehandle              remove string through the kept handle",
 	"/current <expected>        get string pointed by the cursor",
 	"/size <expected>           get set size",
+	"/reserve <capacity>        reserve item nodes",
+	"/capacity <expected>       get set capacity",
 	"/previous                  move cursor to previous string",
 	"/next                      move cursor to next string",
 	"/first                     move cursor to first string",
 	"/last                      move cursor to last string",
+	"/hashed                    replace set by an empty hashed set",
+	"/sorted                    replace set by an empty sorted set",
+	"/swap                      swap set with the other set",
+	"/addall <string> <string>  add saved string, two new strings and",
+	"                           saved string again in bulk",
+	"/union                     replace set by its union with the other set",
+	"/intersection              replace set by its intersection with the other set",
+	"/difference                replace set by its difference with the other set",
+	"/unionupdate               add items from the other set",
+	"/intersectionupdate        remove items not in the other set",
+	"/differenceupdate          remove items in the other set",
+	"",
+	"Every string is kept in a pool until the end of the test,",
+	"so that the same string can be added to both sets.",
 	NULL, /* Sentinel */
 };
 
@@ -51,18 +69,46 @@ yadsl_TesterRet convertReturn(yadsl_SetRet setId)
 
 /* Set object */
 static yadsl_SetHandle *pSet = NULL;
+static yadsl_SetHandle *pOther = NULL;
+static yadsl_SetHandle *pPool = NULL;
 static char *savedStr = NULL;
+static yadsl_SetItemHandle *savedHandle = NULL;
 
 static char buffer[BUFSIZ], arg[BUFSIZ];
 
 yadsl_TesterRet yadsl_tester_init()
 {
-	if (pSet = yadsl_set_create())
+	if ((pSet = yadsl_set_create()) &&
+		(pOther = yadsl_set_create()) &&
+		(pPool = yadsl_set_create()))
 		return YADSL_TESTER_RET_OK;
 	else
 		return YADSL_TESTER_RET_MALLOC;
 }
 
+/* Duplicates string and keeps it in the pool */
+char *poolDuplicate(const char *str)
+{
+	char *temp = yadsl_string_duplicate(str);
+	if (temp == NULL)
+		return NULL;
+	if (yadsl_set_item_add(pPool, temp)) {
+		free(temp);
+		return NULL;
+	}
+	return temp;
+}
+
+/* Replaces set by the result of a set operation */
+void replaceSet(yadsl_SetRet setId, yadsl_SetHandle *newSet)
+{
+	if (setId == YADSL_SET_RET_OK) {
+		yadsl_set_destroy(pSet, NULL, NULL);
+		pSet = newSet;
+		savedHandle = NULL;
+	}
+}
+
 bool filterItem(void *item, void *arg)
 {
 	return strcmp((char *) item, (char *) arg) == 0;
@@ -75,11 +121,8 @@ yadsl_TesterRet yadsl_tester_parse(const char *command)
 	if (yadsl_testerutils_match(command, "save")) {
 		if (yadsl_tester_parse_arguments("s", buffer) != 1)
 			return YADSL_TESTER_RET_ARGUMENT;
-		if ((temp = yadsl_string_duplicate(buffer)) == NULL)
+		if ((temp = poolDuplicate(buffer)) == NULL)
 			return YADSL_TESTER_RET_MALLOC;
-		if (yadsl_set_item_contains_check(pSet, savedStr) != YADSL_SET_RET_CONTAINS)
-			if (savedStr)
-				free(savedStr);
 		savedStr = temp;
 	} else if (yadsl_testerutils_match(command, "contains")) {
 		int expected, actual;
@@ -116,12 +159,8 @@ yadsl_TesterRet yadsl_tester_parse(const char *command)
 		if ((temp = yadsl_string_duplicate(buffer)) == NULL)
 			return YADSL_TESTER_RET_MALLOC;
 		setId = yadsl_set_item_filter(pSet, filterItem, temp, (yadsl_SetItemObj**) &foundStr);
-		if (setId == YADSL_SET_RET_OK) {
-			if (savedStr != NULL &&
-				yadsl_set_item_contains_check(pSet, savedStr) != YADSL_SET_RET_CONTAINS)
-				free(savedStr);
+		if (setId == YADSL_SET_RET_OK)
 			savedStr = foundStr;
-		}
 		free(temp);
 	} else if (yadsl_testerutils_match(command, "add")) {
 		if (savedStr == NULL)
@@ -131,6 +170,17 @@ yadsl_TesterRet yadsl_tester_parse(const char *command)
 		if (savedStr == NULL)
 			yadsl_tester_log("Found no variable saved. Removing NULL.");
 		setId = yadsl_set_item_remove(pSet, savedStr);
+	} else if (yadsl_testerutils_match(command, "addhandle")) {
+		if (savedStr == NULL)
+			yadsl_tester_log("Found no variable saved. Adding NULL.");
+		setId = yadsl_set_item_handle_add(pSet, savedStr, &savedHandle);
+	} else if (yadsl_testerutils_match(command, "removehandle")) {
+		if (savedHandle == NULL) {
+			yadsl_tester_log("Found no handle kept.");
+			return YADSL_TESTER_RET_ARGUMENT;
+		}
+		setId = yadsl_set_item_handle_remove(pSet, savedHandle);
+		savedHandle = NULL;
 	} else if (yadsl_testerutils_match(command, "current")) {
 		char *currentStr;
 		if (yadsl_tester_parse_arguments("s", buffer) != 1)
@@ -160,6 +210,18 @@ yadsl_TesterRet yadsl_tester_parse(const char *command)
 		setId = yadsl_set_size_get(pSet, &actual);
 		if (setId == YADSL_SET_RET_OK && actual != expected)
 			return YADSL_TESTER_RET_RETURN;
+	} else if (yadsl_testerutils_match(command, "reserve")) {
+		size_t capacity;
+		if (yadsl_tester_parse_arguments("z", &capacity) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		setId = yadsl_set_reserve(pSet, capacity);
+	} else if (yadsl_testerutils_match(command, "capacity")) {
+		size_t expected, actual;
+		if (yadsl_tester_parse_arguments("z", &expected) != 1)
+			return YADSL_TESTER_RET_ARGUMENT;
+		setId = yadsl_set_capacity_get(pSet, &actual);
+		if (setId == YADSL_SET_RET_OK && actual != expected)
+			return YADSL_TESTER_RET_RETURN;
 	} else if (yadsl_testerutils_match(command, "previous")) {
 		setId = yadsl_set_cursor_previous(pSet);
 	} else if (yadsl_testerutils_match(command, "next")) {
@@ -168,6 +230,48 @@ yadsl_TesterRet yadsl_tester_parse(const char *command)
 		setId = yadsl_set_cursor_first(pSet);
 	} else if (yadsl_testerutils_match(command, "last")) {
 		setId = yadsl_set_cursor_last(pSet);
+	} else if (yadsl_testerutils_match(command, "hashed")) {
+		yadsl_SetHandle *hashedSet = yadsl_set_create_hashed();
+		if (hashedSet == NULL)
+			return YADSL_TESTER_RET_MALLOC;
+		replaceSet(YADSL_SET_RET_OK, hashedSet);
+	} else if (yadsl_testerutils_match(command, "sorted")) {
+		yadsl_SetHandle *sortedSet = yadsl_set_create();
+		if (sortedSet == NULL)
+			return YADSL_TESTER_RET_MALLOC;
+		replaceSet(YADSL_SET_RET_OK, sortedSet);
+	} else if (yadsl_testerutils_match(command, "swap")) {
+		yadsl_SetHandle *temp = pSet;
+		pSet = pOther;
+		pOther = temp;
+		savedHandle = NULL;
+	} else if (yadsl_testerutils_match(command, "addall")) {
+		yadsl_SetItemObj *items[4];
+		if (yadsl_tester_parse_arguments("ss", buffer, arg) != 2)
+			return YADSL_TESTER_RET_ARGUMENT;
+		items[0] = items[3] = savedStr;
+		if ((items[1] = poolDuplicate(buffer)) == NULL ||
+			(items[2] = poolDuplicate(arg)) == NULL)
+			return YADSL_TESTER_RET_MALLOC;
+		setId = yadsl_set_items_add(pSet, items, 4);
+	} else if (yadsl_testerutils_match(command, "union")) {
+		yadsl_SetHandle *newSet = NULL;
+		setId = yadsl_set_union(pSet, pOther, &newSet);
+		replaceSet(setId, newSet);
+	} else if (yadsl_testerutils_match(command, "intersection")) {
+		yadsl_SetHandle *newSet = NULL;
+		setId = yadsl_set_intersection(pSet, pOther, &newSet);
+		replaceSet(setId, newSet);
+	} else if (yadsl_testerutils_match(command, "difference")) {
+		yadsl_SetHandle *newSet = NULL;
+		setId = yadsl_set_difference(pSet, pOther, &newSet);
+		replaceSet(setId, newSet);
+	} else if (yadsl_testerutils_match(command, "unionupdate")) {
+		setId = yadsl_set_union_update(pSet, pOther);
+	} else if (yadsl_testerutils_match(command, "intersectionupdate")) {
+		setId = yadsl_set_intersection_update(pSet, pOther);
+	} else if (yadsl_testerutils_match(command, "differenceupdate")) {
+		setId = yadsl_set_difference_update(pSet, pOther);
 	} else {
 		return YADSL_TESTER_RET_COMMAND;
 	}
@@ -176,17 +280,13 @@ yadsl_TesterRet yadsl_tester_parse(const char *command)
 
 void freeItem(void *item, void *arg)
 {
-	char *str = (char *) item;
-	if (str == savedStr)
-		savedStr = NULL;
-	free(str);
+	free(item);
 }
 
 yadsl_TesterRet yadsl_tester_release()
 {
-	if (pSet != NULL)
-		yadsl_set_destroy(pSet, freeItem, NULL);
-	if (savedStr != NULL)
-		free(savedStr);
+	yadsl_set_destroy(pSet, NULL, NULL);
+	yadsl_set_destroy(pOther, NULL, NULL);
+	yadsl_set_destroy(pPool, freeItem, NULL);
 	return YADSL_TESTER_RET_OK;
 }